@@ -51,6 +51,14 @@
 #define Stepper_setStepDirectionPositive(directionBitVector, stepper)  (directionBitVector |= _BV(stepper))
 #define Stepper_setStepDirectionNegative(directionBitVector, stepper)  (directionBitVector |= _BV(stepper))
 
+/**
+ * Name of the machine profile the firmware was built for, see
+ * Application_3DPrinter/profiles. Each profile sets its own name.
+ */
+#ifndef MACHINE_PROFILE_NAME
+#define MACHINE_PROFILE_NAME          "default"
+#endif
+
 /**
  * Number of (linear independent) axis for this machine. The number
  * defines the world and axis coordinate system for the machine at hand.
@@ -76,6 +84,48 @@
 #define MACHINE_NUM_EXTRUDER          (uint8_t)1
 #endif
 
+/**
+ * Feedrate used for moves until the first F field is received [mm/s]
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DBLUEMARLIN_DEFAULT_FEEDRATE 25.0
+ */
+#ifndef BLUEMARLIN_DEFAULT_FEEDRATE
+#define BLUEMARLIN_DEFAULT_FEEDRATE   (WorldCoordinate_t)25.0
+#endif
+
+/**
+ * Period at which g-codes are read from the serial line [µs]. Each run
+ * reads up to GCODEREADER_NUMBEROFGCODESTOREAD lines.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DBLUEMARLIN_INGEST_PERIOD 1000
+ */
+#ifndef BLUEMARLIN_INGEST_PERIOD
+#define BLUEMARLIN_INGEST_PERIOD      (uint32_t)1000
+#endif
+
+/**
+ * Longest expected run time of reading g-codes [µs]
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DBLUEMARLIN_INGEST_BUDGET 500
+ */
+#ifndef BLUEMARLIN_INGEST_BUDGET
+#define BLUEMARLIN_INGEST_BUDGET      (uint32_t)500
+#endif
+
+/**
+ * Longest expected run time of g-code execution and planning, see
+ * BlueMarlin_process() [µs]
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DBLUEMARLIN_PROCESS_BUDGET 2000
+ */
+#ifndef BLUEMARLIN_PROCESS_BUDGET
+#define BLUEMARLIN_PROCESS_BUDGET     (uint32_t)2000
+#endif
+
 /* ******************| Type definitions |****************************** */
 
 /* TODO: To be moved to machine/Kinematik module */
@@ -128,8 +178,17 @@ typedef struct {
         uint8_t directionBits;                                /*!< Direction bit-field for each stepper. Bits are used in the same order as axis are defined. */
 } StepperCoordinates_t;
 /* ******************| External function declarations |**************** */
+#ifdef __cplusplus
+extern "C" {
+#endif
 extern void setup(void);
 extern void loop(void);
+#ifdef __cplusplus
+}
+#endif
+extern void BlueMarlin_process(void);
+extern bool BlueMarlin_isIdle(void);
+extern bool BlueMarlin_isWaiting(void);
 
 
 /* ******************| External constants |**************************** */
@@ -0,0 +1,58 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#if (!defined APPLICATION_3DPRINTER_PROFILES_CARTESIAN_H_)
+/* Preprocessor exclusion definition */
+#define APPLICATION_3DPRINTER_PROFILES_CARTESIAN_H_
+/**
+ * \brief Machine profile of a Cartesian printer
+ *
+ * Bed slinger with one extruder, e.g. Prusa i3. Matches the defaults of
+ * all modules.
+ *
+ * Selected with make PROFILE=cartesian. The file is included before every
+ * source file, thus, all values below replace the defaults of the
+ * modules. Values not set here keep their defaults.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+/** \addtogroup Application_3DPrinter
+ * @{
+ */
+
+/* ******************| Macros |**************************************** */
+/**
+ * Name of the profile printed by reports and benchmarks
+ */
+#define MACHINE_PROFILE_NAME                "cartesian"
+
+#define KINEMATIC_TYPE                      KINEMATIC_TYPE_CARTESIAN
+#define MACHINE_NUM_EXTRUDER                (uint8_t)1
+#define KINEMATIC_AXIS_STEPS_PER_UNIT       {80, 80, 400}
+#define KINEMATIC_EXTRUDER_STEPS_PER_UNIT   (AxisCoordinate_t)95
+#define MOTIONBUFFER_MOTIONBUFFER_SIZE      (uint8_t)32
+
+/** @} doxygen end group definition */
+#endif /* if !defined( APPLICATION_3DPRINTER_PROFILES_CARTESIAN_H_ ) */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,60 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#if (!defined APPLICATION_3DPRINTER_PROFILES_DELTA_H_)
+/* Preprocessor exclusion definition */
+#define APPLICATION_3DPRINTER_PROFILES_DELTA_H_
+/**
+ * \brief Machine profile of a delta printer
+ *
+ * Linear delta with three towers and one Bowden extruder. Straight moves
+ * are split into segments, thus, the motion buffer holds more blocks.
+ *
+ * Selected with make PROFILE=delta. The file is included before every
+ * source file, thus, all values below replace the defaults of the
+ * modules. Values not set here keep their defaults.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+/** \addtogroup Application_3DPrinter
+ * @{
+ */
+
+/* ******************| Macros |**************************************** */
+/**
+ * Name of the profile printed by reports and benchmarks
+ */
+#define MACHINE_PROFILE_NAME                "delta"
+
+#define KINEMATIC_TYPE                      KINEMATIC_TYPE_DELTA
+#define MACHINE_NUM_EXTRUDER                (uint8_t)1
+#define KINEMATIC_AXIS_STEPS_PER_UNIT       {80, 80, 80}
+#define KINEMATIC_EXTRUDER_STEPS_PER_UNIT   (AxisCoordinate_t)95
+#define KINEMATIC_DELTA_DIAGONAL_ROD        (WorldCoordinate_t)250.0
+#define KINEMATIC_DELTA_RADIUS              (WorldCoordinate_t)124.0
+#define MOTIONBUFFER_MOTIONBUFFER_SIZE      (uint8_t)64
+
+/** @} doxygen end group definition */
+#endif /* if !defined( APPLICATION_3DPRINTER_PROFILES_DELTA_H_ ) */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,748 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * \file blueMarlin.cpp
+ *
+ * \brief Main file for BlueMarlin firmware
+ *
+ * This is the main entry point to the firmware. In this file setup and
+ * loop are implemented.
+ * The g-codes read by GCodeReader are executed here and handed to the
+ * motion planner.
+ *
+ * \project BlueMarlin
+ * \author kein0f
+ *
+ */
+
+
+/** \addtogroup BlueMarlin
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include "platform.h"
+#include "blueMarlin.h"
+#include <kinematic.h>
+#include <parameter.h>
+#include <gCodeReader.h>
+#include <motionBuffer.h>
+#include <motionPlanner.h>
+#include <stepper.h>
+#include <stepCompress.h>
+#include <scheduler.h>
+#include <serial.h>
+#include <trace.h>
+#include <metrics.h>
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+void BlueMarlin_process(void);
+bool BlueMarlin_isIdle(void);
+bool BlueMarlin_isWaiting(void);
+static bool BlueMarlin_isMoving(void);
+static bool BlueMarlin_synchronize(void);
+static void BlueMarlin_readTarget(const uint8_t *gCode, WorldCoordinates_t *target);
+static WorldCoordinates_t BlueMarlin_machinePosition(const WorldCoordinates_t &position);
+static void BlueMarlin_setPosition(const uint8_t *gCode);
+static uint8_t BlueMarlin_dwell(const uint8_t *gCode);
+static void BlueMarlin_updateParameter(void);
+static uint8_t BlueMarlin_setStepsPerUnit(const uint8_t *gCode);
+static uint8_t BlueMarlin_loadParameter(void);
+static void BlueMarlin_addMetrics(void);
+static uint32_t BlueMarlin_motionBufferDepth(void);
+static uint32_t BlueMarlin_schedulerOverruns(void);
+static uint32_t BlueMarlin_schedulerDeadlineMisses(void);
+static uint8_t BlueMarlin_executeGCode(const uint8_t *gCode);
+static void BlueMarlin_processGCodes(void);
+
+/* ******************| Global Variables |****************************** */
+/**
+ * G-code which is currently executed
+ */
+static GCodeReader_GCode_t BlueMarlin_gCode;
+
+/**
+ * True while #BlueMarlin_gCode is executed. A g-code stays in execution
+ * until it was accepted by the motion planner or, e.g. for dwell, is
+ * finished.
+ */
+static bool BlueMarlin_gCodeActive = false;
+
+/**
+ * Position requested by the last g-code in g-code coordinates, that is
+ * without the offset set by G92 [mm]
+ */
+static WorldCoordinates_t BlueMarlin_position = {0.0, 0.0, 0.0, 0.0};
+
+/**
+ * Offset set by G92 which is added to g-code coordinates to get the
+ * coordinates of the motion planner [mm]
+ */
+static WorldCoordinates_t BlueMarlin_offset = {0.0, 0.0, 0.0, 0.0};
+
+/**
+ * Feedrate of the last g-code with F field [mm/s]
+ */
+static WorldCoordinate_t BlueMarlin_feedrate = BLUEMARLIN_DEFAULT_FEEDRATE;
+
+/**
+ * True if X, Y, Z and E are relative (G91)
+ */
+static bool BlueMarlin_relativePositioning = false;
+
+/**
+ * True if E is relative (M83)
+ */
+static bool BlueMarlin_relativeExtrusion = false;
+
+/**
+ * True while waiting for the end of a dwell
+ */
+static bool BlueMarlin_dwellActive = false;
+
+/**
+ * Time at which the current dwell ends, see micros() [µs]
+ */
+static uint32_t BlueMarlin_dwellEnd;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Implementation of function set-up from Arduino framework
+ *
+ * This function is called right after hardware initialization once. The
+ * existence of this function is based on the Arduino framework for which
+ * this firmware was originally written.
+ * This function does not obey the overall function naming rules.
+*/
+void setup(void)
+{
+#if (TRACE_ENABLE)
+  Trace_init();
+  Trace_name(&Serial_rxRingBuffer, "Serial_rxRingBuffer");
+  Trace_name(&gCodeRingBuffer, "gCodeRingBuffer");
+  Trace_name(&motionBuffer, "motionBuffer");
+#if (STEPPER_GENERATOR == STEPPER_GENERATOR_STEPCOMPRESS)
+  char name[] = "stepCompressQueue0";
+
+  for (uint8_t i=0; i<STEPPER_NUM_STEPPER; i++)
+    {
+      name[sizeof(name) - 2] = '0' + i;
+      Trace_name(&stepCompressQueue[i], name);
+    }
+#endif
+#endif
+  Kinematic_init();
+  motionPlanner.init();
+#if (STEPPER_GENERATOR == STEPPER_GENERATOR_STEPCOMPRESS)
+  StepCompress_init();
+#else
+  Stepper_init();
+#endif
+  /* Defaults were set by the module initialization above and are kept
+   * if there is no valid record in the storage */
+  if (Parameter_load(&parameter) == RESULT_OK)
+    {
+      kinematic.init();
+    }
+  Parameter_publish(&parameter);
+  Parameter_derive();
+  Scheduler_init();
+  /* Reading is cheap and the serial buffer holds several lines, a fixed
+   * rate is enough. Execution and planning run whenever possible. */
+  Scheduler_addTask("ingest", GCodeReader_readGCodeSerial, 0, BLUEMARLIN_INGEST_PERIOD, BLUEMARLIN_INGEST_BUDGET);
+  Scheduler_addTask("process", BlueMarlin_process, 1, SCHEDULER_EVERY_ROUND, BLUEMARLIN_PROCESS_BUDGET);
+  BlueMarlin_addMetrics();
+}
+
+/**
+ * \brief Implementation of function loop from Arduino framework
+ *
+ * This function is called cyclically as fast as possible. The existence
+ * of this function is based on the Arduino framework for which
+ * this firmware was originally written. Each call is one round of the
+ * scheduler, see setup() for the tasks.
+ * This function does not obey the overall function naming rules.
+ */
+void loop(void)
+{
+  Scheduler_run();
+}
+
+/**
+ * \brief Executes g-codes and generates the resulting movements
+ *
+ * Task "process" of the scheduler. Platforms which read g-codes in a
+ * separate thread call this function directly instead of loop().
+ */
+void BlueMarlin_process(void)
+{
+  /* Parameter published by another context are taken over between two
+   * moves */
+  if (motionPlanner.isReady() && !motionPlanner.hasPendingMove())
+    {
+      BlueMarlin_updateParameter();
+    }
+  BlueMarlin_processGCodes();
+  /* Continue segment generation of the current movement as far as the
+   * motion buffer allows */
+  motionPlanner.run();
+#if (STEPPER_GENERATOR == STEPPER_GENERATOR_STEPCOMPRESS)
+  /* Step timing is calculated here, the interrupt only replays it */
+  StepCompress_run();
+#endif
+}
+
+/**
+ * \brief Checks if the machine has nothing to do
+ *
+ * @return True if no g-code is waiting or executed and all movements are
+ * finished
+ */
+bool BlueMarlin_isIdle(void)
+{
+  return !BlueMarlin_gCodeActive && (gCodeRingBuffer.available() == 0) && !BlueMarlin_isMoving();
+}
+
+/**
+ * \brief Checks if only the passing of time changes the state of the machine
+ *
+ * This is the case if the machine stands still and either waits for the
+ * end of a dwell or for new g-codes. Used by simulating platforms to skip
+ * idle time.
+ * @return True if the machine is waiting
+ */
+bool BlueMarlin_isWaiting(void)
+{
+  return (BlueMarlin_dwellActive || (!BlueMarlin_gCodeActive && (gCodeRingBuffer.available() == 0))) &&
+         !BlueMarlin_isMoving();
+}
+
+/**
+ * \brief Checks if any movement is not finished yet
+ *
+ * @return True if the motion planner, the motion buffer or the step
+ * generator still has work to do
+ */
+static bool BlueMarlin_isMoving(void)
+{
+  /* The motion buffer must be checked before the step generator, which may
+   * take a block meanwhile */
+  if (motionPlanner.hasPendingMove() || !motionPlanner.isReady() || (motionBuffer.available() > 0))
+    {
+      return true;
+    }
+#if (STEPPER_GENERATOR == STEPPER_GENERATOR_STEPCOMPRESS)
+  return !StepCompress_isIdle();
+#else
+  return !Stepper_isIdle();
+#endif
+}
+
+/**
+ * \brief Waits for all movements to finish
+ *
+ * Moves held back for coalescing are handed to the motion buffer first.
+ * Never blocks.
+ * @return True if all movements are finished
+ */
+static bool BlueMarlin_synchronize(void)
+{
+  motionPlanner.flushLineMovement();
+  return !BlueMarlin_isMoving();
+}
+
+/**
+ * \brief Reads the target of a move from X, Y, Z and E fields
+ *
+ * Missing fields keep the coordinate of #BlueMarlin_position.
+ * @param[in] gCode Compressed g-code
+ * @param[out] target Target in g-code coordinates [mm]
+ */
+static void BlueMarlin_readTarget(const uint8_t *gCode, WorldCoordinates_t *target)
+{
+  float value;
+
+  *target = BlueMarlin_position;
+  if (GCodeReader_getValue(gCode, 'X', &value) == RESULT_OK)
+    {
+      target->x = BlueMarlin_relativePositioning ? (target->x + value) : value;
+    }
+  if (GCodeReader_getValue(gCode, 'Y', &value) == RESULT_OK)
+    {
+      target->y = BlueMarlin_relativePositioning ? (target->y + value) : value;
+    }
+  if (GCodeReader_getValue(gCode, 'Z', &value) == RESULT_OK)
+    {
+      target->z = BlueMarlin_relativePositioning ? (target->z + value) : value;
+    }
+  if (GCodeReader_getValue(gCode, 'E', &value) == RESULT_OK)
+    {
+      target->e = (BlueMarlin_relativePositioning || BlueMarlin_relativeExtrusion) ? (target->e + value) : value;
+    }
+  if (GCodeReader_getValue(gCode, 'F', &value) == RESULT_OK)
+    {
+      /* G-code feedrate is given in mm/min */
+      BlueMarlin_feedrate = value / 60.0;
+    }
+}
+
+/**
+ * \brief Converts g-code coordinates to motion planner coordinates
+ *
+ * @param[in] position Position in g-code coordinates [mm]
+ * @return Position in coordinates of the motion planner [mm]
+ */
+static WorldCoordinates_t BlueMarlin_machinePosition(const WorldCoordinates_t &position)
+{
+  WorldCoordinates_t machinePosition;
+
+  machinePosition.x = position.x + BlueMarlin_offset.x;
+  machinePosition.y = position.y + BlueMarlin_offset.y;
+  machinePosition.z = position.z + BlueMarlin_offset.z;
+  machinePosition.e = position.e + BlueMarlin_offset.e;
+  return machinePosition;
+}
+
+/**
+ * \brief Sets the current position without moving (G92)
+ *
+ * Only the offset between g-code and motion planner coordinates is
+ * changed. Without any field all coordinates are set to zero.
+ * @param[in] gCode Compressed g-code
+ */
+static void BlueMarlin_setPosition(const uint8_t *gCode)
+{
+  WorldCoordinates_t machinePosition = BlueMarlin_machinePosition(BlueMarlin_position);
+  bool relativePositioning = BlueMarlin_relativePositioning;
+  bool relativeExtrusion = BlueMarlin_relativeExtrusion;
+  float value;
+
+  if ((GCodeReader_getValue(gCode, 'X', &value) != RESULT_OK) && (GCodeReader_getValue(gCode, 'Y', &value) != RESULT_OK) &&
+      (GCodeReader_getValue(gCode, 'Z', &value) != RESULT_OK) && (GCodeReader_getValue(gCode, 'E', &value) != RESULT_OK))
+    {
+      BlueMarlin_position.x = 0.0;
+      BlueMarlin_position.y = 0.0;
+      BlueMarlin_position.z = 0.0;
+      BlueMarlin_position.e = 0.0;
+    }
+  else
+    {
+      /* Given values are always absolute */
+      BlueMarlin_relativePositioning = false;
+      BlueMarlin_relativeExtrusion = false;
+      BlueMarlin_readTarget(gCode, &BlueMarlin_position);
+      BlueMarlin_relativePositioning = relativePositioning;
+      BlueMarlin_relativeExtrusion = relativeExtrusion;
+    }
+  BlueMarlin_offset.x = machinePosition.x - BlueMarlin_position.x;
+  BlueMarlin_offset.y = machinePosition.y - BlueMarlin_position.y;
+  BlueMarlin_offset.z = machinePosition.z - BlueMarlin_position.z;
+  BlueMarlin_offset.e = machinePosition.e - BlueMarlin_position.e;
+}
+
+/**
+ * \brief Waits for all movements to finish and then for the given time (G4)
+ *
+ * The time is given in P [ms] or S [s]. Never blocks.
+ * @param[in] gCode Compressed g-code
+ * @return RESULT_OK if the dwell is finished, RESULT_NOT_OK if not
+ */
+static uint8_t BlueMarlin_dwell(const uint8_t *gCode)
+{
+  float value = 0.0;
+
+  if (!BlueMarlin_dwellActive)
+    {
+      if (!BlueMarlin_synchronize())
+        {
+          return RESULT_NOT_OK;
+        }
+      if (GCodeReader_getValue(gCode, 'P', &value) == RESULT_OK)
+        {
+          value *= 1000.0;
+        }
+      else if (GCodeReader_getValue(gCode, 'S', &value) == RESULT_OK)
+        {
+          value *= 1000000.0;
+        }
+      BlueMarlin_dwellEnd = micros() + (uint32_t)value;
+      BlueMarlin_dwellActive = true;
+    }
+  if ((int32_t)(micros() - BlueMarlin_dwellEnd) < 0)
+    {
+      return RESULT_NOT_OK;
+    }
+  BlueMarlin_dwellActive = false;
+  return RESULT_OK;
+}
+
+/**
+ * \brief Takes over published parameter
+ *
+ * Kinematic constants are recalculated if parameter changed. The motion
+ * planner notices the new version of #derivedParameter itself.
+ * @pre The motion planner is ready and no move is pending
+ */
+static void BlueMarlin_updateParameter(void)
+{
+  if (Parameter_update() == RESULT_OK)
+    {
+      kinematic.init();
+    }
+}
+
+/**
+ * \brief Sets steps per unit (M92)
+ *
+ * X, Y and Z set the axis, E the extruder given by T (default 0). Values
+ * below one step per unit are ignored. Moves planned so far are finished
+ * with the previous values. The whole line is reported and dropped if T
+ * is not the number of an existing extruder.
+ * @param[in] gCode Compressed g-code
+ * @return RESULT_OK if the parameter were published or the line was
+ * dropped, RESULT_NOT_OK if the motion planner is still busy
+ */
+static uint8_t BlueMarlin_setStepsPerUnit(const uint8_t *gCode)
+{
+  const uint8_t axisField[3] = {'X', 'Y', 'Z'};
+  Parameter_t update;
+  float value;
+  float extruder = 0.0;
+
+  /* Negative or fractional T would index outside of the extruders */
+  GCodeReader_getValue(gCode, 'T', &extruder);
+  if (!((extruder >= 0.0) && (extruder < MACHINE_NUM_EXTRUDER) && (extruder == floorf(extruder))))
+    {
+      Platform_serialWrite((const uint8_t *)"Error:invalid extruder\n", 23);
+      return RESULT_OK;
+    }
+  motionPlanner.flushLineMovement();
+  if (!motionPlanner.isReady() || motionPlanner.hasPendingMove())
+    {
+      return RESULT_NOT_OK;
+    }
+  update = parameter;
+  for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++)
+    {
+      if ((GCodeReader_getValue(gCode, axisField[i], &value) == RESULT_OK) && (value >= 1.0))
+        {
+          update.axisStepsPerUnit.axis[i] = (AxisCoordinate_t)(value + 0.5);
+        }
+    }
+  if ((GCodeReader_getValue(gCode, 'E', &value) == RESULT_OK) && (value >= 1.0))
+    {
+      update.axisStepsPerUnit.extruder[(uint8_t)extruder] = (AxisCoordinate_t)(value + 0.5);
+    }
+  Parameter_publish(&update);
+  BlueMarlin_updateParameter();
+  return RESULT_OK;
+}
+
+/**
+ * \brief Restores the stored parameter (M501)
+ *
+ * Like M92 moves planned so far are finished with the previous values.
+ * Nothing changes if there is no valid record in the storage.
+ * @return RESULT_OK if done, RESULT_NOT_OK if the motion planner is still
+ * busy
+ */
+static uint8_t BlueMarlin_loadParameter(void)
+{
+  Parameter_t update;
+
+  motionPlanner.flushLineMovement();
+  if (!motionPlanner.isReady() || motionPlanner.hasPendingMove())
+    {
+      return RESULT_NOT_OK;
+    }
+  update = parameter;
+  if (Parameter_load(&update) == RESULT_OK)
+    {
+      Parameter_publish(&update);
+      BlueMarlin_updateParameter();
+    }
+  return RESULT_OK;
+}
+
+/**
+ * \brief Registers the metrics reported by M800
+ *
+ * Rates of the counters are derived by #Metrics_report, histograms are
+ * given in cycles of #Platform_timeCycles.
+ */
+static void BlueMarlin_addMetrics(void)
+{
+  Metrics_init();
+  Metrics_addCounter("serial.bytes", &Serial_statistics.bytes);
+  Metrics_addCounter("serial.overruns", &Serial_statistics.overruns);
+  Metrics_addCounter("gcode.lines", &GCodeReader_statistics.lines);
+  Metrics_addCounter("gcode.checksum_errors", &GCodeReader_statistics.checksumErrors);
+  Metrics_addCounter("gcode.overflows", &GCodeReader_statistics.overflows);
+  Metrics_addCounter("planner.blocks", &motionPlanner.getBlocks());
+  Metrics_addCounter("planner.slowdowns", &motionPlanner.getSlowdowns());
+  Metrics_addHistogram("planner.block_cycles", &motionPlanner.getBlockCycles());
+  Metrics_addGauge("motion_buffer.depth", BlueMarlin_motionBufferDepth);
+#if (STEPPER_GENERATOR == STEPPER_GENERATOR_STEPCOMPRESS)
+  Metrics_addHistogram("step.isr_cycles", &StepCompress_isrCycles);
+#else
+  Metrics_addHistogram("step.isr_cycles", &Stepper_isrCycles);
+#endif
+  Metrics_addGauge("scheduler.overruns", BlueMarlin_schedulerOverruns);
+  Metrics_addGauge("scheduler.deadline_misses", BlueMarlin_schedulerDeadlineMisses);
+}
+
+/**
+ * \brief Gauge of the blocks waiting in #motionBuffer
+ *
+ * @return Number of blocks
+ */
+static uint32_t BlueMarlin_motionBufferDepth(void)
+{
+  return motionBuffer.available();
+}
+
+/**
+ * \brief Gauge of the scheduler overruns
+ *
+ * @return Runs of all tasks longer than their budget
+ */
+static uint32_t BlueMarlin_schedulerOverruns(void)
+{
+  uint32_t overruns = 0;
+
+  for (uint8_t i=0; i<Scheduler_numTasks; i++)
+    {
+      overruns += Scheduler_tasks[i].statistics.overruns;
+    }
+  return overruns;
+}
+
+/**
+ * \brief Gauge of the scheduler deadline misses
+ *
+ * @return Runs of all fixed-rate tasks started one period or more late
+ */
+static uint32_t BlueMarlin_schedulerDeadlineMisses(void)
+{
+  uint32_t deadlineMisses = 0;
+
+  for (uint8_t i=0; i<Scheduler_numTasks; i++)
+    {
+      deadlineMisses += Scheduler_tasks[i].statistics.deadlineMisses;
+    }
+  return deadlineMisses;
+}
+
+/**
+ * \brief Reports moves the motion planner rejected for good
+ *
+ * Retrying such a move won't help. The line is dropped and the position
+ * is kept.
+ * @param[in] result Return value of a movement function of #motionPlanner
+ * @return True if the move was rejected, false if it was accepted or must
+ * be retried
+ */
+static bool BlueMarlin_isRejected(uint8_t result)
+{
+  switch (result)
+    {
+    case MOTIONPLANNER_RESULT_INVALID_ARC:
+      Platform_serialWrite((const uint8_t *)"Error:invalid arc radius\n", 25);
+      return true;
+    case MOTIONPLANNER_RESULT_UNREACHABLE:
+      Platform_serialWrite((const uint8_t *)"Error:unreachable target\n", 25);
+      return true;
+    default:
+      return false;
+    }
+}
+
+/**
+ * \brief Executes one g-code
+ *
+ * Supported are G0, G1, G2, G3, G4, G90, G91, G92, M82, M83, M92, M400,
+ * M500 (store parameter), M501 (restore parameter) and M800 (report
+ * metrics).
+ * All other g-codes are ignored. Moves to targets the machine can't reach
+ * and arcs whose radius is too short to connect current and target
+ * position are reported and dropped.
+ * @param[in] gCode Compressed g-code
+ * @return RESULT_OK if the g-code was executed, RESULT_NOT_OK if it must
+ * be executed again later, e.g. because the motion planner is busy
+ */
+static uint8_t BlueMarlin_executeGCode(const uint8_t *gCode)
+{
+  WorldCoordinates_t target;
+  float code;
+  float value;
+  float offsetJ = 0.0;
+  uint8_t result;
+
+  if (GCodeReader_getValue(gCode, 'G', &code) == RESULT_OK)
+    {
+      switch ((uint16_t)code)
+        {
+        case 0:
+        case 1:
+          BlueMarlin_readTarget(gCode, &target);
+          result = motionPlanner.queueLineMovement(BlueMarlin_machinePosition(target), BlueMarlin_feedrate);
+          if (BlueMarlin_isRejected(result))
+            {
+              break;
+            }
+          if (result != RESULT_OK)
+            {
+              return RESULT_NOT_OK;
+            }
+          BlueMarlin_position = target;
+          break;
+        case 2:
+        case 3:
+          BlueMarlin_readTarget(gCode, &target);
+          if (GCodeReader_getValue(gCode, 'R', &value) == RESULT_OK)
+            {
+              result = motionPlanner.addArcMovementRadius(BlueMarlin_machinePosition(target), value, (code < 2.5), BlueMarlin_feedrate);
+            }
+          else
+            {
+              value = 0.0;
+              GCodeReader_getValue(gCode, 'I', &value);
+              GCodeReader_getValue(gCode, 'J', &offsetJ);
+              result = motionPlanner.addArcMovement(BlueMarlin_machinePosition(target), value, offsetJ, (code < 2.5), BlueMarlin_feedrate);
+            }
+          if (BlueMarlin_isRejected(result))
+            {
+              break;
+            }
+          if (result != RESULT_OK)
+            {
+              return RESULT_NOT_OK;
+            }
+          BlueMarlin_position = target;
+          break;
+        case 4:
+          return BlueMarlin_dwell(gCode);
+        case 90:
+          BlueMarlin_relativePositioning = false;
+          break;
+        case 91:
+          BlueMarlin_relativePositioning = true;
+          break;
+        case 92:
+          BlueMarlin_setPosition(gCode);
+          break;
+        default:
+          break;
+        }
+    }
+  else if (GCodeReader_getValue(gCode, 'M', &code) == RESULT_OK)
+    {
+      switch ((uint16_t)code)
+        {
+        case 82:
+          BlueMarlin_relativeExtrusion = false;
+          break;
+        case 83:
+          BlueMarlin_relativeExtrusion = true;
+          break;
+        case 92:
+          return BlueMarlin_setStepsPerUnit(gCode);
+        case 400:
+          if (!BlueMarlin_synchronize())
+            {
+              return RESULT_NOT_OK;
+            }
+          break;
+        case 500:
+          Parameter_store(&parameter);
+          break;
+        case 501:
+          return BlueMarlin_loadParameter();
+        case 800:
+          Metrics_report();
+          break;
+        default:
+          break;
+        }
+    }
+  return RESULT_OK;
+}
+
+/**
+ * \brief Checks if a g-code is a line movement (G0 or G1)
+ *
+ * @param[in] gCode Compressed g-code
+ * @return True for G0 and G1
+ */
+static bool BlueMarlin_isLineMovement(const uint8_t *gCode)
+{
+  float code;
+
+  return (GCodeReader_getValue(gCode, 'G', &code) == RESULT_OK) && ((uint16_t)code <= 1);
+}
+
+/**
+ * \brief Executes the g-codes waiting in #gCodeRingBuffer
+ *
+ * Not more than #GCODEREADER_NUMBEROFGCODESTOREAD g-codes are executed
+ * during one call. The move held back for coalescing is handed to the
+ * motion buffer before any other command than G0 and G1. If no g-code is
+ * waiting, e.g. between two lines received over serial, it is only handed
+ * over if the motion buffer would run dry otherwise, see
+ * #MOTIONPLANNER_COALESCE_FLUSH_QUEUED_TIME. Changes of feedrate or
+ * direction are handled by #MotionPlanner::queueLineMovement.
+ */
+static void BlueMarlin_processGCodes(void)
+{
+  for (uint8_t i=0; i<GCODEREADER_NUMBEROFGCODESTOREAD; i++)
+    {
+      if (!BlueMarlin_gCodeActive)
+        {
+          if (gCodeRingBuffer.read(&BlueMarlin_gCode) != RESULT_OK)
+            {
+              if (MotionBuffer_queuedTime() < MOTIONPLANNER_COALESCE_FLUSH_QUEUED_TIME)
+                {
+                  motionPlanner.flushLineMovement();
+                }
+              return;
+            }
+          BlueMarlin_gCodeActive = true;
+        }
+      /* Other commands must not overtake the held back move */
+      if (!BlueMarlin_isLineMovement(BlueMarlin_gCode.data) && (motionPlanner.flushLineMovement() != RESULT_OK))
+        {
+          return;
+        }
+      if (BlueMarlin_executeGCode(BlueMarlin_gCode.data) != RESULT_OK)
+        {
+          return;
+        }
+      BlueMarlin_gCodeActive = false;
+    }
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
@@ -42,6 +42,7 @@
 
 /* ******************| Inclusions |************************************ */
 #include <platform.h>
+#include <ringBuffer.h>
 
 /* ******************| Macros |**************************************** */
 /**
@@ -66,15 +67,48 @@
 #define GCODEREADER_NUMBEROFGCODESTOREAD  (uint8_t)4
 #endif
 
+/**
+ * Number of compressed g-code lines buffered in #gCodeRingBuffer until
+ * they are executed. Must be a power of two.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DGCODEREADER_GCODERINGBUFFER_SIZE 8
+ */
+#ifndef GCODEREADER_GCODERINGBUFFER_SIZE
+#define GCODEREADER_GCODERINGBUFFER_SIZE  (uint8_t)8
+#endif
+
 /* ******************| Type definitions |****************************** */
+/**
+ * One compressed g-code line as stored in #gCodeRingBuffer. The line is
+ * null terminated.
+ */
+typedef struct
+{
+  uint8_t data[GCODEREADER_GCODEBUFFER_SIZE];   /*!< Compressed g-code, e.g. G1X10.5F3000 */
+} GCodeReader_GCode_t;
+
+/**
+ * Statistics of the g-code lines read. Stored atomically, as reports read
+ * them from another context.
+ */
+typedef struct
+{
+  uint32_t lines;             /*!< Number of g-codes written to #gCodeRingBuffer */
+  uint32_t checksumErrors;    /*!< Number of lines dropped because their checksum did not match */
+  uint32_t overflows;         /*!< Number of lines dropped because they did not fit into #GCODEREADER_GCODEBUFFER_SIZE or #Serial_rxRingBuffer */
+} GCodeReader_Statistics_t;
 
 /* ******************| External function declarations |**************** */
 extern void GCodeReader_readGCodeSerial();
-extern void GCodeReader_addGCode(uint8_t *data);
+extern uint8_t GCodeReader_addGCode(uint8_t *data);
+extern uint8_t GCodeReader_getValue(const uint8_t *gCode, uint8_t code, float *value);
 
 /* ******************| External constants |**************************** */
 
 /* ******************| External variables |**************************** */
+extern RingBuffer<GCodeReader_GCode_t, GCODEREADER_GCODERINGBUFFER_SIZE> gCodeRingBuffer;
+extern GCodeReader_Statistics_t GCodeReader_statistics;
 
 /** @} doxygen end group definition */
 #endif /* if !defined( GCODEREADER_INCLUDE_GCODEPARSER_H_ ) */
@@ -41,44 +41,115 @@
 
 /* ******************| Inclusions |************************************ */
 #include "gCodeReader.h"
-#include <ringBuffer.h>
+#include <serial.h>
+#include <trace.h>
 #include <ctype.h>
+#include <string.h>
 
 /* ******************| Macros |**************************************** */
 
 /* ******************| Type Definitions |****************************** */
+/**
+ * State of the compression of one g-code line
+ */
+typedef struct
+{
+  uint8_t *data;                  /*!< Where the compressed g-code is written to */
+  uint8_t length;                 /*!< Number of characters written to #data */
+  uint8_t crc;                    /*!< Checksum of the characters before the checksum field */
+  uint16_t checksum;              /*!< Value of the checksum field */
+  bool checksumField;             /*!< True after the start of the checksum field */
+  bool ignoreUntilNextValidChar;  /*!< True while a special field or blank is skipped */
+  bool finished;                  /*!< True after the start of a comment */
+  bool overflow;                  /*!< True if the compressed g-code did not fit into the buffer */
+} GCodeReader_Compression_t;
 
 /* ******************| Function Prototypes |*************************** */
 void GCodeReader_readGCodeSerial();
-void GCodeReader_addGCode(uint8_t *data);
+uint8_t GCodeReader_addGCode(uint8_t *data);
+uint8_t GCodeReader_getValue(const uint8_t *gCode, uint8_t code, float *value);
+static void GCodeReader_startCompression(GCodeReader_Compression_t *compression, uint8_t *data);
+static void GCodeReader_compress(GCodeReader_Compression_t *compression, uint8_t character);
+static uint8_t GCodeReader_checkCompression(const GCodeReader_Compression_t *compression);
 
 
 /* ******************| Global Variables |****************************** */
+/**
+ * Compressed g-code lines waiting for execution
+ */
+RingBuffer<GCodeReader_GCode_t, GCODEREADER_GCODERINGBUFFER_SIZE> gCodeRingBuffer;
+
+/**
+ * Statistics of the g-code lines read
+ */
+GCodeReader_Statistics_t GCodeReader_statistics;
 
 /* ******************| Function Implementation |*********************** */
 
 /**
- * \brief Reads one g-code from serial line
+ * \brief Reads g-codes from serial line
  *
  * Reads g-codes from different sources, currently serial and sd-card. 
- * One line at a time is read. The buffer for reading g-codes is provided
- * by this module.
+ * Only complete lines in #Serial_rxRingBuffer are read. Each line is
+ * compressed while it is read from the ring buffer, thus, without
+ * assembling it in another buffer first.
  * After g-codes are read they are parsed and written to cyclic buffer.
  * How many g-code lines are read during one call is controlled by 
  * #GCODEREADER_NUMBEROFGCODESTOREAD
+ * No line is read while #gCodeRingBuffer is full. Thus, the serial line
+ * is throttled by the execution of the g-codes. Each line read is
+ * acknowledged with "ok". Lines with wrong checksum, too long to be
+ * compressed into #GCODEREADER_GCODEBUFFER_SIZE characters or truncated
+ * by the receive buffer, see #SERIAL_LINE_TRUNCATED, are dropped and
+ * reported with an error before.
 */
 void GCodeReader_readGCodeSerial()
 {
-  uint8_t gCodeBuffer[GCODEREADER_GCODEBUFFER_SIZE];
-  uint8_t numberOfBytesRead = 0;
+  GCodeReader_GCode_t gCode;
+  GCodeReader_Compression_t compression;
+  uint8_t character;
   
   for (int i=0; i<GCODEREADER_NUMBEROFGCODESTOREAD; i++)
   {
-    //numberOfBytesRead = Serial.Read(*gCodeBuffer, GCODEREADER_GCODEBUFFER_SIZE)
-    if (numberOfBytesRead > 0)
+    if ((gCodeRingBuffer.available() >= GCODEREADER_GCODERINGBUFFER_SIZE) || (Serial_lines() == 0))
+    {
+      break;
+    }
+    GCodeReader_startCompression(&compression, gCode.data);
+    while ((Serial_read(&character) == RESULT_OK) && (character != SERIAL_LINE_END))
     {
-      GCodeReader_addGCode(gCodeBuffer);
+      /* Bytes of the line were lost in the receive buffer, the line is
+       * handled like one too long to be compressed */
+      if (character == SERIAL_LINE_TRUNCATED)
+      {
+        compression.overflow = true;
+      }
+      else
+      {
+        GCodeReader_compress(&compression, character);
+      }
     }
+    gCode.data[compression.length] = '\0';
+    if (GCodeReader_checkCompression(&compression) != RESULT_OK)
+    {
+      if (compression.overflow)
+      {
+        Platform_serialWrite((const uint8_t *)"Error:line too long\n", 20);
+      }
+      else
+      {
+        Platform_serialWrite((const uint8_t *)"Error:checksum mismatch\n", 24);
+      }
+    }
+    /* Lines which are empty after compression, e.g. comments, are dropped */
+    else if (compression.length > 0)
+    {
+      gCodeRingBuffer.write(gCode);
+      __atomic_store_n(&GCodeReader_statistics.lines, GCodeReader_statistics.lines + 1, __ATOMIC_RELAXED);
+      TRACE(1, TRACE_EVENT_GCODE, NULL, gCodeRingBuffer.available());
+    }
+    /* Acknowledge the line so the host sends the next one */
+    Platform_serialWrite((const uint8_t *)"ok\n", 3);
   }
 }
 
@@ -86,83 +157,226 @@ void GCodeReader_readGCodeSerial()
  * \brief Analyzes, compresses and inserts g-code data in #data into ringbuffer
  *
  * Converts the g-code data to upper case and compresses it in-place, thus in #data.
- * - Removes the following special fields (see http://reprap.org/wiki/Gcode#Special_fields)
- * -- N: Line number
- * -- Checks and removes "*: Checksum"
- * -- Comments starting with ;
- * - Removes any blank character, that is, blank or tab
+ * See #GCodeReader_compress for the rules.
+ * The compressed g-code is then added to #gCodeRingBuffer. Lines which are
+ * empty after compression, e.g. comments, whose checksum does not match or
+ * which are too long are dropped.
  * @param[in/out] data Pointer to buffer holding g-code data. A null terminated string
  * is expected.
- * @note U,V,W parameter is not supported. Q parameter is not supported.
+ * @return RESULT_OK if the g-code was added or dropped, RESULT_NOT_OK if
+ * #gCodeRingBuffer is full
  */
-void GCodeReader_addGCode(uint8_t *data)
+uint8_t GCodeReader_addGCode(uint8_t *data)
 {
-  bool ignoreUntilNextValidChar = false;
-  uint8_t *nextChar = data; /* Place to write next character for in-place compression */
-  uint8_t calculatedCRC = 0x00;
-  uint8_t processCounter = 0x00;
+  GCodeReader_GCode_t gCode;
+  GCodeReader_Compression_t compression;
   
-  /* Parse the complete string first to calculate CRC and do in-place compression. Stop
-   * when comment is detected. Make sure to not parse more than buffer length. */
-  while ((*data != '\0') && (processCounter < GCODEREADER_GCODEBUFFER_SIZE))
-  {
-    /* Calculate CRC according to formula found at http://reprap.org/wiki/Gcode#Checking */
-    calculatedCRC ^= *data;
-    /* Convert the character to upper case */
-    *data = toupper(*data);
-    switch (*data)
+  /* The compressed string is never longer than the processed part of the
+   * input. Thus, it can be written to the same buffer. */
+  GCodeReader_startCompression(&compression, data);
+  for (uint8_t *character = data; *character != '\0'; character++)
+  {
+    GCodeReader_compress(&compression, *character);
+  }
+  /* Terminate the compressed string */
+  data[compression.length] = '\0';
+  
+  if ((GCodeReader_checkCompression(&compression) != RESULT_OK) || (compression.length == 0))
+  {
+    return RESULT_OK;
+  }
+  memcpy(gCode.data, data, compression.length + 1);
+  if (gCodeRingBuffer.write(gCode) != RESULT_OK)
+  {
+    return RESULT_NOT_OK;
+  }
+  __atomic_store_n(&GCodeReader_statistics.lines, GCodeReader_statistics.lines + 1, __ATOMIC_RELAXED);
+  TRACE(1, TRACE_EVENT_GCODE, NULL, gCodeRingBuffer.available());
+  return RESULT_OK;
+}
+
+/**
+ * \brief Prepares the compression of one g-code line
+ *
+ * @param[in] compression State of the compression
+ * @param[in] data Buffer for the compressed g-code. Must hold at least
+ * #GCODEREADER_GCODEBUFFER_SIZE characters.
+ */
+static void GCodeReader_startCompression(GCodeReader_Compression_t *compression, uint8_t *data)
+{
+  compression->data = data;
+  compression->length = 0;
+  compression->crc = 0x00;
+  compression->checksum = 0;
+  compression->checksumField = false;
+  compression->ignoreUntilNextValidChar = false;
+  compression->finished = false;
+  compression->overflow = false;
+}
+
+/**
+ * \brief Compresses one character of a g-code line
+ *
+ * Converts the character to upper case and appends it to the compressed
+ * g-code unless it belongs to one of the following
+ * - Special fields (see http://reprap.org/wiki/Gcode#Special_fields)
+ * -- N: Line number
+ * -- *: Checksum
+ * -- Comments starting with ;
+ * - Blank characters, that is, blank or tab
+ * If the compressed g-code does not fit into #GCODEREADER_GCODEBUFFER_SIZE
+ * characters including the termination, the overflow is flagged and the
+ * line must not be executed, see #GCodeReader_checkCompression. The rest
+ * of the line is still processed, thus, the checksum is checked over the
+ * whole line. The compressed g-code is not terminated.
+ * @param[in] compression State of the compression
+ * @param[in] character Next character of the line
+ * @note U,V,W parameter is not supported. Q parameter is not supported.
+ */
+static void GCodeReader_compress(GCodeReader_Compression_t *compression, uint8_t character)
+{
+  if ((character == ';') || compression->finished)
+  {
+    compression->finished = true;
+    return;
+  }
+  /* Calculate CRC according to formula found at http://reprap.org/wiki/Gcode#Checking
+   * over all characters before the checksum field and read the field itself */
+  if (character == '*')
+  {
+    compression->checksumField = true;
+  }
+  else if (!compression->checksumField)
+  {
+    compression->crc ^= character;
+  }
+  else if (isdigit(character) && (compression->checksum <= 0xFF))
+  {
+    compression->checksum = compression->checksum * 10 + (character - '0');
+  }
+  /* Convert the character to upper case */
+  character = toupper(character);
+  switch (character)
+  {
+  case 'N':
+  case '*':
+  case ' ':
+  case '\t':
+    compression->ignoreUntilNextValidChar = true;
+    break;
+  case 'G':
+  case 'M':
+  case 'T':
+  case 'S':
+  case 'P':
+  case 'X':
+  case 'Y':
+  case 'Z':
+  case 'I':
+  case 'J':
+  case 'D':
+  case 'H':
+  case 'F':
+  case 'R':
+  case 'E':
+    compression->ignoreUntilNextValidChar = false;
+    break;
+  default:
+    /* do nothing */
+    break;
+  }
+  /* Only add character to buffer if valid. One character is kept for the
+   * termination. */
+  if (compression->ignoreUntilNextValidChar == false)
+  {
+    if (compression->length < GCODEREADER_GCODEBUFFER_SIZE - 1)
     {
-    case ';':
-    case 'N':
-    case '*':
-    case ' ':
-    case '\t':
-      ignoreUntilNextValidChar = true;
-      break;
-    case 'G':
-    case 'M':
-    case 'T':
-    case 'S':
-    case 'P':
-    case 'X':
-    case 'Y':
-    case 'Z':
-    case 'I':
-    case 'J':
-    case 'D':
-    case 'H':
-    case 'F':
-    case 'R':
-    case 'E':
-      ignoreUntilNextValidChar = false;
-      break;
-    default:
-      /* do nothing */
-      break;
+      compression->data[compression->length++] = character;
     }
-    /* Only add character to buffer if valid */
-    if (ignoreUntilNextValidChar == false)
+    else
     {
-      /* Write data in same buffer but at different location if compressed */
-      *nextChar = *data;
-      nextChar++;
+      compression->overflow = true;
+    }
+  }
+}
+
+/**
+ * \brief Checks the checksum and the length of a compressed line
+ *
+ * Lines without checksum field are valid if they fit into the buffer.
+ * Mismatches and overflows are counted in #GCodeReader_statistics.
+ * @param[in] compression State after the last character of the line
+ * @return RESULT_OK if the line is valid, RESULT_NOT_OK if the checksum
+ * does not match or the line is too long
+ */
+static uint8_t GCodeReader_checkCompression(const GCodeReader_Compression_t *compression)
+{
+  /* A truncated line could move to a wrong position */
+  if (compression->overflow)
+  {
+    __atomic_store_n(&GCodeReader_statistics.overflows, GCodeReader_statistics.overflows + 1, __ATOMIC_RELAXED);
+    return RESULT_NOT_OK;
+  }
+  if (compression->checksumField && (compression->checksum != compression->crc))
+  {
+    __atomic_store_n(&GCodeReader_statistics.checksumErrors, GCodeReader_statistics.checksumErrors + 1, __ATOMIC_RELAXED);
+    return RESULT_NOT_OK;
+  }
+  return RESULT_OK;
+}
+
+/**
+ * \brief Reads the value of one field from a compressed g-code
+ *
+ * The compressed g-code consists of fields only, each a letter immediately
+ * followed by its value, e.g. G1X10.5F3000. Numbers are parsed without
+ * exponent because E is a field letter as well.
+ * @param[in] gCode Compressed, null terminated g-code as written by
+ * #GCodeReader_addGCode
+ * @param[in] code Upper case letter of the field, e.g. 'X'
+ * @param[out] value Value of the field. Not changed if the field does not
+ * exist.
+ * @return RESULT_OK if the field exists, RESULT_NOT_OK if not
+ */
+uint8_t GCodeReader_getValue(const uint8_t *gCode, uint8_t code, float *value)
+{
+  float result = 0.0;
+  float fraction = 0.0;
+  bool negative = false;
+
+  while ((*gCode != '\0') && (*gCode != code))
+  {
+    gCode++;
+  }
+  if (*gCode == '\0')
+  {
+    return RESULT_NOT_OK;
+  }
+  gCode++;
+  if ((*gCode == '-') || (*gCode == '+'))
+  {
+    negative = (*gCode == '-');
+    gCode++;
+  }
+  while ((isdigit(*gCode)) || ((*gCode == '.') && (fraction == 0.0)))
+  {
+    if (*gCode == '.')
+    {
+      fraction = 1.0;
+    }
+    else if (fraction == 0.0)
+    {
+      result = result * 10.0 + (*gCode - '0');
     }
     else
     {
-      /* do nothing */
+      fraction /= 10.0;
+      result += fraction * (*gCode - '0');
     }
-    /* Move to next character */
-    data++;
-    processCounter++;
-  } /* while((data++) && (processCounter < GCODEREADER_NUMBEROFGCODESTOREAD)) */
-
-  /* Terminate the compressed string */
-  *nextChar = '\0';
-  
-  /** @todo Add CRC check here */
-  
-  /* Now write the compressed string to ringbuffer */
-  
+    gCode++;
+  }
+  *value = negative ? -result : result;
+  return RESULT_OK;
 }
 
 /** @} doxygen end group definition */
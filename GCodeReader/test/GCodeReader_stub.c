@@ -0,0 +1,143 @@
+/**
+ * \file GCodeReader_stub.c
+ *
+ * \brief Stubs for GCodeReader unit tests
+ *
+ * All stubs needed for the unit test of this particular modules shall
+ * be done within this file.
+ * The receive ring buffer of the Serial module is replaced by a list of
+ * lines set by the test case.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup GCodeReader
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include "gCodeReader_test.h"
+#include <string.h>
+#include <serial.h>
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+void GCodeReaderTest_setLines(const char **lines, uint8_t count);
+uint8_t Serial_lines(void);
+uint8_t Serial_read(uint8_t *character);
+void Platform_serialWrite(const uint8_t *data, uint8_t length);
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Lines returned by #Serial_read
+ */
+static const char **GCodeReaderTest_lines;
+
+/**
+ * Number of lines in #GCodeReaderTest_lines
+ */
+static uint8_t GCodeReaderTest_lineCount;
+
+/**
+ * Number of lines completely returned by #Serial_read
+ */
+uint8_t GCodeReaderTest_linesRead;
+
+/**
+ * Position of the next character in the current line
+ */
+static uint8_t GCodeReaderTest_position;
+
+/**
+ * Number of "ok" written by #Platform_serialWrite
+ */
+uint8_t GCodeReaderTest_acknowledges;
+
+/**
+ * Number of errors written by #Platform_serialWrite
+ */
+uint8_t GCodeReaderTest_errors;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Sets the lines to be received from serial line
+ *
+ * @param[in] lines Lines without line ending
+ * @param[in] count Number of lines
+ */
+void GCodeReaderTest_setLines(const char **lines, uint8_t count)
+{
+  GCodeReaderTest_lines = lines;
+  GCodeReaderTest_lineCount = count;
+  GCodeReaderTest_linesRead = 0;
+  GCodeReaderTest_position = 0;
+  GCodeReaderTest_acknowledges = 0;
+  GCodeReaderTest_errors = 0;
+}
+
+/**
+ * \brief Returns the number of lines not yet read
+ *
+ * @return Number of complete lines
+ */
+uint8_t Serial_lines(void)
+{
+  return GCodeReaderTest_lineCount - GCodeReaderTest_linesRead;
+}
+
+/**
+ * \brief Returns the next character of the lines set by #GCodeReaderTest_setLines
+ *
+ * Each line is followed by #SERIAL_LINE_END.
+ * @param[out] character Next character
+ * @return RESULT_OK if a character was read, RESULT_NOT_OK if all lines
+ * were read
+ */
+uint8_t Serial_read(uint8_t *character)
+{
+  const char *line;
+
+  if (GCodeReaderTest_linesRead >= GCodeReaderTest_lineCount)
+    {
+      return RESULT_NOT_OK;
+    }
+  line = GCodeReaderTest_lines[GCodeReaderTest_linesRead];
+  if (line[GCodeReaderTest_position] == '\0')
+    {
+      *character = SERIAL_LINE_END;
+      GCodeReaderTest_linesRead++;
+      GCodeReaderTest_position = 0;
+    }
+  else
+    {
+      *character = (uint8_t)line[GCodeReaderTest_position++];
+    }
+  return RESULT_OK;
+}
+
+/**
+ * \brief Counts acknowledges and errors written to serial line
+ *
+ * @param[in] data Data to be written
+ * @param[in] length Number of bytes in #data
+ */
+void Platform_serialWrite(const uint8_t *data, uint8_t length)
+{
+  if ((length == 3) && (strncmp((const char *)data, "ok\n", 3) == 0))
+    {
+      GCodeReaderTest_acknowledges++;
+    }
+  if ((length > 6) && (strncmp((const char *)data, "Error:", 6) == 0))
+    {
+      GCodeReaderTest_errors++;
+    }
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
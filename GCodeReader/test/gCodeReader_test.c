@@ -110,28 +110,208 @@ static void GCodeReader_GCodeReader_parse_2(void)
 /**
  * Simple parse test to see if g-code bigger than buffer
  * work
- * Test if g-code commands bigger than buffer are truncated
- * to GCODEREADER_GCODEBUFFER_SIZE
+ * Test if lines longer than the buffer are accepted as long as the
+ * compressed g-code fits
+ * Test if g-code commands bigger than buffer are dropped and counted
+ * instead of being truncated to GCODEREADER_GCODEBUFFER_SIZE
  *
  */
 static void GCodeReader_GCodeReader_parse_3(void)
 {
   char testBuffer[100];
-
-  strcpy(testBuffer, "G100 M119 T888 S9999.00 X0 Y0,0 Z200 I876.23 J12345.23");
-  GCodeReader_addGCode((uint8_t *)testBuffer);
-  TEST_ASSERT_EQUAL_STRING("G100M119T888S9999.00X0Y0,0Z200I876.23J1234", (char*)testBuffer);
+  GCodeReader_GCode_t gCode;
+
+  strcpy(testBuffer, "G100 M119 T888 S9999.00 X0 Y0,0 Z200 I876.23 J12345.23 E12.5 F3000");
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, GCodeReader_addGCode((uint8_t *)testBuffer));
+  TEST_ASSERT_EQUAL_INT(1, gCodeRingBuffer.available());
+  gCodeRingBuffer.read(&gCode);
+  TEST_ASSERT_EQUAL_STRING("G100M119T888S9999.00X0Y0,0Z200I876.23J12345.23E12.5F3000", (char*)gCode.data);
+
+  strcpy(testBuffer, "G100 M119 T888 S9999.00 X0 Y0,0 Z200 I876.23 J12345.23 E12.5 F3000.000");
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, GCodeReader_addGCode((uint8_t *)testBuffer));
+  TEST_ASSERT_EQUAL_INT(0, gCodeRingBuffer.available());
+  TEST_ASSERT_EQUAL_INT(1, GCodeReader_statistics.overflows);
 }
 
 /**
  * Simple parse test to see if CRC check works
+ * Test if lines with matching checksum are added
+ * Test if lines with wrong checksum are dropped and counted
+ * Test if lines without checksum are not checked
  *
  */
 static void GCodeReader_GCodeReader_parse_4(void)
 {
   char testBuffer[100];
+  GCodeReader_GCode_t gCode;
 
   strcpy(testBuffer, "N6 G1 F1500.0*82");
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, GCodeReader_addGCode((uint8_t *)testBuffer));
+  TEST_ASSERT_EQUAL_INT(1, gCodeRingBuffer.available());
+  TEST_ASSERT_EQUAL_INT(0, GCodeReader_statistics.checksumErrors);
+
+  strcpy(testBuffer, "N6 G1 F1500.0*83");
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, GCodeReader_addGCode((uint8_t *)testBuffer));
+  strcpy(testBuffer, "N6 G1 F1500.0*338");
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, GCodeReader_addGCode((uint8_t *)testBuffer));
+  TEST_ASSERT_EQUAL_INT(1, gCodeRingBuffer.available());
+  TEST_ASSERT_EQUAL_INT(2, GCodeReader_statistics.checksumErrors);
+
+  strcpy(testBuffer, "N6 G1 F1500.0");
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, GCodeReader_addGCode((uint8_t *)testBuffer));
+  TEST_ASSERT_EQUAL_INT(2, gCodeRingBuffer.available());
+  TEST_ASSERT_EQUAL_INT(2, GCodeReader_statistics.lines);
+  gCodeRingBuffer.read(&gCode);
+  TEST_ASSERT_EQUAL_STRING("G1F1500.0", (char*)gCode.data);
+}
+
+/**
+ * Read lines from serial line
+ * Test if compressed g-codes are added to the ring buffer in order
+ * Test if lines without g-code, e.g. comments, are dropped
+ * Test if each line is acknowledged
+ *
+ */
+static void GCodeReader_GCodeReader_readGCodeSerial_1(void)
+{
+  const char *lines[] = {"G1 X10 Y-2.5 ; move", "; comment only", "M83"};
+  GCodeReader_GCode_t gCode;
+
+  GCodeReaderTest_setLines(lines, 3);
+  GCodeReader_readGCodeSerial();
+  TEST_ASSERT_EQUAL_INT(3, GCodeReaderTest_linesRead);
+  TEST_ASSERT_EQUAL_INT(3, GCodeReaderTest_acknowledges);
+  TEST_ASSERT_EQUAL_INT(2, gCodeRingBuffer.available());
+  gCodeRingBuffer.read(&gCode);
+  TEST_ASSERT_EQUAL_STRING("G1X10Y-2.5", (char*)gCode.data);
+  gCodeRingBuffer.read(&gCode);
+  TEST_ASSERT_EQUAL_STRING("M83", (char*)gCode.data);
+}
+
+/**
+ * Read lines from serial line while ring buffer runs full
+ * Test if not more than GCODEREADER_NUMBEROFGCODESTOREAD lines are read
+ * during one call
+ * Test if no line is read while the ring buffer is full
+ *
+ */
+static void GCodeReader_GCodeReader_readGCodeSerial_2(void)
+{
+  const char *lines[] = {"G1 X1", "G1 X2", "G1 X3", "G1 X4", "G1 X5", "G1 X6", "G1 X7", "G1 X8", "G1 X9", "G1 X10"};
+  GCodeReader_GCode_t gCode;
+
+  GCodeReaderTest_setLines(lines, 10);
+  GCodeReader_readGCodeSerial();
+  TEST_ASSERT_EQUAL_INT(GCODEREADER_NUMBEROFGCODESTOREAD, GCodeReaderTest_linesRead);
+  GCodeReader_readGCodeSerial();
+  GCodeReader_readGCodeSerial();
+  TEST_ASSERT_EQUAL_INT(GCODEREADER_GCODERINGBUFFER_SIZE, GCodeReaderTest_linesRead);
+  TEST_ASSERT_EQUAL_INT(GCODEREADER_GCODERINGBUFFER_SIZE, gCodeRingBuffer.available());
+
+  gCodeRingBuffer.read(&gCode);
+  TEST_ASSERT_EQUAL_STRING("G1X1", (char*)gCode.data);
+  GCodeReader_readGCodeSerial();
+  TEST_ASSERT_EQUAL_INT(GCODEREADER_GCODERINGBUFFER_SIZE + 1, GCodeReaderTest_linesRead);
+}
+
+/**
+ * Read a line longer than the g-code buffer from serial line
+ * Test if the line is dropped and reported instead of being truncated
+ * Test if the rest of the line is consumed and the next line is read
+ * completely
+ *
+ */
+static void GCodeReader_GCodeReader_readGCodeSerial_3(void)
+{
+  const char *lines[] = {"G1 X1.000000000 Y2.000000000 Z3.000000000 E4.000000000 F5000.00000000", "G1 X2"};
+  GCodeReader_GCode_t gCode;
+
+  GCodeReaderTest_setLines(lines, 2);
+  GCodeReader_readGCodeSerial();
+  TEST_ASSERT_EQUAL_INT(2, GCodeReaderTest_linesRead);
+  TEST_ASSERT_EQUAL_INT(2, GCodeReaderTest_acknowledges);
+  TEST_ASSERT_EQUAL_INT(1, GCodeReaderTest_errors);
+  TEST_ASSERT_EQUAL_INT(1, GCodeReader_statistics.overflows);
+  TEST_ASSERT_EQUAL_INT(1, gCodeRingBuffer.available());
+  gCodeRingBuffer.read(&gCode);
+  TEST_ASSERT_EQUAL_STRING("G1X2", (char*)gCode.data);
+}
+
+/**
+ * Read lines with checksum from serial line
+ * Test if a line with wrong checksum is dropped and reported
+ * Test if all lines are acknowledged anyway
+ *
+ */
+static void GCodeReader_GCodeReader_readGCodeSerial_4(void)
+{
+  const char *lines[] = {"N7 G1 X10*86", "N7 G1 X10*87", "N7 G1 X10*86"};
+
+  GCodeReaderTest_setLines(lines, 3);
+  GCodeReader_readGCodeSerial();
+  TEST_ASSERT_EQUAL_INT(3, GCodeReaderTest_acknowledges);
+  TEST_ASSERT_EQUAL_INT(1, GCodeReaderTest_errors);
+  TEST_ASSERT_EQUAL_INT(2, gCodeRingBuffer.available());
+  TEST_ASSERT_EQUAL_INT(2, GCodeReader_statistics.lines);
+  TEST_ASSERT_EQUAL_INT(1, GCodeReader_statistics.checksumErrors);
+}
+
+/**
+ * Read a line truncated by the receive buffer from serial line
+ * Test if a 200 byte line, which lost its checksum but whose prefix would
+ * be a valid g-code, is dropped and reported as too long
+ * Test if the next line is read
+ *
+ */
+static void GCodeReader_GCodeReader_readGCodeSerial_5(void)
+{
+  char truncated[SERIAL_RX_BUFFER_SIZE];
+  const char *lines[] = {truncated, "G1 X6"};
+  GCodeReader_GCode_t gCode;
+
+  /* 200 byte line "N1 G1 X5 ;AAA...A*123" as stored by Serial */
+  memset(truncated, 'A', sizeof(truncated));
+  memcpy(truncated, "N1 G1 X5 ;", 10);
+  truncated[SERIAL_RX_BUFFER_SIZE - 2] = SERIAL_LINE_TRUNCATED;
+  truncated[SERIAL_RX_BUFFER_SIZE - 1] = '\0';
+
+  GCodeReaderTest_setLines(lines, 2);
+  GCodeReader_readGCodeSerial();
+  TEST_ASSERT_EQUAL_INT(2, GCodeReaderTest_acknowledges);
+  TEST_ASSERT_EQUAL_INT(1, GCodeReaderTest_errors);
+  TEST_ASSERT_EQUAL_INT(1, GCodeReader_statistics.overflows);
+  TEST_ASSERT_EQUAL_INT(1, gCodeRingBuffer.available());
+  gCodeRingBuffer.read(&gCode);
+  TEST_ASSERT_EQUAL_STRING("G1X6", (char*)gCode.data);
+}
+
+/**
+ * Read values of fields from compressed g-code
+ * Test integer, fractional and negative values
+ * Test if E is not mistaken for an exponent
+ * Test if missing fields are reported and the value is not changed
+ *
+ */
+static void GCodeReader_GCodeReader_getValue_1(void)
+{
+  const uint8_t *gCode = (const uint8_t *)"G1X10.5Y-2.25E.5F3000";
+  float value;
+
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, GCodeReader_getValue(gCode, 'G', &value));
+  TEST_ASSERT(value == 1.0);
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, GCodeReader_getValue(gCode, 'X', &value));
+  TEST_ASSERT(value == 10.5);
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, GCodeReader_getValue(gCode, 'Y', &value));
+  TEST_ASSERT(value == -2.25);
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, GCodeReader_getValue(gCode, 'E', &value));
+  TEST_ASSERT(value == 0.5);
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, GCodeReader_getValue(gCode, 'F', &value));
+  TEST_ASSERT(value == 3000.0);
+  TEST_ASSERT_EQUAL_INT(RESULT_NOT_OK, GCodeReader_getValue(gCode, 'Z', &value));
+  TEST_ASSERT(value == 3000.0);
+
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, GCodeReader_getValue((const uint8_t *)"G1E5", 'G', &value));
+  TEST_ASSERT(value == 1.0);
 }
 
 /* Test buffer length */
@@ -142,7 +322,11 @@ static void GCodeReader_GCodeReader_parse_4(void)
  */
 static void setUp(void)
 {
+  GCodeReader_GCode_t gCode;
 
+  while (gCodeRingBuffer.read(&gCode) == RESULT_OK);
+  GCodeReaderTest_setLines(NULL, 0);
+  memset(&GCodeReader_statistics, 0, sizeof(GCodeReader_statistics));
 }
 
 /**
@@ -159,7 +343,13 @@ TestRef GCodeReader_test_RunTests(void)
     new_TestFixture("Test case GCodeReader_parse_1", GCodeReader_GCodeReader_parse_1),
     new_TestFixture("Test case GCodeReader_parse_2", GCodeReader_GCodeReader_parse_2),
     new_TestFixture("Test case GCodeReader_parse_3", GCodeReader_GCodeReader_parse_3),
-    new_TestFixture("Test case GCodeReader_parse_4", GCodeReader_GCodeReader_parse_4)
+    new_TestFixture("Test case GCodeReader_parse_4", GCodeReader_GCodeReader_parse_4),
+    new_TestFixture("Test case GCodeReader_readGCodeSerial_1", GCodeReader_GCodeReader_readGCodeSerial_1),
+    new_TestFixture("Test case GCodeReader_readGCodeSerial_2", GCodeReader_GCodeReader_readGCodeSerial_2),
+    new_TestFixture("Test case GCodeReader_readGCodeSerial_3", GCodeReader_GCodeReader_readGCodeSerial_3),
+    new_TestFixture("Test case GCodeReader_readGCodeSerial_4", GCodeReader_GCodeReader_readGCodeSerial_4),
+    new_TestFixture("Test case GCodeReader_readGCodeSerial_5", GCodeReader_GCodeReader_readGCodeSerial_5),
+    new_TestFixture("Test case GCodeReader_getValue_1", GCodeReader_GCodeReader_getValue_1)
   };
   EMB_UNIT_TESTCALLER(GCodeReader_tests,"GCodeRingBuffer Unit test",setUp,tearDown,fixtures);
   return (TestRef)&GCodeReader_tests;
@@ -18,16 +18,21 @@
 
 /* ******************| Inclusions |************************************ */
 #include <embUnit/embUnit.h>
+#include <platform.h>
 
 /* ******************| Macros |**************************************** */
 
 /* ******************| Type definitions |****************************** */
 
 /* ******************| External function declarations |**************** */
+extern void GCodeReaderTest_setLines(const char **lines, uint8_t count);
 
 /* ******************| External constants |**************************** */
 
 /* ******************| External variables |**************************** */
+extern uint8_t GCodeReaderTest_linesRead;
+extern uint8_t GCodeReaderTest_acknowledges;
+extern uint8_t GCodeReaderTest_errors;
 
 /** @} doxygen end group definition */
 #endif /* if !defined( TEMPLATE_TEST_DRV_H_ ) */
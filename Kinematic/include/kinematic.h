@@ -0,0 +1,637 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#if (!defined KINEMATIC_INCLUDE_KINEMATIC_H_)
+/* Preprocessor exclusion definition */
+#define KINEMATIC_INCLUDE_KINEMATIC_H_
+/**
+ * \brief Kinematic include file
+ *
+ * Inverse machine kinematics, that is the transformation from world
+ * coordinates [mm] into axis coordinates [steps], for all supported
+ * machine types.
+ * The machine type is selected during compile time with #KINEMATIC_TYPE.
+ * Each machine type is a specialization of the #Kinematic class template.
+ * Because all functions needed during planning are defined inline in this
+ * file, no virtual function call or function pointer is involved and the
+ * linear kinematics boil down to a few multiplications.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup Kinematic
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <blueMarlin.h>
+#include <parameter.h>
+
+/* ******************| Macros |**************************************** */
+/**
+ * Supported machine kinematics
+ */
+#define KINEMATIC_TYPE_CARTESIAN        (uint8_t)0
+#define KINEMATIC_TYPE_COREXY           (uint8_t)1
+#define KINEMATIC_TYPE_DELTA            (uint8_t)2
+
+/**
+ * Kinematic of the machine at hand. Default is a Cartesian machine.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DKINEMATIC_TYPE=KINEMATIC_TYPE_DELTA
+ */
+#ifndef KINEMATIC_TYPE
+#define KINEMATIC_TYPE                  KINEMATIC_TYPE_CARTESIAN
+#endif
+
+/**
+ * Default steps per millimeter for each axis and for all extruder. Values
+ * are written to #parameter during #Kinematic_init.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DKINEMATIC_AXIS_STEPS_PER_UNIT={80,80,400}
+ */
+#ifndef KINEMATIC_AXIS_STEPS_PER_UNIT
+#define KINEMATIC_AXIS_STEPS_PER_UNIT       {80, 80, 400}
+#endif
+#ifndef KINEMATIC_EXTRUDER_STEPS_PER_UNIT
+#define KINEMATIC_EXTRUDER_STEPS_PER_UNIT   (AxisCoordinate_t)95
+#endif
+
+/**
+ * Default length of the diagonal rods of a delta machine in mm.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DKINEMATIC_DELTA_DIAGONAL_ROD 250.0
+ */
+#ifndef KINEMATIC_DELTA_DIAGONAL_ROD
+#define KINEMATIC_DELTA_DIAGONAL_ROD    (WorldCoordinate_t)250.0
+#endif
+
+/**
+ * Default horizontal distance in mm between the center of the effector
+ * joints and the center of the carriage joints of a delta machine.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DKINEMATIC_DELTA_RADIUS 124.0
+ */
+#ifndef KINEMATIC_DELTA_RADIUS
+#define KINEMATIC_DELTA_RADIUS          (WorldCoordinate_t)124.0
+#endif
+
+/**
+ * Maximum number of positions transformed with one call of
+ * inverseMachineKinematicBatch.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DKINEMATIC_BATCH_SIZE 8
+ */
+#ifndef KINEMATIC_BATCH_SIZE
+#define KINEMATIC_BATCH_SIZE            (uint8_t)8
+#endif
+
+/* ******************| Type definitions |****************************** */
+
+/**
+ * Batch of positions in world coordinates [mm]. Stored as structure of
+ * arrays to allow the compiler to use SIMD instructions (SSE/AVX/NEON)
+ * where the target provides them.
+ */
+typedef struct {
+  WorldCoordinate_t x[KINEMATIC_BATCH_SIZE];    /*!< x coordinates in world coordinate system given in mm */
+  WorldCoordinate_t y[KINEMATIC_BATCH_SIZE];    /*!< y coordinates in world coordinate system given in mm */
+  WorldCoordinate_t z[KINEMATIC_BATCH_SIZE];    /*!< z coordinates in world coordinate system given in mm */
+  WorldCoordinate_t e[KINEMATIC_BATCH_SIZE];    /*!< Extruder coordinates in mm */
+} KinematicBatchW_t;
+
+/**
+ * Batch of positions in axis coordinates [steps]. Stored as structure of
+ * arrays. Only the active extruder is part of the batch.
+ */
+typedef struct {
+  AxisCoordinate_t axis[MACHINE_NUM_AXIS][KINEMATIC_BATCH_SIZE];    /*!< Steps for each axis */
+  AxisCoordinate_t extruder[KINEMATIC_BATCH_SIZE];                  /*!< Steps for the active extruder */
+} KinematicBatchA_t;
+
+/**
+ * Rounds a value to the nearest step, half way cases away from zero. Same
+ * as lroundf but without library call which allows the compiler to
+ * vectorize loops using it. Must be used for all conversions into steps to
+ * make sure that single and batch transformation give identical results.
+ * @param[in] value Value in steps
+ * @return Value rounded to nearest step
+ */
+inline AxisCoordinate_t Kinematic_round(float value)
+{
+  return (AxisCoordinate_t)(value + copysignf(0.5f, value));
+}
+
+/**
+ * Transforms the extruder coordinate. Extruder kinematics is the same
+ * for all machines. Only the active extruder will be moved, all other
+ * extruder will keep their position.
+ * @param[in] positionW Position in world coordinates
+ * @param[in/out] positionA Axis coordinates. Only the active extruder is
+ * updated.
+ * @param[in] activeExtruder Extruder which shall be moved
+ */
+inline void Kinematic_extruderKinematic(const WorldCoordinates_t &positionW, AxisCoordinates_t *positionA, uint8_t activeExtruder)
+{
+  positionA->extruder[activeExtruder] = Kinematic_round(positionW.e * derivedParameter.extruderStepsPerUnit[activeExtruder]);
+}
+
+/**
+ * Transforms the extruder coordinate for a batch of positions.
+ * @param[in] positionW Positions in world coordinates
+ * @param[out] positionA Axis coordinates. Only the extruder is updated.
+ * @param[in] count Number of valid positions in the batch
+ * @param[in] activeExtruder Extruder which shall be moved
+ */
+inline void Kinematic_extruderKinematicBatch(const KinematicBatchW_t &positionW, KinematicBatchA_t *positionA, uint8_t count, uint8_t activeExtruder)
+{
+  const float stepsPerUnit = derivedParameter.extruderStepsPerUnit[activeExtruder];
+
+  for (uint8_t k=0; k<count; k++)
+    {
+      positionA->extruder[k] = Kinematic_round(positionW.e[k] * stepsPerUnit);
+    }
+}
+
+/**
+ * Machine kinematic class template. Only the specializations for the
+ * supported #KINEMATIC_TYPE are implemented. Each specialization shall
+ * provide
+ * - isLinear: TRUE if the mapping from world to axis coordinates is
+ * linear.
+ * - init(): Calculates all constant values from #parameter. Must be called
+ * every time one of the kinematic parameter changes.
+ * - inverseMachineKinematic(): Transforms world into axis coordinates.
+ * - inverseMachineKinematicBatch(): Same as inverseMachineKinematic for up
+ * to #KINEMATIC_BATCH_SIZE positions at once.
+ * - inverseKinematic()/forwardKinematic(): Transforms world into axis
+ * coordinates and vice versa without steps per unit conversion, thus,
+ * both in mm. Used to estimate the path deviation of segmented moves.
+ * - isReachable(): TRUE if the machine can reach a position at all. The
+ * inverse kinematics are only defined for reachable positions.
+ */
+template <uint8_t kinematicType> class Kinematic;
+
+/**
+ * Cartesian machine. Each axis moves exactly one world coordinate.
+ */
+template <> class Kinematic<KINEMATIC_TYPE_CARTESIAN>
+{
+public:
+  static const bool isLinear = true;
+
+  void init() { }
+
+  /**
+   * \brief Checks if a position can be reached
+   * @param[in] positionW Absolute position in world coordinates X_W [mm]
+   * @return Always true, the build volume is not limited by the kinematic
+   */
+  inline bool isReachable(const WorldCoordinates_t &positionW) const
+  {
+    (void)positionW;
+    return true;
+  }
+
+  /**
+   * \brief Transforms world into axis coordinates
+   * @param[in] positionW Absolute position in world coordinates X_W [mm]
+   * @param[out] positionA Absolute position in axis coordinates X_A [steps]
+   * @param[in] activeExtruder Extruder which shall be moved
+   */
+  inline void inverseMachineKinematic(const WorldCoordinates_t &positionW, AxisCoordinates_t *positionA, uint8_t activeExtruder) const
+  {
+    positionA->axis[0] = Kinematic_round(positionW.x * derivedParameter.axisStepsPerUnit[0]);
+    positionA->axis[1] = Kinematic_round(positionW.y * derivedParameter.axisStepsPerUnit[1]);
+    positionA->axis[2] = Kinematic_round(positionW.z * derivedParameter.axisStepsPerUnit[2]);
+    Kinematic_extruderKinematic(positionW, positionA, activeExtruder);
+  }
+
+  /**
+   * \brief Transforms a batch of positions from world into axis coordinates
+   * @param[in] positionW Absolute positions in world coordinates X_W [mm]
+   * @param[out] positionA Absolute positions in axis coordinates X_A [steps]
+   * @param[in] count Number of valid positions in the batch
+   * @param[in] activeExtruder Extruder which shall be moved
+   */
+  inline void inverseMachineKinematicBatch(const KinematicBatchW_t &positionW, KinematicBatchA_t *positionA, uint8_t count, uint8_t activeExtruder) const
+  {
+    const float stepsPerUnitX = derivedParameter.axisStepsPerUnit[0];
+    const float stepsPerUnitY = derivedParameter.axisStepsPerUnit[1];
+    const float stepsPerUnitZ = derivedParameter.axisStepsPerUnit[2];
+
+    for (uint8_t k=0; k<count; k++)
+      {
+        positionA->axis[0][k] = Kinematic_round(positionW.x[k] * stepsPerUnitX);
+        positionA->axis[1][k] = Kinematic_round(positionW.y[k] * stepsPerUnitY);
+        positionA->axis[2][k] = Kinematic_round(positionW.z[k] * stepsPerUnitZ);
+      }
+    Kinematic_extruderKinematicBatch(positionW, positionA, count, activeExtruder);
+  }
+
+  /**
+   * \brief Transforms world into axis coordinates given in mm
+   * @param[in] positionW Absolute position in world coordinates X_W [mm]
+   * @param[out] positionA Absolute position of each axis [mm]
+   */
+  inline void inverseKinematic(const WorldCoordinates_t &positionW, WorldCoordinate_t positionA[MACHINE_NUM_AXIS]) const
+  {
+    positionA[0] = positionW.x;
+    positionA[1] = positionW.y;
+    positionA[2] = positionW.z;
+  }
+
+  /**
+   * \brief Transforms axis coordinates given in mm into world coordinates
+   * @param[in] positionA Absolute position of each axis [mm]
+   * @param[out] positionW Absolute position in world coordinates X_W [mm].
+   * Extruder coordinate is left untouched.
+   */
+  inline void forwardKinematic(const WorldCoordinate_t positionA[MACHINE_NUM_AXIS], WorldCoordinates_t *positionW) const
+  {
+    positionW->x = positionA[0];
+    positionW->y = positionA[1];
+    positionW->z = positionA[2];
+  }
+};
+
+/**
+ * CoreXY machine. Motor A moves X+Y, motor B moves X-Y. Z is not coupled.
+ */
+template <> class Kinematic<KINEMATIC_TYPE_COREXY>
+{
+public:
+  static const bool isLinear = true;
+
+  void init() { }
+
+  /**
+   * \brief Checks if a position can be reached
+   * @param[in] positionW Absolute position in world coordinates X_W [mm]
+   * @return Always true, the build volume is not limited by the kinematic
+   */
+  inline bool isReachable(const WorldCoordinates_t &positionW) const
+  {
+    (void)positionW;
+    return true;
+  }
+
+  /**
+   * \brief Transforms world into axis coordinates
+   * @param[in] positionW Absolute position in world coordinates X_W [mm]
+   * @param[out] positionA Absolute position in axis coordinates X_A [steps]
+   * @param[in] activeExtruder Extruder which shall be moved
+   */
+  inline void inverseMachineKinematic(const WorldCoordinates_t &positionW, AxisCoordinates_t *positionA, uint8_t activeExtruder) const
+  {
+    positionA->axis[0] = Kinematic_round((positionW.x + positionW.y) * derivedParameter.axisStepsPerUnit[0]);
+    positionA->axis[1] = Kinematic_round((positionW.x - positionW.y) * derivedParameter.axisStepsPerUnit[1]);
+    positionA->axis[2] = Kinematic_round(positionW.z * derivedParameter.axisStepsPerUnit[2]);
+    Kinematic_extruderKinematic(positionW, positionA, activeExtruder);
+  }
+
+  /**
+   * \brief Transforms a batch of positions from world into axis coordinates
+   * @param[in] positionW Absolute positions in world coordinates X_W [mm]
+   * @param[out] positionA Absolute positions in axis coordinates X_A [steps]
+   * @param[in] count Number of valid positions in the batch
+   * @param[in] activeExtruder Extruder which shall be moved
+   */
+  inline void inverseMachineKinematicBatch(const KinematicBatchW_t &positionW, KinematicBatchA_t *positionA, uint8_t count, uint8_t activeExtruder) const
+  {
+    const float stepsPerUnitA = derivedParameter.axisStepsPerUnit[0];
+    const float stepsPerUnitB = derivedParameter.axisStepsPerUnit[1];
+    const float stepsPerUnitZ = derivedParameter.axisStepsPerUnit[2];
+
+    for (uint8_t k=0; k<count; k++)
+      {
+        positionA->axis[0][k] = Kinematic_round((positionW.x[k] + positionW.y[k]) * stepsPerUnitA);
+        positionA->axis[1][k] = Kinematic_round((positionW.x[k] - positionW.y[k]) * stepsPerUnitB);
+        positionA->axis[2][k] = Kinematic_round(positionW.z[k] * stepsPerUnitZ);
+      }
+    Kinematic_extruderKinematicBatch(positionW, positionA, count, activeExtruder);
+  }
+
+  /**
+   * \brief Transforms world into axis coordinates given in mm
+   * @param[in] positionW Absolute position in world coordinates X_W [mm]
+   * @param[out] positionA Absolute position of each axis [mm]
+   */
+  inline void inverseKinematic(const WorldCoordinates_t &positionW, WorldCoordinate_t positionA[MACHINE_NUM_AXIS]) const
+  {
+    positionA[0] = positionW.x + positionW.y;
+    positionA[1] = positionW.x - positionW.y;
+    positionA[2] = positionW.z;
+  }
+
+  /**
+   * \brief Transforms axis coordinates given in mm into world coordinates
+   * @param[in] positionA Absolute position of each axis [mm]
+   * @param[out] positionW Absolute position in world coordinates X_W [mm].
+   * Extruder coordinate is left untouched.
+   */
+  inline void forwardKinematic(const WorldCoordinate_t positionA[MACHINE_NUM_AXIS], WorldCoordinates_t *positionW) const
+  {
+    positionW->x = (positionA[0] + positionA[1]) * (WorldCoordinate_t)0.5;
+    positionW->y = (positionA[0] - positionA[1]) * (WorldCoordinate_t)0.5;
+    positionW->z = positionA[2];
+  }
+};
+
+/**
+ * Linear delta machine with three towers placed at 210°, 330° and 90°.
+ * Tower positions and the squared diagonal rod length are calculated once
+ * in #init. The inverse kinematic therefore only needs one single precision
+ * square root per tower.
+ */
+template <> class Kinematic<KINEMATIC_TYPE_DELTA>
+{
+private:
+  WorldCoordinate_t towerX[MACHINE_NUM_AXIS];    /*!< X position of each tower in mm */
+  WorldCoordinate_t towerY[MACHINE_NUM_AXIS];    /*!< Y position of each tower in mm */
+  WorldCoordinate_t diagonalRod2;                /*!< Diagonal rod length squared in mm^2 */
+
+  /**
+   * \brief Squared height of the carriage above the effector
+   *
+   * Zero for unreachable positions and NaN, so that the square root is
+   * always defined. Written as comparison instead of max to keep the
+   * batch loop vectorizable.
+   * @param[in] dx Distance of the effector from the tower in X [mm]
+   * @param[in] dy Distance of the effector from the tower in Y [mm]
+   * @return Squared height [mm^2], at least zero
+   */
+  inline WorldCoordinate_t carriageHeight2(WorldCoordinate_t dx, WorldCoordinate_t dy) const
+  {
+    WorldCoordinate_t height2 = diagonalRod2 - dx*dx - dy*dy;
+    return (height2 > 0.0f) ? height2 : 0.0f;
+  }
+
+public:
+  static const bool isLinear = false;
+
+  void init();
+
+  /**
+   * \brief Checks if a position can be reached
+   *
+   * The effector can't be farther than the diagonal rod from any tower
+   * in the XY plane. Otherwise the carriage height is the square root of
+   * a negative number.
+   * @param[in] positionW Absolute position in world coordinates X_W [mm]
+   * @return True if the diagonal rods can reach the position
+   */
+  inline bool isReachable(const WorldCoordinates_t &positionW) const
+  {
+    for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++)
+      {
+        WorldCoordinate_t dx = towerX[i] - positionW.x;
+        WorldCoordinate_t dy = towerY[i] - positionW.y;
+        if (!(diagonalRod2 - dx*dx - dy*dy >= 0.0))
+          {
+            return false;
+          }
+      }
+    return true;
+  }
+
+  /**
+   * \brief Transforms world into axis coordinates
+   * @param[in] positionW Absolute position in world coordinates X_W [mm]
+   * @param[out] positionA Absolute position of each carriage in axis
+   * coordinates X_A [steps]
+   * @param[in] activeExtruder Extruder which shall be moved
+   */
+  inline void inverseMachineKinematic(const WorldCoordinates_t &positionW, AxisCoordinates_t *positionA, uint8_t activeExtruder) const
+  {
+    WorldCoordinate_t carriageA[MACHINE_NUM_AXIS];
+
+    inverseKinematic(positionW, carriageA);
+    for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++)
+      {
+        positionA->axis[i] = Kinematic_round(carriageA[i] * derivedParameter.axisStepsPerUnit[i]);
+      }
+    Kinematic_extruderKinematic(positionW, positionA, activeExtruder);
+  }
+
+  /**
+   * \brief Transforms a batch of positions from world into axis coordinates
+   *
+   * Only the targets of moves are checked by #isReachable. Segments of an
+   * arc may still leave the reachable area, such positions are moved to
+   * its border instead of resulting in an undefined carriage height.
+   * @param[in] positionW Absolute positions in world coordinates X_W [mm]
+   * @param[out] positionA Absolute positions in axis coordinates X_A [steps]
+   * @param[in] count Number of valid positions in the batch
+   * @param[in] activeExtruder Extruder which shall be moved
+   */
+  inline void inverseMachineKinematicBatch(const KinematicBatchW_t &positionW, KinematicBatchA_t *positionA, uint8_t count, uint8_t activeExtruder) const
+  {
+    /* Loop over the towers outside so that the inner loop only contains
+     * independent operations on the batch which can be vectorized */
+    for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++)
+      {
+        const WorldCoordinate_t tX = towerX[i];
+        const WorldCoordinate_t tY = towerY[i];
+        const float stepsPerUnit = derivedParameter.axisStepsPerUnit[i];
+        AxisCoordinate_t *carriageA = positionA->axis[i];
+
+        for (uint8_t k=0; k<count; k++)
+          {
+            WorldCoordinate_t dx = tX - positionW.x[k];
+            WorldCoordinate_t dy = tY - positionW.y[k];
+            carriageA[k] = Kinematic_round((sqrtf(carriageHeight2(dx, dy)) + positionW.z[k]) * stepsPerUnit);
+          }
+      }
+    Kinematic_extruderKinematicBatch(positionW, positionA, count, activeExtruder);
+  }
+
+  /**
+   * \brief Transforms world into carriage heights given in mm
+   * @param[in] positionW Absolute position in world coordinates X_W [mm]
+   * @param[out] positionA Absolute height of each carriage [mm]
+   */
+  inline void inverseKinematic(const WorldCoordinates_t &positionW, WorldCoordinate_t positionA[MACHINE_NUM_AXIS]) const
+  {
+    for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++)
+      {
+        WorldCoordinate_t dx = towerX[i] - positionW.x;
+        WorldCoordinate_t dy = towerY[i] - positionW.y;
+        positionA[i] = sqrtf(carriageHeight2(dx, dy)) + positionW.z;
+      }
+  }
+
+  void forwardKinematic(const WorldCoordinate_t positionA[MACHINE_NUM_AXIS], WorldCoordinates_t *positionW) const;
+};
+
+/**
+ * Kinematic of the machine at hand
+ */
+typedef Kinematic<KINEMATIC_TYPE> Kinematic_t;
+
+/**
+ * \brief Path deviation of a chord of a move
+ *
+ * A chord moves all axes linearly in axis coordinates. For non-linear
+ * kinematics the head therefore leaves the straight line in world
+ * coordinates. The deviation is measured in the middle of the chord, where
+ * it is biggest for smooth kinematics.
+ * @param[in] kinematic Kinematic of the machine
+ * @param[in] startW Start of the move in world coordinates [mm]
+ * @param[in] moveW Complete move in world coordinates [mm]
+ * @param[in] from Start of the chord as fraction of the move (0..1)
+ * @param[in] to End of the chord as fraction of the move (0..1)
+ * @return Deviation of the head from the ideal path in the middle of the
+ * chord [mm]
+ */
+template <class KinematicT> WorldCoordinate_t Kinematic_chordDeviation(const KinematicT &kinematic, const WorldCoordinates_t &startW,
+                                                                       const WorldCoordinates_t &moveW, float from, float to)
+{
+  WorldCoordinates_t fromW, toW, midpointW, interpolatedW;
+  WorldCoordinate_t fromA[MACHINE_NUM_AXIS], toA[MACHINE_NUM_AXIS], interpolatedA[MACHINE_NUM_AXIS];
+  float middle = (from + to) / 2;
+
+  fromW.x = startW.x + moveW.x * from;
+  fromW.y = startW.y + moveW.y * from;
+  fromW.z = startW.z + moveW.z * from;
+  toW.x = startW.x + moveW.x * to;
+  toW.y = startW.y + moveW.y * to;
+  toW.z = startW.z + moveW.z * to;
+  midpointW.x = startW.x + moveW.x * middle;
+  midpointW.y = startW.y + moveW.y * middle;
+  midpointW.z = startW.z + moveW.z * middle;
+
+  kinematic.inverseKinematic(fromW, fromA);
+  kinematic.inverseKinematic(toW, toA);
+  for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++)
+    {
+      interpolatedA[i] = (fromA[i] + toA[i]) / 2;
+    }
+  kinematic.forwardKinematic(interpolatedA, &interpolatedW);
+
+  return sqrtf(sq(interpolatedW.x - midpointW.x) + sq(interpolatedW.y - midpointW.y) + sq(interpolatedW.z - midpointW.z));
+}
+
+/**
+ * \brief Number of equally long chords a move must be split into
+ *
+ * The deviation of a chord grows with the square of its length. A first
+ * estimate is derived from the biggest deviation found when splitting the
+ * move into the given number of equally long parts. Because the curvature of the kinematic changes within
+ * a part, e.g. close to a delta tower, the estimate can be too low by more
+ * than half. Thus, the deviation of every chord is measured afterwards and
+ * the number of chords is increased until all of them are within the
+ * tolerance. Usually one correction is enough.
+ * @param[in] kinematic Kinematic of the machine
+ * @param[in] startW Start of the move in world coordinates [mm]
+ * @param[in] moveW Complete move in world coordinates [mm]
+ * @param[in] toleranceInverse Reciprocal of the maximum deviation of each
+ * chord [1/mm]
+ * @param[in] samples Number of parts used for the first estimate
+ * @return Number of chords, at least one
+ */
+template <class KinematicT> int Kinematic_chords(const KinematicT &kinematic, const WorldCoordinates_t &startW,
+                                                 const WorldCoordinates_t &moveW, WorldCoordinate_t toleranceInverse, uint8_t samples)
+{
+  /* Terminates even for a kinematic which is not smooth */
+  const int maximumChords = 32767;
+  WorldCoordinate_t deviationW = 0.0;
+  WorldCoordinate_t chordDeviationW;
+  int chords;
+
+  for (uint8_t i=0; i<samples; i++)
+    {
+      chordDeviationW = Kinematic_chordDeviation(kinematic, startW, moveW, (float)i / samples, (float)(i + 1) / samples);
+      if (chordDeviationW > deviationW)
+        {
+          deviationW = chordDeviationW;
+        }
+    }
+  chords = (int)ceilf(samples * sqrtf(deviationW * toleranceInverse));
+  if (chords < 1)
+    {
+      chords = 1;
+    }
+
+  while (chords < maximumChords)
+    {
+      WorldCoordinates_t pointW, midpointW, interpolatedW;
+      WorldCoordinate_t fromA[MACHINE_NUM_AXIS], toA[MACHINE_NUM_AXIS], interpolatedA[MACHINE_NUM_AXIS];
+
+      /* End of one chord is the start of the next one, so the inverse
+       * kinematic is only needed once per chord */
+      kinematic.inverseKinematic(startW, fromA);
+      deviationW = 0.0;
+      for (int i=0; i<chords; i++)
+        {
+          float middle = (i + 0.5f) / chords;
+          float to = (float)(i + 1) / chords;
+
+          pointW.x = startW.x + moveW.x * to;
+          pointW.y = startW.y + moveW.y * to;
+          pointW.z = startW.z + moveW.z * to;
+          kinematic.inverseKinematic(pointW, toA);
+          for (uint8_t j=0; j<MACHINE_NUM_AXIS; j++)
+            {
+              interpolatedA[j] = (fromA[j] + toA[j]) / 2;
+              fromA[j] = toA[j];
+            }
+          kinematic.forwardKinematic(interpolatedA, &interpolatedW);
+          midpointW.x = startW.x + moveW.x * middle;
+          midpointW.y = startW.y + moveW.y * middle;
+          midpointW.z = startW.z + moveW.z * middle;
+          chordDeviationW = sq(interpolatedW.x - midpointW.x) + sq(interpolatedW.y - midpointW.y) + sq(interpolatedW.z - midpointW.z);
+          if (chordDeviationW > deviationW)
+            {
+              deviationW = chordDeviationW;
+            }
+        }
+      deviationW = sqrtf(deviationW);
+      if (deviationW * toleranceInverse <= 1.0f)
+        {
+          break;
+        }
+      /* At least one more chord, the estimate may round to the same count */
+      int estimate = (int)ceilf(chords * sqrtf(deviationW * toleranceInverse));
+      chords = (estimate > chords) ? estimate : chords + 1;
+    }
+  return chords;
+}
+
+/* ******************| External function declarations |**************** */
+extern void Kinematic_init();
+
+/* ******************| External constants |**************************** */
+
+/* ******************| External variables |**************************** */
+extern Kinematic_t kinematic;
+
+/** @} doxygen end group definition */
+#endif /* if !defined( KINEMATIC_INCLUDE_KINEMATIC_H_ ) */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,141 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * \addtogroup Kinematic
+ * @{
+ *
+ * \brief Kinematic source file
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ * Only the parts of the kinematics which are not time critical are
+ * implemented here. Everything used for each segment is implemented
+ * inline in kinematic.h.
+ *
+ * @note Replaces function calculate_delta and recalc_delta_settings
+ */
+
+/* ******************| Inclusions |************************************ */
+#include "kinematic.h"
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+void Kinematic_init();
+
+/* ******************| Global Variables |****************************** */
+Kinematic_t kinematic;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Initializes Kinematic module
+ *
+ * Sets all kinematic related parameter to their default values and
+ * calculates the constant values of the selected kinematic.
+ */
+void Kinematic_init()
+{
+  AxisCoordinate_t axisStepsPerUnit[MACHINE_NUM_AXIS] = KINEMATIC_AXIS_STEPS_PER_UNIT;
+
+  for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++)
+    {
+      parameter.axisStepsPerUnit.axis[i] = axisStepsPerUnit[i];
+    }
+  for (uint8_t i=0; i<MACHINE_NUM_EXTRUDER; i++)
+    {
+      parameter.axisStepsPerUnit.extruder[i] = KINEMATIC_EXTRUDER_STEPS_PER_UNIT;
+    }
+  parameter.deltaDiagonalRod = KINEMATIC_DELTA_DIAGONAL_ROD;
+  parameter.deltaRadius = KINEMATIC_DELTA_RADIUS;
+
+  kinematic.init();
+}
+
+/**
+ * \brief Calculates constant values for delta kinematic
+ *
+ * Tower positions are calculated from #parameter deltaRadius. Towers
+ * are placed at 210° (front left), 330° (front right) and 90° (back).
+ */
+void Kinematic<KINEMATIC_TYPE_DELTA>::init()
+{
+  static_assert(MACHINE_NUM_AXIS == 3, "Delta kinematic needs exactly three axis");
+  /* sin/cos of 210°, 330° and 90° */
+  const WorldCoordinate_t towerCos[MACHINE_NUM_AXIS] = {-0.866025404, 0.866025404, 0.0};
+  const WorldCoordinate_t towerSin[MACHINE_NUM_AXIS] = {-0.5, -0.5, 1.0};
+
+  for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++)
+    {
+      towerX[i] = parameter.deltaRadius * towerCos[i];
+      towerY[i] = parameter.deltaRadius * towerSin[i];
+    }
+  diagonalRod2 = sq(parameter.deltaDiagonalRod);
+}
+
+/**
+ * \brief Transforms carriage heights given in mm into world coordinates
+ *
+ * Trilateration of the three spheres with radius diagonal rod around each
+ * carriage joint. Not used during normal operation and therefore not
+ * optimized for speed.
+ * @param[in] positionA Absolute height of each carriage [mm]
+ * @param[out] positionW Absolute position in world coordinates X_W [mm].
+ * Extruder coordinate is left untouched.
+ */
+void Kinematic<KINEMATIC_TYPE_DELTA>::forwardKinematic(const WorldCoordinate_t positionA[MACHINE_NUM_AXIS], WorldCoordinates_t *positionW) const
+{
+  /* Vector from tower 1 to tower 2 and tower 1 to tower 3 */
+  WorldCoordinate_t p12[3] = {towerX[1] - towerX[0], towerY[1] - towerY[0], positionA[1] - positionA[0]};
+  WorldCoordinate_t p13[3] = {towerX[2] - towerX[0], towerY[2] - towerY[0], positionA[2] - positionA[0]};
+  WorldCoordinate_t ex[3], ey[3], ez[3];
+
+  /* Unit vector in x direction: tower 1 to tower 2 */
+  WorldCoordinate_t d = sqrtf(sq(p12[0]) + sq(p12[1]) + sq(p12[2]));
+  for (uint8_t i=0; i<3; i++) ex[i] = p12[i] / d;
+
+  /* Unit vector in y direction: part of p13 orthogonal to ex */
+  WorldCoordinate_t i13 = ex[0]*p13[0] + ex[1]*p13[1] + ex[2]*p13[2];
+  for (uint8_t i=0; i<3; i++) ey[i] = p13[i] - i13 * ex[i];
+  WorldCoordinate_t j = sqrtf(sq(ey[0]) + sq(ey[1]) + sq(ey[2]));
+  for (uint8_t i=0; i<3; i++) ey[i] = ey[i] / j;
+
+  /* Unit vector in z direction: cross product of ex and ey */
+  ez[0] = ex[1]*ey[2] - ex[2]*ey[1];
+  ez[1] = ex[2]*ey[0] - ex[0]*ey[2];
+  ez[2] = ex[0]*ey[1] - ex[1]*ey[0];
+
+  /* All rods have the same length, which simplifies the trilateration */
+  WorldCoordinate_t xNew = d / 2;
+  WorldCoordinate_t yNew = ((sq(i13) + sq(j)) / 2 - i13 * xNew) / j;
+  WorldCoordinate_t zNew = sqrtf(diagonalRod2 - sq(xNew) - sq(yNew));
+
+  /* Effector is below the carriages, thus, subtract z part */
+  positionW->x = towerX[0] + ex[0]*xNew + ey[0]*yNew - ez[0]*zNew;
+  positionW->y = towerY[0] + ex[1]*xNew + ey[1]*yNew - ez[1]*zNew;
+  positionW->z = positionA[0] + ex[2]*xNew + ey[2]*yNew - ez[2]*zNew;
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
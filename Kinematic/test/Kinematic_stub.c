@@ -0,0 +1,36 @@
+/**
+ * \file Kinematic_stub.c
+ *
+ * \brief Stubs for Kinematic unit tests
+ *
+ * All stubs needed for the unit test of this particular modules shall
+ * be done within this file.
+ *
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup Kinematic
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+/* Parameter and the values derived from them are provided by the
+ * Parameter module itself */
+#include "../../Parameter/src/parameter.cpp"
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+
+/* ******************| Global Variables |****************************** */
+
+/* ******************| Function Implementation |*********************** */
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
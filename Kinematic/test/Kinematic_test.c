@@ -0,0 +1,390 @@
+/**
+ * \file Kinematic_test.c
+ *
+ * \brief Kinematic unit test implementation
+ *
+ * Please see http://embunit.sourceforge.net/ for more information. For
+ * detailed documentation see http://embunit.sourceforge.net/embunit/index.html
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup Kinematic
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include "Kinematic_test.h"
+/* Include .cpp file to be tested in order to get access to all private
+ * or static functions */
+#include "../src/kinematic.cpp"
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+
+/* ******************| Global Variables |****************************** */
+Kinematic<KINEMATIC_TYPE_CARTESIAN> cartesianKinematic;
+Kinematic<KINEMATIC_TYPE_COREXY> coreXYKinematic;
+Kinematic<KINEMATIC_TYPE_DELTA> deltaKinematic;
+
+/* ******************| Function Implementation |*********************** */
+
+/**
+ * Test if linear and non-linear kinematics are flagged correctly
+ */
+static void Kinematic_Kinematic_isLinear_1(void)
+{
+  TEST_ASSERT(Kinematic<KINEMATIC_TYPE_CARTESIAN>::isLinear);
+  TEST_ASSERT(Kinematic<KINEMATIC_TYPE_COREXY>::isLinear);
+  TEST_ASSERT(!Kinematic<KINEMATIC_TYPE_DELTA>::isLinear);
+}
+
+/**
+ * Cartesian inverse kinematic
+ * Test if origin is transformed to zero steps
+ * Test if each world coordinate is transformed to its own axis only
+ * Test if extruder coordinate is transformed for active extruder
+ */
+static void Kinematic_Cartesian_inverseMachineKinematic_1(void)
+{
+  WorldCoordinates_t positionW = {0.0, 0.0, 0.0, 0.0};
+  AxisCoordinates_t positionA;
+
+  cartesianKinematic.inverseMachineKinematic(positionW, &positionA, 0);
+  TEST_ASSERT_EQUAL_INT(0, positionA.axis[0]);
+  TEST_ASSERT_EQUAL_INT(0, positionA.axis[1]);
+  TEST_ASSERT_EQUAL_INT(0, positionA.axis[2]);
+  TEST_ASSERT_EQUAL_INT(0, positionA.extruder[0]);
+
+  positionW = {10.0, -20.0, 5.0, 1.0};
+  cartesianKinematic.inverseMachineKinematic(positionW, &positionA, 0);
+  TEST_ASSERT_EQUAL_INT(800, positionA.axis[0]);
+  TEST_ASSERT_EQUAL_INT(-1600, positionA.axis[1]);
+  TEST_ASSERT_EQUAL_INT(400, positionA.axis[2]);
+  TEST_ASSERT_EQUAL_INT(95, positionA.extruder[0]);
+}
+
+/**
+ * CoreXY inverse kinematic
+ * Test if a pure X move turns both motors in the same direction
+ * Test if a pure Y move turns both motors in opposite direction
+ * Test if Z is not coupled
+ */
+static void Kinematic_CoreXY_inverseMachineKinematic_1(void)
+{
+  WorldCoordinates_t positionW = {10.0, 0.0, 0.0, 0.0};
+  AxisCoordinates_t positionA;
+
+  coreXYKinematic.inverseMachineKinematic(positionW, &positionA, 0);
+  TEST_ASSERT_EQUAL_INT(800, positionA.axis[0]);
+  TEST_ASSERT_EQUAL_INT(800, positionA.axis[1]);
+  TEST_ASSERT_EQUAL_INT(0, positionA.axis[2]);
+
+  positionW = {0.0, 10.0, 2.5, 0.0};
+  coreXYKinematic.inverseMachineKinematic(positionW, &positionA, 0);
+  TEST_ASSERT_EQUAL_INT(800, positionA.axis[0]);
+  TEST_ASSERT_EQUAL_INT(-800, positionA.axis[1]);
+  TEST_ASSERT_EQUAL_INT(200, positionA.axis[2]);
+}
+
+/**
+ * Delta inverse kinematic
+ * Test if all carriages are at the same height if effector is in the
+ * center of the machine
+ * Test if carriage height matches sqrt(rod^2 - radius^2)
+ * Test if a z move moves all carriages by the same amount
+ * Test if moving towards the back tower lifts its carriage above the
+ * other two
+ */
+static void Kinematic_Delta_inverseMachineKinematic_1(void)
+{
+  WorldCoordinates_t positionW = {0.0, 0.0, 0.0, 0.0};
+  AxisCoordinates_t positionA, centerA;
+  AxisCoordinate_t expected = lroundf(sqrtf(sq(KINEMATIC_DELTA_DIAGONAL_ROD) - sq(KINEMATIC_DELTA_RADIUS)) * KINEMATIC_TEST_STEPSPERUNIT);
+
+  deltaKinematic.inverseMachineKinematic(positionW, &centerA, 0);
+  TEST_ASSERT_EQUAL_INT(expected, centerA.axis[0]);
+  TEST_ASSERT_EQUAL_INT(expected, centerA.axis[1]);
+  TEST_ASSERT_EQUAL_INT(expected, centerA.axis[2]);
+
+  positionW.z = 10.0;
+  deltaKinematic.inverseMachineKinematic(positionW, &positionA, 0);
+  for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++)
+    {
+      TEST_ASSERT_EQUAL_INT(centerA.axis[i] + 10 * KINEMATIC_TEST_STEPSPERUNIT, positionA.axis[i]);
+    }
+
+  positionW = {0.0, 50.0, 0.0, 0.0};
+  deltaKinematic.inverseMachineKinematic(positionW, &positionA, 0);
+  TEST_ASSERT(positionA.axis[2] > centerA.axis[2]);
+  TEST_ASSERT(positionA.axis[0] < centerA.axis[0]);
+  TEST_ASSERT_EQUAL_INT(positionA.axis[0], positionA.axis[1]);
+}
+
+/**
+ * Forward kinematic of all kinematics
+ * Test if forward kinematic of the inverse kinematic returns the original
+ * position for a few points spread over the build volume
+ */
+static void Kinematic_Kinematic_forwardKinematic_1(void)
+{
+  const WorldCoordinates_t testPositionW[] = {
+      {0.0, 0.0, 0.0, 0.0},
+      {10.0, -20.0, 5.0, 0.0},
+      {-80.0, 30.0, 100.0, 0.0},
+      {60.0, 60.0, 1.5, 0.0}
+  };
+  WorldCoordinate_t positionA[MACHINE_NUM_AXIS];
+  WorldCoordinates_t positionW;
+
+  for (uint8_t i=0; i<sizeof(testPositionW)/sizeof(testPositionW[0]); i++)
+    {
+      cartesianKinematic.inverseKinematic(testPositionW[i], positionA);
+      cartesianKinematic.forwardKinematic(positionA, &positionW);
+      TEST_ASSERT(fabsf(positionW.x - testPositionW[i].x) < 0.001);
+      TEST_ASSERT(fabsf(positionW.y - testPositionW[i].y) < 0.001);
+      TEST_ASSERT(fabsf(positionW.z - testPositionW[i].z) < 0.001);
+
+      coreXYKinematic.inverseKinematic(testPositionW[i], positionA);
+      coreXYKinematic.forwardKinematic(positionA, &positionW);
+      TEST_ASSERT(fabsf(positionW.x - testPositionW[i].x) < 0.001);
+      TEST_ASSERT(fabsf(positionW.y - testPositionW[i].y) < 0.001);
+      TEST_ASSERT(fabsf(positionW.z - testPositionW[i].z) < 0.001);
+
+      deltaKinematic.inverseKinematic(testPositionW[i], positionA);
+      deltaKinematic.forwardKinematic(positionA, &positionW);
+      TEST_ASSERT(fabsf(positionW.x - testPositionW[i].x) < 0.01);
+      TEST_ASSERT(fabsf(positionW.y - testPositionW[i].y) < 0.01);
+      TEST_ASSERT(fabsf(positionW.z - testPositionW[i].z) < 0.01);
+    }
+}
+
+/**
+ * Batch inverse kinematic of all kinematics
+ * Test if the batch transformation gives the same results as the single
+ * position transformation for a full and for a partially filled batch
+ */
+static void Kinematic_Kinematic_inverseMachineKinematicBatch_1(void)
+{
+  KinematicBatchW_t batchW;
+  KinematicBatchA_t cartesianA, coreXYA, deltaA;
+  WorldCoordinates_t positionW;
+  AxisCoordinates_t positionA;
+
+  for (uint8_t k=0; k<KINEMATIC_BATCH_SIZE; k++)
+    {
+      batchW.x[k] = -80.0 + 17.3 * k;
+      batchW.y[k] = 60.0 - 11.7 * k;
+      batchW.z[k] = 0.2 * k;
+      batchW.e[k] = 0.05 * k;
+    }
+  for (uint8_t count=KINEMATIC_BATCH_SIZE - 1; count<=KINEMATIC_BATCH_SIZE; count++)
+    {
+      cartesianKinematic.inverseMachineKinematicBatch(batchW, &cartesianA, count, 0);
+      coreXYKinematic.inverseMachineKinematicBatch(batchW, &coreXYA, count, 0);
+      deltaKinematic.inverseMachineKinematicBatch(batchW, &deltaA, count, 0);
+      for (uint8_t k=0; k<count; k++)
+        {
+          positionW = {batchW.x[k], batchW.y[k], batchW.z[k], batchW.e[k]};
+          cartesianKinematic.inverseMachineKinematic(positionW, &positionA, 0);
+          for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++)
+            {
+              TEST_ASSERT(abs(positionA.axis[i] - cartesianA.axis[i][k]) <= 1);
+            }
+          TEST_ASSERT(abs(positionA.extruder[0] - cartesianA.extruder[k]) <= 1);
+
+          coreXYKinematic.inverseMachineKinematic(positionW, &positionA, 0);
+          for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++)
+            {
+              TEST_ASSERT(abs(positionA.axis[i] - coreXYA.axis[i][k]) <= 1);
+            }
+
+          deltaKinematic.inverseMachineKinematic(positionW, &positionA, 0);
+          for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++)
+            {
+              TEST_ASSERT(abs(positionA.axis[i] - deltaA.axis[i][k]) <= 1);
+            }
+        }
+    }
+}
+
+/**
+ * Batch inverse kinematic of delta for unreachable positions, e.g. arc
+ * segments outside the reachable area
+ * Test if carriages whose tower is too far away are moved to the height
+ * of the effector instead of giving an undefined result
+ * Test if reachable positions of the same batch are not affected
+ */
+static void Kinematic_Delta_inverseMachineKinematicBatch_1(void)
+{
+  KinematicBatchW_t batchW = {};
+  KinematicBatchA_t deltaA;
+  WorldCoordinates_t positionW = {0.0, 0.0, 10.0, 0.0};
+  AxisCoordinates_t positionA;
+
+  deltaKinematic.inverseMachineKinematic(positionW, &positionA, 0);
+  for (uint8_t k=0; k<KINEMATIC_BATCH_SIZE; k++)
+    {
+      batchW.x[k] = (k & 1) ? 0.0 : 500.0;
+      batchW.z[k] = 10.0;
+    }
+  deltaKinematic.inverseMachineKinematicBatch(batchW, &deltaA, KINEMATIC_BATCH_SIZE, 0);
+  for (uint8_t k=0; k<KINEMATIC_BATCH_SIZE; k++)
+    {
+      for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++)
+        {
+          if (k & 1)
+            {
+              TEST_ASSERT_EQUAL_INT(positionA.axis[i], deltaA.axis[i][k]);
+            }
+          else
+            {
+              TEST_ASSERT_EQUAL_INT(10 * KINEMATIC_TEST_STEPSPERUNIT, deltaA.axis[i][k]);
+            }
+        }
+    }
+}
+
+/**
+ * Reachability of all kinematics
+ * Test if linear kinematics can reach any position
+ * Test if delta can reach the center and positions just inside the
+ * diagonal rod length of the back tower
+ * Test if delta can't reach positions farther than the diagonal rod from
+ * any tower, e.g. G1 X500
+ */
+static void Kinematic_Kinematic_isReachable_1(void)
+{
+  const WorldCoordinate_t backTowerY = KINEMATIC_DELTA_RADIUS;
+
+  TEST_ASSERT(cartesianKinematic.isReachable({500.0, 0.0, 10.0, 0.0}));
+  TEST_ASSERT(coreXYKinematic.isReachable({500.0, 0.0, 10.0, 0.0}));
+
+  TEST_ASSERT(deltaKinematic.isReachable({0.0, 0.0, 0.0, 0.0}));
+  TEST_ASSERT(deltaKinematic.isReachable({0.0, backTowerY - KINEMATIC_DELTA_DIAGONAL_ROD + 1.0, 0.0, 0.0}));
+  TEST_ASSERT(!deltaKinematic.isReachable({0.0, backTowerY - KINEMATIC_DELTA_DIAGONAL_ROD - 1.0, 0.0, 0.0}));
+  TEST_ASSERT(!deltaKinematic.isReachable({500.0, 0.0, 10.0, 0.0}));
+  TEST_ASSERT(!deltaKinematic.isReachable({-500.0, -500.0, 0.0, 0.0}));
+}
+
+/**
+ * Chord count of delta kinematic
+ * Test if a linear kinematic never needs more than one chord
+ * Test if the path deviation of every chord of a delta move stays within
+ * the tolerance when sampled finer than the midpoint, especially for moves
+ * close to a tower where the first estimate is too low
+ * Test if the moves are not split much more than needed
+ */
+static void Kinematic_Delta_chords_1(void)
+{
+  const WorldCoordinate_t tolerance = 0.01;
+  const uint8_t subSamples = 8;
+  const WorldCoordinates_t startW[] = {
+      {-100.0, -40.0, 0.0, 0.0},
+      {-90.0, -80.0, 0.0, 0.0},
+      {-100.0, 0.0, 0.0, 0.0},
+      {0.0, 100.0, 0.0, 0.0},
+      {-104.0, -60.0, 0.0, 0.0}
+  };
+  const WorldCoordinates_t moveW[] = {
+      {40.0, -30.0, 0.0, 0.0},
+      {0.0, 60.0, 0.0, 0.0},
+      {200.0, 0.0, 0.0, 0.0},
+      {0.0, -200.0, 0.0, 0.0},
+      {10.0, 10.0, 0.0, 0.0}
+  };
+  WorldCoordinate_t fromA[MACHINE_NUM_AXIS], toA[MACHINE_NUM_AXIS], interpolatedA[MACHINE_NUM_AXIS];
+  WorldCoordinates_t pointW, interpolatedW;
+
+  TEST_ASSERT_EQUAL_INT(1, Kinematic_chords(cartesianKinematic, startW[0], moveW[0], 1/tolerance, 4));
+
+  for (uint8_t i=0; i<sizeof(startW)/sizeof(startW[0]); i++)
+    {
+      int chords = Kinematic_chords(deltaKinematic, startW[i], moveW[i], 1/tolerance, 4);
+      WorldCoordinate_t deviationW = 0.0;
+
+      for (int k=0; k<chords; k++)
+        {
+          pointW.x = startW[i].x + moveW[i].x * k / chords;
+          pointW.y = startW[i].y + moveW[i].y * k / chords;
+          pointW.z = startW[i].z;
+          deltaKinematic.inverseKinematic(pointW, fromA);
+          pointW.x = startW[i].x + moveW[i].x * (k + 1) / chords;
+          pointW.y = startW[i].y + moveW[i].y * (k + 1) / chords;
+          deltaKinematic.inverseKinematic(pointW, toA);
+          for (uint8_t j=1; j<subSamples; j++)
+            {
+              float u = (float)j / subSamples;
+              for (uint8_t a=0; a<MACHINE_NUM_AXIS; a++)
+                {
+                  interpolatedA[a] = fromA[a] + (toA[a] - fromA[a]) * u;
+                }
+              deltaKinematic.forwardKinematic(interpolatedA, &interpolatedW);
+              pointW.x = startW[i].x + moveW[i].x * (k + u) / chords;
+              pointW.y = startW[i].y + moveW[i].y * (k + u) / chords;
+              deviationW = fmaxf(deviationW, sqrtf(sq(interpolatedW.x - pointW.x) + sq(interpolatedW.y - pointW.y) +
+                                                   sq(interpolatedW.z - pointW.z)));
+            }
+        }
+      TEST_ASSERT(deviationW <= tolerance);
+      TEST_ASSERT(deviationW > tolerance / 2);
+    }
+}
+
+/**
+ * Test Setup function which is called before all each test case
+ */
+static void setUpKinematic(void)
+{
+  for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++)
+    {
+      parameter.axisStepsPerUnit.axis[i] = KINEMATIC_TEST_STEPSPERUNIT;
+    }
+  parameter.axisStepsPerUnit.extruder[0] = KINEMATIC_TEST_EXTRUDERSTEPSPERUNIT;
+  parameter.deltaDiagonalRod = KINEMATIC_DELTA_DIAGONAL_ROD;
+  parameter.deltaRadius = KINEMATIC_DELTA_RADIUS;
+  Parameter_derive();
+  deltaKinematic.init();
+}
+
+/**
+ * Test Teardown function which is called for after each test
+ */
+static void tearDownKinematic(void)
+{
+}
+
+TestRef Kinematic_test_RunTests(void)
+{
+  EMB_UNIT_TESTFIXTURES(fixtures) {
+    new_TestFixture("Test case Kinematic_Kinematic_isLinear_1", Kinematic_Kinematic_isLinear_1),
+    new_TestFixture("Test case Kinematic_Cartesian_inverseMachineKinematic_1", Kinematic_Cartesian_inverseMachineKinematic_1),
+    new_TestFixture("Test case Kinematic_CoreXY_inverseMachineKinematic_1", Kinematic_CoreXY_inverseMachineKinematic_1),
+    new_TestFixture("Test case Kinematic_Delta_inverseMachineKinematic_1", Kinematic_Delta_inverseMachineKinematic_1),
+    new_TestFixture("Test case Kinematic_Kinematic_forwardKinematic_1", Kinematic_Kinematic_forwardKinematic_1),
+    new_TestFixture("Test case Kinematic_Kinematic_inverseMachineKinematicBatch_1", Kinematic_Kinematic_inverseMachineKinematicBatch_1),
+    new_TestFixture("Test case Kinematic_Delta_inverseMachineKinematicBatch_1", Kinematic_Delta_inverseMachineKinematicBatch_1),
+    new_TestFixture("Test case Kinematic_Kinematic_isReachable_1", Kinematic_Kinematic_isReachable_1),
+    new_TestFixture("Test case Kinematic_Delta_chords_1", Kinematic_Delta_chords_1)
+  };
+  EMB_UNIT_TESTCALLER(Kinematic_tests,"Kinematic Unit test",setUpKinematic,tearDownKinematic,fixtures);
+  return (TestRef)&Kinematic_tests;
+}
+
+/**
+ *
+ */
+int main(void)
+{
+  TestRunner_start();
+  TestRunner_runTest(Kinematic_test_RunTests());
+  TestRunner_end();
+}
+
+/** @} doxygen end group definition */
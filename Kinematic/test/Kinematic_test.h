@@ -0,0 +1,40 @@
+#if (!defined KINEMATIC_TEST_H_)
+/* Preprocessor exclusion definition */
+#define KINEMATIC_TEST_H_
+/** 
+ * \file Kinematic_test.h 
+ * 
+ * \brief Kinematic include file for test driver
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup Kinematic
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <embUnit/embUnit.h>
+#include <platform.h>
+
+/* ******************| Macros |**************************************** */
+/**
+ * Steps per unit used for all axis during the test
+ */
+#define KINEMATIC_TEST_STEPSPERUNIT         (AxisCoordinate_t)80
+#define KINEMATIC_TEST_EXTRUDERSTEPSPERUNIT (AxisCoordinate_t)95
+
+/* ******************| Type definitions |****************************** */
+
+/* ******************| External function declarations |**************** */
+
+/* ******************| External constants |**************************** */
+
+/* ******************| External variables |**************************** */
+
+/** @} doxygen end group definition */
+#endif /* if !defined( KINEMATIC_TEST_H_ ) */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,194 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#if (!defined METRICS_INCLUDE_METRICS_H_)
+/* Preprocessor exclusion definition */
+#define METRICS_INCLUDE_METRICS_H_
+/**
+ * \brief Metrics include file
+ *
+ * Registry of counters, gauges and latency histograms which are reported
+ * over the serial line, see #Metrics_report. Counters and histograms are
+ * written by exactly one context each, e.g. the step interrupt, without
+ * any lock. Reading them from another context never blocks the writer.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup Metrics
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <platform.h>
+
+/* ******************| Macros |**************************************** */
+/**
+ * Set to 0 to remove all latency probes, see #METRICS_SPAN. Counters are
+ * kept anyway as they cost one increment only.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DMETRICS_ENABLE 1
+ */
+#ifndef METRICS_ENABLE
+#define METRICS_ENABLE                1
+#endif
+
+/**
+ * Maximum number of metrics in the registry
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DMETRICS_MAX_METRICS 16
+ */
+#ifndef METRICS_MAX_METRICS
+#define METRICS_MAX_METRICS           (uint8_t)16
+#endif
+
+/**
+ * Number of buckets of a histogram. Bucket 0 counts the value 0, bucket
+ * i values from 2^(i-1) to 2^i - 1. The last bucket counts all values
+ * above as well.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DMETRICS_HISTOGRAM_BUCKETS 16
+ */
+#ifndef METRICS_HISTOGRAM_BUCKETS
+#define METRICS_HISTOGRAM_BUCKETS     (uint8_t)16
+#endif
+
+/**
+ * Longest line of a report including the line ending
+ */
+#define METRICS_LINE_LENGTH           (uint8_t)200
+
+/**
+ * Types of metrics
+ */
+#define METRICS_TYPE_COUNTER          (uint8_t)0   /*!< Increasing count, reported with its rate per second */
+#define METRICS_TYPE_GAUGE            (uint8_t)1   /*!< Current value returned by a function */
+#define METRICS_TYPE_HISTOGRAM        (uint8_t)2   /*!< Distribution of durations [cycles] */
+
+/**
+ * \brief Takes the start time of a span if latency probes are enabled
+ *
+ * Declares the local variable start.
+ * @param[in] start Name of the variable
+ */
+#if (METRICS_ENABLE)
+#define METRICS_SPAN_START(start)     uint64_t start = Platform_timeCycles()
+#else
+#define METRICS_SPAN_START(start)
+#endif
+
+/**
+ * \brief Records the duration of a span started by #METRICS_SPAN_START
+ *
+ * @param[in] histogram Histogram the duration is added to
+ * @param[in] start Variable given to #METRICS_SPAN_START
+ */
+#if (METRICS_ENABLE)
+#define METRICS_SPAN(histogram, start) Metrics_record((histogram), (uint32_t)(Platform_timeCycles() - (start)))
+#else
+#define METRICS_SPAN(histogram, start)
+#endif
+
+/* ******************| Type definitions |****************************** */
+/**
+ * Function returning the current value of a gauge
+ */
+typedef uint32_t (*Metrics_Gauge_t)(void);
+
+/**
+ * Distribution of durations. All values are given in cycles, see
+ * #Platform_timeCycles.
+ */
+typedef struct
+{
+  uint32_t count;                                 /*!< Number of values */
+  uint32_t max;                                   /*!< Highest value */
+  uint64_t sum;                                   /*!< Sum of all values */
+  uint32_t bucket[METRICS_HISTOGRAM_BUCKETS];     /*!< Number of values per bucket, see #METRICS_HISTOGRAM_BUCKETS */
+} Metrics_Histogram_t;
+
+/**
+ * Entry of the registry
+ */
+typedef struct
+{
+  const char *name;                               /*!< Name used as key in reports */
+  uint8_t type;                                   /*!< One of METRICS_TYPE_... */
+  union
+  {
+    const uint32_t *counter;                      /*!< #METRICS_TYPE_COUNTER */
+    Metrics_Gauge_t gauge;                        /*!< #METRICS_TYPE_GAUGE */
+    const Metrics_Histogram_t *histogram;         /*!< #METRICS_TYPE_HISTOGRAM */
+  } metric;
+  uint32_t reported;                              /*!< Value of a counter in the previous report */
+} Metrics_Entry_t;
+
+/* ******************| External function declarations |**************** */
+extern void Metrics_init(void);
+extern uint8_t Metrics_addCounter(const char *name, const uint32_t *counter);
+extern uint8_t Metrics_addGauge(const char *name, Metrics_Gauge_t gauge);
+extern uint8_t Metrics_addHistogram(const char *name, const Metrics_Histogram_t *histogram);
+extern void Metrics_report(void);
+
+/* ******************| External constants |**************************** */
+
+/* ******************| External variables |**************************** */
+extern Metrics_Entry_t Metrics_registry[METRICS_MAX_METRICS];
+extern uint8_t Metrics_numMetrics;
+
+/* ******************| Inline functions |****************************** */
+/**
+ * \brief Adds one value to a histogram
+ *
+ * Only one context may record to a histogram. Each field is stored
+ * atomically, the count last. A report running concurrently may thus
+ * miss the latest value in some fields but never sees a torn one.
+ * Use #METRICS_SPAN for durations instead of calling this function
+ * directly.
+ * @param[in] histogram Histogram
+ * @param[in] value Value [cycles]
+ */
+static inline void Metrics_record(Metrics_Histogram_t *histogram, uint32_t value)
+{
+  uint8_t bucket = (value == 0) ? 0 : (uint8_t)(32 - __builtin_clz(value));
+
+  if (bucket >= METRICS_HISTOGRAM_BUCKETS)
+    {
+      bucket = METRICS_HISTOGRAM_BUCKETS - 1;
+    }
+  __atomic_store_n(&histogram->bucket[bucket], histogram->bucket[bucket] + 1, __ATOMIC_RELAXED);
+  __atomic_store_n(&histogram->sum, histogram->sum + value, __ATOMIC_RELAXED);
+  if (value > histogram->max)
+    {
+      __atomic_store_n(&histogram->max, value, __ATOMIC_RELAXED);
+    }
+  __atomic_store_n(&histogram->count, histogram->count + 1, __ATOMIC_RELEASE);
+}
+
+/** @} doxygen end group definition */
+#endif /* if !defined( METRICS_INCLUDE_METRICS_H_ ) */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,281 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * \brief Metrics source file
+ *
+ * GNU coding standard (https://www.gnu.org/prep/standards/) shall be
+ * followed beside the snake_case_thing. Please use camelCase instead.
+ *
+ * The registry only holds the address of each metric. Counters and
+ * histograms stay in the module which updates them, thus, hot paths
+ * don't call into this module at all.
+ * A report consists of one key=value line per value. Keys are the names
+ * given during registration, extended by the part of a histogram or by
+ * .rate for the rate of a counter.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+/** \addtogroup Metrics
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "metrics.h"
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+void Metrics_init(void);
+uint8_t Metrics_addCounter(const char *name, const uint32_t *counter);
+uint8_t Metrics_addGauge(const char *name, Metrics_Gauge_t gauge);
+uint8_t Metrics_addHistogram(const char *name, const Metrics_Histogram_t *histogram);
+void Metrics_report(void);
+static Metrics_Entry_t *Metrics_add(const char *name, uint8_t type);
+static void Metrics_write(const char *format, ...) __attribute__((format(printf, 1, 2)));
+static void Metrics_reportHistogram(const char *name, const Metrics_Histogram_t *histogram);
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Registered metrics in order of registration
+ */
+Metrics_Entry_t Metrics_registry[METRICS_MAX_METRICS];
+
+/**
+ * Number of valid entries in #Metrics_registry
+ */
+uint8_t Metrics_numMetrics = 0;
+
+/**
+ * #Platform_timeMicros and #Platform_timeCycles during #Metrics_init
+ */
+static uint64_t Metrics_startMicros;
+static uint64_t Metrics_startCycles;
+
+/**
+ * #Platform_timeMicros during the previous report or #Metrics_init. Rates
+ * of counters are given for the time since.
+ */
+static uint64_t Metrics_reportMicros;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Initializes Metrics module
+ *
+ * Empties the registry and starts the uptime.
+ */
+void Metrics_init(void)
+{
+  memset(Metrics_registry, 0, sizeof(Metrics_registry));
+  Metrics_numMetrics = 0;
+  Metrics_startMicros = Platform_timeMicros();
+  Metrics_startCycles = Platform_timeCycles();
+  Metrics_reportMicros = Metrics_startMicros;
+}
+
+/**
+ * \brief Adds a counter to the registry
+ *
+ * @param[in] name Key in reports, must stay valid
+ * @param[in] counter Counter, written by one context only
+ * @return RESULT_OK if added, RESULT_NOT_OK if the registry is full
+ */
+uint8_t Metrics_addCounter(const char *name, const uint32_t *counter)
+{
+  Metrics_Entry_t *entry = Metrics_add(name, METRICS_TYPE_COUNTER);
+
+  if (entry == NULL)
+    {
+      return RESULT_NOT_OK;
+    }
+  entry->metric.counter = counter;
+  entry->reported = *counter;
+  return RESULT_OK;
+}
+
+/**
+ * \brief Adds a gauge to the registry
+ *
+ * @param[in] name Key in reports, must stay valid
+ * @param[in] gauge Function returning the current value. Called by
+ * #Metrics_report.
+ * @return RESULT_OK if added, RESULT_NOT_OK if the registry is full
+ */
+uint8_t Metrics_addGauge(const char *name, Metrics_Gauge_t gauge)
+{
+  Metrics_Entry_t *entry = Metrics_add(name, METRICS_TYPE_GAUGE);
+
+  if (entry == NULL)
+    {
+      return RESULT_NOT_OK;
+    }
+  entry->metric.gauge = gauge;
+  return RESULT_OK;
+}
+
+/**
+ * \brief Adds a histogram to the registry
+ *
+ * @param[in] name Key in reports, must stay valid
+ * @param[in] histogram Histogram, written by one context only with
+ * #Metrics_record
+ * @return RESULT_OK if added, RESULT_NOT_OK if the registry is full
+ */
+uint8_t Metrics_addHistogram(const char *name, const Metrics_Histogram_t *histogram)
+{
+  Metrics_Entry_t *entry = Metrics_add(name, METRICS_TYPE_HISTOGRAM);
+
+  if (entry == NULL)
+    {
+      return RESULT_NOT_OK;
+    }
+  entry->metric.histogram = histogram;
+  return RESULT_OK;
+}
+
+/**
+ * \brief Writes all metrics to the serial line
+ *
+ * Starts with the time since #Metrics_init and the cycles per µs
+ * measured over this time, which convert histograms to time. Afterwards
+ * each metric follows in order of registration:
+ * - Counter: name=value and name.rate=increase per second since the
+ *   previous report
+ * - Gauge: name=value
+ * - Histogram: name.count, name.avg, name.max [cycles] and name.buckets
+ *   with the counts of all buckets separated by comma
+ */
+void Metrics_report(void)
+{
+  uint64_t micros = Platform_timeMicros();
+  uint64_t cycles = Platform_timeCycles();
+  uint64_t uptime = micros - Metrics_startMicros;
+  uint64_t interval = micros - Metrics_reportMicros;
+  uint64_t millicyclesPerMicro = (uptime > 0) ? (cycles - Metrics_startCycles) * 1000 / uptime : 0;
+  uint32_t value;
+
+  Metrics_write("metrics.uptime_us=%llu\n", (unsigned long long)uptime);
+  Metrics_write("metrics.cycles_per_us=%llu.%03u\n", (unsigned long long)(millicyclesPerMicro / 1000),
+                (unsigned int)(millicyclesPerMicro % 1000));
+  for (uint8_t i=0; i<Metrics_numMetrics; i++)
+    {
+      Metrics_Entry_t *entry = &Metrics_registry[i];
+
+      switch (entry->type)
+        {
+        case METRICS_TYPE_COUNTER:
+          value = __atomic_load_n(entry->metric.counter, __ATOMIC_RELAXED);
+          Metrics_write("%s=%u\n", entry->name, value);
+          Metrics_write("%s.rate=%llu\n", entry->name,
+                        (unsigned long long)((interval > 0) ? (uint64_t)(value - entry->reported) * 1000000 / interval : 0));
+          entry->reported = value;
+          break;
+        case METRICS_TYPE_GAUGE:
+          Metrics_write("%s=%u\n", entry->name, entry->metric.gauge());
+          break;
+        case METRICS_TYPE_HISTOGRAM:
+          Metrics_reportHistogram(entry->name, entry->metric.histogram);
+          break;
+        default:
+          break;
+        }
+    }
+  Metrics_reportMicros = micros;
+}
+
+/**
+ * \brief Reserves the next entry of the registry
+ *
+ * @param[in] name Key in reports
+ * @param[in] type One of METRICS_TYPE_...
+ * @return Entry or NULL if the registry is full
+ */
+static Metrics_Entry_t *Metrics_add(const char *name, uint8_t type)
+{
+  Metrics_Entry_t *entry;
+
+  if (Metrics_numMetrics >= METRICS_MAX_METRICS)
+    {
+      return NULL;
+    }
+  entry = &Metrics_registry[Metrics_numMetrics++];
+  entry->name = name;
+  entry->type = type;
+  return entry;
+}
+
+/**
+ * \brief Writes one formatted line to the serial line
+ *
+ * Lines longer than #METRICS_LINE_LENGTH are truncated.
+ * @param[in] format Format as for printf
+ */
+static void Metrics_write(const char *format, ...)
+{
+  char line[METRICS_LINE_LENGTH];
+  va_list arguments;
+  int length;
+
+  va_start(arguments, format);
+  length = vsnprintf(line, sizeof(line), format, arguments);
+  va_end(arguments);
+  if (length > 0)
+    {
+      Platform_serialWrite((const uint8_t *)line, (uint8_t)min(length, (int)sizeof(line) - 1));
+    }
+}
+
+/**
+ * \brief Writes the lines of one histogram
+ *
+ * The count is read first. Values recorded meanwhile may already be part
+ * of sum, maximum or buckets, thus, these may be slightly ahead of it.
+ * @param[in] name Key of the histogram
+ * @param[in] histogram Histogram
+ */
+static void Metrics_reportHistogram(const char *name, const Metrics_Histogram_t *histogram)
+{
+  char buckets[METRICS_LINE_LENGTH];
+  uint32_t count = __atomic_load_n(&histogram->count, __ATOMIC_ACQUIRE);
+  uint64_t sum = __atomic_load_n(&histogram->sum, __ATOMIC_RELAXED);
+  int length = 0;
+
+  Metrics_write("%s.count=%u\n", name, count);
+  Metrics_write("%s.avg=%llu\n", name, (unsigned long long)((count > 0) ? sum / count : 0));
+  Metrics_write("%s.max=%u\n", name, __atomic_load_n(&histogram->max, __ATOMIC_RELAXED));
+  for (uint8_t i=0; (i<METRICS_HISTOGRAM_BUCKETS) && (length < (int)sizeof(buckets)); i++)
+    {
+      length += snprintf(&buckets[length], sizeof(buckets) - length, (i == 0) ? "%u" : ",%u",
+                         __atomic_load_n(&histogram->bucket[i], __ATOMIC_RELAXED));
+    }
+  Metrics_write("%s.buckets=%s\n", name, buckets);
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
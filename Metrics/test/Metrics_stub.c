@@ -0,0 +1,83 @@
+/**
+ * \file Metrics_stub.c
+ *
+ * \brief Stubs for Metrics unit tests
+ *
+ * All stubs needed for the unit test of this particular modules shall
+ * be done within this file.
+ * Both clocks of the platform are replaced by variables set by the
+ * tests, the serial line by a buffer collecting all data written.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup Metrics
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <string.h>
+#include "Metrics_test.h"
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+uint64_t Platform_timeCycles(void);
+uint64_t Platform_timeMicros(void);
+void Platform_serialWrite(const uint8_t *data, uint8_t length);
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Virtual cycle counter
+ */
+uint64_t MetricsTest_cycles;
+
+/**
+ * Virtual time [µs]
+ */
+uint64_t MetricsTest_micros;
+
+/**
+ * All data written to serial line, null terminated
+ */
+char MetricsTest_output[2048];
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Virtual replacement of Platform_timeCycles()
+ *
+ * @return #MetricsTest_cycles
+ */
+uint64_t Platform_timeCycles(void)
+{
+  return MetricsTest_cycles;
+}
+
+/**
+ * \brief Virtual replacement of Platform_timeMicros()
+ *
+ * @return #MetricsTest_micros
+ */
+uint64_t Platform_timeMicros(void)
+{
+  return MetricsTest_micros;
+}
+
+/**
+ * \brief Appends data written to serial line to #MetricsTest_output
+ *
+ * @param[in] data Data to be written
+ * @param[in] length Number of bytes in #data
+ */
+void Platform_serialWrite(const uint8_t *data, uint8_t length)
+{
+  strncat(MetricsTest_output, (const char *)data, min((size_t)length, sizeof(MetricsTest_output) - strlen(MetricsTest_output) - 1));
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,168 @@
+/**
+ * \file Metrics_test.c
+ *
+ * \brief Metrics unit test implementation
+ *
+ * Please see http://embunit.sourceforge.net/ for more information. For
+ * detailed documentation see http://embunit.sourceforge.net/embunit/index.html
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup Metrics
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include "Metrics_test.h"
+/* Include .cpp file to be tested in order to get access to all private
+ * or static functions */
+#include "../src/metrics.cpp"
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+static uint32_t MetricsTest_gauge(void);
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Counter registered by the tests
+ */
+static uint32_t MetricsTest_counter;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Gauge registered by the tests
+ *
+ * @return Constant 7
+ */
+static uint32_t MetricsTest_gauge(void)
+{
+  return 7;
+}
+
+/**
+ * Record to histogram
+ * Test if values are sorted into buckets by their number of bits
+ * Test if values too big for the last bucket are counted there
+ * Test count, sum and maximum
+ */
+static void Metrics_Metrics_record_1(void)
+{
+  Metrics_Histogram_t histogram = {};
+  const uint32_t values[] = {0, 1, 2, 3, 4, 1000, 0x10000000};
+
+  for (uint8_t i=0; i<sizeof(values)/sizeof(values[0]); i++)
+    {
+      Metrics_record(&histogram, values[i]);
+    }
+  TEST_ASSERT_EQUAL_INT(7, histogram.count);
+  TEST_ASSERT_EQUAL_INT(0x10000000 + 1010, histogram.sum);
+  TEST_ASSERT_EQUAL_INT(0x10000000, histogram.max);
+  TEST_ASSERT_EQUAL_INT(1, histogram.bucket[0]);
+  TEST_ASSERT_EQUAL_INT(1, histogram.bucket[1]);
+  TEST_ASSERT_EQUAL_INT(2, histogram.bucket[2]);
+  TEST_ASSERT_EQUAL_INT(1, histogram.bucket[3]);
+  TEST_ASSERT_EQUAL_INT(1, histogram.bucket[10]);
+  TEST_ASSERT_EQUAL_INT(1, histogram.bucket[METRICS_HISTOGRAM_BUCKETS - 1]);
+}
+
+/**
+ * Report all types of metrics
+ * Test if every metric is reported as key=value lines in order of
+ * registration
+ * Test if the rate of a counter refers to the time since the previous
+ * report
+ */
+static void Metrics_Metrics_report_1(void)
+{
+  Metrics_Histogram_t histogram = {};
+
+  Metrics_addCounter("counter", &MetricsTest_counter);
+  Metrics_addGauge("gauge", MetricsTest_gauge);
+  Metrics_addHistogram("histogram", &histogram);
+  Metrics_record(&histogram, 100);
+  Metrics_record(&histogram, 300);
+
+  MetricsTest_counter = 50;
+  MetricsTest_micros += 500000;
+  MetricsTest_cycles += 1000000;
+  Metrics_report();
+  TEST_ASSERT_EQUAL_STRING("metrics.uptime_us=500000\n"
+                           "metrics.cycles_per_us=2.000\n"
+                           "counter=50\n"
+                           "counter.rate=100\n"
+                           "gauge=7\n"
+                           "histogram.count=2\n"
+                           "histogram.avg=200\n"
+                           "histogram.max=300\n"
+                           "histogram.buckets=0,0,0,0,0,0,0,1,0,1,0,0,0,0,0,0\n", MetricsTest_output);
+
+  MetricsTest_output[0] = '\0';
+  MetricsTest_counter = 60;
+  MetricsTest_micros += 2000000;
+  Metrics_report();
+  TEST_ASSERT(strstr(MetricsTest_output, "counter=60\ncounter.rate=5\n") != NULL);
+}
+
+/**
+ * Registry full
+ * Test if metrics beyond METRICS_MAX_METRICS are refused
+ */
+static void Metrics_Metrics_add_1(void)
+{
+  for (uint8_t i=0; i<METRICS_MAX_METRICS; i++)
+    {
+      TEST_ASSERT_EQUAL_INT(RESULT_OK, Metrics_addGauge("gauge", MetricsTest_gauge));
+    }
+  TEST_ASSERT_EQUAL_INT(RESULT_NOT_OK, Metrics_addCounter("counter", &MetricsTest_counter));
+  TEST_ASSERT_EQUAL_INT(METRICS_MAX_METRICS, Metrics_numMetrics);
+}
+
+/**
+ * Test Setup function which is called before all each test case
+ */
+static void setUpMetrics(void)
+{
+  MetricsTest_cycles = 1000;
+  MetricsTest_micros = 100;
+  MetricsTest_counter = 0;
+  MetricsTest_output[0] = '\0';
+  Metrics_init();
+}
+
+/**
+ * Test Teardown function which is called for after each test
+ */
+static void tearDownMetrics(void)
+{
+}
+
+TestRef Metrics_test_RunTests(void)
+{
+  EMB_UNIT_TESTFIXTURES(fixtures) {
+    new_TestFixture("Test case Metrics_Metrics_record_1", Metrics_Metrics_record_1),
+    new_TestFixture("Test case Metrics_Metrics_report_1", Metrics_Metrics_report_1),
+    new_TestFixture("Test case Metrics_Metrics_add_1", Metrics_Metrics_add_1)
+  };
+  EMB_UNIT_TESTCALLER(Metrics_tests,"Metrics Unit test",setUpMetrics,tearDownMetrics,fixtures);
+  return (TestRef)&Metrics_tests;
+}
+
+/**
+ *
+ */
+int main(void)
+{
+  TestRunner_start();
+  TestRunner_runTest(Metrics_test_RunTests());
+  TestRunner_end();
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,39 @@
+#if (!defined METRICS_TEST_H_)
+/* Preprocessor exclusion definition */
+#define METRICS_TEST_H_
+/**
+ * \file Metrics_test.h
+ *
+ * \brief Metrics include file for test driver
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup Metrics
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <embUnit/embUnit.h>
+#include <platform.h>
+#include <metrics.h>
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type definitions |****************************** */
+
+/* ******************| External function declarations |**************** */
+
+/* ******************| External constants |**************************** */
+
+/* ******************| External variables |**************************** */
+extern uint64_t MetricsTest_cycles;
+extern uint64_t MetricsTest_micros;
+extern char MetricsTest_output[];
+
+/** @} doxygen end group definition */
+#endif /* if !defined( METRICS_TEST_H_ ) */
+/* ******************| End of file |*********************************** */
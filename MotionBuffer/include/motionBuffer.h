@@ -35,6 +35,8 @@
  */
 
 /* ******************| Inclusions |************************************ */
+#include <blueMarlin.h>
+#include <ringBuffer.h>
 
 /* ******************| Macros |**************************************** */
 /**
@@ -47,6 +49,18 @@
 #define MOTIONBUFFER_MOTIONBUFFER_SIZE        (uint8_t)32
 #endif
 
+/**
+ * Maximum execution time of all blocks in #motionbuffer in µs. No new
+ * blocks are accepted if the buffer holds more. This limits the time until
+ * e.g. a pause or a feedrate change becomes effective.
+ * Its possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DMOTIONBUFFER_MAXIMUM_QUEUED_TIME 1000000
+ */
+#ifndef MOTIONBUFFER_MAXIMUM_QUEUED_TIME
+#define MOTIONBUFFER_MAXIMUM_QUEUED_TIME      (uint32_t)1000000
+#endif
+
 
 /* ******************| Type definitions |****************************** */
 
@@ -67,27 +81,58 @@ typedef struct
   StepperCoordinates_t steps;           /*!< Number of absolute steps for this move along each axis and for each extruder */
   StepperCoordinate_t stepEventCount;   /*!< Maximum number of step events required to complete this block */
 
-  StepperCoordinate_t initialRate;      /*!< */
-  StepperCoordinate_t accelerateUntil;  /*!< */
-  StepperCoordinate_t accelerationRate; /*!< */
+  /* Values used for the trapezoidal rate changes. Produced by #MotionPlanner,
+   * consumed by #Stepper */
+  StepperCoordinate_t initialRate;      /*!< Step rate at the start of the block in steps/sec */
+  StepperCoordinate_t accelerateUntil;  /*!< Number of step events after which acceleration stops */
+  StepperCoordinate_t accelerationRate; /*!< Acceleration and deceleration in steps/sec^2 */
 
-  StepperCoordinate_t develerateAfter;  /*!< */
-  StepperCoordinate_t finalRate;        /*!< */
+  StepperCoordinate_t decelerateAfter;  /*!< Number of step events after which deceleration starts */
+  StepperCoordinate_t finalRate;        /*!< Step rate at the end of the block in steps/sec */
 
 
   StepperCoordinate_t nominalRate;      /*!< Nominal speed for this block, that is #stepEvenCount/time, in steps/sec */
   StepperCoordinate_t maxEntrySpeed;    /*!< Maximum allowable junction entry speed based on speed in steps/sec */
   StepperCoordinate_t entrySpeed;       /*!< Entry speed at previous-current block junction in steps/sec */
+  uint32_t duration;                    /*!< Execution time of this block in µs */
 
   /* Values used for internal calculation */
 } MotionBlock_t;
 
 /* ******************| External function declarations |**************** */
+extern uint8_t MotionBuffer_write(const MotionBlock_t &block);
+extern uint8_t MotionBuffer_read(MotionBlock_t *block);
 
 /* ******************| External constants |**************************** */
 
 /* ******************| External variables |**************************** */
 extern RingBuffer<MotionBlock_t, MOTIONBUFFER_MOTIONBUFFER_SIZE> motionBuffer;
+extern uint32_t MotionBuffer_writtenTime;
+extern uint32_t MotionBuffer_readTime;
+
+/**
+ * \brief Execution time of all blocks in #motionBuffer
+ *
+ * Both counters are free running. Thus, the difference is correct even
+ * after an overflow. Must be called by the producer of #motionBuffer.
+ * @return Queued execution time in µs
+ */
+inline uint32_t MotionBuffer_queuedTime()
+{
+  return MotionBuffer_writtenTime - __atomic_load_n(&MotionBuffer_readTime, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * \brief Checks if #motionBuffer can accept another block
+ *
+ * @return True if all entries are used or if the buffer holds more than
+ * #MOTIONBUFFER_MAXIMUM_QUEUED_TIME
+ */
+inline bool MotionBuffer_isFull()
+{
+  return (motionBuffer.available() >= MOTIONBUFFER_MOTIONBUFFER_SIZE) ||
+         (MotionBuffer_queuedTime() >= MOTIONBUFFER_MAXIMUM_QUEUED_TIME);
+}
 
 /** @} doxygen end group definition */
 #endif /* if !defined( MOTIONBUFFER_INCLUDE_MOTIONBUFFER_H_ ) */
@@ -40,11 +40,61 @@
 /* ******************| Type Definitions |****************************** */
 
 /* ******************| Function Prototypes |*************************** */
+uint8_t MotionBuffer_write(const MotionBlock_t &block);
+uint8_t MotionBuffer_read(MotionBlock_t *block);
 
 /* ******************| Global Variables |****************************** */
 RingBuffer<MotionBlock_t, MOTIONBUFFER_MOTIONBUFFER_SIZE> motionBuffer;
 
+/**
+ * Sum of the execution time of all blocks ever written to #motionBuffer [µs]
+ */
+uint32_t MotionBuffer_writtenTime = 0;
+
+/**
+ * Sum of the execution time of all blocks ever read from #motionBuffer [µs].
+ * Written by the consumer, e.g. the step timer interrupt, and read by the
+ * producer. Thus, it is only accessed atomically.
+ */
+uint32_t MotionBuffer_readTime = 0;
+
 /* ******************| Function Implementation |*********************** */
+/**
+ * \brief Writes one block to #motionBuffer
+ *
+ * Adds the execution time of the block to the queued time.
+ * @param[in] block Block to be added
+ * @return RESULT_OK if block was added, RESULT_NOT_OK if buffer is full
+ */
+uint8_t MotionBuffer_write(const MotionBlock_t &block)
+{
+  uint8_t retVal = motionBuffer.write(block);
+
+  if (retVal == RESULT_OK)
+    {
+      MotionBuffer_writtenTime += block.duration;
+    }
+  return retVal;
+}
+
+/**
+ * \brief Reads one block from #motionBuffer
+ *
+ * Removes the execution time of the block from the queued time. Thus, the
+ * block being executed is not counted anymore.
+ * @param[out] block Block read from buffer
+ * @return RESULT_OK if a block was read, RESULT_NOT_OK if buffer is empty
+ */
+uint8_t MotionBuffer_read(MotionBlock_t *block)
+{
+  uint8_t retVal = motionBuffer.read(block);
+
+  if (retVal == RESULT_OK)
+    {
+      __atomic_store_n(&MotionBuffer_readTime, MotionBuffer_readTime + block->duration, __ATOMIC_RELEASE);
+    }
+  return retVal;
+}
 
 /** @} doxygen end group definition */
 /* ******************| End of file |*********************************** */
@@ -39,15 +39,16 @@
  */
 
 /* ******************| Inclusions |************************************ */
-#include<BlueMarlin.h>
-#include<RingBuffer.h>
+#include <blueMarlin.h>
+#include <kinematic.h>
+#include <metrics.h>
 
 /* ******************| Macros |**************************************** */
 
 /**
  * Minimum number of steps for one movement. Everything with less than
- * this number of steps will be ignored as move and must be joined with
- * the next movement by the next upper layer.
+ * this number of steps will not be added as block but joined with the
+ * next movement.
  * It's possible to override default in the respective configuration file
  * or by specifying the value during compile time with
  * -DMOTIONPLANNER_MINIMUM_SEGMENT_SIZE 5
@@ -56,8 +57,230 @@
 #define MOTIONPLANNER_MINIMUM_SEGMENT_SIZE     (StepperCoordinate_t)5
 #endif
 
+/**
+ * Default number of segments per second of movement for non-linear
+ * kinematics. Only used if segmentChordalTolerance is zero.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DMOTIONPLANNER_SEGMENTS_PER_SECOND 200
+ */
+#ifndef MOTIONPLANNER_SEGMENTS_PER_SECOND
+#define MOTIONPLANNER_SEGMENTS_PER_SECOND       (uint16_t)200
+#endif
+
+/**
+ * Default maximum deviation in mm of the head from the ideal path for
+ * segmented moves of non-linear kinematics.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DMOTIONPLANNER_SEGMENT_CHORDAL_TOLERANCE 0.01
+ */
+#ifndef MOTIONPLANNER_SEGMENT_CHORDAL_TOLERANCE
+#define MOTIONPLANNER_SEGMENT_CHORDAL_TOLERANCE (WorldCoordinate_t)0.01
+#endif
+
+/**
+ * Number of parts a move of a non-linear kinematic is split into to
+ * estimate its path deviation. The more parts, the better the first
+ * estimate and the less corrections are needed for moves where the
+ * curvature of the kinematic changes a lot, e.g. long moves crossing the
+ * workspace of a delta machine.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DMOTIONPLANNER_SEGMENT_DEVIATION_SAMPLES 4
+ */
+#ifndef MOTIONPLANNER_SEGMENT_DEVIATION_SAMPLES
+#define MOTIONPLANNER_SEGMENT_DEVIATION_SAMPLES (uint8_t)4
+#endif
+
+/**
+ * Minimum cosine of the angle between a new move and the pending coalesced
+ * move. Moves with a bigger direction change are not merged. Default
+ * corresponds to approximately 0.8°.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DMOTIONPLANNER_COALESCE_COS_TOLERANCE 0.9999
+ */
+#ifndef MOTIONPLANNER_COALESCE_COS_TOLERANCE
+#define MOTIONPLANNER_COALESCE_COS_TOLERANCE    (WorldCoordinate_t)0.9999
+#endif
+
+/**
+ * Maximum relative difference of the extrusion ratio (E per mm of travel)
+ * between a new move and the pending coalesced move.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DMOTIONPLANNER_COALESCE_EXTRUSION_TOLERANCE 0.05
+ */
+#ifndef MOTIONPLANNER_COALESCE_EXTRUSION_TOLERANCE
+#define MOTIONPLANNER_COALESCE_EXTRUSION_TOLERANCE (WorldCoordinate_t)0.05
+#endif
+
+/**
+ * Maximum number of moves merged into one coalesced move. A value of one
+ * disables coalescing.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DMOTIONPLANNER_COALESCE_MAX_MOVES 16
+ */
+#ifndef MOTIONPLANNER_COALESCE_MAX_MOVES
+#define MOTIONPLANNER_COALESCE_MAX_MOVES        (uint8_t)16
+#endif
+
+/**
+ * Maximum travel time [s] of one coalesced move. Together with
+ * #MOTIONPLANNER_COALESCE_MAX_MOVES this limits the time a move is held
+ * back before it is handed to the motion buffer.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DMOTIONPLANNER_COALESCE_MAX_TIME 0.05
+ */
+#ifndef MOTIONPLANNER_COALESCE_MAX_TIME
+#define MOTIONPLANNER_COALESCE_MAX_TIME         (float)0.05
+#endif
+
+/**
+ * Minimum execution time of one block in µs while the motion buffer runs
+ * low, see #MOTIONPLANNER_SLOWDOWN_QUEUED_TIME.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DMOTIONPLANNER_MINIMUM_SEGMENT_TIME 20000
+ */
+#ifndef MOTIONPLANNER_MINIMUM_SEGMENT_TIME
+#define MOTIONPLANNER_MINIMUM_SEGMENT_TIME      (uint32_t)20000
+#endif
+
+/**
+ * Queued execution time in µs below which short blocks are slowed down
+ * to give the upper layers time to refill the motion buffer. The queued
+ * time rather than the number of blocks is used because the same number
+ * of blocks may hold a few milliseconds or several seconds of motion.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DMOTIONPLANNER_SLOWDOWN_QUEUED_TIME 20000
+ */
+#ifndef MOTIONPLANNER_SLOWDOWN_QUEUED_TIME
+#define MOTIONPLANNER_SLOWDOWN_QUEUED_TIME      (uint32_t)20000
+#endif
+
+/**
+ * Queued execution time in µs below which a move held back for coalescing
+ * is handed to the motion buffer although no other command follows yet.
+ * Above, the move waits for the next g-code to be merged with. Should be
+ * bigger than #MOTIONPLANNER_SLOWDOWN_QUEUED_TIME, otherwise the flushed
+ * move is slowed down.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DMOTIONPLANNER_COALESCE_FLUSH_QUEUED_TIME 50000
+ */
+#ifndef MOTIONPLANNER_COALESCE_FLUSH_QUEUED_TIME
+#define MOTIONPLANNER_COALESCE_FLUSH_QUEUED_TIME (uint32_t)50000
+#endif
+
+/**
+ * Maximum deviation in mm of the segments of an arc from the ideal arc.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DMOTIONPLANNER_ARC_CHORDAL_TOLERANCE 0.01
+ */
+#ifndef MOTIONPLANNER_ARC_CHORDAL_TOLERANCE
+#define MOTIONPLANNER_ARC_CHORDAL_TOLERANCE     (WorldCoordinate_t)0.01
+#endif
+
+/**
+ * Number of arc segments calculated with the incremental rotation before
+ * the position is corrected by an exact calculation using sin and cos.
+ * Higher values are faster but accumulate more rounding error.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DMOTIONPLANNER_ARC_CORRECTION 12
+ */
+#ifndef MOTIONPLANNER_ARC_CORRECTION
+#define MOTIONPLANNER_ARC_CORRECTION            (uint8_t)12
+#endif
+
+/**
+ * Radius in mm an arc given by radius (G2/G3 R) may be shorter than half the
+ * distance from start to target. Such an arc is taken as half circle.
+ * Covers the rounding of the radius by slicers and of float coordinates.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DMOTIONPLANNER_ARC_RADIUS_TOLERANCE 0.001
+ */
+#ifndef MOTIONPLANNER_ARC_RADIUS_TOLERANCE
+#define MOTIONPLANNER_ARC_RADIUS_TOLERANCE      (WorldCoordinate_t)0.001
+#endif
+
+/**
+ * Returned by #MotionPlanner::addArcMovementRadius if no arc with the given
+ * radius connects start and target position. In contrast to RESULT_NOT_OK
+ * retrying won't help.
+ */
+#define MOTIONPLANNER_RESULT_INVALID_ARC        (uint8_t)2
+
+/**
+ * Returned by the movement functions of #MotionPlanner if the kinematic
+ * can't reach the target, see #Kinematic_t isReachable. Like
+ * #MOTIONPLANNER_RESULT_INVALID_ARC retrying won't help.
+ */
+#define MOTIONPLANNER_RESULT_UNREACHABLE        (uint8_t)3
+
 /* ******************| Type definitions |****************************** */
 
+/**
+ * Coalesced move which was not yet handed over to the motion buffer. The
+ * move always starts at the current world position of the planner.
+ */
+typedef struct
+{
+  WorldCoordinates_t targetPositionW;  /*!< Absolute target position in world coordinates [mm] */
+  WorldCoordinates_t directionW;       /*!< Unit vector from start to target position, extruder coordinate is E per mm of travel */
+  WorldCoordinate_t lengthW;           /*!< Travel length of all merged moves [mm] */
+  WorldCoordinate_t feedrateW;         /*!< Feedrate of all merged moves [mm/s] */
+  uint8_t moves;                       /*!< Number of merged moves, zero if no move is pending */
+} MotionPlanner_PendingMove_t;
+
+/**
+ * State of the segment generation of one line movement. Segments are
+ * transformed in batches and added to the motion buffer as long as there
+ * is space. The generation continues with the next call of
+ * MotionPlanner::run.
+ */
+typedef struct
+{
+  WorldCoordinates_t targetPositionW;  /*!< Absolute target position of the move in world coordinates [mm] */
+  WorldCoordinates_t segmentMoveW;     /*!< Move of one segment in world coordinates [mm] */
+  float segmentTravelTime;             /*!< Travel time of one segment [s] */
+  int segments;                        /*!< Number of segments not yet transformed into axis coordinates */
+  KinematicBatchA_t batchA;            /*!< Transformed positions of the current batch in axis coordinates */
+  uint8_t batchCount;                  /*!< Number of positions in batchA */
+  uint8_t batchIndex;                  /*!< Next position in batchA to be added to the motion buffer */
+} MotionPlanner_LineGenerator_t;
+
+/**
+ * State of the segment generation of one arc movement. Each segment is
+ * handed to the line segment generation as soon as the previous one is
+ * finished.
+ */
+typedef struct
+{
+  WorldCoordinates_t startPositionW;   /*!< Absolute start position of the arc in world coordinates [mm] */
+  WorldCoordinates_t targetPositionW;  /*!< Absolute target position of the arc in world coordinates [mm] */
+  WorldCoordinate_t centerX;           /*!< Center of the arc in X [mm] */
+  WorldCoordinate_t centerY;           /*!< Center of the arc in Y [mm] */
+  WorldCoordinate_t offsetI;           /*!< Offset of the center from the start position in X [mm] */
+  WorldCoordinate_t offsetJ;           /*!< Offset of the center from the start position in Y [mm] */
+  WorldCoordinate_t radiusX;           /*!< Vector from the center to the last segment end in X [mm] */
+  WorldCoordinate_t radiusY;           /*!< Vector from the center to the last segment end in Y [mm] */
+  float theta;                         /*!< Angle of one segment [rad] */
+  float cosTheta;                      /*!< Cosine of theta */
+  float sinTheta;                      /*!< Sine of theta */
+  WorldCoordinate_t feedrateW;         /*!< Feedrate of the arc [mm/s] */
+  int segment;                         /*!< Index of the last started segment */
+  int segments;                        /*!< Number of segments of the arc */
+  uint8_t correctionCount;             /*!< Segments since the last exact calculation */
+} MotionPlanner_ArcGenerator_t;
+
 class MotionPlanner
 {
 private:
@@ -78,14 +301,78 @@ private:
    */
   AxisCoordinates_t axisPosition;
 
+  /**
+   * Travel time [s] of segments which were too small to be added to the
+   * motion buffer. Their steps are still missing in #axisPosition and will
+   * be part of the next block. Thus, the travel time must be added to the
+   * next block, too.
+   */
+  float pendingTravelTime = 0.0;
+
+  /**
+   * Move which is held back by #queueLineMovement to be merged with the
+   * following moves.
+   */
+  MotionPlanner_PendingMove_t pendingMove = {};
+
+  /**
+   * Number of blocks which were slowed down because the motion buffer ran
+   * low
+   */
+  uint32_t slowdowns = 0;
+
+  /**
+   * Number of blocks added to the motion buffer
+   */
+  uint32_t blocks = 0;
+
+  /**
+   * Duration of #run per block added, for calls which added any
+   */
+  Metrics_Histogram_t blockCycles = {};
+
+  /**
+   * Segment generation of the current line movement
+   */
+  MotionPlanner_LineGenerator_t lineGenerator = {};
+
+  /**
+   * Segment generation of the current arc movement
+   */
+  MotionPlanner_ArcGenerator_t arcGenerator = {};
+
   /**
    * Currently active extruder
    * @TODO Decide if to move to machine module
    */
   uint8_t activeExtruder = 0;
 
+  /**
+   * Version of #derivedParameter #axisPosition was calculated with
+   */
+  uint8_t parameterVersion = 0;
+
+  int calculateSegments(const WorldCoordinates_t &moveW, float totalTravelTime);
+  uint8_t addSegment(const AxisCoordinates_t &segmentStepsA, float segmentTravelTime, bool lastSegment);
+  const WorldCoordinates_t &plannedPosition() const;
+  void startLineMovement(const WorldCoordinates_t &targetPositionW, WorldCoordinate_t feedrateW);
+  uint8_t runLineMovement();
+  void nextArcSegment();
+
 public:
-  bool addLineMovement(WorldCoordinates_t deltaMove, WorldCoordinate_t feedrate);
+  void init();
+  void run();
+  bool isReady() const;
+  uint8_t addLineMovement(WorldCoordinates_t targetPositionW, WorldCoordinate_t feedrateW);
+  uint8_t queueLineMovement(WorldCoordinates_t targetPositionW, WorldCoordinate_t feedrateW);
+  bool flushLineMovement();
+  uint8_t addArcMovement(WorldCoordinates_t targetPositionW, WorldCoordinate_t offsetI, WorldCoordinate_t offsetJ, bool clockwise, WorldCoordinate_t feedrateW);
+  uint8_t addArcMovementRadius(WorldCoordinates_t targetPositionW, WorldCoordinate_t radius, bool clockwise, WorldCoordinate_t feedrateW);
+  void refreshPosition();
+  const uint32_t &getSlowdowns() const { return slowdowns; }
+  const uint32_t &getBlocks() const { return blocks; }
+  const Metrics_Histogram_t &getBlockCycles() const { return blockCycles; }
+  bool hasPendingMove() const { return pendingMove.moves > 0; }
 
 };
 
@@ -94,6 +381,7 @@ public:
 /* ******************| External constants |**************************** */
 
 /* ******************| External variables |**************************** */
+extern MotionPlanner motionPlanner;
 
 /** @} doxygen end group definition */
 #endif /* if !defined( MOTIONPLANNER_INCLUDE_MOTIONPLANNER_H_ ) */
@@ -20,7 +20,7 @@
  *
  */
 /**
- * /** \addtogroup MotionPlanner
+ * \addtogroup MotionPlanner
  * @{
  *
  * \brief MotionPlanner source file
@@ -94,20 +94,77 @@
  */
 
 /* ******************| Inclusions |************************************ */
-#include "MotionPlanner.h"
+#include "motionPlanner.h"
 #include <platform.h>
+#include <parameter.h>
+#include <kinematic.h>
 #include <motionBuffer.h>
-#include <stdlib.h>
+#include <trace.h>
 
 /* ******************| Macros |**************************************** */
+/**
+ * Angular travel [rad] below which start and target of an arc are treated
+ * as identical, that is, the arc is a full circle.
+ */
+#define MOTIONPLANNER_ARC_ANGULAR_TRAVEL_EPSILON  (float)5E-7
 
 /* ******************| Type Definitions |****************************** */
 
 /* ******************| Function Prototypes |*************************** */
 
 /* ******************| Global Variables |****************************** */
+MotionPlanner motionPlanner;
 
 /* ******************| Function Implementation |*********************** */
+/**
+ * \brief Initializes MotionPlanner
+ *
+ * Sets all motion planner related parameter to their default values.
+ */
+void MotionPlanner::init()
+{
+  parameter.segmentsPerSecond = MOTIONPLANNER_SEGMENTS_PER_SECOND;
+  parameter.segmentChordalTolerance = MOTIONPLANNER_SEGMENT_CHORDAL_TOLERANCE;
+}
+
+/**
+ * \brief Calculates the number of segments for one move
+ *
+ * Linear kinematics map a line in world coordinates onto a line in axis
+ * coordinates. Splitting the move would not add any accuracy but only flood
+ * the motion buffer. Thus, moves for linear kinematics are never split.
+ * For non-linear kinematics the number of segments is chosen such that the
+ * path deviation of each segment stays below segmentChordalTolerance, see
+ * Kinematic_chords(). Thus, slow moves are not split more than needed and
+ * moves near the edge of the workspace, where the kinematic is strongly
+ * curved, get more segments.
+ * If segmentChordalTolerance is zero, a fixed number of segments per second
+ * (segmentsPerSecond) is used instead.
+ * @param[in] moveW Complete move in world coordinates [mm] starting at
+ * #worldPosition
+ * @param[in] totalTravelTime Travel time for the complete move [s]
+ * @return Number of segments for this move, at least one.
+ */
+int MotionPlanner::calculateSegments(const WorldCoordinates_t &moveW, float totalTravelTime)
+{
+  int segments = 1;
+
+  if (!Kinematic_t::isLinear)
+    {
+      if (parameter.segmentChordalTolerance > 0.0)
+        {
+          segments = Kinematic_chords(kinematic, worldPosition, moveW, derivedParameter.segmentChordalToleranceInverse,
+                                      MOTIONPLANNER_SEGMENT_DEVIATION_SAMPLES);
+        }
+      else
+        {
+          segments = (int)(parameter.segmentsPerSecond * totalTravelTime);
+        }
+      segments = max(1, segments);
+    }
+  return segments;
+}
+
 /**
  * \brief Add a new movement to the motion planner
  * Adds a new movement to the head of the motion planner buffer to be
@@ -118,167 +175,655 @@
  * * Feedrate was limited to maximum feedrate
  * * Coordinates are corrected by bed leveling etc. matrix
  *
- * For nonlinear kinematics the move will be split into segments. It is
- * assumed that even nonlinear kinematics are smooth functions and therefore
- * no jerk control is applied on the segments.
+ * For nonlinear kinematics the move will be split into segments (see
+ * #calculateSegments). It is assumed that even nonlinear kinematics are
+ * smooth functions and therefore no jerk control is applied on the segments.
+ * Moves for linear kinematics (see #Kinematic_t isLinear) are never split
+ * and result in exactly one block.
  *
  * Because this function shall be used for all kind of machines configurations
  * macros like X_AXIS shall not be used but instead #MACHINE_NUM_AXIS and
  * #MACHINE_NUM_EXTRUDER used instead.
- * This function is blocking if the buffer can't hold the new motion. If
- * the ringbuffer is full the function will will call Idle() until buffer is
- * free again.
- *
- * This function is split into the following parts.
- * 1. Calculate base values for this move: Length of move in world coordinates [mm]
- * number of segments and time for each segment [s]
- * 2. For all segments of this move: Calculate the necessary steps using inverse machine
- * kinematics
- * 3. Calculate and limit acceleration for this move
- * 4. Calculate and limit jerk, that is speed changes between to consecutive blocks, for this move
+ * This function is not blocking. The move is accepted only if the motion
+ * planner is ready, see #isReady. Segments are added to the motion buffer
+ * as long as there is space, the remaining segments are added by #run.
  * @param[in] targetPositionW Absolute target position of head in world coordinates
  * X_W [mm] and relative extruder coordinates E_W [mm].
  * @param[in] feedrateW Feedrate, that is speed, for this move in mm/s (f_W [mm/s])
- * @return TRUE
+ * @return RESULT_OK if the move was accepted, RESULT_NOT_OK if the motion
+ * planner is still busy with the previous move,
+ * #MOTIONPLANNER_RESULT_UNREACHABLE if the target can't be reached
  * @note Replaces function plan_buffer_line and prepare_move_delta
  */
-bool MotionPlanner::addLineMovement(WorldCoordinates_t targetPositionW, WorldCoordinate_t feedrateW)
+uint8_t MotionPlanner::addLineMovement(WorldCoordinates_t targetPositionW, WorldCoordinate_t feedrateW)
 {
-  bool retVal = RESULT_NOT_OK;
-  WorldCoordinates_t segmentMoveW;
-  AxisCoordinates_t stepsA, segmentStepsA;
-  MotionBlock_t motion;
+  TRACE_SPAN_START(start);
+
+  if (!kinematic.isReachable(targetPositionW))
+    {
+      return MOTIONPLANNER_RESULT_UNREACHABLE;
+    }
+  if (!isReady())
+    {
+      return RESULT_NOT_OK;
+    }
+  startLineMovement(targetPositionW, feedrateW);
+  run();
+  TRACE_SPAN(1, TRACE_EVENT_LINE, start);
+  return RESULT_OK;
+}
 
-  /* Step 1: Calculate base values for this move: Length of move in world coordinates [mm] number
-   * of segments and time for each segment [s] */
+/**
+ * \brief Checks if the motion planner can accept a new movement
+ *
+ * @return True if all segments of the previous line or arc movement were
+ * added to the motion buffer
+ */
+bool MotionPlanner::isReady() const
+{
+  return (lineGenerator.segments == 0) && (lineGenerator.batchIndex >= lineGenerator.batchCount) &&
+         (arcGenerator.segment >= arcGenerator.segments);
+}
+
+/**
+ * \brief Continues the segment generation of the current movement
+ *
+ * Adds segments of the current line or arc movement to the motion buffer
+ * until either the movement is finished or the motion buffer is full.
+ * Shall be called cyclically, e.g. from the main loop. Never blocks.
+ * The duration per block added is recorded in #blockCycles.
+ */
+void MotionPlanner::run()
+{
+#if (METRICS_ENABLE)
+  uint64_t start = Platform_timeCycles();
+  uint32_t blocksBefore = blocks;
+#endif
+
+  while ((runLineMovement() == RESULT_OK) && (arcGenerator.segment < arcGenerator.segments))
+    {
+      nextArcSegment();
+    }
+#if (METRICS_ENABLE)
+  if (blocks != blocksBefore)
+    {
+      Metrics_record(&blockCycles, (uint32_t)((Platform_timeCycles() - start) / (blocks - blocksBefore)));
+    }
+#endif
+}
+
+/**
+ * \brief Position after all accepted movements are finished
+ *
+ * @return Target of the pending coalesced move, of the current line
+ * movement or #worldPosition if the motion planner is idle
+ */
+const WorldCoordinates_t &MotionPlanner::plannedPosition() const
+{
+  if (pendingMove.moves > 0)
+    {
+      return pendingMove.targetPositionW;
+    }
+  if (!isReady())
+    {
+      return lineGenerator.targetPositionW;
+    }
+  return worldPosition;
+}
+
+/**
+ * \brief Prepares the segment generation for a new line movement
+ *
+ * Calculates base values for this move: Length of move in world coordinates
+ * [mm], number of segments and time for each segment [s]. The segments
+ * itself are generated by #runLineMovement.
+ * @param[in] targetPositionW Absolute target position of head in world coordinates
+ * X_W [mm] and relative extruder coordinates E_W [mm].
+ * @param[in] feedrateW Feedrate, that is speed, for this move in mm/s (f_W [mm/s])
+ */
+void MotionPlanner::startLineMovement(const WorldCoordinates_t &targetPositionW, WorldCoordinate_t feedrateW)
+{
+  WorldCoordinates_t moveW;
+
+  /* Parameter may only change between two moves */
+  if (parameterVersion != derivedParameter.version)
+    {
+      refreshPosition();
+    }
   /* First calculate the length for the complete move */
-  segmentMoveW.x = (targetPositionW.x - worldPosition.x);
-  segmentMoveW.y = (targetPositionW.y - worldPosition.y);
-  segmentMoveW.z = (targetPositionW.z - worldPosition.z);
-  segmentMoveW.e = (targetPositionW.e - worldPosition.e);
-  /* Calculate length, travel time and speed for for this move.
-   * Because this is a line movement in world coordinates, those values are constant during the move
-   * and therefore calculated only once */
-  WorldCoordinate_t totalTravelLengthW = sqrt(sq(segmentMoveW.x) + sq(segmentMoveW.y) + sq(segmentMoveW.z));
+  moveW.x = (targetPositionW.x - worldPosition.x);
+  moveW.y = (targetPositionW.y - worldPosition.y);
+  moveW.z = (targetPositionW.z - worldPosition.z);
+  moveW.e = (targetPositionW.e - worldPosition.e);
+  /* Calculate length and travel time for for this move. Because this is a line movement
+   * in world coordinates, those values are constant during the move and therefore calculated
+   * only once. Extruder only moves use the extruder length instead. */
+  WorldCoordinate_t totalTravelLengthW = sqrt(sq(moveW.x) + sq(moveW.y) + sq(moveW.z));
+  if (totalTravelLengthW == 0.0)
+    {
+      totalTravelLengthW = abs(moveW.e);
+    }
   float totalTravelTime = totalTravelLengthW / feedrateW;
-  float travelSpeedW = totalTravelLengthW / totalTravelTime;
 
-  int segments = max(1, parameter.segmentsPerSecond * totalTravelTime);
-  float segmentTravelTime = totalTravelTime / segments;
+  int segments = calculateSegments(moveW, totalTravelTime);
 
   /* All segments are of equal length. Therefore we calculate it once now that we know how many
    * segments we are going to do. */
-  segmentMoveW.x = segmentMoveW.x / segments;
-  segmentMoveW.y = segmentMoveW.y / segments;
-  segmentMoveW.z = segmentMoveW.z / segments;
-  segmentMoveW.e = segmentMoveW.e / segments;
-
-  /* Iterate over all segments of this move. Iterator starts from one for easier
-   * calculation later on.
-   */
-  for (int segment=1; segment <= segments; segment++)
-    {
-      /* Step 2. For all segments of this move: Calculate the necessary steps using inverse
-       *  machine kinematics */
-      /* We directly increment the position pretending that the move was already done */
-      worldPosition.x += segmentMoveW.x;
-      worldPosition.y += segmentMoveW.y;
-      worldPosition.z += segmentMoveW.z;
-      worldPosition.e += segmentMoveW.e;
-
-      /* Transform from world into axis coordinate systems */
-      kinematic.inverseMachineKinematic(worldPosition, &segmentStepsA, activeExtruder);
-
-      motion.stepEventCount = 0;
-      motion.steps.directionBits = STEPPER_DIRECTION_POSITIVE;
-
-      /* Calculate the delta steps. Extruder coordinates are always relative. Therefore
-       * no delta needs to be calculated */
+  float segmentFraction = 1.0f / segments;
+  lineGenerator.targetPositionW = targetPositionW;
+  lineGenerator.segmentMoveW.x = moveW.x * segmentFraction;
+  lineGenerator.segmentMoveW.y = moveW.y * segmentFraction;
+  lineGenerator.segmentMoveW.z = moveW.z * segmentFraction;
+  lineGenerator.segmentMoveW.e = moveW.e * segmentFraction;
+  lineGenerator.segmentTravelTime = totalTravelTime * segmentFraction;
+  lineGenerator.segments = segments;
+  lineGenerator.batchCount = 0;
+  lineGenerator.batchIndex = 0;
+}
+
+/**
+ * \brief Adds segments of the current line movement to the motion buffer
+ *
+ * Segments are transformed in batches of up to #KINEMATIC_BATCH_SIZE
+ * positions to make use of SIMD instructions, if available. Transformed
+ * positions are kept in #lineGenerator until there is space in the motion
+ * buffer.
+ * @return RESULT_OK if all segments were added, RESULT_NOT_OK if the motion
+ * buffer is full
+ */
+uint8_t MotionPlanner::runLineMovement()
+{
+  KinematicBatchW_t batchW;
+  AxisCoordinates_t segmentStepsA;
+
+  while ((lineGenerator.batchIndex < lineGenerator.batchCount) || (lineGenerator.segments > 0))
+    {
+      if (lineGenerator.batchIndex >= lineGenerator.batchCount)
+        {
+          /* Calculate the necessary steps for the next batch of segments using inverse
+           * machine kinematics. We directly increment the position pretending that the
+           * move was already done. The last segment ends exactly at the target. */
+          lineGenerator.batchCount = (uint8_t)min((int)KINEMATIC_BATCH_SIZE, lineGenerator.segments);
+          for (uint8_t k=0; k<lineGenerator.batchCount; k++)
+            {
+              if (lineGenerator.segments - k == 1)
+                {
+                  worldPosition = lineGenerator.targetPositionW;
+                }
+              else
+                {
+                  worldPosition.x += lineGenerator.segmentMoveW.x;
+                  worldPosition.y += lineGenerator.segmentMoveW.y;
+                  worldPosition.z += lineGenerator.segmentMoveW.z;
+                  worldPosition.e += lineGenerator.segmentMoveW.e;
+                }
+              batchW.x[k] = worldPosition.x;
+              batchW.y[k] = worldPosition.y;
+              batchW.z[k] = worldPosition.z;
+              batchW.e[k] = worldPosition.e;
+            }
+          lineGenerator.segments -= lineGenerator.batchCount;
+          lineGenerator.batchIndex = 0;
+
+          /* Transform from world into axis coordinate systems */
+          kinematic.inverseMachineKinematicBatch(batchW, &lineGenerator.batchA, lineGenerator.batchCount, activeExtruder);
+        }
+
+      /* If the buffer is full: good! That means we are well ahead of the
+       * machine. Return and continue with the next call. */
+      if (MotionBuffer_isFull())
+        {
+          return RESULT_NOT_OK;
+        }
+
+      /* Extruder which are not active keep their position */
+      segmentStepsA = axisPosition;
       for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++)
         {
-	  segmentStepsA.axis[i] = segmentStepsA.axis[i] - axisPosition.axis[i];
-	  /* Transform from axis to stepper coordinates */
-	  motion.steps[i] = abs(segmentStepsA.axis[i]);
-	  /* Calculate direction bits for this move */
-	  if (segmentStepsA.axis[i] < 0)
-	    {
-	      Stepper_setStepDirectionNegative(motion.steps.directionBits, i);
-	    }
-	  /* Calculate maximum number of steps needed for this move */
-	  motion.stepEventCount = max(motion.stepEventCount, motion.steps[i]);
+          segmentStepsA.axis[i] = lineGenerator.batchA.axis[i][lineGenerator.batchIndex];
         }
-      for (uint8_t i=0; i<MACHINE_NUM_EXTRUDER; i++)
-	{
-	  /* Transform from axis to stepper coordinates */
-	  motion.steps[i] = abs(segmentStepsA.extruder[i]);
-	  /* Calculate direction bits for this move */
-	  if (segmentStepsA.extruder[i] < 0)
-	    {
-	      Stepper_setStepDirectionNegative(motion.steps.directionBits, i);
-	    }
-	  /* Calculate maximum number of steps needed for this move */
-	  motion.stepEventCount = max(motion.stepEventCount, motion.steps[i]);
-	}
-      /* Only proceed if block steps are above threshold */
-      if (motion.stepEventCount > MOTIONPLANNER_MINIMUM_SEGMENT_SIZE)
+      segmentStepsA.extruder[activeExtruder] = lineGenerator.batchA.extruder[lineGenerator.batchIndex];
+      lineGenerator.batchIndex++;
+
+      /* Residual steps are never carried over into the next move */
+      addSegment(segmentStepsA, lineGenerator.segmentTravelTime,
+                 (lineGenerator.batchIndex >= lineGenerator.batchCount) && (lineGenerator.segments == 0) &&
+                 (arcGenerator.segment >= arcGenerator.segments));
+    }
+  return RESULT_OK;
+}
+
+/**
+ * \brief Queues a new movement to be merged with the following ones
+ *
+ * Slicers split curves and long lines into many short, nearly collinear
+ * moves. Each of them would become its own block and use up the motion
+ * buffer. Thus, moves are held back and merged as long as
+ * * the direction of the new move deviates less than
+ * #MOTIONPLANNER_COALESCE_COS_TOLERANCE from the pending move
+ * * the extrusion per mm differs less than
+ * #MOTIONPLANNER_COALESCE_EXTRUSION_TOLERANCE
+ * * the feedrate is the same
+ * * not more than #MOTIONPLANNER_COALESCE_MAX_MOVES moves and not more than
+ * #MOTIONPLANNER_COALESCE_MAX_TIME travel time are merged.
+ * Otherwise the pending move is handed to #addLineMovement and the new move
+ * becomes the pending one. Moves without travel, e.g. retracts, are never
+ * merged.
+ * Because the last move is always held back, #flushLineMovement must be
+ * called if no further move follows, e.g. when the input is empty or before
+ * dwelling. #addLineMovement must not be called directly while a move is
+ * pending.
+ * @param[in] targetPositionW Absolute target position of head in world coordinates
+ * X_W [mm] and extruder coordinates E_W [mm].
+ * @param[in] feedrateW Feedrate, that is speed, for this move in mm/s (f_W [mm/s])
+ * @return RESULT_OK if the move was accepted, RESULT_NOT_OK if the motion
+ * planner is still busy with the previous move,
+ * #MOTIONPLANNER_RESULT_UNREACHABLE if the target can't be reached
+ */
+uint8_t MotionPlanner::queueLineMovement(WorldCoordinates_t targetPositionW, WorldCoordinate_t feedrateW)
+{
+  WorldCoordinates_t moveW;
+
+  if (!kinematic.isReachable(targetPositionW))
+    {
+      return MOTIONPLANNER_RESULT_UNREACHABLE;
+    }
+  if (!isReady())
+    {
+      return RESULT_NOT_OK;
+    }
+  /* New move starts where the pending one ends */
+  const WorldCoordinates_t &startW = plannedPosition();
+
+  moveW.x = targetPositionW.x - startW.x;
+  moveW.y = targetPositionW.y - startW.y;
+  moveW.z = targetPositionW.z - startW.z;
+  moveW.e = targetPositionW.e - startW.e;
+  WorldCoordinate_t lengthW = sqrt(sq(moveW.x) + sq(moveW.y) + sq(moveW.z));
+
+  /* Direction of the move and extrusion per mm */
+  if (lengthW > 0.0)
+    {
+      WorldCoordinate_t lengthInverseW = 1 / lengthW;
+      moveW.x *= lengthInverseW;
+      moveW.y *= lengthInverseW;
+      moveW.z *= lengthInverseW;
+      moveW.e *= lengthInverseW;
+    }
+
+  if (pendingMove.moves > 0)
+    {
+      WorldCoordinate_t cosW = moveW.x * pendingMove.directionW.x + moveW.y * pendingMove.directionW.y + moveW.z * pendingMove.directionW.z;
+      if ((lengthW == 0.0) || (pendingMove.lengthW == 0.0) ||
+          (feedrateW != pendingMove.feedrateW) ||
+          (cosW < MOTIONPLANNER_COALESCE_COS_TOLERANCE) ||
+          (abs(moveW.e - pendingMove.directionW.e) > MOTIONPLANNER_COALESCE_EXTRUSION_TOLERANCE * abs(pendingMove.directionW.e)) ||
+          (pendingMove.lengthW + lengthW > MOTIONPLANNER_COALESCE_MAX_TIME * feedrateW))
         {
+          flushLineMovement();
+        }
+    }
 
-	  motion.nominalRate = segmentTravelTime / motion.stepEventCount;
+  if (pendingMove.moves == 0)
+    {
+      pendingMove.directionW = moveW;
+      pendingMove.lengthW = lengthW;
+      pendingMove.feedrateW = feedrateW;
+    }
+  else
+    {
+      /* Merged move is the chord from the current position to the new target */
+      pendingMove.directionW.x = targetPositionW.x - worldPosition.x;
+      pendingMove.directionW.y = targetPositionW.y - worldPosition.y;
+      pendingMove.directionW.z = targetPositionW.z - worldPosition.z;
+      pendingMove.directionW.e = targetPositionW.e - worldPosition.e;
+      WorldCoordinate_t chordInverseW = 1 / sqrt(sq(pendingMove.directionW.x) + sq(pendingMove.directionW.y) + sq(pendingMove.directionW.z));
+      pendingMove.directionW.x *= chordInverseW;
+      pendingMove.directionW.y *= chordInverseW;
+      pendingMove.directionW.z *= chordInverseW;
+      pendingMove.directionW.e *= chordInverseW;
+      pendingMove.lengthW += lengthW;
+    }
+  pendingMove.targetPositionW = targetPositionW;
+  pendingMove.moves++;
 
-	  /* @todo: Rpelace with correct code. For movment smothing (i.e. jerk control)
-	   * is ont applied.*/
-	  motion.
-	  /* If the buffer is full: good! That means we are well ahead of the
-	   * machine. Rest here until there is room in the buffer.
-	  */
-	  while (!motionBuffer.available()) Idle();
+  if (pendingMove.moves >= MOTIONPLANNER_COALESCE_MAX_MOVES)
+    {
+      flushLineMovement();
+    }
+  return RESULT_OK;
+}
 
-	  motionBuffer.write(motion);
-	  retVal = RESULT_OK;
+/**
+ * \brief Hands the pending coalesced move to the motion buffer
+ *
+ * @return RESULT_OK if no move is pending anymore, RESULT_NOT_OK if the
+ * motion planner is still busy with the previous move
+ */
+bool MotionPlanner::flushLineMovement()
+{
+  TRACE_SPAN_START(start);
+
+  if (pendingMove.moves > 0)
+    {
+      if (!isReady())
+        {
+          return RESULT_NOT_OK;
         }
+      pendingMove.moves = 0;
+      startLineMovement(pendingMove.targetPositionW, pendingMove.feedrateW);
+      run();
+      TRACE_SPAN(1, TRACE_EVENT_LINE, start);
     }
-  return retVal;
+  return RESULT_OK;
 }
 
+/**
+ * \brief Recalculates the axis position after parameter changed
+ *
+ * The world position is kept and transformed again into axis coordinates
+ * with the current #derivedParameter. Thus, changing e.g. steps per unit
+ * does not move the machine. Blocks already in the motion buffer are not
+ * changed. Called automatically by the next line movement if the version
+ * of #derivedParameter changed.
+ * @pre #isReady and no move is pending, see #hasPendingMove
+ */
+void MotionPlanner::refreshPosition()
+{
+  kinematic.inverseMachineKinematic(worldPosition, &axisPosition, activeExtruder);
+  parameterVersion = derivedParameter.version;
+}
 
+/**
+ * \brief Add a new arc movement in the XY plane to the motion planner
+ *
+ * The arc is split into line segments which are handed to the line segment
+ * generation one by one while they are calculated, see #nextArcSegment.
+ * Thus, the arc is never buffered completely. The number of segments is
+ * chosen such that the deviation (sagitta) of each segment from the ideal
+ * arc stays below #MOTIONPLANNER_ARC_CHORDAL_TOLERANCE.
+ * A pending coalesced move (see #queueLineMovement) is flushed first.
+ * @param[in] targetPositionW Absolute target position of head in world coordinates
+ * X_W [mm] and extruder coordinates E_W [mm].
+ * @param[in] offsetI Offset of the arc center from the current position in X [mm]
+ * @param[in] offsetJ Offset of the arc center from the current position in Y [mm]
+ * @param[in] clockwise True for clockwise (G2), false for counter-clockwise (G3)
+ * arcs
+ * @param[in] feedrateW Feedrate, that is speed, for this move in mm/s (f_W [mm/s])
+ * @return RESULT_OK if the arc was accepted, RESULT_NOT_OK if the motion
+ * planner is still busy with the previous move,
+ * #MOTIONPLANNER_RESULT_UNREACHABLE if the target can't be reached
+ * @note Replaces function plan_arc
+ */
+uint8_t MotionPlanner::addArcMovement(WorldCoordinates_t targetPositionW, WorldCoordinate_t offsetI, WorldCoordinate_t offsetJ, bool clockwise, WorldCoordinate_t feedrateW)
+{
+  if (!kinematic.isReachable(targetPositionW))
+    {
+      return MOTIONPLANNER_RESULT_UNREACHABLE;
+    }
+  if (!isReady())
+    {
+      return RESULT_NOT_OK;
+    }
+  flushLineMovement();
 
+  const WorldCoordinates_t &startW = plannedPosition();
+  arcGenerator.startPositionW = startW;
+  arcGenerator.targetPositionW = targetPositionW;
+  arcGenerator.centerX = startW.x + offsetI;
+  arcGenerator.centerY = startW.y + offsetJ;
+  arcGenerator.offsetI = offsetI;
+  arcGenerator.offsetJ = offsetJ;
+  /* Radius vectors from the center to start and target position */
+  arcGenerator.radiusX = -offsetI;
+  arcGenerator.radiusY = -offsetJ;
+  const WorldCoordinate_t targetRadiusX = targetPositionW.x - arcGenerator.centerX;
+  const WorldCoordinate_t targetRadiusY = targetPositionW.y - arcGenerator.centerY;
+  const WorldCoordinate_t radius = sqrt(sq(offsetI) + sq(offsetJ));
 
+  /* Angle between start and target, positive counter-clockwise */
+  float angularTravel = atan2(arcGenerator.radiusX * targetRadiusY - arcGenerator.radiusY * targetRadiusX,
+                              arcGenerator.radiusX * targetRadiusX + arcGenerator.radiusY * targetRadiusY);
+  if (clockwise)
+    {
+      if (angularTravel >= -MOTIONPLANNER_ARC_ANGULAR_TRAVEL_EPSILON) angularTravel -= 2 * M_PI;
+    }
+  else
+    {
+      if (angularTravel <= MOTIONPLANNER_ARC_ANGULAR_TRAVEL_EPSILON) angularTravel += 2 * M_PI;
+    }
 
-    /* Only proceed if block steps are above threshold */
-    if (motion.stepEventCount > MOTIONPLANNER_MINIMUM_SEGMENT_SIZE)
-      {
-	/* TODO: Add volumetric_multiplier and extruder_multiplier functionality here
-	 * motion.steps.e = deltaMoveW.e * volumetric_multiplier;
-	 * motion.steps.e = deltaMove.e * extruder_multiplier[EXTRUDER]; */
+  /* Biggest segment angle theta for which the sagitta radius*(1-cos(theta/2)) stays
+   * below tolerance */
+  int segments = 1;
+  if (radius > MOTIONPLANNER_ARC_CHORDAL_TOLERANCE)
+    {
+      float segmentAngle = 2 * acos(1 - MOTIONPLANNER_ARC_CHORDAL_TOLERANCE / radius);
+      int angleSegments = (int)ceil(abs(angularTravel) / segmentAngle);
+      segments = max(1, angleSegments);
+    }
 
-	/* TODO: Add fan speed control here
-	 * for (uint8_t i = 0; i < FAN_COUNT; i++) block->fan_speed[i] = fanSpeeds[i];
-	 */
+  arcGenerator.theta = angularTravel / segments;
+  arcGenerator.cosTheta = cos(arcGenerator.theta);
+  arcGenerator.sinTheta = sin(arcGenerator.theta);
+  arcGenerator.feedrateW = feedrateW;
+  arcGenerator.segment = 0;
+  arcGenerator.segments = segments;
+  arcGenerator.correctionCount = 0;
 
-	/* Enabling stepper was moved to stepper module */
-	/* ******** 2. Calculate and limit speed for this move ******** */
+  run();
+  return RESULT_OK;
+}
 
-	/* Calculate overall length [steps] of this move */
-	AxisCoordinate_t travelLength = 0;
-	for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++)
-	  {
-	    travelLength += deltaMove.axis[i] * deltaMove.axis[i];
-	  }
-	travelLength = sqrt(travelLength);
-	/* Calculate the speed for each axis [steps/sec] */
-	AxisCoordinates_t travelSpeed;
-	for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++)
-	  {
-	    travelSpeed.axis[i] = feedrate * deltaMove.axis[i] / travelLength;
-	  }
-	/* Finally, to be executed, add the block to motion buffer. Because we waited for
-	 * space earlier, the motion will always be added */
+/**
+ * \brief Add a new arc movement in the XY plane given by its radius
+ *
+ * Calculates the center of the arc and calls #addArcMovement. Positive
+ * radius selects the arc with less than 180°, negative radius the one with
+ * more than 180°.
+ * @param[in] targetPositionW Absolute target position of head in world coordinates
+ * X_W [mm] and extruder coordinates E_W [mm].
+ * @param[in] radius Radius of the arc [mm]
+ * @param[in] clockwise True for clockwise (G2), false for counter-clockwise (G3)
+ * arcs
+ * @param[in] feedrateW Feedrate, that is speed, for this move in mm/s (f_W [mm/s])
+ * @return RESULT_NOT_OK if the motion planner is busy,
+ * #MOTIONPLANNER_RESULT_INVALID_ARC if no arc with the given radius connects
+ * current and target position, return value of #addArcMovement otherwise
+ */
+uint8_t MotionPlanner::addArcMovementRadius(WorldCoordinates_t targetPositionW, WorldCoordinate_t radius, bool clockwise, WorldCoordinate_t feedrateW)
+{
+  if (!isReady())
+    {
+      return RESULT_NOT_OK;
+    }
+  const WorldCoordinates_t &startW = plannedPosition();
+  WorldCoordinate_t moveX = targetPositionW.x - startW.x;
+  WorldCoordinate_t moveY = targetPositionW.y - startW.y;
+  WorldCoordinate_t distance = sqrt(sq(moveX) + sq(moveY));
+  /* Squared distance of the center from the middle of the chord, times four */
+  WorldCoordinate_t heightSquared = 4 * sq(radius) - sq(moveX) - sq(moveY);
 
-	previousTravelSpeed = travelSpeed;
+  if ((distance == 0.0) || (abs(radius) < distance / 2 - MOTIONPLANNER_ARC_RADIUS_TOLERANCE))
+    {
+      return MOTIONPLANNER_RESULT_INVALID_ARC;
+    }
+  /* Radius slightly too short due to rounding, take the half circle */
+  if (heightSquared < 0.0)
+    {
+      heightSquared = 0.0;
+    }
+  /* Height of the center over the chord relative to the chord length */
+  WorldCoordinate_t height = -sqrt(heightSquared) / distance;
+  if (!clockwise) height = -height;
+  if (radius < 0.0) height = -height;
 
-      }
-    } // for (int i=0; i< segments; i++)
-  /* Save speed for next run */
+  return addArcMovement(targetPositionW, (moveX - moveY * height) / 2, (moveY + moveX * height) / 2, clockwise, feedrateW);
 }
+
+/**
+ * \brief Starts the line movement for the next segment of the current arc
+ *
+ * Segment positions are calculated by rotating the radius vector with a
+ * constant rotation matrix. Because rounding errors accumulate, every
+ * #MOTIONPLANNER_ARC_CORRECTION segments the position is calculated exactly
+ * from the start of the arc instead. Z and E move linear during the arc,
+ * which results in a helix for Z moves. The last segment ends exactly at
+ * the target.
+ */
+void MotionPlanner::nextArcSegment()
+{
+  WorldCoordinates_t segmentPositionW;
+  int segment = ++arcGenerator.segment;
+
+  if (segment >= arcGenerator.segments)
+    {
+      startLineMovement(arcGenerator.targetPositionW, arcGenerator.feedrateW);
+      return;
+    }
+  if (arcGenerator.correctionCount < MOTIONPLANNER_ARC_CORRECTION)
+    {
+      /* Rotate radius vector by theta */
+      WorldCoordinate_t rotatedX = arcGenerator.radiusX * arcGenerator.cosTheta - arcGenerator.radiusY * arcGenerator.sinTheta;
+      arcGenerator.radiusY = arcGenerator.radiusX * arcGenerator.sinTheta + arcGenerator.radiusY * arcGenerator.cosTheta;
+      arcGenerator.radiusX = rotatedX;
+      arcGenerator.correctionCount++;
+    }
+  else
+    {
+      /* Exact calculation from the start of the arc to remove accumulated error */
+      float cosSegment = cos(segment * arcGenerator.theta);
+      float sinSegment = sin(segment * arcGenerator.theta);
+      arcGenerator.radiusX = -arcGenerator.offsetI * cosSegment + arcGenerator.offsetJ * sinSegment;
+      arcGenerator.radiusY = -arcGenerator.offsetI * sinSegment - arcGenerator.offsetJ * cosSegment;
+      arcGenerator.correctionCount = 0;
+    }
+  float fraction = (float)segment / arcGenerator.segments;
+  segmentPositionW.x = arcGenerator.centerX + arcGenerator.radiusX;
+  segmentPositionW.y = arcGenerator.centerY + arcGenerator.radiusY;
+  segmentPositionW.z = arcGenerator.startPositionW.z + (arcGenerator.targetPositionW.z - arcGenerator.startPositionW.z) * fraction;
+  segmentPositionW.e = arcGenerator.startPositionW.e + (arcGenerator.targetPositionW.e - arcGenerator.startPositionW.e) * fraction;
+  startLineMovement(segmentPositionW, arcGenerator.feedrateW);
+}
+
+/**
+ * \brief Adds one segment to the motion buffer
+ *
+ * Calculates the steps for one segment from the difference between the
+ * requested and the current position in axis coordinates and adds the
+ * resulting block to #motionBuffer.
+ * Segments with not more than #MOTIONPLANNER_MINIMUM_SEGMENT_SIZE steps are
+ * not added but merged with the next segment of the same move. Because
+ * #axisPosition is only advanced for segments which are added, the next
+ * block automatically includes the residual steps. Its travel time is
+ * carried over in #pendingTravelTime. This way no steps get lost and finely
+ * tessellated paths result in fewer, larger blocks without position drift.
+ * The last segment of a move (or arc) is always added if it has any steps.
+ * Thus, nothing is held back once the planner is ready, e.g. before G4,
+ * M400 or at the end of the input, and no travel time is carried over into
+ * an unrelated move.
+ * The execution time of each block is tracked in the motion buffer. If less
+ * than #MOTIONPLANNER_SLOWDOWN_QUEUED_TIME is queued, short blocks are
+ * slowed down towards #MOTIONPLANNER_MINIMUM_SEGMENT_TIME.
+ * The caller must make sure that the motion buffer is not full, see
+ * #MotionBuffer_isFull.
+ * @param[in] segmentStepsA Absolute target position of the segment in axis
+ * coordinates [steps]
+ * @param[in] segmentTravelTime Travel time for this segment [s]
+ * @param[in] lastSegment True for the last segment of a move
+ * @return RESULT_OK if a block was added to the motion buffer, RESULT_NOT_OK
+ * if the segment was too small and will be merged with the next one or if
+ * the move ended without steps
+ */
+uint8_t MotionPlanner::addSegment(const AxisCoordinates_t &segmentStepsA, float segmentTravelTime, bool lastSegment)
+{
+  uint8_t retVal = RESULT_NOT_OK;
+  MotionBlock_t motion;
+
+  motion.stepEventCount = 0;
+  motion.steps.directionBits = STEPPER_DIRECTION_POSITIVE;
+
+  /* Calculate the delta steps */
+  for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++)
+    {
+      AxisCoordinate_t deltaStepsA = segmentStepsA.axis[i] - axisPosition.axis[i];
+      /* Transform from axis to stepper coordinates */
+      motion.steps.steps[i] = abs(deltaStepsA);
+      /* Calculate direction bits for this move */
+      if (deltaStepsA < 0)
+        {
+          Stepper_setStepDirectionNegative(motion.steps.directionBits, i);
+        }
+      /* Calculate maximum number of steps needed for this move */
+      motion.stepEventCount = max(motion.stepEventCount, motion.steps.steps[i]);
+    }
+  for (uint8_t i=0; i<MACHINE_NUM_EXTRUDER; i++)
+    {
+      AxisCoordinate_t deltaStepsA = segmentStepsA.extruder[i] - axisPosition.extruder[i];
+      /* Transform from axis to stepper coordinates */
+      motion.steps.extruder[i] = abs(deltaStepsA);
+      /* Calculate direction bits for this move. Extruder bits follow the axis bits */
+      if (deltaStepsA < 0)
+        {
+          Stepper_setStepDirectionNegative(motion.steps.directionBits, MACHINE_NUM_AXIS + i);
+        }
+      /* Calculate maximum number of steps needed for this move */
+      motion.stepEventCount = max(motion.stepEventCount, motion.steps.extruder[i]);
+    }
+  /* Travel time of all previously merged segments is part of this block */
+  pendingTravelTime += segmentTravelTime;
+
+  /* Only proceed if block steps are above threshold or the move ends.
+   * Otherwise the steps as well as the travel time are merged with the next
+   * segment. */
+  if ((motion.stepEventCount > MOTIONPLANNER_MINIMUM_SEGMENT_SIZE) || (lastSegment && (motion.stepEventCount > 0)))
+    {
+      /* Remember the new absolute position in axis coordinates for the next segment */
+      axisPosition = segmentStepsA;
+      segmentTravelTime = pendingTravelTime;
+      pendingTravelTime = 0.0;
+
+      /* TODO: Add volumetric_multiplier and extruder_multiplier functionality here
+       * motion.steps.e = deltaMoveW.e * volumetric_multiplier;
+       * motion.steps.e = deltaMove.e * extruder_multiplier[EXTRUDER]; */
+
+      /* TODO: Add fan speed control here
+       * for (uint8_t i = 0; i < FAN_COUNT; i++) block->fan_speed[i] = fanSpeeds[i];
+       */
+      motion.duration = max((uint32_t)1, (uint32_t)(segmentTravelTime * 1000000));
+
+      /* Slow down short blocks if the motion buffer runs low. The less time is
+       * queued, the closer the block gets to the minimum segment time. Nothing
+       * is slowed down if the machine is standing still anyway. */
+      uint32_t queuedTime = MotionBuffer_queuedTime();
+      if ((queuedTime > 0) && (queuedTime < MOTIONPLANNER_SLOWDOWN_QUEUED_TIME) &&
+          (motion.duration < MOTIONPLANNER_MINIMUM_SEGMENT_TIME))
+        {
+          motion.duration += (uint32_t)((float)(MOTIONPLANNER_MINIMUM_SEGMENT_TIME - motion.duration) *
+                                        (MOTIONPLANNER_SLOWDOWN_QUEUED_TIME - queuedTime) / MOTIONPLANNER_SLOWDOWN_QUEUED_TIME);
+          slowdowns++;
+        }
+      motion.nominalRate = motion.stepEventCount / (motion.duration * 1E-6);
+
+      /* @todo: Replace with correct code. For now movement smoothing (i.e. acceleration
+       * and jerk control) is not applied and the block is executed at nominal rate. */
+      motion.initialRate = motion.nominalRate;
+      motion.finalRate = motion.nominalRate;
+      motion.accelerateUntil = 0;
+      motion.decelerateAfter = motion.stepEventCount;
+      motion.accelerationRate = 0;
+
+      MotionBuffer_write(motion);
+      blocks++;
+      retVal = RESULT_OK;
+    }
+  else if (lastSegment)
+    {
+      /* Move without steps, there is nothing its travel time belongs to */
+      pendingTravelTime = 0.0;
+    }
+  return retVal;
+}
+
 /** @} doxygen end group definition */
 /* ******************| End of file |*********************************** */
@@ -0,0 +1,99 @@
+/**
+ * \file MotionPlanner_stub.c
+ *
+ * \brief Stubs for MotionPlanner unit tests
+ *
+ * All stubs needed for the unit test of this particular modules shall
+ * be done within this file.
+ * The stepper is replaced by a simple consumer which executes the blocks
+ * in #motionBuffer on a virtual clock.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup MotionPlanner
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include "MotionPlanner_test.h"
+#include <blueMarlin.h>
+/* Parameter and the values derived from them are provided by the
+ * Parameter module itself */
+#include "../../Parameter/src/parameter.cpp"
+#include <motionBuffer.h>
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+uint64_t Platform_timeCycles(void);
+void MotionPlannerTest_reset();
+void MotionPlannerTest_simulate(uint32_t time);
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Virtual time of the simulation [µs]
+ */
+uint32_t MotionPlannerTest_time;
+
+/**
+ * Virtual time at which the block currently executed by the consumer is
+ * finished [µs]
+ */
+uint32_t MotionPlannerTest_blockEnd;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Cycle counter for the latency probes, durations are not tested
+ *
+ * @return Always 0
+ */
+uint64_t Platform_timeCycles(void)
+{
+  return 0;
+}
+
+/**
+ * \brief Empties the motion buffer and resets the virtual clock
+ */
+void MotionPlannerTest_reset()
+{
+  MotionBlock_t block;
+
+  while (MotionBuffer_read(&block) == RESULT_OK);
+  MotionBuffer_writtenTime = 0;
+  MotionBuffer_readTime = 0;
+  MotionPlannerTest_time = 0;
+  MotionPlannerTest_blockEnd = 0;
+}
+
+/**
+ * \brief Executes all blocks which are due until #time
+ *
+ * A block is removed from the buffer when its execution starts. If the
+ * buffer runs empty the consumer stands still until #time.
+ * @param[in] time Virtual time to advance to [µs]
+ */
+void MotionPlannerTest_simulate(uint32_t time)
+{
+  MotionBlock_t block;
+
+  while (MotionPlannerTest_blockEnd <= time)
+    {
+      if (MotionBuffer_read(&block) != RESULT_OK)
+        {
+          MotionPlannerTest_blockEnd = time;
+          break;
+        }
+      MotionPlannerTest_blockEnd += block.duration;
+    }
+  MotionPlannerTest_time = time;
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,333 @@
+/**
+ * \file MotionPlanner_test.c
+ *
+ * \brief MotionPlanner unit test implementation
+ *
+ * Please see http://embunit.sourceforge.net/ for more information. For
+ * detailed documentation see http://embunit.sourceforge.net/embunit/index.html
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup MotionPlanner
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include "MotionPlanner_test.h"
+/* Include .cpp file to be tested in order to get access to all private
+ * or static functions. Modules used by the motion planner are included
+ * as well because the ring buffer is a template. */
+#include "../../RingBuffer/src/ringBuffer.cpp"
+#include "../../Kinematic/src/kinematic.cpp"
+#include "../../MotionBuffer/src/motionBuffer.cpp"
+#include "../src/motionPlanner.cpp"
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+
+/* ******************| Global Variables |****************************** */
+
+/* ******************| Function Implementation |*********************** */
+
+/**
+ * \brief Reads all blocks from the motion buffer
+ * @param[out] steps Sum of the signed steps of all blocks for each axis
+ * @param[out] duration Sum of the duration of all blocks [µs]
+ * @return Number of blocks read
+ */
+static int MotionPlannerTest_readBlocks(AxisCoordinate_t steps[MACHINE_NUM_AXIS], uint32_t *duration)
+{
+  MotionBlock_t block;
+  int blocks = 0;
+
+  for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++) steps[i] = 0;
+  *duration = 0;
+  while (MotionBuffer_read(&block) == RESULT_OK)
+    {
+      for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++)
+        {
+          if (block.steps.directionBits & _BV(i)) steps[i] -= block.steps.steps[i];
+          else steps[i] += block.steps.steps[i];
+        }
+      *duration += block.duration;
+      blocks++;
+    }
+  return blocks;
+}
+
+/**
+ * Sub-threshold segments
+ * Test if a move with less than MOTIONPLANNER_MINIMUM_SEGMENT_SIZE steps
+ * still adds its block at the end of the move
+ * Test if neither its steps nor its travel time are added to the next move
+ * Test if a move without steps adds no block and no travel time
+ */
+static void MotionPlanner_MotionPlanner_addLineMovement_1(void)
+{
+  AxisCoordinate_t steps[MACHINE_NUM_AXIS];
+  uint32_t duration;
+
+  /* 0.05mm are 4 steps and take 5ms at 10mm/s */
+  TEST_ASSERT(motionPlanner.addLineMovement({0.05, 0.0, 0.0, 0.0}, 10.0) == RESULT_OK);
+  TEST_ASSERT_EQUAL_INT(1, MotionPlannerTest_readBlocks(steps, &duration));
+  TEST_ASSERT_EQUAL_INT(4, steps[0]);
+  TEST_ASSERT(abs((int32_t)duration - 5000) <= 1);
+
+  /* 0.005mm round to no step */
+  TEST_ASSERT(motionPlanner.addLineMovement({0.055, 0.0, 0.0, 0.0}, 10.0) == RESULT_OK);
+  TEST_ASSERT_EQUAL_INT(0, motionBuffer.available());
+
+  TEST_ASSERT(motionPlanner.addLineMovement({0.1, 0.0, 0.0, 0.0}, 10.0) == RESULT_OK);
+  TEST_ASSERT_EQUAL_INT(1, MotionPlannerTest_readBlocks(steps, &duration));
+  TEST_ASSERT_EQUAL_INT(4, steps[0]);
+  TEST_ASSERT(abs((int32_t)duration - 4500) <= 1);
+}
+
+/**
+ * Coalescing of collinear moves
+ * Test if collinear moves with equal extrusion result in one block
+ * Test if a corner and a change of extrusion start a new block
+ * Test if nothing is added before flush
+ */
+static void MotionPlanner_MotionPlanner_queueLineMovement_1(void)
+{
+  AxisCoordinate_t steps[MACHINE_NUM_AXIS];
+  uint32_t duration;
+
+  for (uint8_t i=1; i<=4; i++)
+    {
+      motionPlanner.queueLineMovement({0.5f * i, 0.0, 0.0, 0.02f * i}, 50.0);
+    }
+  TEST_ASSERT_EQUAL_INT(0, motionBuffer.available());
+  /* Corner */
+  motionPlanner.queueLineMovement({2.0, 0.5, 0.0, 0.1}, 50.0);
+  /* Same direction but twice the extrusion */
+  motionPlanner.queueLineMovement({2.0, 1.0, 0.0, 0.14}, 50.0);
+  motionPlanner.flushLineMovement();
+
+  TEST_ASSERT_EQUAL_INT(3, MotionPlannerTest_readBlocks(steps, &duration));
+  TEST_ASSERT_EQUAL_INT(2 * MOTIONPLANNER_TEST_STEPSPERUNIT, steps[0]);
+  TEST_ASSERT_EQUAL_INT(1 * MOTIONPLANNER_TEST_STEPSPERUNIT, steps[1]);
+}
+
+/**
+ * Arc movements
+ * Test if a full circle returns to the start position
+ * Test if a half circle ends at the target and is split into several
+ * blocks
+ * Test if the radius form results in the same arc as the center form
+ * Test if a radius too short is rejected as invalid without adding blocks
+ * Test if a radius rounded just below half the distance is accepted
+ */
+static void MotionPlanner_MotionPlanner_addArcMovement_1(void)
+{
+  AxisCoordinate_t steps[MACHINE_NUM_AXIS];
+  uint32_t duration;
+  int blocks;
+
+  /* Arcs are chosen small enough to fit into the motion buffer */
+  motionPlanner.addArcMovement({0.0, 0.0, 0.0, 0.0}, 1.5, 0.0, true, 50.0);
+  TEST_ASSERT(MotionPlannerTest_readBlocks(steps, &duration) > 1);
+  TEST_ASSERT_EQUAL_INT(0, steps[0]);
+  TEST_ASSERT_EQUAL_INT(0, steps[1]);
+
+  motionPlanner.addArcMovement({10.0, 0.0, 1.0, 0.0}, 5.0, 0.0, false, 50.0);
+  blocks = MotionPlannerTest_readBlocks(steps, &duration);
+  TEST_ASSERT(blocks > 1);
+  TEST_ASSERT_EQUAL_INT(10 * MOTIONPLANNER_TEST_STEPSPERUNIT, steps[0]);
+  TEST_ASSERT_EQUAL_INT(0, steps[1]);
+  TEST_ASSERT_EQUAL_INT(1 * MOTIONPLANNER_TEST_STEPSPERUNIT, steps[2]);
+
+  motionPlanner.addArcMovementRadius({0.0, 0.0, 1.0, 0.0}, 5.0, false, 50.0);
+  TEST_ASSERT_EQUAL_INT(blocks, MotionPlannerTest_readBlocks(steps, &duration));
+  TEST_ASSERT_EQUAL_INT(-10 * MOTIONPLANNER_TEST_STEPSPERUNIT, steps[0]);
+
+  /* No arc with radius 2 connects two points 10mm apart */
+  TEST_ASSERT_EQUAL_INT(MOTIONPLANNER_RESULT_INVALID_ARC, motionPlanner.addArcMovementRadius({10.0, 0.0, 1.0, 0.0}, 2.0, false, 50.0));
+  TEST_ASSERT_EQUAL_INT(0, MotionPlannerTest_readBlocks(steps, &duration));
+
+  /* Radius rounded below half the distance gives the half circle */
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, motionPlanner.addArcMovementRadius({10.0, 0.0, 1.0, 0.0}, 4.9995, false, 50.0));
+  TEST_ASSERT_EQUAL_INT(blocks, MotionPlannerTest_readBlocks(steps, &duration));
+  TEST_ASSERT_EQUAL_INT(10 * MOTIONPLANNER_TEST_STEPSPERUNIT, steps[0]);
+}
+
+/**
+ * Slowdown policy
+ * Test if a short block is not slowed down if the machine stands still
+ * Test if a short block is slowed down if less than
+ * MOTIONPLANNER_SLOWDOWN_QUEUED_TIME is queued
+ * Test if a short block is not slowed down if enough time is queued
+ */
+static void MotionPlanner_MotionPlanner_addSegment_1(void)
+{
+  MotionBlock_t block;
+
+  /* 0.2mm at 100mm/s take 2ms */
+  motionPlanner.addLineMovement({0.2, 0.0, 0.0, 0.0}, 100.0);
+  TEST_ASSERT_EQUAL_INT(2000, MotionBuffer_queuedTime());
+
+  motionPlanner.addLineMovement({0.4, 0.0, 0.0, 0.0}, 100.0);
+  TEST_ASSERT(MotionBuffer_queuedTime() > 2000 + 2000 + (MOTIONPLANNER_MINIMUM_SEGMENT_TIME - 2000) / 2);
+  TEST_ASSERT_EQUAL_INT(1, motionPlanner.getSlowdowns());
+
+  /* 10mm take 100ms */
+  motionPlanner.addLineMovement({10.4, 0.0, 0.0, 0.0}, 100.0);
+  motionPlanner.addLineMovement({10.6, 0.0, 0.0, 0.0}, 100.0);
+  TEST_ASSERT_EQUAL_INT(1, motionPlanner.getSlowdowns());
+  while (MotionBuffer_read(&block) == RESULT_OK);
+  TEST_ASSERT_EQUAL_INT(2000, block.duration);
+}
+
+/**
+ * Slowdown policy on a virtual clock
+ * Dense moves mixed with long moves are sent by a host which is slower
+ * than the execution of the dense moves. Test if less blocks are slowed
+ * down than with a policy which slows down whenever the buffer is less
+ * than half full.
+ */
+static void MotionPlanner_MotionPlanner_addSegment_2(void)
+{
+  uint32_t countSlowdowns = 0;
+  uint32_t lineTime = 0;
+  WorldCoordinate_t x = 0.0;
+
+  for (uint8_t repeat=0; repeat<10; repeat++)
+    {
+      for (uint8_t i=0; i<=60; i++)
+        {
+          /* One long move of 20mm followed by 60 moves of 0.2mm at 100mm/s */
+          x += (i == 0) ? 20.0 : 0.2;
+          /* One line every 3ms */
+          lineTime += 3000;
+          MotionPlannerTest_simulate(max(lineTime, MotionPlannerTest_time));
+          motionPlanner.run();
+          if ((i > 0) && (motionBuffer.available() < MOTIONBUFFER_MOTIONBUFFER_SIZE / 2))
+            {
+              countSlowdowns++;
+            }
+          /* Wait until the consumer takes the next block if the planner is busy */
+          while (motionPlanner.addLineMovement({x, 0.0, 0.0, 0.0}, 100.0) != RESULT_OK)
+            {
+              MotionPlannerTest_simulate(MotionPlannerTest_blockEnd);
+              motionPlanner.run();
+            }
+        }
+    }
+  TEST_ASSERT(motionPlanner.getSlowdowns() < countSlowdowns / 2);
+}
+
+/**
+ * Resumable segment generation
+ * Test if an arc with more segments than the motion buffer can hold
+ * returns immediately with a full motion buffer
+ * Test if no further movement is accepted until all segments are added
+ * Test if calling run while the buffer is emptied adds all segments
+ */
+static void MotionPlanner_MotionPlanner_run_1(void)
+{
+  MotionBlock_t block;
+  AxisCoordinate_t steps[MACHINE_NUM_AXIS] = {0, 0, 0};
+  int blocks = 0;
+
+  TEST_ASSERT(motionPlanner.addArcMovement({0.0, 0.0, 0.0, 0.0}, 10.0, 0.0, true, 50.0) == RESULT_OK);
+  TEST_ASSERT_EQUAL_INT(MOTIONBUFFER_MOTIONBUFFER_SIZE, motionBuffer.available());
+  TEST_ASSERT(!motionPlanner.isReady());
+  TEST_ASSERT(motionPlanner.addLineMovement({1.0, 0.0, 0.0, 0.0}, 50.0) == RESULT_NOT_OK);
+  TEST_ASSERT(motionPlanner.queueLineMovement({1.0, 0.0, 0.0, 0.0}, 50.0) == RESULT_NOT_OK);
+
+  while (MotionBuffer_read(&block) == RESULT_OK)
+    {
+      for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++)
+        {
+          if (block.steps.directionBits & _BV(i)) steps[i] -= block.steps.steps[i];
+          else steps[i] += block.steps.steps[i];
+        }
+      blocks++;
+      motionPlanner.run();
+    }
+  TEST_ASSERT(motionPlanner.isReady());
+  TEST_ASSERT(blocks > MOTIONBUFFER_MOTIONBUFFER_SIZE);
+  TEST_ASSERT_EQUAL_INT(0, steps[0]);
+  TEST_ASSERT_EQUAL_INT(0, steps[1]);
+}
+
+/**
+ * Parameter change between two moves
+ * Test if a new version of derived parameter does not move the machine
+ * Test if the next move uses the new steps per unit
+ */
+static void MotionPlanner_MotionPlanner_refreshPosition_1(void)
+{
+  AxisCoordinate_t steps[MACHINE_NUM_AXIS];
+  uint32_t duration;
+
+  TEST_ASSERT(motionPlanner.addLineMovement({1.0, 0.0, 0.0, 0.0}, 50.0) == RESULT_OK);
+  TEST_ASSERT_EQUAL_INT(1, MotionPlannerTest_readBlocks(steps, &duration));
+  TEST_ASSERT_EQUAL_INT(MOTIONPLANNER_TEST_STEPSPERUNIT, steps[0]);
+
+  parameter.axisStepsPerUnit.axis[0] = 2 * MOTIONPLANNER_TEST_STEPSPERUNIT;
+  Parameter_derive();
+  TEST_ASSERT(motionPlanner.addLineMovement({2.0, 0.0, 0.0, 0.0}, 50.0) == RESULT_OK);
+  TEST_ASSERT_EQUAL_INT(1, MotionPlannerTest_readBlocks(steps, &duration));
+  TEST_ASSERT_EQUAL_INT(2 * MOTIONPLANNER_TEST_STEPSPERUNIT, steps[0]);
+}
+
+/**
+ * Test Setup function which is called for before each test
+ */
+static void setUpMotionPlanner(void)
+{
+  MotionPlannerTest_reset();
+  Kinematic_init();
+  for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++)
+    {
+      parameter.axisStepsPerUnit.axis[i] = MOTIONPLANNER_TEST_STEPSPERUNIT;
+    }
+  Parameter_derive();
+  kinematic.init();
+  motionPlanner = MotionPlanner();
+  motionPlanner.init();
+}
+
+/**
+ * Test Teardown function which is called for after each test
+ */
+static void tearDownMotionPlanner(void)
+{
+}
+
+TestRef MotionPlanner_test_RunTests(void)
+{
+  EMB_UNIT_TESTFIXTURES(fixtures) {
+    new_TestFixture("Test case MotionPlanner_MotionPlanner_addLineMovement_1", MotionPlanner_MotionPlanner_addLineMovement_1),
+    new_TestFixture("Test case MotionPlanner_MotionPlanner_queueLineMovement_1", MotionPlanner_MotionPlanner_queueLineMovement_1),
+    new_TestFixture("Test case MotionPlanner_MotionPlanner_addArcMovement_1", MotionPlanner_MotionPlanner_addArcMovement_1),
+    new_TestFixture("Test case MotionPlanner_MotionPlanner_addSegment_1", MotionPlanner_MotionPlanner_addSegment_1),
+    new_TestFixture("Test case MotionPlanner_MotionPlanner_addSegment_2", MotionPlanner_MotionPlanner_addSegment_2),
+    new_TestFixture("Test case MotionPlanner_MotionPlanner_run_1", MotionPlanner_MotionPlanner_run_1),
+    new_TestFixture("Test case MotionPlanner_MotionPlanner_refreshPosition_1", MotionPlanner_MotionPlanner_refreshPosition_1)
+  };
+  EMB_UNIT_TESTCALLER(MotionPlanner_tests,"MotionPlanner Unit test",setUpMotionPlanner,tearDownMotionPlanner,fixtures);
+  return (TestRef)&MotionPlanner_tests;
+}
+
+/**
+ *
+ */
+int main(void)
+{
+  TestRunner_start();
+  TestRunner_runTest(MotionPlanner_test_RunTests());
+  TestRunner_end();
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
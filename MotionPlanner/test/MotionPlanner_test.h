@@ -0,0 +1,43 @@
+#if (!defined MOTIONPLANNER_TEST_H_)
+/* Preprocessor exclusion definition */
+#define MOTIONPLANNER_TEST_H_
+/**
+ * \file MotionPlanner_test.h
+ *
+ * \brief MotionPlanner include file for test driver
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup MotionPlanner
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <embUnit/embUnit.h>
+#include <platform.h>
+
+/* ******************| Macros |**************************************** */
+/**
+ * Steps per unit used for all axis during the test
+ */
+#define MOTIONPLANNER_TEST_STEPSPERUNIT     (AxisCoordinate_t)80
+
+/* ******************| Type definitions |****************************** */
+
+/* ******************| External function declarations |**************** */
+extern void MotionPlannerTest_reset();
+extern void MotionPlannerTest_simulate(uint32_t time);
+
+/* ******************| External constants |**************************** */
+
+/* ******************| External variables |**************************** */
+extern uint32_t MotionPlannerTest_time;
+extern uint32_t MotionPlannerTest_blockEnd;
+
+/** @} doxygen end group definition */
+#endif /* if !defined( MOTIONPLANNER_TEST_H_ ) */
+/* ******************| End of file |*********************************** */
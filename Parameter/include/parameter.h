@@ -23,6 +23,16 @@
 /* Preprocessor exclusion definition */
 #define PARAMETER_INCLUDE_PARAMETER_H_
 /**
+ * \brief Parameter include file
+ *
+ * Machine parameter which may be changed at runtime, e.g. by M92. The
+ * parameter are kept in a store of two copies guarded by a sequence
+ * counter. A new set of parameter is published at once. Readers always
+ * get a consistent snapshot without disabling interrupts.
+ * Values the planner would otherwise calculate from #parameter for every
+ * move are derived once per update and kept in #derivedParameter.
+ * Sets of parameter are stored in the non-volatile storage of the
+ * platform as CRC protected records, see #Parameter_store.
  *
  * \project BlueMarlin
  * \author kein0r
@@ -35,17 +45,46 @@
  */
 
 /* ******************| Inclusions |************************************ */
+#include <blueMarlin.h>
 
 /* ******************| Macros |**************************************** */
+/**
+ * Layout version of #Parameter_t. Stored records of another version are
+ * ignored. Must be incremented every time #Parameter_t changes.
+ */
+#define PARAMETER_VERSION               (uint8_t)1
+
+/**
+ * Number of records in the storage. Records are written in turn, thus,
+ * each one is only written every PARAMETER_STORAGE_SLOTS-th time. All
+ * records are read at once during start-up.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DPARAMETER_STORAGE_SLOTS 4
+ */
+#ifndef PARAMETER_STORAGE_SLOTS
+#define PARAMETER_STORAGE_SLOTS         (uint8_t)4
+#endif
+
+/**
+ * Address of the first record in the storage of the platform. Must be the
+ * start of a page if the storage is flash.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DPARAMETER_STORAGE_ADDRESS 0
+ */
+#ifndef PARAMETER_STORAGE_ADDRESS
+#define PARAMETER_STORAGE_ADDRESS       (uint16_t)0
+#endif
 
 /* ******************| Type definitions |****************************** */
 /**
- * Struct to store all machine parameter. To be interrupt save changing the
- * parameters is only allowed. Reading can be done by directly accessing the
- * struct elements.
- * Each parameter shall be set during initialization of the module which
- * defines the default value for the respective parameter.
+ * Struct to store all machine parameter. Changes are never made in place
+ * but published as a complete new set with #Parameter_publish.
+ * Each parameter shall be set in #parameter during initialization of the
+ * module which defines the default value for the respective parameter.
  * All parameter are grouped in a struct for easier storage in EEPROM.
+ * version holds the layout version #PARAMETER_VERSION.
  * @note Limiting values for all non-linear kinematics, which needs to be
  * transformed by inverse kinematic, are transformed at the center,
  * that is 0,0,0 of the machine.
@@ -56,16 +95,56 @@ typedef struct {
     AxisCoordinates_t volumetric_multiplier[MACHINE_NUM_EXTRUDER];     /*!< Extrude factor (in percent) for each extruder individually */
     AxisCoordinates_t minimumFeedrate;                                 /*!< Minumum Feedrate for moves in steps/sec */
     AxisCoordinates_t minimumTravelFeedrate;                           /*!< Minumum Feedrate for travel moves in steps/sec */
-    uint16_t segmentsPerSecond;                                        /*!< Number of segment a linear move will be split into per second of movement */
+    uint16_t segmentsPerSecond;                                        /*!< Number of segment a linear move will be split into per second of movement. Only used for non-linear kinematics */
+    WorldCoordinate_t segmentChordalTolerance;                         /*!< Maximum path deviation in mm for segmented moves of non-linear kinematics. Zero to use segmentsPerSecond instead */
+    WorldCoordinate_t deltaDiagonalRod;                                /*!< Length of the diagonal rods of a delta machine in mm */
+    WorldCoordinate_t deltaRadius;                                     /*!< Horizontal distance between effector and carriage joints of a delta machine in mm */
 } Parameter_t;
 
-extern Parameter_t parameter;
+/**
+ * Values derived from #parameter. Recalculated by #Parameter_derive every
+ * time #parameter changes. Modules which keep own values calculated from
+ * #parameter compare version to find out if they must recalculate them.
+ */
+typedef struct {
+    uint8_t version;                                     /*!< Incremented every time the values are derived again */
+    float axisStepsPerUnit[MACHINE_NUM_AXIS];            /*!< Steps per mm of each axis */
+    float extruderStepsPerUnit[MACHINE_NUM_EXTRUDER];    /*!< Steps per mm of each extruder */
+    WorldCoordinate_t segmentChordalToleranceInverse;    /*!< Reciprocal of segmentChordalTolerance in 1/mm, zero if segmentChordalTolerance is zero */
+} Parameter_Derived_t;
+
+/**
+ * One record in the storage
+ */
+typedef struct {
+    uint32_t sequence;                                   /*!< Number of the store which wrote the record, the valid record with the highest number is loaded */
+    Parameter_t parameter;                               /*!< Stored parameter */
+    uint32_t crc;                                        /*!< CRC-32 of all bytes before */
+} Parameter_Record_t;
+
+/**
+ * Statistics of the storage
+ */
+typedef struct {
+    uint32_t sequence;                                   /*!< Sequence of the newest valid record, zero if there is none */
+    uint32_t stores;                                     /*!< Number of records written */
+    uint8_t invalidRecords;                              /*!< Number of records found invalid by the last load */
+} Parameter_StorageStatistics_t;
 
 /* ******************| External function declarations |**************** */
+extern void Parameter_publish(const Parameter_t *update);
+extern void Parameter_read(Parameter_t *snapshot);
+extern uint8_t Parameter_update(void);
+extern void Parameter_derive(void);
+extern uint8_t Parameter_load(Parameter_t *set);
+extern uint8_t Parameter_store(const Parameter_t *set);
 
 /* ******************| External constants |**************************** */
 
 /* ******************| External variables |**************************** */
+extern Parameter_t parameter;
+extern Parameter_Derived_t derivedParameter;
+extern Parameter_StorageStatistics_t Parameter_storageStatistics;
 
 /** @} doxygen end group definition */
 #endif /* if !defined( PARAMETER_INCLUDE_PARAMETER_H_ ) */
@@ -20,10 +20,22 @@
  *
  */
 /**
+ * \brief Parameter source file
  *
  * GNU coding standard (https://www.gnu.org/prep/standards/) shall be
  * followed beside the snake_case_thing. Please use camelCase instead.
  *
+ * The store consists of two copies and a sequence counter. Readers use
+ * the copy selected by the lowest bit of the counter. The writer first
+ * moves all readers to the second copy and updates the first one, then
+ * moves them back and updates the second one. Thus, there is always one
+ * copy which is not written. A reader which was interrupted by the
+ * writer notices the changed counter and simply reads again. A reader
+ * which interrupts the writer, e.g. an interrupt service routine, never
+ * has to.
+ * There shall be only one writer, that is all g-codes changing parameter
+ * are executed in the same context.
+ *
  * \project BlueMarlin
  * \author kein0r
  *
@@ -41,11 +53,135 @@
 /* ******************| Type Definitions |****************************** */
 
 /* ******************| Function Prototypes |*************************** */
+void Parameter_publish(const Parameter_t *update);
+void Parameter_read(Parameter_t *snapshot);
+uint8_t Parameter_update(void);
+void Parameter_derive(void);
+static uint8_t Parameter_snapshot(Parameter_t *snapshot);
 
 /* ******************| Global Variables |****************************** */
-Parameter_t parameter;
+/**
+ * Parameter used by g-code execution and planning. Holds the defaults
+ * set during initialization until they are published. Afterwards only
+ * changed by #Parameter_update, thus, it never changes while a move is
+ * planned.
+ */
+Parameter_t parameter = {PARAMETER_VERSION};
+
+/**
+ * Values derived from #parameter, see #Parameter_derive
+ */
+Parameter_Derived_t derivedParameter;
+
+/**
+ * Both copies of the store
+ */
+static Parameter_t Parameter_copies[2];
+
+/**
+ * Sequence counter of the store. Even while no update is in progress.
+ * Readers use #Parameter_copies at the lowest bit of the counter.
+ */
+static uint8_t Parameter_sequence = 0;
+
+/**
+ * Sequence counter of the store when #parameter was updated last
+ */
+static uint8_t Parameter_updateSequence = 0;
 
 /* ******************| Function Implementation |*********************** */
+/**
+ * \brief Publishes a new set of parameter
+ *
+ * Readers get either the previous or the new set, never a mix of both.
+ * @param[in] update New parameter, usually a modified copy of #parameter
+ * @note Must not be called from different contexts concurrently
+ */
+void Parameter_publish(const Parameter_t *update)
+{
+  uint8_t sequence = Parameter_sequence;
+
+  /* Readers switch to the second copy before the first one is written */
+  __atomic_store_n(&Parameter_sequence, (uint8_t)(sequence + 1), __ATOMIC_RELEASE);
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  Parameter_copies[0] = *update;
+  /* And back to the new set in the first copy */
+  __atomic_store_n(&Parameter_sequence, (uint8_t)(sequence + 2), __ATOMIC_RELEASE);
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  Parameter_copies[1] = *update;
+}
+
+/**
+ * \brief Reads a consistent snapshot of the store
+ *
+ * @param[out] snapshot Copy of the parameter
+ * @return Sequence counter belonging to #snapshot
+ */
+static uint8_t Parameter_snapshot(Parameter_t *snapshot)
+{
+  uint8_t sequence;
+
+  do
+    {
+      sequence = __atomic_load_n(&Parameter_sequence, __ATOMIC_ACQUIRE);
+      *snapshot = Parameter_copies[sequence & 1];
+      /* The copy must be complete before the counter is checked again */
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    }
+  while (__atomic_load_n(&Parameter_sequence, __ATOMIC_RELAXED) != sequence);
+  return sequence;
+}
+
+/**
+ * \brief Reads the last published parameter
+ *
+ * May be called from any context including interrupts and other
+ * threads. Never blocks.
+ * @param[out] snapshot Copy of the parameter
+ */
+void Parameter_read(Parameter_t *snapshot)
+{
+  Parameter_snapshot(snapshot);
+}
+
+/**
+ * \brief Takes over published parameter into #parameter
+ *
+ * To be called by g-code execution at a point where no move is planned.
+ * #derivedParameter is updated as well.
+ * @return RESULT_OK if #parameter was changed, RESULT_NOT_OK if nothing
+ * was published since the last call
+ */
+uint8_t Parameter_update(void)
+{
+  if (__atomic_load_n(&Parameter_sequence, __ATOMIC_ACQUIRE) == Parameter_updateSequence)
+    {
+      return RESULT_NOT_OK;
+    }
+  Parameter_updateSequence = Parameter_snapshot(&parameter);
+  Parameter_derive();
+  return RESULT_OK;
+}
+
+/**
+ * \brief Calculates #derivedParameter from #parameter
+ *
+ * Called by #Parameter_update. Must be called once after all modules
+ * wrote their defaults to #parameter.
+ */
+void Parameter_derive(void)
+{
+  for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++)
+    {
+      derivedParameter.axisStepsPerUnit[i] = parameter.axisStepsPerUnit.axis[i];
+    }
+  for (uint8_t i=0; i<MACHINE_NUM_EXTRUDER; i++)
+    {
+      derivedParameter.extruderStepsPerUnit[i] = parameter.axisStepsPerUnit.extruder[i];
+    }
+  derivedParameter.segmentChordalToleranceInverse = (parameter.segmentChordalTolerance > 0.0) ? 1 / parameter.segmentChordalTolerance : 0.0;
+  derivedParameter.version++;
+}
 
 /** @} doxygen end group definition */
 /* ******************| End of file |*********************************** */
@@ -0,0 +1,180 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * \brief Parameter storage source file
+ *
+ * GNU coding standard (https://www.gnu.org/prep/standards/) shall be
+ * followed beside the snake_case_thing. Please use camelCase instead.
+ *
+ * Parameter are kept in #PARAMETER_STORAGE_SLOTS records one after
+ * another in the non-volatile storage of the platform. Each store writes
+ * the slot following the newest record with the next sequence number.
+ * Thus, the records wear evenly and the previous record is still intact
+ * while the new one is written. A record which was not completely
+ * written, e.g. because of a power loss, fails the CRC and the previous
+ * one is loaded instead.
+ * All records are read at once during start-up, which takes a single
+ * transfer from EEPROM or flash.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+/** \addtogroup Parameter
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <stddef.h>
+#include <string.h>
+#include "parameter.h"
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+uint8_t Parameter_load(Parameter_t *set);
+uint8_t Parameter_store(const Parameter_t *set);
+static uint32_t Parameter_crc(const void *data, uint16_t length);
+
+/* ******************| Global Variables |****************************** */
+static_assert(PARAMETER_STORAGE_ADDRESS + PARAMETER_STORAGE_SLOTS * sizeof(Parameter_Record_t) <= PLATFORM_STORAGE_SIZE,
+              "Parameter records don't fit into the storage of the platform");
+
+/**
+ * CRC-32 (polynomial 0x04C11DB7, reflected) of all values of a nibble.
+ * Small enough for every platform and still only two lookups per byte.
+ */
+static const uint32_t Parameter_crcTable[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+/**
+ * Statistics of the storage
+ */
+Parameter_StorageStatistics_t Parameter_storageStatistics;
+
+/**
+ * Slot of the newest valid record. The first store writes slot 0.
+ */
+static uint8_t Parameter_storageSlot = PARAMETER_STORAGE_SLOTS - 1;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Calculates the CRC-32 of a block of memory
+ *
+ * @param[in] data First byte
+ * @param[in] length Number of bytes
+ * @return CRC-32 as used by Ethernet and zip, that is 0xCBF43926 for
+ * "123456789"
+ */
+static uint32_t Parameter_crc(const void *data, uint16_t length)
+{
+  const uint8_t *byte = (const uint8_t *)data;
+  uint32_t crc = 0xFFFFFFFF;
+
+  for (uint16_t i=0; i<length; i++)
+    {
+      crc ^= byte[i];
+      crc = (crc >> 4) ^ Parameter_crcTable[crc & 0x0F];
+      crc = (crc >> 4) ^ Parameter_crcTable[crc & 0x0F];
+    }
+  return ~crc;
+}
+
+/**
+ * \brief Loads the newest valid record from the storage
+ *
+ * Reads all records at once. A record is valid if its CRC matches and
+ * it was written with the current #PARAMETER_VERSION.
+ * @param[out] set Loaded parameter. Not changed if there is no valid
+ * record, thus, defaults written to it before are kept.
+ * @return RESULT_OK if a record was loaded, RESULT_NOT_OK if not
+ */
+uint8_t Parameter_load(Parameter_t *set)
+{
+  Parameter_Record_t records[PARAMETER_STORAGE_SLOTS];
+  const Parameter_Record_t *newest = NULL;
+
+  Parameter_storageStatistics.invalidRecords = 0;
+  if (Platform_storageRead(PARAMETER_STORAGE_ADDRESS, records, sizeof(records)) != RESULT_OK)
+    {
+      return RESULT_NOT_OK;
+    }
+  for (uint8_t i=0; i<PARAMETER_STORAGE_SLOTS; i++)
+    {
+      if ((Parameter_crc(&records[i], offsetof(Parameter_Record_t, crc)) != records[i].crc) ||
+          (records[i].parameter.version != PARAMETER_VERSION))
+        {
+          Parameter_storageStatistics.invalidRecords++;
+        }
+      /* Sequence numbers may wrap around */
+      else if ((newest == NULL) || ((int32_t)(records[i].sequence - newest->sequence) > 0))
+        {
+          newest = &records[i];
+          Parameter_storageSlot = i;
+        }
+    }
+  if (newest == NULL)
+    {
+      return RESULT_NOT_OK;
+    }
+  *set = newest->parameter;
+  Parameter_storageStatistics.sequence = newest->sequence;
+  return RESULT_OK;
+}
+
+/**
+ * \brief Stores parameter as new record
+ *
+ * Overwrites the slot following the newest record. The newest record
+ * stays intact until the new one is completely written.
+ * @param[in] set Parameter to be stored, usually #parameter
+ * @return RESULT_OK if the record was written, RESULT_NOT_OK if not
+ * @note Blocks until the platform wrote the record
+ */
+uint8_t Parameter_store(const Parameter_t *set)
+{
+  Parameter_Record_t record;
+  uint8_t slot = (Parameter_storageSlot + 1) % PARAMETER_STORAGE_SLOTS;
+
+  /* Padding is covered by the CRC as well */
+  memset(&record, 0, sizeof(record));
+  record.sequence = Parameter_storageStatistics.sequence + 1;
+  record.parameter = *set;
+  record.parameter.version = PARAMETER_VERSION;
+  record.crc = Parameter_crc(&record, offsetof(Parameter_Record_t, crc));
+  if (Platform_storageWrite(PARAMETER_STORAGE_ADDRESS + slot * sizeof(record), &record, sizeof(record)) != RESULT_OK)
+    {
+      return RESULT_NOT_OK;
+    }
+  Parameter_storageSlot = slot;
+  Parameter_storageStatistics.sequence = record.sequence;
+  Parameter_storageStatistics.stores++;
+  return RESULT_OK;
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,221 @@
+/**
+ * \file Parameter_stub.c
+ *
+ * \brief Stubs for Parameter unit tests
+ *
+ * All stubs needed for the unit test of this particular modules shall
+ * be done within this file.
+ * Every field of a parameter set written by the tests holds the same
+ * value, thus, a set mixed from two updates is easily detected. The
+ * reader thread of the stress test reads as fast as possible and checks
+ * every snapshot.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup Parameter
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <pthread.h>
+#include <string.h>
+#include "Parameter_test.h"
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+void ParameterTest_fill(Parameter_t *set, int32_t value);
+bool ParameterTest_check(const Parameter_t *set, int32_t *value);
+void ParameterTest_startReader(void);
+void ParameterTest_stopReader(void);
+static void *ParameterTest_reader(void *argument);
+void ParameterTest_eraseStorage(void);
+uint8_t Platform_storageRead(uint16_t address, void *data, uint16_t length);
+uint8_t Platform_storageWrite(uint16_t address, const void *data, uint16_t length);
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Number of snapshots read by the reader thread
+ */
+uint32_t ParameterTest_reads;
+
+/**
+ * Number of snapshots mixed from different sets
+ */
+uint32_t ParameterTest_inconsistentReads;
+
+/**
+ * Number of snapshots older than the one read before
+ */
+uint32_t ParameterTest_outdatedReads;
+
+/**
+ * Reader thread of the stress test
+ */
+static pthread_t ParameterTest_thread;
+
+/**
+ * Set to end the reader thread
+ */
+static bool ParameterTest_stop;
+
+/**
+ * Storage of the platform
+ */
+uint8_t ParameterTest_storage[PLATFORM_STORAGE_SIZE];
+
+/**
+ * Number of calls to Platform_storageRead()
+ */
+uint32_t ParameterTest_storageReads;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Sets every field of a parameter set to the same value
+ *
+ * @param[out] set Parameter set
+ * @param[in] value Value of all fields
+ */
+void ParameterTest_fill(Parameter_t *set, int32_t value)
+{
+  set->version = (uint8_t)value;
+  for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++)
+    {
+      set->axisStepsPerUnit.axis[i] = value;
+      set->minimumFeedrate.axis[i] = value;
+      set->minimumTravelFeedrate.axis[i] = value;
+    }
+  for (uint8_t i=0; i<MACHINE_NUM_EXTRUDER; i++)
+    {
+      set->axisStepsPerUnit.extruder[i] = value;
+      set->minimumFeedrate.extruder[i] = value;
+      set->minimumTravelFeedrate.extruder[i] = value;
+    }
+  set->segmentsPerSecond = (uint16_t)value;
+  set->segmentChordalTolerance = (WorldCoordinate_t)value;
+  set->deltaDiagonalRod = (WorldCoordinate_t)value;
+  set->deltaRadius = (WorldCoordinate_t)value;
+}
+
+/**
+ * \brief Checks if all fields of a parameter set hold the same value
+ *
+ * @param[in] set Parameter set
+ * @param[out] value Value of the set
+ * @return True if the set is consistent
+ */
+bool ParameterTest_check(const Parameter_t *set, int32_t *value)
+{
+  bool consistent;
+
+  *value = set->axisStepsPerUnit.axis[0];
+  consistent = (set->version == (uint8_t)*value) && (set->segmentsPerSecond == (uint16_t)*value) &&
+               (set->segmentChordalTolerance == (WorldCoordinate_t)*value) &&
+               (set->deltaDiagonalRod == (WorldCoordinate_t)*value) && (set->deltaRadius == (WorldCoordinate_t)*value);
+  for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++)
+    {
+      consistent = consistent && (set->axisStepsPerUnit.axis[i] == *value) && (set->minimumFeedrate.axis[i] == *value) &&
+                   (set->minimumTravelFeedrate.axis[i] == *value);
+    }
+  for (uint8_t i=0; i<MACHINE_NUM_EXTRUDER; i++)
+    {
+      consistent = consistent && (set->axisStepsPerUnit.extruder[i] == *value) && (set->minimumFeedrate.extruder[i] == *value) &&
+                   (set->minimumTravelFeedrate.extruder[i] == *value);
+    }
+  return consistent;
+}
+
+/**
+ * \brief Reader thread of the stress test
+ *
+ * @param[in] argument Not used
+ * @return Not used
+ */
+static void *ParameterTest_reader(void *argument)
+{
+  Parameter_t snapshot;
+  int32_t value;
+  int32_t lastValue = 0;
+
+  while (!__atomic_load_n(&ParameterTest_stop, __ATOMIC_RELAXED))
+    {
+      Parameter_read(&snapshot);
+      ParameterTest_reads++;
+      if (!ParameterTest_check(&snapshot, &value))
+        {
+          ParameterTest_inconsistentReads++;
+        }
+      else if (value < lastValue)
+        {
+          ParameterTest_outdatedReads++;
+        }
+      lastValue = value;
+    }
+  return NULL;
+}
+
+/**
+ * \brief Starts the reader thread
+ */
+void ParameterTest_startReader(void)
+{
+  ParameterTest_reads = 0;
+  ParameterTest_inconsistentReads = 0;
+  ParameterTest_outdatedReads = 0;
+  ParameterTest_stop = false;
+  pthread_create(&ParameterTest_thread, NULL, ParameterTest_reader, NULL);
+}
+
+/**
+ * \brief Stops the reader thread and waits for its end
+ */
+void ParameterTest_stopReader(void)
+{
+  __atomic_store_n(&ParameterTest_stop, true, __ATOMIC_RELAXED);
+  pthread_join(ParameterTest_thread, NULL);
+}
+
+/**
+ * \brief Erases the storage and clears the read counter
+ */
+void ParameterTest_eraseStorage(void)
+{
+  memset(ParameterTest_storage, 0xFF, sizeof(ParameterTest_storage));
+  ParameterTest_storageReads = 0;
+}
+
+/**
+ * \brief Stub of the platform storage, reads from #ParameterTest_storage
+ */
+uint8_t Platform_storageRead(uint16_t address, void *data, uint16_t length)
+{
+  ParameterTest_storageReads++;
+  if ((uint32_t)address + length > PLATFORM_STORAGE_SIZE)
+    {
+      return RESULT_NOT_OK;
+    }
+  memcpy(data, &ParameterTest_storage[address], length);
+  return RESULT_OK;
+}
+
+/**
+ * \brief Stub of the platform storage, writes to #ParameterTest_storage
+ */
+uint8_t Platform_storageWrite(uint16_t address, const void *data, uint16_t length)
+{
+  if ((uint32_t)address + length > PLATFORM_STORAGE_SIZE)
+    {
+      return RESULT_NOT_OK;
+    }
+  memcpy(&ParameterTest_storage[address], data, length);
+  return RESULT_OK;
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,287 @@
+/**
+ * \file Parameter_test.c
+ *
+ * \brief Parameter unit test implementation
+ *
+ * Please see http://embunit.sourceforge.net/ for more information. For
+ * detailed documentation see http://embunit.sourceforge.net/embunit/index.html
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup Parameter
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include "Parameter_test.h"
+/* Include .cpp file to be tested in order to get access to all private
+ * or static functions */
+#include "../src/parameter.cpp"
+#include "../src/parameterStorage.cpp"
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+
+/* ******************| Global Variables |****************************** */
+
+/* ******************| Function Implementation |*********************** */
+
+/**
+ * Publish and update
+ * Test if a published set is read back
+ * Test if #parameter is only changed by Parameter_update() and only once
+ * per publish
+ */
+static void Parameter_Parameter_publish_1(void)
+{
+  Parameter_t set;
+  int32_t value;
+
+  ParameterTest_fill(&set, 80);
+  Parameter_publish(&set);
+  ParameterTest_fill(&set, 0);
+  Parameter_read(&set);
+  TEST_ASSERT(ParameterTest_check(&set, &value));
+  TEST_ASSERT_EQUAL_INT(80, value);
+
+  TEST_ASSERT_EQUAL_INT(0, parameter.axisStepsPerUnit.axis[0]);
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, Parameter_update());
+  TEST_ASSERT(ParameterTest_check(&parameter, &value));
+  TEST_ASSERT_EQUAL_INT(80, value);
+  TEST_ASSERT_EQUAL_INT(RESULT_NOT_OK, Parameter_update());
+}
+
+/**
+ * Reader interrupting the writer
+ * Test if a reader running while the first copy is written gets the
+ * complete previous set from the second copy without retrying
+ */
+static void Parameter_Parameter_read_1(void)
+{
+  Parameter_t set;
+  int32_t value;
+
+  ParameterTest_fill(&set, 100);
+  Parameter_publish(&set);
+  /* State of the store in the middle of Parameter_publish() */
+  Parameter_sequence++;
+  ParameterTest_fill(&Parameter_copies[0], 200);
+  Parameter_copies[0].deltaRadius = 0.0;
+
+  Parameter_read(&set);
+  TEST_ASSERT(ParameterTest_check(&set, &value));
+  TEST_ASSERT_EQUAL_INT(100, value);
+}
+
+/**
+ * Stress test
+ * Test if a reader thread reading as fast as possible while sets are
+ * published never gets a mixed or an older set than before
+ */
+static void Parameter_Parameter_read_2(void)
+{
+  Parameter_t set;
+  int32_t value;
+
+  ParameterTest_startReader();
+  for (uint32_t i=1; i<=PARAMETER_TEST_UPDATES; i++)
+    {
+      ParameterTest_fill(&set, (int32_t)i);
+      Parameter_publish(&set);
+    }
+  ParameterTest_stopReader();
+
+  TEST_ASSERT(ParameterTest_reads > 0);
+  TEST_ASSERT_EQUAL_INT(0, ParameterTest_inconsistentReads);
+  TEST_ASSERT_EQUAL_INT(0, ParameterTest_outdatedReads);
+  Parameter_read(&set);
+  TEST_ASSERT(ParameterTest_check(&set, &value));
+  TEST_ASSERT_EQUAL_INT(PARAMETER_TEST_UPDATES, value);
+}
+
+/**
+ * Derived parameter
+ * Test if derived values are recalculated and the version changes with
+ * every update
+ * Test if a chordal tolerance of zero results in a reciprocal of zero
+ */
+static void Parameter_Parameter_derive_1(void)
+{
+  Parameter_t set;
+  uint8_t version = derivedParameter.version;
+
+  ParameterTest_fill(&set, 4);
+  Parameter_publish(&set);
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, Parameter_update());
+  TEST_ASSERT(derivedParameter.version != version);
+  TEST_ASSERT(derivedParameter.axisStepsPerUnit[MACHINE_NUM_AXIS - 1] == 4.0f);
+  TEST_ASSERT(derivedParameter.extruderStepsPerUnit[MACHINE_NUM_EXTRUDER - 1] == 4.0f);
+  TEST_ASSERT(derivedParameter.segmentChordalToleranceInverse == 0.25f);
+
+  version = derivedParameter.version;
+  TEST_ASSERT_EQUAL_INT(RESULT_NOT_OK, Parameter_update());
+  TEST_ASSERT_EQUAL_INT(version, derivedParameter.version);
+
+  set.segmentChordalTolerance = 0.0;
+  Parameter_publish(&set);
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, Parameter_update());
+  TEST_ASSERT(derivedParameter.version != version);
+  TEST_ASSERT(derivedParameter.segmentChordalToleranceInverse == 0.0f);
+}
+
+/**
+ * Store and load
+ * Test if an empty storage keeps the defaults with a single read
+ * Test if a stored set is loaded back with the current version
+ * Test if the CRC is the common CRC-32
+ */
+static void Parameter_Parameter_store_1(void)
+{
+  Parameter_t set;
+  int32_t value;
+
+  TEST_ASSERT_EQUAL_INT(0xCBF43926, Parameter_crc("123456789", 9));
+
+  ParameterTest_fill(&set, 30);
+  TEST_ASSERT_EQUAL_INT(RESULT_NOT_OK, Parameter_load(&set));
+  TEST_ASSERT_EQUAL_INT(1, ParameterTest_storageReads);
+  TEST_ASSERT_EQUAL_INT(PARAMETER_STORAGE_SLOTS, Parameter_storageStatistics.invalidRecords);
+  TEST_ASSERT(ParameterTest_check(&set, &value));
+  TEST_ASSERT_EQUAL_INT(30, value);
+
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, Parameter_store(&set));
+  ParameterTest_fill(&set, 0);
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, Parameter_load(&set));
+  TEST_ASSERT_EQUAL_INT(2, ParameterTest_storageReads);
+  TEST_ASSERT_EQUAL_INT(PARAMETER_STORAGE_SLOTS - 1, Parameter_storageStatistics.invalidRecords);
+  TEST_ASSERT_EQUAL_INT(PARAMETER_VERSION, set.version);
+  /* Version is set by Parameter_store() */
+  set.version = 30;
+  TEST_ASSERT(ParameterTest_check(&set, &value));
+  TEST_ASSERT_EQUAL_INT(30, value);
+}
+
+/**
+ * Wear leveling
+ * Test if records are written in turn to all slots
+ * Test if the newest record is loaded after the sequence wrapped around
+ */
+static void Parameter_Parameter_store_2(void)
+{
+  Parameter_Record_t *records = (Parameter_Record_t *)&ParameterTest_storage[PARAMETER_STORAGE_ADDRESS];
+  Parameter_t set;
+  int32_t value;
+
+  Parameter_storageStatistics.sequence = 0xFFFFFFFF - PARAMETER_STORAGE_SLOTS + 1;
+  for (uint8_t i=1; i<=2 * PARAMETER_STORAGE_SLOTS; i++)
+    {
+      ParameterTest_fill(&set, i);
+      TEST_ASSERT_EQUAL_INT(RESULT_OK, Parameter_store(&set));
+      TEST_ASSERT_EQUAL_INT(i, records[(i - 1) % PARAMETER_STORAGE_SLOTS].parameter.axisStepsPerUnit.axis[0]);
+    }
+  TEST_ASSERT_EQUAL_INT(2 * PARAMETER_STORAGE_SLOTS, Parameter_storageStatistics.stores);
+
+  Parameter_storageSlot = 0;
+  Parameter_storageStatistics.sequence = 0;
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, Parameter_load(&set));
+  TEST_ASSERT_EQUAL_INT(0, Parameter_storageStatistics.invalidRecords);
+  TEST_ASSERT_EQUAL_INT(PARAMETER_STORAGE_SLOTS - 1, Parameter_storageSlot);
+  TEST_ASSERT_EQUAL_INT(PARAMETER_STORAGE_SLOTS, Parameter_storageStatistics.sequence);
+  set.version = 2 * PARAMETER_STORAGE_SLOTS;
+  TEST_ASSERT(ParameterTest_check(&set, &value));
+  TEST_ASSERT_EQUAL_INT(2 * PARAMETER_STORAGE_SLOTS, value);
+}
+
+/**
+ * Invalid records
+ * Test if the previous record is loaded if the newest one is corrupted,
+ * e.g. by a power loss while it was written
+ * Test if records of another version are ignored
+ */
+static void Parameter_Parameter_load_1(void)
+{
+  Parameter_Record_t *records = (Parameter_Record_t *)&ParameterTest_storage[PARAMETER_STORAGE_ADDRESS];
+  Parameter_t set;
+  int32_t value;
+
+  ParameterTest_fill(&set, 1);
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, Parameter_store(&set));
+  ParameterTest_fill(&set, 2);
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, Parameter_store(&set));
+  records[1].parameter.deltaRadius = 0.0;
+
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, Parameter_load(&set));
+  TEST_ASSERT_EQUAL_INT(PARAMETER_STORAGE_SLOTS - 1, Parameter_storageStatistics.invalidRecords);
+  set.version = 1;
+  TEST_ASSERT(ParameterTest_check(&set, &value));
+  TEST_ASSERT_EQUAL_INT(1, value);
+  /* The corrupted record is overwritten next */
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, Parameter_store(&set));
+  TEST_ASSERT_EQUAL_INT(2, Parameter_storageStatistics.sequence);
+  TEST_ASSERT_EQUAL_INT(1, records[1].parameter.axisStepsPerUnit.axis[0]);
+
+  /* Record of another version with a valid CRC */
+  records[1].parameter.version = PARAMETER_VERSION + 1;
+  records[1].crc = Parameter_crc(&records[1], offsetof(Parameter_Record_t, crc));
+  ParameterTest_fill(&set, 0);
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, Parameter_load(&set));
+  TEST_ASSERT_EQUAL_INT(1, Parameter_storageStatistics.sequence);
+  TEST_ASSERT_EQUAL_INT(0, Parameter_storageSlot);
+}
+
+/**
+ * Test Setup function which is called before all each test case
+ */
+static void setUpParameter(void)
+{
+  ParameterTest_fill(&parameter, 0);
+  ParameterTest_fill(&Parameter_copies[0], 0);
+  ParameterTest_fill(&Parameter_copies[1], 0);
+  Parameter_sequence = 0;
+  Parameter_updateSequence = 0;
+  ParameterTest_eraseStorage();
+  memset(&Parameter_storageStatistics, 0, sizeof(Parameter_storageStatistics));
+  Parameter_storageSlot = PARAMETER_STORAGE_SLOTS - 1;
+}
+
+/**
+ * Test Teardown function which is called for after each test
+ */
+static void tearDownParameter(void)
+{
+}
+
+TestRef Parameter_test_RunTests(void)
+{
+  EMB_UNIT_TESTFIXTURES(fixtures) {
+    new_TestFixture("Test case Parameter_Parameter_publish_1", Parameter_Parameter_publish_1),
+    new_TestFixture("Test case Parameter_Parameter_read_1", Parameter_Parameter_read_1),
+    new_TestFixture("Test case Parameter_Parameter_read_2", Parameter_Parameter_read_2),
+    new_TestFixture("Test case Parameter_Parameter_derive_1", Parameter_Parameter_derive_1),
+    new_TestFixture("Test case Parameter_Parameter_store_1", Parameter_Parameter_store_1),
+    new_TestFixture("Test case Parameter_Parameter_store_2", Parameter_Parameter_store_2),
+    new_TestFixture("Test case Parameter_Parameter_load_1", Parameter_Parameter_load_1)
+  };
+  EMB_UNIT_TESTCALLER(Parameter_tests,"Parameter Unit test",setUpParameter,tearDownParameter,fixtures);
+  return (TestRef)&Parameter_tests;
+}
+
+/**
+ *
+ */
+int main(void)
+{
+  TestRunner_start();
+  TestRunner_runTest(Parameter_test_RunTests());
+  TestRunner_end();
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,50 @@
+#if (!defined PARAMETER_TEST_H_)
+/* Preprocessor exclusion definition */
+#define PARAMETER_TEST_H_
+/**
+ * \file Parameter_test.h
+ *
+ * \brief Parameter include file for test driver
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup Parameter
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <embUnit/embUnit.h>
+#include <platform.h>
+#include <parameter.h>
+
+/* ******************| Macros |**************************************** */
+/**
+ * Number of parameter sets published by the stress test
+ */
+#define PARAMETER_TEST_UPDATES        (uint32_t)2000000
+
+/* ******************| Type definitions |****************************** */
+
+/* ******************| External function declarations |**************** */
+extern void ParameterTest_fill(Parameter_t *set, int32_t value);
+extern bool ParameterTest_check(const Parameter_t *set, int32_t *value);
+extern void ParameterTest_startReader(void);
+extern void ParameterTest_stopReader(void);
+extern void ParameterTest_eraseStorage(void);
+
+/* ******************| External constants |**************************** */
+
+/* ******************| External variables |**************************** */
+extern uint32_t ParameterTest_reads;
+extern uint32_t ParameterTest_inconsistentReads;
+extern uint32_t ParameterTest_outdatedReads;
+extern uint8_t ParameterTest_storage[PLATFORM_STORAGE_SIZE];
+extern uint32_t ParameterTest_storageReads;
+
+/** @} doxygen end group definition */
+#endif /* if !defined( PARAMETER_TEST_H_ ) */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,208 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#if (!defined PLATFORM_INCLUDE_PLATFORM_H_)
+/* Preprocessor exclusion definition */
+#define PLATFORM_INCLUDE_PLATFORM_H_
+/**
+ * \file platform.h
+ *
+ * \brief Platform module include file
+ *
+ * The inclusion protection does not obey the naming because there shall
+ * be only one platform used at a time.
+ * Runs the firmware natively on a 64 bit Linux host, see Readme.md.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+/** \addtogroup Platform_LinuxX86_64
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+/* Standard headers must be included before the Arduino like macros below
+ * are defined. Otherwise the macros will clash with the declarations of
+ * abs() and friends. */
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+#ifndef __cplusplus
+#include <stdbool.h>
+#endif
+
+/* ******************| Macros |**************************************** */
+/**
+ * \brief Return values to be used by all functions
+ */
+#define RESULT_OK       (uint8_t)1
+#define RESULT_NOT_OK   (uint8_t)0
+
+/**
+ * Macros from Arduino.h
+ */
+#define min(a,b) ((a)<(b)?(a):(b))
+#define max(a,b) ((a)>(b)?(a):(b))
+#define abs(x) ((x)>0?(x):-(x))
+#define sq(x) ((x)*(x))
+
+/**
+ * Macros from Arduino sfr_defs.h
+ */
+#define _BV(bit) (1 << (bit))
+
+/*
+ * Platform module shall specify TRUE/FALSE.
+ */
+#undef FALSE
+#undef TRUE
+#define FALSE	0
+#define TRUE	1
+
+/**
+ * Baud rate used if a serial device is opened.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DPLATFORM_SERIAL_BAUDRATE 115200
+ */
+#ifndef PLATFORM_SERIAL_BAUDRATE
+#define PLATFORM_SERIAL_BAUDRATE          (uint32_t)115200
+#endif
+
+/**
+ * Size of the non-volatile storage for parameter [bytes]. Same as the
+ * EEPROM of an ATmega2560.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DPLATFORM_STORAGE_SIZE 4096
+ */
+#ifndef PLATFORM_STORAGE_SIZE
+#define PLATFORM_STORAGE_SIZE             (uint16_t)4096
+#endif
+
+/**
+ * Time a thread of the threaded runtime sleeps if it has nothing to do or
+ * waits for the next thread [µs]
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DPLATFORM_THREAD_IDLE_TIME 100
+ */
+#ifndef PLATFORM_THREAD_IDLE_TIME
+#define PLATFORM_THREAD_IDLE_TIME         (uint32_t)100
+#endif
+
+/**
+ * The step thread spins instead of sleeping if the next step timer
+ * interrupt is due within this time. Covers the wake-up latency of the
+ * host [µs]
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DPLATFORM_THREAD_SPIN_TIME 50
+ */
+#ifndef PLATFORM_THREAD_SPIN_TIME
+#define PLATFORM_THREAD_SPIN_TIME         (uint32_t)50
+#endif
+
+/**
+ * Threads of the threaded runtime
+ */
+#define PLATFORM_THREAD_READER            (uint8_t)0
+#define PLATFORM_THREAD_PLANNER           (uint8_t)1
+#define PLATFORM_THREAD_STEPPER           (uint8_t)2
+#define PLATFORM_THREAD_NUM               (uint8_t)3
+
+/* ******************| Type definitions |****************************** */
+/**
+ * Platform module shall specify the following data types.
+ * - uint8_t, int8_t,
+ * - uint16_t, int16_t,
+ * - uint32_t, int32_t
+ * - uint64_t, int64_t
+ * - bool
+ * On Linux they are taken from stdint.h and stdbool.h.
+ */
+
+/**
+ * Statistics of the step timer
+ */
+typedef struct
+{
+  uint64_t isrCalls;       /*!< Number of calls of the step timer interrupt */
+  uint64_t stepEvents;     /*!< Number of step events, i.e. calls of #Platform_stepperWriteStep */
+  uint64_t latenessSum;    /*!< Sum of the lateness of all calls [ticks] */
+  uint32_t maxLateness;    /*!< Longest time a call was later than its compare value [ticks] */
+} Platform_StepperTimerStatistics_t;
+
+/**
+ * Statistics of one thread of the threaded runtime
+ */
+typedef struct
+{
+  uint64_t iterations;     /*!< Number of iterations of the thread's loop */
+  uint64_t busyTime;       /*!< Time spent outside of sleeping or waiting for data [ns] */
+  uint64_t runTime;        /*!< Time from start to end of the thread [ns] */
+  uint64_t stalls;         /*!< Number of iterations in which the next thread did not accept more data */
+} Platform_ThreadStatistics_t;
+
+/* ******************| External function declarations |**************** */
+#ifdef __cplusplus
+extern "C" {
+#endif
+extern void setup(void);
+extern void loop(void);
+extern void Platform_stepperWriteDirection(uint8_t directionBits);
+extern void Platform_stepperWriteStep(uint8_t stepBits);
+extern void Platform_stepperTimerPoll(void);
+extern uint64_t Platform_stepperTimerNext(void);
+extern uint8_t Platform_serialOpen(const char *device, uint32_t baudrate);
+extern void Platform_serialClose(void);
+extern void Platform_serialReceive(void);
+extern void Platform_serialWrite(const uint8_t *data, uint8_t length);
+extern void Platform_serialWait(uint32_t timeout);
+extern uint8_t Platform_threadStart(const int16_t cpu[PLATFORM_THREAD_NUM], int priority);
+extern void Platform_threadStop(void);
+extern uint8_t Platform_storageOpen(const char *fileName);
+extern void Platform_storageClose(void);
+extern uint8_t Platform_storageRead(uint16_t address, void *data, uint16_t length);
+extern uint8_t Platform_storageWrite(uint16_t address, const void *data, uint16_t length);
+extern uint64_t Platform_clockNanoseconds(void);
+extern void Platform_clockSleepUntil(uint64_t nanoseconds);
+extern uint64_t Platform_timeMicros(void);
+extern uint64_t Platform_timeCycles(void);
+extern void Platform_timeSleepUntil(uint64_t deadline);
+extern uint32_t micros(void);
+extern uint32_t millis(void);
+#ifdef __cplusplus
+}
+#endif
+
+/* ******************| External constants |**************************** */
+
+/* ******************| External variables |**************************** */
+extern uint32_t Platform_stepperTimerTime;
+extern int32_t Platform_stepperPosition[8];
+extern Platform_StepperTimerStatistics_t Platform_stepperTimerStatistics;
+extern Platform_ThreadStatistics_t Platform_threadStatistics[PLATFORM_THREAD_NUM];
+
+/** @} doxygen end group definition */
+#endif /* if !defined( PLATFORM_INCLUDE_PLATFORM_H_ ) */
+/* ******************| End of file |*********************************** */
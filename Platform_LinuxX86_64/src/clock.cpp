@@ -0,0 +1,183 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * \file clock.cpp
+ *
+ * \brief Monotonic clock of the Linux host
+ *
+ * All time of this platform is derived from CLOCK_MONOTONIC which is not
+ * affected by changes of the system time. Time is counted from the first
+ * use of the clock.
+ * Sleeping uses a one-shot timerfd with absolute expiry per thread, so a
+ * deadline is never missed by the time it takes to calculate a relative
+ * timeout.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+/** \addtogroup Platform_LinuxX86_64
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/timerfd.h>
+#include <x86intrin.h>
+#include "platform.h"
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+static uint64_t Platform_clockRead(void);
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Value of CLOCK_MONOTONIC at the first use of the clock [ns]
+ */
+static uint64_t Platform_clockStart = Platform_clockRead();
+
+/**
+ * Deadline timer of the calling thread. Created on first use, lives as
+ * long as the process.
+ */
+static __thread int Platform_clockTimer = -1;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Reads CLOCK_MONOTONIC
+ *
+ * @return Current value of CLOCK_MONOTONIC [ns]
+ */
+static uint64_t Platform_clockRead(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * \brief Time since start in nanoseconds
+ *
+ * @return Time since start [ns]
+ */
+uint64_t Platform_clockNanoseconds(void)
+{
+  return Platform_clockRead() - Platform_clockStart;
+}
+
+/**
+ * \brief Sleeps until the given time since start
+ *
+ * Returns immediately if the time has passed and early if a signal is
+ * received.
+ * @param[in] nanoseconds Time since start to wake up [ns]
+ */
+void Platform_clockSleepUntil(uint64_t nanoseconds)
+{
+  struct itimerspec timer = {};
+  struct timespec wakeUp;
+  uint64_t absolute = Platform_clockStart + nanoseconds;
+  uint64_t expirations;
+
+  wakeUp.tv_sec = (time_t)(absolute / 1000000000ULL);
+  wakeUp.tv_nsec = (long)(absolute % 1000000000ULL);
+  if (Platform_clockTimer < 0)
+    {
+      Platform_clockTimer = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    }
+  timer.it_value = wakeUp;
+  if ((Platform_clockTimer >= 0) && (timerfd_settime(Platform_clockTimer, TFD_TIMER_ABSTIME, &timer, NULL) == 0))
+    {
+      /* Blocks until the timer expired */
+      if (read(Platform_clockTimer, &expirations, sizeof(expirations)) < 0)
+        {
+          /* Interrupted by a signal, nothing to be done */
+        }
+    }
+  else
+    {
+      clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeUp, NULL);
+    }
+}
+
+/**
+ * \brief Time since start in microseconds
+ *
+ * @return Time since start [µs]
+ */
+uint64_t Platform_timeMicros(void)
+{
+  return Platform_clockNanoseconds() / 1000ULL;
+}
+
+/**
+ * \brief Cycle counter of the host
+ *
+ * @return Time stamp counter of the CPU [cycles]. Not synchronized between
+ * CPUs on all hosts, compare values of the same thread only.
+ */
+uint64_t Platform_timeCycles(void)
+{
+  return __rdtsc();
+}
+
+/**
+ * \brief Sleeps until the given time
+ *
+ * @param[in] deadline Time to wake up, see #Platform_timeMicros [µs]
+ */
+void Platform_timeSleepUntil(uint64_t deadline)
+{
+  Platform_clockSleepUntil(deadline * 1000ULL);
+}
+
+/**
+ * \brief Time since start in microseconds
+ *
+ * Replaces micros() of the Arduino framework.
+ * @return Time since start [µs]. Overflows after approximately 70 minutes.
+ */
+uint32_t micros(void)
+{
+  return (uint32_t)Platform_timeMicros();
+}
+
+/**
+ * \brief Time since start in milliseconds
+ *
+ * Replaces millis() of the Arduino framework.
+ * @return Time since start [ms]. Overflows after approximately 50 days.
+ */
+uint32_t millis(void)
+{
+  return (uint32_t)(Platform_clockNanoseconds() / 1000000ULL);
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,374 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * \file main.cpp
+ *
+ * \brief Main function of the Linux host
+ *
+ * Runs the firmware in real time on a Linux host. The step timer is
+ * polled after each call of loop(). While the machine is waiting, e.g.
+ * for the end of a dwell, the process sleeps until the next step timer
+ * interrupt or the next fixed-rate task of the scheduler is due instead
+ * of spinning.
+ * Optionally the process is run with real-time priority (SCHED_FIFO) and
+ * its memory is locked to keep page faults out of the loop. Both require
+ * the respective privileges (CAP_SYS_NICE, CAP_IPC_LOCK).
+ * With -t the firmware runs in three threads instead, see thread.cpp.
+ * SIGINT and SIGTERM shut the firmware down and print the step timer
+ * statistics.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+/** \addtogroup Platform_LinuxX86_64
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+/* Must be included before platform.h because of macros min and max */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "platform.h"
+#include <blueMarlin.h>
+#include <stepper.h>
+#include <scheduler.h>
+#include <serial.h>
+#include <parameter.h>
+#include <trace.h>
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+static void Platform_signalHandler(int signal);
+static void Platform_usage(const char *name);
+static uint8_t Platform_parseCpus(const char *list, int16_t cpu[PLATFORM_THREAD_NUM]);
+static void Platform_report(uint64_t loops, bool threaded, uint64_t setupTime);
+static void Platform_writeTrace(const char *fileName);
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Set by the signal handler to end the main loop
+ */
+static volatile sig_atomic_t Platform_shutdown = 0;
+
+/**
+ * Names of the threads of the threaded runtime used in the report
+ */
+static const char * const Platform_threadNames[PLATFORM_THREAD_NUM] = {"Reader", "Planner", "Stepper"};
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Requests shutdown of the main loop
+ *
+ * @param[in] signal Received signal
+ */
+static void Platform_signalHandler(int signal)
+{
+  Platform_shutdown = 1;
+}
+
+/**
+ * \brief Prints the command line options
+ *
+ * @param[in] name Name of the executable
+ */
+static void Platform_usage(const char *name)
+{
+  fprintf(stderr, "Usage: %s [-d <device>] [-b <baud rate>] [-p <priority>] [-l] [-t [-c <cpus>]] [-e <file>] [-r <file>]\n", name);
+  fprintf(stderr, "  -d <device>     Serial device, a pseudo terminal is created if omitted\n");
+  fprintf(stderr, "  -b <baud rate>  Baud rate of the serial device (default %u)\n", PLATFORM_SERIAL_BAUDRATE);
+  fprintf(stderr, "  -p <priority>   Run with SCHED_FIFO and the given priority\n");
+  fprintf(stderr, "  -l              Lock all memory of the process\n");
+  fprintf(stderr, "  -t              Run reader, planner and stepper in separate threads\n");
+  fprintf(stderr, "  -c <cpus>       CPUs of reader, planner and stepper thread, e.g. 1,2,3\n");
+  fprintf(stderr, "                  (default: last three CPUs), -1 leaves a thread unpinned\n");
+  fprintf(stderr, "  -e <file>       Keep the parameter storage (EEPROM) in the given file,\n");
+  fprintf(stderr, "                  it is lost at exit if omitted\n");
+  fprintf(stderr, "  -r <file>       Write the recorded events to the given file at exit\n");
+}
+
+/**
+ * \brief Parses the CPU list of the threads
+ *
+ * @param[in] list Comma separated CPU numbers of reader, planner and
+ * stepper thread
+ * @param[out] cpu CPU of each thread
+ * @return RESULT_OK if the list contains one number for each thread,
+ * RESULT_NOT_OK if not
+ */
+static uint8_t Platform_parseCpus(const char *list, int16_t cpu[PLATFORM_THREAD_NUM])
+{
+  char *end;
+
+  for (uint8_t i=0; i<PLATFORM_THREAD_NUM; i++)
+    {
+      cpu[i] = (int16_t)strtol(list, &end, 10);
+      if ((end == list) || (*end != ((i < (PLATFORM_THREAD_NUM - 1)) ? ',' : '\0')))
+        {
+          return RESULT_NOT_OK;
+        }
+      list = end + 1;
+    }
+  return RESULT_OK;
+}
+
+/**
+ * \brief Prints the serial, scheduler and step timer statistics
+ *
+ * @param[in] loops Number of calls of loop()
+ * @param[in] threaded True if the threaded runtime was used
+ * @param[in] setupTime Time spent in setup() [ns], that is from power-on
+ * to a ready motion planner
+ */
+static void Platform_report(uint64_t loops, bool threaded, uint64_t setupTime)
+{
+  Platform_ThreadStatistics_t *thread;
+  Scheduler_TaskStatistics_t *task;
+
+  Platform_StepperTimerStatistics_t *statistics = &Platform_stepperTimerStatistics;
+  double nanosecondsPerTick = 1.0e9 / STEPPER_TIMER_FREQUENCY;
+
+  printf("Run time:           %12.6f s\n", (double)Platform_clockNanoseconds() / 1.0e9);
+  printf("Setup time:         %12.1f us %12u parameter record\n", (double)setupTime / 1.0e3, Parameter_storageStatistics.sequence);
+  printf("Received:           %12u bytes %12u lines %8u overruns\n", Serial_statistics.bytes, Serial_statistics.lines,
+         Serial_statistics.overruns);
+  if (threaded)
+    {
+      for (uint8_t i=0; i<PLATFORM_THREAD_NUM; i++)
+        {
+          thread = &Platform_threadStatistics[i];
+          printf("%-8s thread:    %12llu iterations %6.2f %% busy %12llu stalls\n", Platform_threadNames[i],
+                 (unsigned long long)thread->iterations,
+                 (thread->runTime > 0) ? (100.0 * thread->busyTime / thread->runTime) : 0.0,
+                 (unsigned long long)thread->stalls);
+        }
+    }
+  else
+    {
+      printf("Loops:              %12llu\n", (unsigned long long)loops);
+      printf("Max round time:     %12u us\n", Scheduler_statistics.maxRoundTime);
+      printf("Max loop latency:   %12u us\n", Scheduler_statistics.maxRoundInterval);
+      for (uint8_t i=0; i<Scheduler_numTasks; i++)
+        {
+          task = &Scheduler_tasks[i].statistics;
+          printf("Task %-14s %12u runs %8.1f us mean %8u us max %8u overruns %8u deadline misses\n", Scheduler_tasks[i].name,
+                 task->runs, (task->runs > 0) ? ((double)task->totalTime / task->runs) : 0.0,
+                 task->maxTime, task->overruns, task->deadlineMisses);
+        }
+    }
+  printf("Interrupt calls:    %12llu\n", (unsigned long long)statistics->isrCalls);
+  printf("Step events:        %12llu\n", (unsigned long long)statistics->stepEvents);
+  printf("Mean lateness:      %12.0f ns\n", (statistics->isrCalls > 0) ? ((double)statistics->latenessSum / statistics->isrCalls * nanosecondsPerTick) : 0.0);
+  printf("Max lateness:       %12.0f ns\n", (double)statistics->maxLateness * nanosecondsPerTick);
+  for (uint8_t i=0; i<STEPPER_NUM_STEPPER; i++)
+    {
+      printf("Position stepper %u: %12d steps\n", i, Platform_stepperPosition[i]);
+    }
+}
+
+/**
+ * \brief Writes the recorded events, see Trace module
+ *
+ * @param[in] fileName Name of the dump file
+ */
+static void Platform_writeTrace(const char *fileName)
+{
+#if (TRACE_ENABLE)
+  Trace_Header_t header;
+  FILE *file = fopen(fileName, "wb");
+
+  if (file == NULL)
+    {
+      perror("Can't write trace");
+      return;
+    }
+  Trace_header(&header);
+  fwrite(&header, sizeof(header), 1, file);
+  for (uint32_t i=0; i<header.records; i++)
+    {
+      fwrite(Trace_get(i), sizeof(Trace_Record_t), 1, file);
+    }
+  fclose(file);
+  printf("Trace:              %12u records %8u lost\n", header.records, header.lostRecords);
+#else
+  fprintf(stderr, "No trace written to %s, build with make TRACE=1\n", fileName);
+#endif
+}
+
+/*
+ * \brief main function to be implemented by each platform
+ *
+ * Usage: BlueMarlin [-d <device>] [-b <baud rate>] [-p <priority>] [-l] [-t [-c <cpus>]] [-e <file>] [-r <file>]
+ * As this is the main function it obviously does not use the existing naming
+ * conventions.
+ *
+ * @return return value to Os
+ */
+int main(int argc, char *argv[])
+{
+  const char *device = NULL;
+  const char *storageFile = NULL;
+  const char *traceFile = NULL;
+  uint32_t baudrate = PLATFORM_SERIAL_BAUDRATE;
+  int priority = 0;
+  bool lockMemory = false;
+  bool threaded = false;
+  int16_t cpu[PLATFORM_THREAD_NUM];
+  long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  struct sigaction action;
+  struct sched_param parameter;
+  uint64_t loops = 0;
+  uint64_t deadline;
+  uint64_t setupTime;
+  int option;
+
+  /* Pin the threads to the last CPUs by default, the first ones usually
+   * handle most of the interrupts */
+  for (uint8_t i=0; i<PLATFORM_THREAD_NUM; i++)
+    {
+      cpu[i] = (cpus >= PLATFORM_THREAD_NUM) ? (int16_t)(cpus - PLATFORM_THREAD_NUM + i) : -1;
+    }
+  while ((option = getopt(argc, argv, "d:b:p:ltc:e:r:h")) != -1)
+    {
+      switch (option)
+        {
+        case 'd':
+          device = optarg;
+          break;
+        case 'b':
+          baudrate = (uint32_t)strtoul(optarg, NULL, 10);
+          break;
+        case 'p':
+          priority = atoi(optarg);
+          break;
+        case 'l':
+          lockMemory = true;
+          break;
+        case 't':
+          threaded = true;
+          break;
+        case 'c':
+          if (Platform_parseCpus(optarg, cpu) != RESULT_OK)
+            {
+              Platform_usage(argv[0]);
+              return 1;
+            }
+          break;
+        case 'e':
+          storageFile = optarg;
+          break;
+        case 'r':
+          traceFile = optarg;
+          break;
+        default:
+          Platform_usage(argv[0]);
+          return 1;
+        }
+    }
+
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = Platform_signalHandler;
+  sigemptyset(&action.sa_mask);
+  sigaction(SIGINT, &action, NULL);
+  sigaction(SIGTERM, &action, NULL);
+
+  /* Missing privileges are not fatal, the firmware just runs with more
+   * jitter */
+  if (lockMemory && (mlockall(MCL_CURRENT | MCL_FUTURE) != 0))
+    {
+      perror("Can't lock memory");
+    }
+  /* The threaded runtime only runs the step thread with SCHED_FIFO */
+  if ((priority > 0) && !threaded)
+    {
+      parameter.sched_priority = priority;
+      if (sched_setscheduler(0, SCHED_FIFO, &parameter) != 0)
+        {
+          perror("Can't set SCHED_FIFO");
+        }
+    }
+
+  if (Platform_storageOpen(storageFile) != RESULT_OK)
+    {
+      return 1;
+    }
+  if (Platform_serialOpen(device, baudrate) != RESULT_OK)
+    {
+      Platform_storageClose();
+      return 1;
+    }
+
+  /* Call init function normally used by Aurduino framework */
+  setupTime = Platform_clockNanoseconds();
+  setup();
+  setupTime = Platform_clockNanoseconds() - setupTime;
+  if (threaded)
+    {
+      if (Platform_threadStart(cpu, priority) != RESULT_OK)
+        {
+          Platform_serialClose();
+          Platform_storageClose();
+          return 1;
+        }
+      while (!Platform_shutdown)
+        {
+          pause();
+        }
+      Platform_threadStop();
+    }
+  while (!Platform_shutdown)
+    {
+      Platform_serialReceive();
+      loop();
+      Platform_stepperTimerPoll();
+      loops++;
+      /* Tickless: nothing but the step timer or the next fixed-rate task
+       * can change the state of a waiting machine */
+      if (BlueMarlin_isWaiting())
+        {
+          deadline = min(Scheduler_nextRelease(), UINT64_MAX / 1000ULL) * 1000ULL;
+          Platform_clockSleepUntil(min(Platform_stepperTimerNext(), deadline));
+          Platform_stepperTimerPoll();
+        }
+    }
+  Platform_serialClose();
+  Platform_storageClose();
+  Platform_report(loops, threaded, setupTime);
+  if (traceFile != NULL)
+    {
+      Platform_writeTrace(traceFile);
+    }
+  return 0;
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
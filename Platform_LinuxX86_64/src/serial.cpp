@@ -0,0 +1,265 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * \file serial.cpp
+ *
+ * \brief Serial line of the Linux host
+ *
+ * Either a real serial device, e.g. /dev/ttyUSB0, is used or a pseudo
+ * terminal is created to which a host software connects. In both cases
+ * the file descriptor is non-blocking so that the main loop never waits
+ * for data. #Platform_serialReceive stands in for the receive interrupt
+ * and passes received bytes to the Serial module.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+/** \addtogroup Platform_LinuxX86_64
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <stdio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <poll.h>
+#include <time.h>
+#include "platform.h"
+#include <serial.h>
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+static speed_t Platform_serialSpeed(uint32_t baudrate);
+
+/* ******************| Global Variables |****************************** */
+/**
+ * File descriptor of the serial device or of the master side of the
+ * pseudo terminal
+ */
+static int Platform_serialFd = -1;
+
+/**
+ * Settings of the serial device before it was opened. Restored on close.
+ */
+static struct termios Platform_serialSettings;
+
+/**
+ * True if #Platform_serialSettings must be restored on close
+ */
+static bool Platform_serialRestore = false;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Converts a baud rate to the respective termios constant
+ *
+ * @param[in] baudrate Baud rate [bit/s]
+ * @return termios constant or B0 if the baud rate is not supported
+ */
+static speed_t Platform_serialSpeed(uint32_t baudrate)
+{
+  switch (baudrate)
+    {
+    case 9600:
+      return B9600;
+    case 19200:
+      return B19200;
+    case 38400:
+      return B38400;
+    case 57600:
+      return B57600;
+    case 115200:
+      return B115200;
+    case 230400:
+      return B230400;
+    case 460800:
+      return B460800;
+    case 500000:
+      return B500000;
+    case 921600:
+      return B921600;
+    case 1000000:
+      return B1000000;
+    case 1500000:
+      return B1500000;
+    case 2000000:
+      return B2000000;
+    default:
+      return B0;
+    }
+}
+
+/**
+ * \brief Opens the serial line
+ *
+ * If no device is given a pseudo terminal is created and the name of its
+ * slave side is printed. Host software connects to the slave side as if
+ * it was a serial device.
+ * @param[in] device Name of the serial device or NULL for a pseudo terminal
+ * @param[in] baudrate Baud rate of the serial device [bit/s]. Ignored for
+ * pseudo terminals.
+ * @return RESULT_OK if the serial line was opened, RESULT_NOT_OK if not
+ */
+uint8_t Platform_serialOpen(const char *device, uint32_t baudrate)
+{
+  struct termios settings;
+  speed_t speed;
+
+  if (device == NULL)
+    {
+      Platform_serialFd = posix_openpt(O_RDWR | O_NOCTTY);
+      if ((Platform_serialFd < 0) || (grantpt(Platform_serialFd) != 0) || (unlockpt(Platform_serialFd) != 0))
+        {
+          perror("Can't create pseudo terminal");
+          Platform_serialClose();
+          return RESULT_NOT_OK;
+        }
+      printf("Serial line: %s\n", ptsname(Platform_serialFd));
+      fflush(stdout);
+    }
+  else
+    {
+      speed = Platform_serialSpeed(baudrate);
+      if (speed == B0)
+        {
+          fprintf(stderr, "Baud rate %u is not supported\n", baudrate);
+          return RESULT_NOT_OK;
+        }
+      Platform_serialFd = open(device, O_RDWR | O_NOCTTY | O_NONBLOCK);
+      if ((Platform_serialFd < 0) || (tcgetattr(Platform_serialFd, &Platform_serialSettings) != 0))
+        {
+          perror(device);
+          Platform_serialClose();
+          return RESULT_NOT_OK;
+        }
+      Platform_serialRestore = true;
+      settings = Platform_serialSettings;
+      cfsetispeed(&settings, speed);
+      cfsetospeed(&settings, speed);
+      cfmakeraw(&settings);
+      tcsetattr(Platform_serialFd, TCSANOW, &settings);
+    }
+  /* Echo and line editing would corrupt the g-code */
+  if (tcgetattr(Platform_serialFd, &settings) == 0)
+    {
+      cfmakeraw(&settings);
+      tcsetattr(Platform_serialFd, TCSANOW, &settings);
+    }
+  fcntl(Platform_serialFd, F_SETFL, fcntl(Platform_serialFd, F_GETFL) | O_NONBLOCK);
+  return RESULT_OK;
+}
+
+/**
+ * \brief Closes the serial line
+ *
+ * Settings of a serial device are restored.
+ */
+void Platform_serialClose(void)
+{
+  if (Platform_serialFd >= 0)
+    {
+      if (Platform_serialRestore)
+        {
+          tcsetattr(Platform_serialFd, TCSANOW, &Platform_serialSettings);
+        }
+      close(Platform_serialFd);
+    }
+  Platform_serialFd = -1;
+  Platform_serialRestore = false;
+}
+
+/**
+ * \brief Receives data from serial line
+ *
+ * Stands in for the receive interrupt. Each read() fetches as many bytes
+ * as fit into the receive ring buffer of the Serial module, see
+ * Serial_free(). Bytes which do not fit stay in the buffer of the
+ * operating system, thus, nothing is lost even at high baud rates.
+ */
+void Platform_serialReceive(void)
+{
+  uint8_t data[SERIAL_RX_BUFFER_SIZE];
+  uint8_t space;
+  ssize_t length;
+
+  /* read() returns EAGAIN if no data is available and EIO for a pseudo
+   * terminal without connected slave. Both simply mean no data. */
+  while ((Platform_serialFd >= 0) && ((space = Serial_free()) > 0) &&
+         ((length = read(Platform_serialFd, data, space)) > 0))
+    {
+      for (ssize_t i=0; i<length; i++)
+        {
+          Serial_receive(data[i]);
+        }
+    }
+}
+
+/**
+ * \brief Writes data to serial line
+ *
+ * Data which does not fit into the transmit buffer of the operating system
+ * is discarded.
+ * @param[in] data Data to be written
+ * @param[in] length Number of bytes in #data
+ */
+void Platform_serialWrite(const uint8_t *data, uint8_t length)
+{
+  if (Platform_serialFd >= 0)
+    {
+      if (write(Platform_serialFd, data, length) < 0)
+        {
+          /* EAGAIN: host does not read its responses, nothing to be done */
+        }
+    }
+}
+
+/**
+ * \brief Waits until data is received
+ *
+ * Returns immediately if data is available. A pseudo terminal without
+ * connected slave side never receives data, the full timeout is waited.
+ * @param[in] timeout Maximum time to wait [µs]
+ */
+void Platform_serialWait(uint32_t timeout)
+{
+  struct pollfd fd;
+  struct timespec time;
+
+  fd.fd = Platform_serialFd;
+  fd.events = POLLIN;
+  fd.revents = 0;
+  time.tv_sec = timeout / 1000000UL;
+  time.tv_nsec = (long)(timeout % 1000000UL) * 1000L;
+  if ((ppoll(&fd, 1, &time, NULL) > 0) && (fd.revents & POLLHUP))
+    {
+      nanosleep(&time, NULL);
+    }
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
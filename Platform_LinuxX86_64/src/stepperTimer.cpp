@@ -0,0 +1,161 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * \file stepperTimer.cpp
+ *
+ * \brief Step timer and stepper outputs of the Linux host
+ *
+ * There is no timer interrupt in user space. The step timer is therefore
+ * polled from the main loop: #Platform_stepperTimerPoll calls the
+ * interrupt of the step generator selected with #STEPPER_GENERATOR for
+ * every compare value the monotonic clock has passed. How late each call
+ * is compared to its compare value is recorded in
+ * #Platform_stepperTimerStatistics.
+ * There are no stepper drivers either. Step pulses are counted per stepper
+ * in #Platform_stepperPosition.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+/** \addtogroup Platform_LinuxX86_64
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include "platform.h"
+#include <stepper.h>
+#include <stepCompress.h>
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+static uint64_t Platform_stepperTimerTicks(void);
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Time of the last call of the interrupt [ticks of #STEPPER_TIMER_FREQUENCY]
+ */
+uint32_t Platform_stepperTimerTime = 0;
+
+/**
+ * Time at which the interrupt is called next [ticks]
+ */
+static uint64_t Platform_stepperTimerCompare = 0;
+
+/**
+ * Last direction bits written by the step generator
+ */
+static uint8_t Platform_stepperDirectionBits = 0;
+
+/**
+ * Position of each stepper counted from step pulses [steps]
+ */
+int32_t Platform_stepperPosition[8] = {0};
+
+/**
+ * Statistics of the step timer
+ */
+Platform_StepperTimerStatistics_t Platform_stepperTimerStatistics = {0, 0, 0, 0};
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Reads the monotonic clock in ticks of the step timer
+ *
+ * @return Time since start [ticks of #STEPPER_TIMER_FREQUENCY]
+ */
+static uint64_t Platform_stepperTimerTicks(void)
+{
+  return (uint64_t)((unsigned __int128)Platform_clockNanoseconds() * STEPPER_TIMER_FREQUENCY / 1000000000ULL);
+}
+
+/**
+ * \brief Sets direction pins of all steppers
+ *
+ * @param[in] directionBits One bit per stepper, set bit means negative
+ * direction
+ */
+void Platform_stepperWriteDirection(uint8_t directionBits)
+{
+  Platform_stepperDirectionBits = directionBits;
+}
+
+/**
+ * \brief Issues one step pulse for each stepper with its bit set
+ *
+ * @param[in] stepBits One bit per stepper
+ */
+void Platform_stepperWriteStep(uint8_t stepBits)
+{
+  Platform_stepperTimerStatistics.stepEvents++;
+  for (uint8_t i=0; i<8; i++)
+    {
+      if (stepBits & _BV(i))
+        {
+          Platform_stepperPosition[i] += (Platform_stepperDirectionBits & _BV(i)) ? -1 : 1;
+        }
+    }
+}
+
+/**
+ * \brief Calls the interrupt for all compare values which have passed
+ *
+ * Shall be called as often as possible from the main loop. If the main
+ * loop was delayed the missed calls are made immediately one after the
+ * other.
+ */
+void Platform_stepperTimerPoll(void)
+{
+  uint64_t now = Platform_stepperTimerTicks();
+  uint32_t lateness;
+
+  while (Platform_stepperTimerCompare <= now)
+    {
+      lateness = (uint32_t)min(now - Platform_stepperTimerCompare, (uint64_t)UINT32_MAX);
+      Platform_stepperTimerStatistics.isrCalls++;
+      Platform_stepperTimerStatistics.latenessSum += lateness;
+      Platform_stepperTimerStatistics.maxLateness = max(Platform_stepperTimerStatistics.maxLateness, lateness);
+      Platform_stepperTimerTime = (uint32_t)Platform_stepperTimerCompare;
+#if (STEPPER_GENERATOR == STEPPER_GENERATOR_STEPCOMPRESS)
+      Platform_stepperTimerCompare += StepCompress_isr();
+#else
+      Platform_stepperTimerCompare += Stepper_isr();
+#endif
+    }
+}
+
+/**
+ * \brief Time of the next call of the interrupt
+ *
+ * @return Time since start at which #Platform_stepperTimerPoll calls the
+ * interrupt next [ns]
+ */
+uint64_t Platform_stepperTimerNext(void)
+{
+  return (uint64_t)((unsigned __int128)Platform_stepperTimerCompare * 1000000000ULL / STEPPER_TIMER_FREQUENCY);
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
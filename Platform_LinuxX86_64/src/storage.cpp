@@ -0,0 +1,188 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * \file storage.cpp
+ *
+ * \brief Non-volatile storage of the Linux host
+ *
+ * The EEPROM of a printer is emulated by a file which is mapped into
+ * memory. Reading and writing are plain copies, the kernel writes changed
+ * pages back to the file. The file is created and erased, that is, filled
+ * with 0xFF, if it does not exist. Without a file the storage is an
+ * anonymous mapping and only kept until the process ends.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+/** \addtogroup Platform_LinuxX86_64
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+/* Must be included before platform.h because of macros min and max */
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "platform.h"
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+static uint8_t Platform_storageErase(int file, off_t from);
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Mapping of the storage, NULL as long as the storage is not open
+ */
+static uint8_t *Platform_storage = NULL;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Erases the end of the storage file
+ *
+ * @param[in] file Storage file
+ * @param[in] from First byte to be erased
+ * @return RESULT_OK if the file was extended, RESULT_NOT_OK if not
+ */
+static uint8_t Platform_storageErase(int file, off_t from)
+{
+  uint8_t erased[PLATFORM_STORAGE_SIZE];
+
+  memset(erased, 0xFF, sizeof(erased));
+  if (pwrite(file, erased, PLATFORM_STORAGE_SIZE - from, from) != (ssize_t)(PLATFORM_STORAGE_SIZE - from))
+    {
+      return RESULT_NOT_OK;
+    }
+  return RESULT_OK;
+}
+
+/**
+ * \brief Maps the storage file into memory
+ *
+ * @param[in] fileName Storage file, created if it does not exist. NULL
+ * for a storage which is not kept after the end of the process.
+ * @return RESULT_OK if the storage is ready, RESULT_NOT_OK if not
+ */
+uint8_t Platform_storageOpen(const char *fileName)
+{
+  struct stat status;
+  void *mapping;
+  int file;
+
+  if (fileName == NULL)
+    {
+      mapping = mmap(NULL, PLATFORM_STORAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (mapping == MAP_FAILED)
+        {
+          perror("Can't map storage");
+          return RESULT_NOT_OK;
+        }
+      memset(mapping, 0xFF, PLATFORM_STORAGE_SIZE);
+    }
+  else
+    {
+      file = open(fileName, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+      if (file < 0)
+        {
+          perror(fileName);
+          return RESULT_NOT_OK;
+        }
+      if ((fstat(file, &status) != 0) ||
+          ((status.st_size < PLATFORM_STORAGE_SIZE) && (Platform_storageErase(file, status.st_size) != RESULT_OK)))
+        {
+          perror(fileName);
+          close(file);
+          return RESULT_NOT_OK;
+        }
+      mapping = mmap(NULL, PLATFORM_STORAGE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+      /* The mapping keeps the file open */
+      close(file);
+      if (mapping == MAP_FAILED)
+        {
+          perror(fileName);
+          return RESULT_NOT_OK;
+        }
+    }
+  Platform_storage = (uint8_t *)mapping;
+  return RESULT_OK;
+}
+
+/**
+ * \brief Writes the storage back to its file and unmaps it
+ */
+void Platform_storageClose(void)
+{
+  if (Platform_storage != NULL)
+    {
+      msync(Platform_storage, PLATFORM_STORAGE_SIZE, MS_SYNC);
+      munmap(Platform_storage, PLATFORM_STORAGE_SIZE);
+      Platform_storage = NULL;
+    }
+}
+
+/**
+ * \brief Reads from the storage
+ *
+ * @param[in] address First byte to be read
+ * @param[out] data Read bytes
+ * @param[in] length Number of bytes to be read
+ * @return RESULT_OK if the bytes were read, RESULT_NOT_OK if the storage
+ * is not open or the bytes are outside of it
+ */
+uint8_t Platform_storageRead(uint16_t address, void *data, uint16_t length)
+{
+  if ((Platform_storage == NULL) || ((uint32_t)address + length > PLATFORM_STORAGE_SIZE))
+    {
+      return RESULT_NOT_OK;
+    }
+  memcpy(data, &Platform_storage[address], length);
+  return RESULT_OK;
+}
+
+/**
+ * \brief Writes to the storage
+ *
+ * @param[in] address First byte to be written
+ * @param[in] data Bytes to be written
+ * @param[in] length Number of bytes to be written
+ * @return RESULT_OK if the bytes were written, RESULT_NOT_OK if the
+ * storage is not open or the bytes are outside of it
+ */
+uint8_t Platform_storageWrite(uint16_t address, const void *data, uint16_t length)
+{
+  if ((Platform_storage == NULL) || ((uint32_t)address + length > PLATFORM_STORAGE_SIZE))
+    {
+      return RESULT_NOT_OK;
+    }
+  memcpy(&Platform_storage[address], data, length);
+  return RESULT_OK;
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,307 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * \file thread.cpp
+ *
+ * \brief Threaded runtime of the Linux host
+ *
+ * Instead of calling loop() the firmware is split into three threads,
+ * each optionally pinned to its own CPU:
+ * - Reader: reads g-codes from the serial line into #gCodeRingBuffer
+ * - Planner: executes g-codes and generates movements into #motionBuffer
+ *   (and, with StepCompress, the step schedules), see BlueMarlin_process()
+ * - Stepper: polls the step timer and calls the step timer interrupt
+ * The threads are only connected by the ring buffers, which are safe for
+ * one producer and one consumer. A full ring applies backpressure: the
+ * producing thread sleeps instead of spinning. As no g-code is
+ * acknowledged while #gCodeRingBuffer is full, the host is throttled as
+ * well.
+ * The step thread may run with SCHED_FIFO. It sleeps until shortly
+ * before the next interrupt is due and spins for the rest of the time.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+/** \addtogroup Platform_LinuxX86_64
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+/* Must be included before platform.h because of macros min and max */
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sched.h>
+#include "platform.h"
+#include <blueMarlin.h>
+#include <gCodeReader.h>
+#include <serial.h>
+#include <motionBuffer.h>
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+static bool Platform_threadRunning(void);
+static void Platform_threadSleep(uint32_t time);
+static void *Platform_threadReader(void *argument);
+static void *Platform_threadPlanner(void *argument);
+static void *Platform_threadStepper(void *argument);
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Statistics of each thread. Only written by the respective thread, only
+ * to be read after #Platform_threadStop.
+ */
+Platform_ThreadStatistics_t Platform_threadStatistics[PLATFORM_THREAD_NUM];
+
+/**
+ * Set by #Platform_threadStop to end all threads
+ */
+static bool Platform_threadStopRequest = false;
+
+/**
+ * Handles of the threads
+ */
+static pthread_t Platform_threads[PLATFORM_THREAD_NUM];
+
+/**
+ * Functions executed by the threads
+ */
+static void *(* const Platform_threadFunctions[PLATFORM_THREAD_NUM])(void *) =
+{
+  Platform_threadReader,
+  Platform_threadPlanner,
+  Platform_threadStepper
+};
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Checks if the threads shall continue
+ *
+ * @return False after #Platform_threadStop was called
+ */
+static bool Platform_threadRunning(void)
+{
+  return !__atomic_load_n(&Platform_threadStopRequest, __ATOMIC_RELAXED);
+}
+
+/**
+ * \brief Sleeps for the given time
+ *
+ * @param[in] time Time to sleep [µs]
+ */
+static void Platform_threadSleep(uint32_t time)
+{
+  Platform_clockSleepUntil(Platform_clockNanoseconds() + (uint64_t)time * 1000ULL);
+}
+
+/**
+ * \brief Reader thread
+ *
+ * Receives data and reads g-codes as long as #gCodeRingBuffer accepts
+ * them. Waits for data if no complete line is left.
+ * @param[in] argument Not used
+ * @return Not used
+ */
+static void *Platform_threadReader(void *argument)
+{
+  Platform_ThreadStatistics_t *statistics = &Platform_threadStatistics[PLATFORM_THREAD_READER];
+  uint64_t start = Platform_clockNanoseconds();
+  uint64_t begin;
+
+  while (Platform_threadRunning())
+    {
+      begin = Platform_clockNanoseconds();
+      Platform_serialReceive();
+      GCodeReader_readGCodeSerial();
+      statistics->busyTime += Platform_clockNanoseconds() - begin;
+      statistics->iterations++;
+      if (gCodeRingBuffer.available() >= GCODEREADER_GCODERINGBUFFER_SIZE)
+        {
+          statistics->stalls++;
+          Platform_threadSleep(PLATFORM_THREAD_IDLE_TIME);
+        }
+      else if (Serial_lines() == 0)
+        {
+          Platform_serialWait(PLATFORM_THREAD_IDLE_TIME);
+        }
+    }
+  statistics->runTime = Platform_clockNanoseconds() - start;
+  return NULL;
+}
+
+/**
+ * \brief Planner thread
+ *
+ * Executes g-codes and plans movements. Sleeps while the machine is
+ * waiting or #motionBuffer is full.
+ * @param[in] argument Not used
+ * @return Not used
+ */
+static void *Platform_threadPlanner(void *argument)
+{
+  Platform_ThreadStatistics_t *statistics = &Platform_threadStatistics[PLATFORM_THREAD_PLANNER];
+  uint64_t start = Platform_clockNanoseconds();
+  uint64_t begin;
+
+  while (Platform_threadRunning())
+    {
+      begin = Platform_clockNanoseconds();
+      BlueMarlin_process();
+      statistics->busyTime += Platform_clockNanoseconds() - begin;
+      statistics->iterations++;
+      if (motionBuffer.available() >= MOTIONBUFFER_MOTIONBUFFER_SIZE)
+        {
+          statistics->stalls++;
+          Platform_threadSleep(PLATFORM_THREAD_IDLE_TIME);
+        }
+      else if (BlueMarlin_isWaiting())
+        {
+          Platform_threadSleep(PLATFORM_THREAD_IDLE_TIME);
+        }
+    }
+  statistics->runTime = Platform_clockNanoseconds() - start;
+  return NULL;
+}
+
+/**
+ * \brief Stepper thread
+ *
+ * Calls the step timer interrupt whenever it is due. Sleeps until
+ * #PLATFORM_THREAD_SPIN_TIME before the next interrupt and spins for the
+ * rest of the time. Only the interrupt calls count as busy.
+ * @param[in] argument Not used
+ * @return Not used
+ */
+static void *Platform_threadStepper(void *argument)
+{
+  Platform_ThreadStatistics_t *statistics = &Platform_threadStatistics[PLATFORM_THREAD_STEPPER];
+  uint64_t start = Platform_clockNanoseconds();
+  uint64_t now;
+  uint64_t next;
+
+  while (Platform_threadRunning())
+    {
+      now = Platform_clockNanoseconds();
+      next = Platform_stepperTimerNext();
+      if (next <= now)
+        {
+          Platform_stepperTimerPoll();
+          statistics->busyTime += Platform_clockNanoseconds() - now;
+        }
+      else if ((next - now) > ((uint64_t)PLATFORM_THREAD_SPIN_TIME * 1000ULL))
+        {
+          Platform_clockSleepUntil(next - (uint64_t)PLATFORM_THREAD_SPIN_TIME * 1000ULL);
+        }
+      statistics->iterations++;
+    }
+  statistics->runTime = Platform_clockNanoseconds() - start;
+  return NULL;
+}
+
+/**
+ * \brief Starts the threads
+ *
+ * The firmware must have been set up before. Signals are blocked in all
+ * threads so that only the calling thread handles them.
+ * @param[in] cpu CPU for each thread, negative values leave the thread
+ * unpinned
+ * @param[in] priority SCHED_FIFO priority of the step thread, 0 for normal
+ * scheduling. If it can't be set the thread runs with normal scheduling.
+ * @return RESULT_OK if all threads were started, RESULT_NOT_OK if not
+ */
+uint8_t Platform_threadStart(const int16_t cpu[PLATFORM_THREAD_NUM], int priority)
+{
+  pthread_attr_t attributes;
+  struct sched_param parameter;
+  cpu_set_t cpuSet;
+  sigset_t signals;
+  sigset_t previousSignals;
+  int error;
+  uint8_t retVal = RESULT_OK;
+
+  memset(Platform_threadStatistics, 0, sizeof(Platform_threadStatistics));
+  Platform_threadStopRequest = false;
+  sigfillset(&signals);
+  pthread_sigmask(SIG_BLOCK, &signals, &previousSignals);
+  for (uint8_t i=0; (i<PLATFORM_THREAD_NUM) && (retVal == RESULT_OK); i++)
+    {
+      pthread_attr_init(&attributes);
+      if (cpu[i] >= 0)
+        {
+          CPU_ZERO(&cpuSet);
+          CPU_SET(cpu[i], &cpuSet);
+          pthread_attr_setaffinity_np(&attributes, sizeof(cpuSet), &cpuSet);
+        }
+      if ((i == PLATFORM_THREAD_STEPPER) && (priority > 0))
+        {
+          parameter.sched_priority = priority;
+          pthread_attr_setinheritsched(&attributes, PTHREAD_EXPLICIT_SCHED);
+          pthread_attr_setschedpolicy(&attributes, SCHED_FIFO);
+          pthread_attr_setschedparam(&attributes, &parameter);
+        }
+      error = pthread_create(&Platform_threads[i], &attributes, Platform_threadFunctions[i], NULL);
+      if ((error == EPERM) && (i == PLATFORM_THREAD_STEPPER) && (priority > 0))
+        {
+          fprintf(stderr, "Can't set SCHED_FIFO for step thread: %s\n", strerror(error));
+          pthread_attr_setinheritsched(&attributes, PTHREAD_INHERIT_SCHED);
+          error = pthread_create(&Platform_threads[i], &attributes, Platform_threadFunctions[i], NULL);
+        }
+      if (error != 0)
+        {
+          fprintf(stderr, "Can't start thread %u: %s\n", i, strerror(error));
+          /* Stop the threads already started */
+          __atomic_store_n(&Platform_threadStopRequest, true, __ATOMIC_RELAXED);
+          for (uint8_t j=0; j<i; j++)
+            {
+              pthread_join(Platform_threads[j], NULL);
+            }
+          retVal = RESULT_NOT_OK;
+        }
+      pthread_attr_destroy(&attributes);
+    }
+  pthread_sigmask(SIG_SETMASK, &previousSignals, NULL);
+  return retVal;
+}
+
+/**
+ * \brief Stops all threads and waits until they ended
+ *
+ * @pre #Platform_threadStart returned RESULT_OK
+ */
+void Platform_threadStop(void)
+{
+  __atomic_store_n(&Platform_threadStopRequest, true, __ATOMIC_RELAXED);
+  for (uint8_t i=0; i<PLATFORM_THREAD_NUM; i++)
+    {
+      pthread_join(Platform_threads[i], NULL);
+    }
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
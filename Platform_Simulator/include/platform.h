@@ -0,0 +1,191 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#if (!defined PLATFORM_INCLUDE_PLATFORM_H_)
+/* Preprocessor exclusion definition */
+#define PLATFORM_INCLUDE_PLATFORM_H_
+/**
+ * \file platform.h
+ *
+ * \brief Platform module include file
+ *
+ * The inclusion protection does not obey the naming because there shall
+ * be only one platform used at a time.
+ * The simulator runs the firmware on the host against a virtual clock,
+ * see Readme.md.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+/** \addtogroup Platform_Simulator
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+/* Standard headers must be included before the Arduino like macros below
+ * are defined. Otherwise the macros will clash with the declarations of
+ * abs() and friends. */
+#include <stdlib.h>
+#include <math.h>
+
+/* ******************| Macros |**************************************** */
+/**
+ * \brief Return values to be used by all functions
+ */
+#define RESULT_OK       (uint8_t)1
+#define RESULT_NOT_OK   (uint8_t)0
+
+/**
+ * Macros from Arduino.h
+ */
+#define min(a,b) ((a)<(b)?(a):(b))
+#define max(a,b) ((a)>(b)?(a):(b))
+#define abs(x) ((x)>0?(x):-(x))
+#define sq(x) ((x)*(x))
+
+/**
+ * Macros from Arduino sfr_defs.h
+ */
+#define _BV(bit) (1 << (bit))
+
+/**
+ * Virtual time consumed by one call of loop() [µs]. As long as the
+ * machine is moving the virtual clock advances by this time after each
+ * call, independent of the host time actually needed.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DPLATFORM_SIMULATOR_LOOP_TIME 50
+ */
+#ifndef PLATFORM_SIMULATOR_LOOP_TIME
+#define PLATFORM_SIMULATOR_LOOP_TIME      (uint32_t)50
+#endif
+
+/**
+ * Interval of the velocity and acceleration samples written to the
+ * motion trace [µs].
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DPLATFORM_SIMULATOR_SAMPLE_TIME 1000
+ */
+#ifndef PLATFORM_SIMULATOR_SAMPLE_TIME
+#define PLATFORM_SIMULATOR_SAMPLE_TIME    (uint32_t)1000
+#endif
+
+/**
+ * Size of the non-volatile storage for parameter [bytes]. Same as the
+ * EEPROM of an ATmega2560.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DPLATFORM_STORAGE_SIZE 4096
+ */
+#ifndef PLATFORM_STORAGE_SIZE
+#define PLATFORM_STORAGE_SIZE             (uint16_t)4096
+#endif
+
+/* ******************| Type definitions |****************************** */
+
+/**
+ * Platform module shall specify the following data types. 
+ * - uint8_t, int8_t,
+ * - uint16_t, int16_t,
+ * - uint32_t, int32_t
+ * - uint64_t, int64_t
+ * Normally they are specified in stdint.h, however, this will invoke one
+ * more external reference and is therefore avoided. The following is a 
+ * copy of mingw's stdint.h file.
+ */
+typedef signed char int8_t;
+typedef unsigned char   uint8_t;
+typedef short  int16_t;
+typedef unsigned short  uint16_t;
+typedef int  int32_t;
+typedef unsigned   uint32_t;
+/* 64 bit types differ between LP64 and LLP64 hosts. Use the compiler's
+ * definition to stay compatible with stdint.h if it is included anyway. */
+typedef __INT64_TYPE__  int64_t;
+typedef __UINT64_TYPE__  uint64_t;
+/* Limits of the types above, guarded in case stdint.h was included */
+#ifndef UINT32_MAX
+#define INT32_MAX   2147483647
+#define UINT32_MAX  0xffffffffU
+#define UINT64_MAX  0xffffffffffffffffULL
+#endif
+
+/*
+ * Platform module shall specify bool datatype and TRUE/FALSE.
+ * @note Not sure how this works in conjunction with the cpp bool definition.
+ */
+#ifndef __cplusplus
+typedef unsigned char bool;
+#endif
+#undef FALSE
+#undef TRUE
+#define FALSE	0
+#define TRUE	1
+
+/**
+ * Statistics of the simulation
+ */
+typedef struct
+{
+  uint64_t loops;          /*!< Number of calls of loop() */
+  uint64_t isrCalls;       /*!< Number of calls of the step timer interrupt */
+  uint64_t stepEvents;     /*!< Number of step events, i.e. calls of #Platform_stepperWriteStep */
+  uint64_t skippedTime;    /*!< Virtual time skipped while the machine was waiting [ticks] */
+} Platform_SimulatorStatistics_t;
+
+/* ******************| External function declarations |**************** */
+#ifdef __cplusplus
+extern "C" {
+#endif
+extern void setup(void);
+extern void loop(void);
+extern void Platform_stepperWriteDirection(uint8_t directionBits);
+extern void Platform_stepperWriteStep(uint8_t stepBits);
+extern void Platform_stepperTimerRun(uint32_t ticks);
+extern uint8_t Platform_serialOpen(const char *fileName);
+extern void Platform_serialReceive(void);
+extern void Platform_serialWrite(const uint8_t *data, uint8_t length);
+extern uint8_t Platform_traceOpen(const char *prefix);
+extern void Platform_traceClose(void);
+extern uint8_t Platform_storageRead(uint16_t address, void *data, uint16_t length);
+extern uint8_t Platform_storageWrite(uint16_t address, const void *data, uint16_t length);
+extern uint64_t Platform_timeMicros(void);
+extern uint64_t Platform_timeCycles(void);
+extern void Platform_timeSleepUntil(uint64_t deadline);
+extern uint32_t micros(void);
+#ifdef __cplusplus
+}
+#endif
+
+/* ******************| External constants |**************************** */
+
+/* ******************| External variables |**************************** */
+extern uint32_t Platform_stepperTimerTime;
+extern uint64_t Platform_simulatorTime;
+extern int32_t Platform_stepperPosition[8];
+extern Platform_SimulatorStatistics_t Platform_simulatorStatistics;
+extern bool Platform_serialEndOfInput;
+
+/** @} doxygen end group definition */
+#endif /* if !defined( PLATFORM_INCLUDE_PLATFORM_H_ ) */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,187 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * \file main.cpp
+ *
+ * \brief Main function of the simulator
+ *
+ * Runs the complete firmware, that is g-code reader, motion planner,
+ * motion buffer and step generator, against the virtual clock of
+ * stepperTimer.cpp as fast as the host allows. Each call of loop() takes
+ * #PLATFORM_SIMULATOR_LOOP_TIME of virtual time. While the machine is
+ * waiting, e.g. for the end of a dwell, the virtual clock jumps to the
+ * next release of a scheduler task.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+/** \addtogroup Platform_Simulator
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+/* Must be included before platform.h because of macros min and max */
+#include <chrono>
+#include <stdio.h>
+#include "platform.h"
+#include <blueMarlin.h>
+#include <stepper.h>
+#include <motionPlanner.h>
+#include <scheduler.h>
+#include <serial.h>
+#include <trace.h>
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+static void Platform_report(double wallTime);
+static void Platform_writeTrace(const char *prefix);
+
+/* ******************| Global Variables |****************************** */
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Prints the result of the simulation
+ *
+ * @param[in] wallTime Host time needed for the simulation [s]
+ */
+static void Platform_report(double wallTime)
+{
+  double simulatedTime = (double)Platform_simulatorTime / STEPPER_TIMER_FREQUENCY;
+
+  printf("Simulated time:     %12.6f s\n", simulatedTime);
+  printf("Wall time:          %12.6f s\n", wallTime);
+  printf("Speed-up:           %12.1f\n", (wallTime > 0.0) ? (simulatedTime / wallTime) : 0.0);
+  printf("Skipped idle time:  %12.6f s\n", (double)Platform_simulatorStatistics.skippedTime / STEPPER_TIMER_FREQUENCY);
+  printf("G-code lines:       %12u\n", Serial_statistics.lines);
+  printf("Loops:              %12llu\n", (unsigned long long)Platform_simulatorStatistics.loops);
+  printf("Interrupt calls:    %12llu\n", (unsigned long long)Platform_simulatorStatistics.isrCalls);
+  printf("Step events:        %12llu\n", (unsigned long long)Platform_simulatorStatistics.stepEvents);
+  printf("Planner slowdowns:  %12u\n", motionPlanner.getSlowdowns());
+  for (uint8_t i=0; i<STEPPER_NUM_STEPPER; i++)
+    {
+      printf("Position stepper %u: %12d steps\n", i, Platform_stepperPosition[i]);
+    }
+}
+
+/**
+ * \brief Writes the recorded events to <prefix>_trace.bin, see Trace module
+ *
+ * Time stamps are virtual, thus, all events of one call of loop() get the
+ * same time.
+ * @param[in] prefix Trace prefix
+ */
+static void Platform_writeTrace(const char *prefix)
+{
+#if (TRACE_ENABLE)
+  Trace_Header_t header;
+  char fileName[512];
+  FILE *file;
+
+  snprintf(fileName, sizeof(fileName), "%s_trace.bin", prefix);
+  file = fopen(fileName, "wb");
+  if (file == NULL)
+    {
+      fprintf(stderr, "Can't write trace %s\n", fileName);
+      return;
+    }
+  Trace_header(&header);
+  fwrite(&header, sizeof(header), 1, file);
+  for (uint32_t i=0; i<header.records; i++)
+    {
+      fwrite(Trace_get(i), sizeof(Trace_Record_t), 1, file);
+    }
+  fclose(file);
+  printf("Trace:              %12u records %8u lost\n", header.records, header.lostRecords);
+#endif
+}
+
+/*
+ * \brief main function to be implemented by each platform
+ *
+ * Usage: BlueMarlinSimulator <g-code file> [<trace prefix>]
+ * Without trace prefix no traces are written.
+ * As this is the main function it obviously does not use the existing naming
+ * conventions.
+ *
+ * @return return value to Os
+ */
+int main(int argc, char *argv[])
+{
+  std::chrono::steady_clock::time_point start;
+  uint32_t lines;
+  uint64_t deadline;
+
+  if ((argc < 2) || (argc > 3))
+    {
+      fprintf(stderr, "Usage: %s <g-code file> [<trace prefix>]\n", argv[0]);
+      return 1;
+    }
+  if (Platform_serialOpen(argv[1]) != RESULT_OK)
+    {
+      fprintf(stderr, "Can't open g-code file %s\n", argv[1]);
+      return 1;
+    }
+  if ((argc == 3) && (Platform_traceOpen(argv[2]) != RESULT_OK))
+    {
+      fprintf(stderr, "Can't open trace files %s_*.csv\n", argv[2]);
+      Platform_traceClose();
+      return 1;
+    }
+
+  start = std::chrono::steady_clock::now();
+  /* Call init function normally used by Aurduino framework */
+  setup();
+  while (!(Platform_serialEndOfInput && (Serial_lines() == 0) && BlueMarlin_isIdle()))
+    {
+      lines = Serial_statistics.linesRead;
+      Platform_serialReceive();
+      loop();
+      Platform_simulatorStatistics.loops++;
+      /* Nothing but the next scheduled task can change the state of a
+       * waiting machine. Lines without g-code, e.g. comments, are read
+       * without waiting. */
+      if (BlueMarlin_isWaiting() && (lines == Serial_statistics.linesRead))
+        {
+          deadline = Platform_timeMicros() + PLATFORM_SIMULATOR_LOOP_TIME;
+          Platform_timeSleepUntil(max(Scheduler_nextRelease(), deadline));
+        }
+      else
+        {
+          Platform_stepperTimerRun(PLATFORM_SIMULATOR_LOOP_TIME * (STEPPER_TIMER_FREQUENCY / 1000000));
+        }
+    }
+  Platform_traceClose();
+  Platform_report(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+  if (argc == 3)
+    {
+      Platform_writeTrace(argv[2]);
+    }
+  return 0;
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,129 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * \file serial.cpp
+ *
+ * \brief Serial line of the simulator
+ *
+ * The serial line is replaced by a g-code file. The receive ring buffer
+ * of the Serial module is filled from the file before each call of
+ * loop(), as if the host would always keep it filled. Responses of the
+ * firmware are discarded.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+/** \addtogroup Platform_Simulator
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <stdio.h>
+#include "platform.h"
+#include <serial.h>
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+
+/* ******************| Global Variables |****************************** */
+/**
+ * G-code file replacing the serial line
+ */
+static FILE *Platform_serialInput = NULL;
+
+/**
+ * True after the g-code file was read completely
+ */
+bool Platform_serialEndOfInput = false;
+
+/**
+ * Last byte read from the g-code file
+ */
+static uint8_t Platform_serialLastCharacter = '\n';
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Opens the g-code file which replaces the serial line
+ *
+ * @param[in] fileName Name of the g-code file
+ * @return RESULT_OK if the file was opened, RESULT_NOT_OK if not
+ */
+uint8_t Platform_serialOpen(const char *fileName)
+{
+  Platform_serialInput = fopen(fileName, "r");
+  Platform_serialEndOfInput = (Platform_serialInput == NULL);
+  return (Platform_serialInput != NULL) ? RESULT_OK : RESULT_NOT_OK;
+}
+
+/**
+ * \brief Receives data from serial line
+ *
+ * Stands in for the receive interrupt. Passes as many bytes of the g-code
+ * file to Serial_receive() as fit into the receive ring buffer. A line
+ * ending is added at the end of the file in case the last line has none.
+ */
+void Platform_serialReceive(void)
+{
+  uint8_t data[SERIAL_RX_BUFFER_SIZE];
+  uint8_t space = Serial_free();
+  size_t length;
+
+  if (Platform_serialEndOfInput || (space == 0))
+    {
+      return;
+    }
+  length = fread(data, 1, space, Platform_serialInput);
+  for (size_t i=0; i<length; i++)
+    {
+      Serial_receive(data[i]);
+      Platform_serialLastCharacter = data[i];
+    }
+  if (length < space)
+    {
+      if ((Platform_serialLastCharacter != '\n') && (Platform_serialLastCharacter != '\r'))
+        {
+          Serial_receive('\n');
+        }
+      fclose(Platform_serialInput);
+      Platform_serialInput = NULL;
+      Platform_serialEndOfInput = true;
+    }
+}
+
+/**
+ * \brief Writes data to serial line
+ *
+ * Nobody is listening, the data is discarded.
+ * @param[in] data Data to be written
+ * @param[in] length Number of bytes in #data
+ */
+void Platform_serialWrite(const uint8_t *data, uint8_t length)
+{
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
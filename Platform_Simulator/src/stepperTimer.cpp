@@ -0,0 +1,366 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * \file stepperTimer.cpp
+ *
+ * \brief Virtual step timer, stepper outputs and traces of the simulator
+ *
+ * The step timer runs on a virtual clock: #Platform_stepperTimerRun
+ * advances the clock and calls the interrupt of the step generator
+ * selected with #STEPPER_GENERATOR whenever the interval returned by the
+ * last call has elapsed. The host time needed for this does not influence
+ * the result. Thus, each simulation of the same g-code gives exactly the
+ * same steps at exactly the same time.
+ * If tracing is enabled every step of each stepper is written to a step
+ * trace and velocity and acceleration of each stepper are sampled every
+ * #PLATFORM_SIMULATOR_SAMPLE_TIME into a motion trace.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+/** \addtogroup Platform_Simulator
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <stdio.h>
+#include "platform.h"
+#include <stepper.h>
+#include <stepCompress.h>
+
+/* ******************| Macros |**************************************** */
+/**
+ * Ticks of the step timer per µs
+ */
+#define PLATFORM_TICKS_PER_MICROSECOND    (STEPPER_TIMER_FREQUENCY / 1000000)
+
+/* ******************| Type Definitions |****************************** */
+/**
+ * Trace data of one stepper
+ */
+typedef struct
+{
+  FILE *stepTrace;          /*!< Step trace, NULL if tracing is disabled */
+  uint64_t lastStepTime;    /*!< Time of the last step [ticks] */
+  uint64_t lastInterval;    /*!< Time between the last two steps [ticks] */
+  int8_t direction;         /*!< Direction of the last step, 1 or -1 */
+  uint64_t windowStart;     /*!< Time of the last step before the current sample [ticks] */
+  int32_t windowSteps;      /*!< Steps since #windowStart, negative steps are subtracted [steps] */
+  float velocity;           /*!< Velocity at the last sample [steps/s] */
+} Platform_StepperTrace_t;
+
+/* ******************| Function Prototypes |*************************** */
+static void Platform_sample(uint64_t time);
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Virtual time of the step timer [ticks of #STEPPER_TIMER_FREQUENCY].
+ * Overflows, use #Platform_simulatorTime for time stamps.
+ */
+uint32_t Platform_stepperTimerTime = 0;
+
+/**
+ * Virtual time since start of the simulation [ticks of
+ * #STEPPER_TIMER_FREQUENCY]
+ */
+uint64_t Platform_simulatorTime = 0;
+
+/**
+ * Virtual time at which the interrupt is called next [ticks]
+ */
+static uint64_t Platform_stepperTimerCompare = 0;
+
+/**
+ * Last direction bits written by the step generator
+ */
+static uint8_t Platform_stepperDirectionBits = 0;
+
+/**
+ * Position of each stepper counted from step pulses [steps]
+ */
+int32_t Platform_stepperPosition[8] = {0};
+
+/**
+ * Statistics of the simulation
+ */
+Platform_SimulatorStatistics_t Platform_simulatorStatistics = {0, 0, 0, 0};
+
+/**
+ * Trace data of each stepper
+ */
+static Platform_StepperTrace_t Platform_stepperTrace[STEPPER_NUM_STEPPER];
+
+/**
+ * Motion trace, NULL if tracing is disabled
+ */
+static FILE *Platform_motionTrace = NULL;
+
+/**
+ * Virtual time of the next velocity and acceleration sample [ticks]
+ */
+static uint64_t Platform_nextSample = 0;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Opens step traces and motion trace
+ *
+ * The step trace of stepper i is written to <prefix>_stepper<i>.csv, one
+ * line with time [s] and position [steps] per step. The motion trace is
+ * written to <prefix>_motion.csv, one line with time [s] followed by
+ * velocity [steps/s] and acceleration [steps/s^2] of each stepper per
+ * sample.
+ * @param[in] prefix Prefix of the file names including the path
+ * @return RESULT_OK if all files were opened, RESULT_NOT_OK if not
+ */
+uint8_t Platform_traceOpen(const char *prefix)
+{
+  char fileName[512];
+
+  for (uint8_t i=0; i<STEPPER_NUM_STEPPER; i++)
+    {
+      snprintf(fileName, sizeof(fileName), "%s_stepper%u.csv", prefix, i);
+      Platform_stepperTrace[i].stepTrace = fopen(fileName, "w");
+      if (Platform_stepperTrace[i].stepTrace == NULL)
+        {
+          return RESULT_NOT_OK;
+        }
+      fprintf(Platform_stepperTrace[i].stepTrace, "time,position\n");
+    }
+  snprintf(fileName, sizeof(fileName), "%s_motion.csv", prefix);
+  Platform_motionTrace = fopen(fileName, "w");
+  if (Platform_motionTrace == NULL)
+    {
+      return RESULT_NOT_OK;
+    }
+  fprintf(Platform_motionTrace, "time");
+  for (uint8_t i=0; i<STEPPER_NUM_STEPPER; i++)
+    {
+      fprintf(Platform_motionTrace, ",velocity%u,acceleration%u", i, i);
+    }
+  fprintf(Platform_motionTrace, "\n");
+  return RESULT_OK;
+}
+
+/**
+ * \brief Closes all traces
+ */
+void Platform_traceClose(void)
+{
+  for (uint8_t i=0; i<STEPPER_NUM_STEPPER; i++)
+    {
+      if (Platform_stepperTrace[i].stepTrace != NULL)
+        {
+          fclose(Platform_stepperTrace[i].stepTrace);
+          Platform_stepperTrace[i].stepTrace = NULL;
+        }
+    }
+  if (Platform_motionTrace != NULL)
+    {
+      fclose(Platform_motionTrace);
+      Platform_motionTrace = NULL;
+    }
+}
+
+/**
+ * \brief Sets direction pins of all steppers
+ *
+ * @param[in] directionBits One bit per stepper, set bit means negative
+ * direction
+ */
+void Platform_stepperWriteDirection(uint8_t directionBits)
+{
+  Platform_stepperDirectionBits = directionBits;
+}
+
+/**
+ * \brief Issues one step pulse for each stepper with its bit set
+ *
+ * @param[in] stepBits One bit per stepper
+ */
+void Platform_stepperWriteStep(uint8_t stepBits)
+{
+  Platform_simulatorStatistics.stepEvents++;
+  for (uint8_t i=0; i<STEPPER_NUM_STEPPER; i++)
+    {
+      if (stepBits & _BV(i))
+        {
+          Platform_StepperTrace_t &trace = Platform_stepperTrace[i];
+
+          trace.direction = (Platform_stepperDirectionBits & _BV(i)) ? -1 : 1;
+          Platform_stepperPosition[i] += trace.direction;
+          trace.lastInterval = Platform_simulatorTime - trace.lastStepTime;
+          trace.lastStepTime = Platform_simulatorTime;
+          if (trace.lastInterval > STEPPER_TIMER_FREQUENCY / STEPPER_MINIMUM_RATE)
+            {
+              /* First step after standstill starts a new window */
+              trace.windowStart = Platform_simulatorTime;
+              trace.windowSteps = 0;
+            }
+          else
+            {
+              trace.windowSteps += trace.direction;
+            }
+          if (trace.stepTrace != NULL)
+            {
+              fprintf(trace.stepTrace, "%.7f,%d\n", (double)Platform_simulatorTime / STEPPER_TIMER_FREQUENCY, Platform_stepperPosition[i]);
+            }
+        }
+    }
+}
+
+/**
+ * \brief Writes one sample of the motion trace
+ *
+ * The velocity of each stepper is the mean step rate between the last step
+ * before the previous sample and the last step before this sample. This
+ * averages the jitter of the step times within one sample interval. If the
+ * stepper did not step since the previous sample the velocity is
+ * estimated from the time since its last step instead. Rates below
+ * #STEPPER_MINIMUM_RATE are regarded as standstill. The acceleration is the
+ * change of velocity since the previous sample.
+ * @param[in] time Virtual time of the sample [ticks]
+ */
+static void Platform_sample(uint64_t time)
+{
+  uint64_t interval;
+  float velocity;
+
+  fprintf(Platform_motionTrace, "%.6f", (double)time / STEPPER_TIMER_FREQUENCY);
+  for (uint8_t i=0; i<STEPPER_NUM_STEPPER; i++)
+    {
+      Platform_StepperTrace_t &trace = Platform_stepperTrace[i];
+
+      velocity = 0.0;
+      if (trace.windowSteps != 0)
+        {
+          velocity = (float)trace.windowSteps * STEPPER_TIMER_FREQUENCY / (trace.lastStepTime - trace.windowStart);
+          trace.windowStart = trace.lastStepTime;
+          trace.windowSteps = 0;
+        }
+      else
+        {
+          interval = max(trace.lastInterval, time - trace.lastStepTime);
+          if ((trace.lastInterval > 0) && (interval <= STEPPER_TIMER_FREQUENCY / STEPPER_MINIMUM_RATE))
+            {
+              velocity = (float)trace.direction * STEPPER_TIMER_FREQUENCY / interval;
+            }
+        }
+      fprintf(Platform_motionTrace, ",%.1f,%.1f", velocity,
+              (velocity - trace.velocity) * (1000000.0 / PLATFORM_SIMULATOR_SAMPLE_TIME));
+      trace.velocity = velocity;
+    }
+  fprintf(Platform_motionTrace, "\n");
+}
+
+/**
+ * \brief Advances the virtual clock
+ *
+ * Calls the interrupt of the step generator whenever the virtual time
+ * reaches the next compare value and writes the samples of the motion
+ * trace which are due.
+ * @param[in] ticks Time to advance [ticks of #STEPPER_TIMER_FREQUENCY]
+ */
+void Platform_stepperTimerRun(uint32_t ticks)
+{
+  uint64_t end = Platform_simulatorTime + ticks;
+
+  while (Platform_stepperTimerCompare <= end)
+    {
+      while ((Platform_motionTrace != NULL) && (Platform_nextSample <= Platform_stepperTimerCompare))
+        {
+          Platform_sample(Platform_nextSample);
+          Platform_nextSample += PLATFORM_SIMULATOR_SAMPLE_TIME * PLATFORM_TICKS_PER_MICROSECOND;
+        }
+      Platform_simulatorTime = Platform_stepperTimerCompare;
+      Platform_stepperTimerTime = (uint32_t)Platform_simulatorTime;
+      Platform_simulatorStatistics.isrCalls++;
+#if (STEPPER_GENERATOR == STEPPER_GENERATOR_STEPCOMPRESS)
+      Platform_stepperTimerCompare += StepCompress_isr();
+#else
+      Platform_stepperTimerCompare += Stepper_isr();
+#endif
+    }
+  Platform_simulatorTime = end;
+  Platform_stepperTimerTime = (uint32_t)end;
+}
+
+/**
+ * \brief Virtual time since start of the simulation in microseconds
+ *
+ * @return Time since start [µs]
+ */
+uint64_t Platform_timeMicros(void)
+{
+  return Platform_simulatorTime / PLATFORM_TICKS_PER_MICROSECOND;
+}
+
+/**
+ * \brief Cycle counter
+ *
+ * There are no cycles in virtual time, the ticks of the virtual step
+ * timer are returned instead.
+ * @return Time since start [ticks of #STEPPER_TIMER_FREQUENCY]
+ */
+uint64_t Platform_timeCycles(void)
+{
+  return Platform_simulatorTime;
+}
+
+/**
+ * \brief Advances the virtual clock to the given deadline
+ *
+ * Interrupts due until then are called as by #Platform_stepperTimerRun.
+ * Used while the machine is waiting, so idle time is skipped without
+ * calling loop() over and over. The skipped time is added to
+ * #Platform_simulatorStatistics.
+ * @param[in] deadline Virtual time to wake up, see #Platform_timeMicros
+ * [µs]. Nothing happens if the deadline has already passed.
+ */
+void Platform_timeSleepUntil(uint64_t deadline)
+{
+  uint64_t ticks;
+
+  deadline *= PLATFORM_TICKS_PER_MICROSECOND;
+  while (deadline > Platform_simulatorTime)
+    {
+      /* Step timer advances 32 bit at a time */
+      ticks = min(deadline - Platform_simulatorTime, (uint64_t)INT32_MAX);
+      Platform_simulatorStatistics.skippedTime += ticks;
+      Platform_stepperTimerRun((uint32_t)ticks);
+    }
+}
+
+/**
+ * \brief Virtual time since start of the simulation in microseconds
+ *
+ * Replaces micros() of the Arduino framework.
+ * @return Time since start [µs]. Overflows after approximately 70 minutes.
+ */
+uint32_t micros(void)
+{
+  return (uint32_t)Platform_timeMicros();
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
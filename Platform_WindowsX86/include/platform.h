@@ -39,6 +39,11 @@
  */
 
 /* ******************| Inclusions |************************************ */
+/* Standard headers must be included before the Arduino like macros below
+ * are defined. Otherwise the macros will clash with the declarations of
+ * abs() and friends. */
+#include <stdlib.h>
+#include <math.h>
 
 /* ******************| Macros |**************************************** */
 /**
@@ -53,12 +58,24 @@
 #define min(a,b) ((a)<(b)?(a):(b))
 #define max(a,b) ((a)>(b)?(a):(b))
 #define abs(x) ((x)>0?(x):-(x))
+#define sq(x) ((x)*(x))
 
 /**
  * Macros from Arduino sfr_defs.h
  */
 #define _BV(bit) (1 << (bit))
 
+/**
+ * Size of the non-volatile storage for parameter [bytes]. Same as the
+ * EEPROM of an ATmega2560.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DPLATFORM_STORAGE_SIZE 4096
+ */
+#ifndef PLATFORM_STORAGE_SIZE
+#define PLATFORM_STORAGE_SIZE             (uint16_t)4096
+#endif
+
 /* ******************| Type definitions |****************************** */
 
 /**
@@ -66,6 +83,7 @@
  * - uint8_t, int8_t,
  * - uint16_t, int16_t,
  * - uint32_t, int32_t
+ * - uint64_t, int64_t
  * Normally they are specified in stdint.h, however, this will invoke one
  * more external reference and is therefore avoided. The following is a 
  * copy of mingw's stdint.h file.
@@ -76,6 +94,16 @@ typedef short  int16_t;
 typedef unsigned short  uint16_t;
 typedef int  int32_t;
 typedef unsigned   uint32_t;
+/* 64 bit types differ between LP64 and LLP64 hosts. Use the compiler's
+ * definition to stay compatible with stdint.h if it is included anyway. */
+typedef __INT64_TYPE__  int64_t;
+typedef __UINT64_TYPE__  uint64_t;
+/* Limits of the types above, guarded in case stdint.h was included */
+#ifndef UINT32_MAX
+#define INT32_MAX   2147483647
+#define UINT32_MAX  0xffffffffU
+#define UINT64_MAX  0xffffffffffffffffULL
+#endif
 
 /*
  * Platform module shall specify bool datatype and TRUE/FALSE.
@@ -89,13 +117,46 @@ typedef unsigned char bool;
 #define FALSE	0
 #define TRUE	1
 
+/**
+ * Statistics of the virtual step timer. Host time is only measured for
+ * interrupts which issued a step event.
+ */
+typedef struct
+{
+  uint32_t isrCalls;       /*!< Number of interrupts which issued a step event */
+  uint32_t stepEvents;     /*!< Number of step events issued by these interrupts */
+  uint32_t minInterval;    /*!< Shortest interval between two step events [ticks] */
+  uint64_t hostTime;       /*!< Sum of the host time spent in these interrupts [ns] */
+  uint64_t hostCycles;     /*!< Sum of the host cycles spent in these interrupts */
+  uint32_t maxHostTime;    /*!< Longest host time spent in one interrupt [ns] */
+} Platform_StepperTimerStatistics_t;
+
 /* ******************| External function declarations |**************** */
+#ifdef __cplusplus
+extern "C" {
+#endif
 extern void setup(void);
 extern void loop(void);
+extern void Platform_stepperWriteDirection(uint8_t directionBits);
+extern void Platform_stepperWriteStep(uint8_t stepBits);
+extern void Platform_stepperTimerRun(uint32_t ticks);
+extern void Platform_serialWrite(const uint8_t *data, uint8_t length);
+extern uint8_t Platform_storageRead(uint16_t address, void *data, uint16_t length);
+extern uint8_t Platform_storageWrite(uint16_t address, const void *data, uint16_t length);
+extern uint64_t Platform_timeMicros(void);
+extern uint64_t Platform_timeCycles(void);
+extern void Platform_timeSleepUntil(uint64_t deadline);
+extern uint32_t micros(void);
+#ifdef __cplusplus
+}
+#endif
 
 /* ******************| External constants |**************************** */
 
 /* ******************| External variables |**************************** */
+extern uint32_t Platform_stepperTimerTime;
+extern int32_t Platform_stepperPosition[8];
+extern Platform_StepperTimerStatistics_t Platform_stepperTimerStatistics;
 
 /** @} doxygen end group definition */
 #endif /* if !defined( PLATFORM_INCLUDE_PLATFORM_H_ ) */
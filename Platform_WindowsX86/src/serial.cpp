@@ -20,26 +20,24 @@
  *
  */
 /**
- * \file blueMarlin.c
+ * \file serial.cpp
  *
- * \brief Main file for BlueMarlin firmware
+ * \brief Serial line of the host platform
  *
- * This is the main entry point to the firmware. In this file setup and
- * loop are implemented.
+ * There is no serial line attached on the host yet. Thus, no g-code is
+ * ever received and everything written is discarded.
  *
  * \project BlueMarlin
- * \author kein0f
+ * \author kein0r
  *
  */
 
-
-/** \addtogroup BlueMarlin
+/** \addtogroup Platform_WindowsX86
  * @{
  */
 
 /* ******************| Inclusions |************************************ */
 #include "platform.h"
-#include "blueMarlin.h"
 
 /* ******************| Macros |**************************************** */
 
@@ -51,29 +49,13 @@
 
 /* ******************| Function Implementation |*********************** */
 /**
- * \brief Implementation of function set-up from Arduino framework
- *
- * This function is called right after hardware initialization once. The
- * existence of this function is based on the Arduino framework for which
- * this firmware was originally written.
- * This function does not obey the overall function naming rules.
-*/
-void setup(void)
-{
-
-}
-
-/**
- * \brief Implementation of function loop from Arduino framework
+ * \brief Writes data to serial line
  *
- * This function is called cyclically as fast as possible. The existence
- * of this function is based on the Arduino framework for which
- * this firmware was originally written.
- * This function does not obey the overall function naming rules.
+ * @param[in] data Data to be written
+ * @param[in] length Number of bytes in #data
  */
-void loop(void)
+void Platform_serialWrite(const uint8_t *data, uint8_t length)
 {
-
 }
 
 /** @} doxygen end group definition */
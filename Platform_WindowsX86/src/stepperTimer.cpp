@@ -0,0 +1,212 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * \file stepperTimer.cpp
+ *
+ * \brief Virtual step timer and stepper outputs
+ *
+ * There is neither a timer nor stepper drivers on the host. The step timer
+ * is therefore simulated: #Platform_stepperTimerRun advances a virtual
+ * clock and calls the interrupt of the step generator selected with
+ * #STEPPER_GENERATOR whenever the interval returned by the last call has
+ * elapsed. Step pulses are counted per stepper in
+ * #Platform_stepperPosition.
+ * While doing so the host time spent in the interrupt is measured to get an
+ * idea of the interrupt load.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+/** \addtogroup Platform_WindowsX86
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+/* Must be included before platform.h because of macros min and max */
+#include <chrono>
+#include <x86intrin.h>
+#include "platform.h"
+#include <stepper.h>
+#include <stepCompress.h>
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Virtual time of the step timer [ticks of #STEPPER_TIMER_FREQUENCY]
+ */
+uint32_t Platform_stepperTimerTime = 0;
+
+/**
+ * Virtual time at which the interrupt is called next
+ */
+static uint32_t Platform_stepperTimerCompare = 0;
+
+/**
+ * Last direction bits written by #Stepper
+ */
+static uint8_t Platform_stepperDirectionBits = 0;
+
+/**
+ * Position of each stepper counted from step pulses [steps]
+ */
+int32_t Platform_stepperPosition[8] = {0};
+
+/**
+ * Statistics of the virtual step timer
+ */
+Platform_StepperTimerStatistics_t Platform_stepperTimerStatistics = {0, 0, 0xFFFFFFFF, 0, 0, 0};
+
+/**
+ * True if the last interrupt issued a step event
+ */
+static bool Platform_stepperStepEvent = false;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Sets direction pins of all steppers
+ *
+ * @param[in] directionBits One bit per stepper, set bit means negative
+ * direction
+ */
+void Platform_stepperWriteDirection(uint8_t directionBits)
+{
+  Platform_stepperDirectionBits = directionBits;
+}
+
+/**
+ * \brief Issues one step pulse for each stepper with its bit set
+ *
+ * @param[in] stepBits One bit per stepper
+ */
+void Platform_stepperWriteStep(uint8_t stepBits)
+{
+  Platform_stepperStepEvent = true;
+  Platform_stepperTimerStatistics.stepEvents++;
+  for (uint8_t i=0; i<8; i++)
+    {
+      if (stepBits & _BV(i))
+        {
+          Platform_stepperPosition[i] += (Platform_stepperDirectionBits & _BV(i)) ? -1 : 1;
+        }
+    }
+}
+
+/**
+ * \brief Advances the virtual step timer
+ *
+ * Calls the interrupt of the step generator whenever the virtual time
+ * reaches the next compare value. Interrupts which issued at least one
+ * step pulse are added to #Platform_stepperTimerStatistics.
+ * @param[in] ticks Time to advance [ticks of #STEPPER_TIMER_FREQUENCY]
+ */
+void Platform_stepperTimerRun(uint32_t ticks)
+{
+  uint32_t end = Platform_stepperTimerTime + ticks;
+  uint32_t interval;
+  uint32_t hostTime;
+  uint64_t cycles;
+  std::chrono::steady_clock::time_point start;
+
+  while ((int32_t)(Platform_stepperTimerCompare - end) <= 0)
+    {
+      Platform_stepperTimerTime = Platform_stepperTimerCompare;
+      Platform_stepperStepEvent = false;
+
+      start = std::chrono::steady_clock::now();
+      cycles = __rdtsc();
+#if (STEPPER_GENERATOR == STEPPER_GENERATOR_STEPCOMPRESS)
+      interval = StepCompress_isr();
+#else
+      interval = Stepper_isr();
+#endif
+      cycles = __rdtsc() - cycles;
+      hostTime = (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+      if (Platform_stepperStepEvent)
+        {
+          Platform_stepperTimerStatistics.isrCalls++;
+          Platform_stepperTimerStatistics.hostTime += hostTime;
+          Platform_stepperTimerStatistics.hostCycles += cycles;
+          Platform_stepperTimerStatistics.maxHostTime = max(Platform_stepperTimerStatistics.maxHostTime, hostTime);
+          Platform_stepperTimerStatistics.minInterval = min(Platform_stepperTimerStatistics.minInterval, interval);
+        }
+      Platform_stepperTimerCompare += interval;
+    }
+  Platform_stepperTimerTime = end;
+}
+
+/**
+ * \brief Time since start of the host in microseconds
+ *
+ * Unlike the step timer this is the real time of the host, taken from the
+ * monotonic steady_clock.
+ * @return Time since start [µs]
+ */
+uint64_t Platform_timeMicros(void)
+{
+  static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * \brief Cycle counter of the host
+ *
+ * @return Time stamp counter of the CPU [cycles]
+ */
+uint64_t Platform_timeCycles(void)
+{
+  return __rdtsc();
+}
+
+/**
+ * \brief Waits until the given time
+ *
+ * Windows can't sleep with microsecond resolution, the time is waited
+ * actively.
+ * @param[in] deadline Time to wake up, see #Platform_timeMicros [µs]
+ */
+void Platform_timeSleepUntil(uint64_t deadline)
+{
+  while (Platform_timeMicros() < deadline);
+}
+
+/**
+ * \brief Time since start of the host in microseconds
+ *
+ * Replaces micros() of the Arduino framework.
+ * @return Time since start [µs]. Overflows after approximately 70 minutes.
+ */
+uint32_t micros(void)
+{
+  return (uint32_t)Platform_timeMicros();
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
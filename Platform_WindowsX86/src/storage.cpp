@@ -0,0 +1,114 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * \file storage.cpp
+ *
+ * \brief Non-volatile storage of the Windows platform
+ *
+ * The storage is emulated in RAM and starts erased, that is, filled
+ * with 0xFF like a new EEPROM or flash. Stored parameter are therefore
+ * only kept until the process ends.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+/** \addtogroup Platform_WindowsX86
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+/* Must be included before platform.h because of macros min and max */
+#include <string.h>
+#include "platform.h"
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+static bool Platform_storageErase(void);
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Content of the storage
+ */
+static uint8_t Platform_storage[PLATFORM_STORAGE_SIZE];
+
+/**
+ * True after #Platform_storage was erased during start-up
+ */
+static bool Platform_storageErased = Platform_storageErase();
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Erases the complete storage
+ *
+ * @return Always true
+ */
+static bool Platform_storageErase(void)
+{
+  memset(Platform_storage, 0xFF, sizeof(Platform_storage));
+  return true;
+}
+
+/**
+ * \brief Reads from the storage
+ *
+ * @param[in] address First byte to be read
+ * @param[out] data Read bytes
+ * @param[in] length Number of bytes to be read
+ * @return RESULT_OK if the bytes were read, RESULT_NOT_OK if they are
+ * outside of the storage
+ */
+uint8_t Platform_storageRead(uint16_t address, void *data, uint16_t length)
+{
+  if (!Platform_storageErased || ((uint32_t)address + length > PLATFORM_STORAGE_SIZE))
+    {
+      return RESULT_NOT_OK;
+    }
+  memcpy(data, &Platform_storage[address], length);
+  return RESULT_OK;
+}
+
+/**
+ * \brief Writes to the storage
+ *
+ * @param[in] address First byte to be written
+ * @param[in] data Bytes to be written
+ * @param[in] length Number of bytes to be written
+ * @return RESULT_OK if the bytes were written, RESULT_NOT_OK if they are
+ * outside of the storage
+ */
+uint8_t Platform_storageWrite(uint16_t address, const void *data, uint16_t length)
+{
+  if (!Platform_storageErased || ((uint32_t)address + length > PLATFORM_STORAGE_SIZE))
+    {
+      return RESULT_NOT_OK;
+    }
+  memcpy(&Platform_storage[address], data, length);
+  return RESULT_OK;
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
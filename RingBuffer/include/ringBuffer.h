@@ -36,50 +36,42 @@
 
 /* ******************| Inclusions |************************************ */
 #include <platform.h>
+#include <trace.h>
 
 /* ******************| Macros |**************************************** */
-#define RINGBUFFER_LASTOPERATION_READ         FALSE
-#define RINGBUFFER_LASTOPERATION_WRITE        TRUE
-
 #define RINGBUFFER_ITERATOR_TAIL              (uint8_t)0
 #define RINGBUFFER_ITERATOR_HEAD              (uint8_t)1
 
 /* ******************| Type definitions |****************************** */
 
 /* Some function like macro to make code more readable */
-#define RingBuffer_incrementIndex(a)          a = ((a + 1) % ringBufferSize)
-#define RingBuffer_decrementIndex(a)          a = (((RingBuffer_BufferIndex_t)(a - 1)) % ringBufferSize)
-#define RingBuffer_ringBufferFull(x)          (x.lastOperation == RINGBUFFER_LASTOPERATION_WRITE && (x.head == x.tail))
-#define RingBuffer_ringBufferEmpty(x)         (x.lastOperation == RINGBUFFER_LASTOPERATION_READ && (x.head == x.tail))
+#define RingBuffer_index(a)                   ((a) & (ringBufferSize - 1))
 
 
 template <class T, uint8_t ringBufferSize> class RingBuffer
 {
 
     /**
-     * Datatype to keep track of last operation to ring buffer. FALSE if last
-     * operation was a read, otherwise last operation was a write to buffer
-     */
-    typedef bool RingBuffer_lastOperation_t;
-
-
-    /**
-     * Typedef for head and tail pointer of ringbuffer
+     * Typedef for head and tail counter of ringbuffer
      */
     typedef uint8_t RingBuffer_BufferIndex_t;
 
     /**
     * Data structure for ring buffer.
-    * Index pointer for head and tail will always point to element which is next to be read/written.
-    * This ring buffer will use "Record last operation" for full/empty buffer distinction see
-    * https://en.wikipedia.org/wiki/Circular_buffer "Record last operation" for details
+    * Head and tail are free running counters of the elements written and
+    * read. The element to be written/read next is at the counter modulo
+    * ringBufferSize, the number of elements in the buffer is the difference
+    * of both counters. Thus, full and empty buffer can be distinguished
+    * without further state.
+    * Head is only changed by the producer and tail only by the consumer.
+    * One producer and one consumer, e.g. main loop and interrupt or two
+    * threads, may therefore use the buffer concurrently without locking.
     */
     typedef struct
     {
         T buffer[ringBufferSize];                  /*!< Content of ring buffer */
-        RingBuffer_BufferIndex_t head;             /*!< Index for writing to the ring buffer. Index is increased after writing (i.e. producing) an element */
-        RingBuffer_BufferIndex_t tail;             /*!< Index for reading from ring buffer. Index is increased after reading (i.e consuming) an element. */
-        RingBuffer_lastOperation_t lastOperation;  /*!< False if last operation was reading the buffer, true if last operation was writting into the buffer */
+        RingBuffer_BufferIndex_t head;             /*!< Number of elements written (modulo 256). Increased after writing (i.e. producing) an element */
+        RingBuffer_BufferIndex_t tail;             /*!< Number of elements read (modulo 256). Increased after reading (i.e consuming) an element. */
     } RingBuffer_RingBuffer_t;
 
 private:
@@ -97,6 +89,9 @@ public:
     T* previousElement();
 };
 
+/* Member functions of the template must be visible wherever it is used */
+#include "../src/ringBuffer.cpp"
+
 /* ******************| External function declarations |**************** */
 
 /* ******************| External constants |**************************** */
@@ -19,6 +19,9 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  *
  */
+#if (!defined RINGBUFFER_SRC_RINGBUFFER_CPP_)
+/* Preprocessor exclusion definition */
+#define RINGBUFFER_SRC_RINGBUFFER_CPP_
 /**
  * \brief Generic ringbuffer template class
  *
@@ -30,6 +33,9 @@
  * - _enqueuecommand: Copies command to command_queue buffer 
  * - _commit_command: Moves the write pointer of command_queue (cmd_queue_index_w) ahead
  * 
+ * This file is included by ringBuffer.h because the member functions of
+ * a template must be visible in every translation unit which uses it.
+ *
  * \project BlueMarlin
  * \author kein0r
  *
@@ -59,11 +65,11 @@
 template <class T, uint8_t ringBufferSize>RingBuffer<T, ringBufferSize>::RingBuffer()
 {
 	static_assert(!(ringBufferSize && ((ringBufferSize & (ringBufferSize-1)))), "ringBufferSize must be to the power of two (2, 4, 16, 32, ...)");
-    /* Initialize ring buffer */
+	static_assert(ringBufferSize <= 128, "ringBufferSize must not exceed 128 because head and tail are 8 bit counters");
+    /* Initialize ring buffer, buffer is empty on start-up */
     ringBuffer.head = 0;
     ringBuffer.tail = 0;
-    iterator = ringBufferSize;     /* Set iterator outside of the buffer to mark it invalid */
-    ringBuffer.lastOperation = RINGBUFFER_LASTOPERATION_READ; /* Buffer is empty on start-up */
+    iterator = 0;     /* Iterator is invalid until startIterator is called */
 }
 
 /**
@@ -74,22 +80,29 @@ template <class T, uint8_t ringBufferSize>RingBuffer<T, ringBufferSize>::RingBuf
  * @return Returns RESULT_OK in case element could be added to ringbuffer, 
  * RESULT_NOT_OK if not
  * @note This function is non-blocking. If the element can't be added
- * the function will just return.
+ * the function will just return. It may run concurrently to #read but
+ * only one producer must write to the buffer.
  */
 template <class T, uint8_t ringBufferSize>uint8_t RingBuffer<T, ringBufferSize>::write(const T data)
 {
   uint8_t retVal = RESULT_NOT_OK;
-  if (!RingBuffer_ringBufferFull(ringBuffer))
+  RingBuffer_BufferIndex_t head = ringBuffer.head;
+  /* Acquire makes sure the consumer is done with an element before it is
+   * overwritten */
+  RingBuffer_BufferIndex_t tail = __atomic_load_n(&ringBuffer.tail, __ATOMIC_ACQUIRE);
+
+  if ((RingBuffer_BufferIndex_t)(head - tail) < ringBufferSize)
   {
     /* Place data in buffer */
-    ringBuffer.buffer[ringBuffer.head] = data;
-    ringBuffer.lastOperation = RINGBUFFER_LASTOPERATION_WRITE;
-    RingBuffer_incrementIndex(ringBuffer.head);
+    ringBuffer.buffer[RingBuffer_index(head)] = data;
+    /* Release publishes the element before the new head */
+    __atomic_store_n(&ringBuffer.head, (RingBuffer_BufferIndex_t)(head + 1), __ATOMIC_RELEASE);
 	retVal = RESULT_OK;
+    TRACE(2, TRACE_EVENT_RINGBUFFER_WRITE, this, (RingBuffer_BufferIndex_t)(head + 1 - tail));
   }
   else
   {
-    /* Nothing to be done */
+    TRACE(2, TRACE_EVENT_RINGBUFFER_FULL, this, ringBufferSize);
   }
   return retVal;
 }
@@ -103,37 +116,42 @@ template <class T, uint8_t ringBufferSize>uint8_t RingBuffer<T, ringBufferSize>:
  * If no data is present #data will be left untouched.
  * @return Function will return RESULT_OK in case data was present in 
  * ringbuffer and was copied to #data. RESULT_NOT_OK if not.
+ * @note This function may run concurrently to #write but only one consumer
+ * must read from the buffer.
  */
 template <class T, uint8_t ringBufferSize> uint8_t RingBuffer<T, ringBufferSize>::read(T *data)
 {
   uint8_t retVal = RESULT_NOT_OK;
+  RingBuffer_BufferIndex_t tail = ringBuffer.tail;
+  /* Acquire makes sure the element written by the producer is visible */
+  RingBuffer_BufferIndex_t head = __atomic_load_n(&ringBuffer.head, __ATOMIC_ACQUIRE);
   
-  if(! RingBuffer_ringBufferEmpty(ringBuffer) )
+  if (head != tail)
   {
-    *data = ringBuffer.buffer[ringBuffer.tail];
-    ringBuffer.lastOperation = RINGBUFFER_LASTOPERATION_READ;
-    RingBuffer_incrementIndex(ringBuffer.tail);
+    *data = ringBuffer.buffer[RingBuffer_index(tail)];
+    /* Release hands the element back to the producer after it was copied */
+    __atomic_store_n(&ringBuffer.tail, (RingBuffer_BufferIndex_t)(tail + 1), __ATOMIC_RELEASE);
 	retVal = RESULT_OK;
+    TRACE(2, TRACE_EVENT_RINGBUFFER_READ, this, (RingBuffer_BufferIndex_t)(head - tail - 1));
   }
   return retVal;
 }
 
 /**
- * \brief Returns the number of bytes in ringbuffer.
- * @return Number of bytes already received from two wire slave device
- * @note This function is not interrupt save in case buffer is filled within
- * interrupt context head must be either copied to a local variable or 
- * interrupts shall be locked before calling (noInterrupts()/interrupts())
+ * \brief Returns the number of elements in ringbuffer.
+ * @return Number of elements written but not yet read
+ * @note Producer and consumer may call this function. The result may be
+ * outdated as soon as it is returned, but never in a harmful way: For the
+ * producer the buffer can only become emptier, for the consumer only
+ * fuller.
  */
 template <class T, uint8_t ringBufferSize> uint8_t RingBuffer<T, ringBufferSize>::available()
 {
+  RingBuffer_BufferIndex_t tail = __atomic_load_n(&ringBuffer.tail, __ATOMIC_ACQUIRE);
+  RingBuffer_BufferIndex_t head = __atomic_load_n(&ringBuffer.head, __ATOMIC_ACQUIRE);
+
   /* Cast to uint8_t is important here because if not compiler will chose sint8_t */
-  uint8_t retVal = (uint8_t)(ringBuffer.head - ringBuffer.tail) % ringBufferSize;
-  if ((retVal == 0) && (ringBuffer.lastOperation == RINGBUFFER_LASTOPERATION_WRITE))
-  {
-	retVal = ringBufferSize;
-  }
-  return retVal;
+  return (uint8_t)(head - tail);
 }
 
 /**
@@ -153,21 +171,20 @@ template <class T, uint8_t ringBufferSize> T* RingBuffer<T, ringBufferSize>::sta
   T *retVal = NULL;
 
   /* We can only iterate over the buffer if it's not empty */
-  if (!RingBuffer_ringBufferEmpty(ringBuffer))
+  if (ringBuffer.head != ringBuffer.tail)
   {
     if (initialIteratorPlace == RINGBUFFER_ITERATOR_HEAD)
     {
       /* Because head points to the next element to be written, thus, to a
        * right now still empty space, iterator must be decreased once to point
        * to a valid location */
-      iterator = ringBuffer.head;
-      RingBuffer_decrementIndex(iterator);
+      iterator = ringBuffer.head - 1;
     }
     else
     {
       iterator = ringBuffer.tail;
     }
-    retVal = &(ringBuffer.buffer[iterator]);
+    retVal = &(ringBuffer.buffer[RingBuffer_index(iterator)]);
   }
   return retVal;
 }
@@ -181,17 +198,15 @@ template <class T, uint8_t ringBufferSize> T* RingBuffer<T, ringBufferSize>::sta
 template <class T, uint8_t ringBufferSize> T* RingBuffer<T, ringBufferSize>::nextElement()
 {
   T *retVal = NULL;
-  RingBuffer_BufferIndex_t tempIterator = iterator;
-
   /* Firstly only increment a copy of the real iterator to check if
    * it is not increased beyond head.
    */
-  RingBuffer_incrementIndex(tempIterator);
+  RingBuffer_BufferIndex_t tempIterator = iterator + 1;
 
   /* Only increment if we are not yet at head */
   if (tempIterator != ringBuffer.head)
   {
-    retVal = &(ringBuffer.buffer[iterator]);
+    retVal = &(ringBuffer.buffer[RingBuffer_index(iterator)]);
     iterator = tempIterator;
   }
   return retVal;
@@ -209,10 +224,11 @@ template <class T, uint8_t ringBufferSize> T* RingBuffer<T, ringBufferSize>::pre
   /* Only decrement if we are not yet at tail */
   if (iterator != ringBuffer.tail)
   {
-    RingBuffer_decrementIndex(iterator);
-    retVal = &(ringBuffer.buffer[iterator]);
+    iterator--;
+    retVal = &(ringBuffer.buffer[RingBuffer_index(iterator)]);
   }
   return retVal;
 }
 /** @} doxygen end group definition */
+#endif /* if !defined( RINGBUFFER_SRC_RINGBUFFER_CPP_ ) */
 /* ******************| End of file |*********************************** */
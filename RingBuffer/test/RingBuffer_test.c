@@ -511,6 +511,40 @@ static void RingBuffer_RingBuffer_previousElement_2(void)
   TEST_ASSERT_NULL(charRingBuffer->previousElement());
 }
 
+/*
+ * Test if head and tail counters wrap around correctly
+ * Write and read more than 256 elements in chunks which do not divide
+ * the buffer size, check content and number of elements all the way
+ * and fill the buffer completely after the counters wrapped
+ */
+static void RingBuffer_RingBuffer_WrapChar_1(void)
+{
+  char element;
+  unsigned char next = 0;
+  unsigned char expected = 0;
+
+  for (int i=0; i<100; i++)
+  {
+    for (int j=0; j<5; j++)
+    {
+      TEST_ASSERT_EQUAL_INT(RESULT_OK, charRingBuffer->write((char)next++));
+    }
+    TEST_ASSERT_EQUAL_INT(5, charRingBuffer->available());
+    for (int j=0; j<5; j++)
+    {
+      TEST_ASSERT_EQUAL_INT(RESULT_OK, charRingBuffer->read(&element));
+      TEST_ASSERT_EQUAL_INT(expected++, (unsigned char)element);
+    }
+    TEST_ASSERT_EQUAL_INT(0, charRingBuffer->available());
+  }
+  for (int i=0; i<RINGBUFFER_RINGBUFFER_TESTSIZE; i++)
+  {
+    TEST_ASSERT_EQUAL_INT(RESULT_OK, charRingBuffer->write((char)i));
+  }
+  TEST_ASSERT_EQUAL_INT(RINGBUFFER_RINGBUFFER_TESTSIZE, charRingBuffer->available());
+  TEST_ASSERT_EQUAL_INT(RESULT_NOT_OK, charRingBuffer->write(element));
+}
+
 
 /**
  * Test Setup function which is called before all each test case
@@ -551,7 +585,8 @@ TestRef CharRingBuffer_test_RunTests(void)
     new_TestFixture("Test case RingBuffer_RingBuffer_ReadChar_1", RingBuffer_RingBuffer_ReadChar_1),
     new_TestFixture("Test case RingBuffer_RingBuffer_ReadChar_2", RingBuffer_RingBuffer_ReadChar_2),
     new_TestFixture("Test case RingBuffer_RingBuffer_WriteChar_1", RingBuffer_RingBuffer_WriteChar_1),
-    new_TestFixture("Test case RingBuffer_RingBuffer_WriteChar_2", RingBuffer_RingBuffer_WriteChar_2)
+    new_TestFixture("Test case RingBuffer_RingBuffer_WriteChar_2", RingBuffer_RingBuffer_WriteChar_2),
+    new_TestFixture("Test case RingBuffer_RingBuffer_WrapChar_1", RingBuffer_RingBuffer_WrapChar_1)
   };
   EMB_UNIT_TESTCALLER(CharRingBuffer_tests,"GCodeRingBuffer Unit test",setUpCharRingBuffer,tearDownCharRingBuffer,fixtures);
   return (TestRef)&CharRingBuffer_tests;
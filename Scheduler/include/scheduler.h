@@ -0,0 +1,131 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#if (!defined SCHEDULER_INCLUDE_SCHEDULER_H_)
+/* Preprocessor exclusion definition */
+#define SCHEDULER_INCLUDE_SCHEDULER_H_
+/**
+ * \brief Scheduler include file
+ *
+ * Cooperative scheduler. Each call of #Scheduler_run is one round in
+ * which every due task is run once, in order of priority. Tasks are
+ * either run in every round or at a fixed rate. As no task is
+ * interrupted, each task must return within its budget. The worst case
+ * latency of a task is therefore bounded by the sum of all budgets.
+ * Run time, lateness and deadline misses of each task as well as the
+ * duration of the rounds are recorded.
+ * #Scheduler_nextRelease allows the platform to sleep until the next
+ * fixed-rate task is due while the application has nothing to do.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup Scheduler
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <platform.h>
+
+/* ******************| Macros |**************************************** */
+/**
+ * Maximum number of tasks.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DSCHEDULER_MAX_TASKS 8
+ */
+#ifndef SCHEDULER_MAX_TASKS
+#define SCHEDULER_MAX_TASKS           (uint8_t)8
+#endif
+
+/**
+ * Period of tasks which shall run in every round
+ */
+#define SCHEDULER_EVERY_ROUND         (uint32_t)0
+
+/**
+ * Budget of tasks whose run time shall not be checked
+ */
+#define SCHEDULER_NO_BUDGET           (uint32_t)0
+
+/* ******************| Type definitions |****************************** */
+/**
+ * Function of a task. Must return within the budget of the task.
+ */
+typedef void (*Scheduler_Function_t)(void);
+
+/**
+ * Run time statistics of a task. All times are given in µs.
+ */
+typedef struct
+{
+  uint32_t runs;              /*!< Number of runs */
+  uint64_t totalTime;         /*!< Sum of all run times */
+  uint32_t maxTime;           /*!< Longest run time */
+  uint32_t overruns;          /*!< Number of runs longer than the budget */
+  uint32_t maxLateness;       /*!< Longest time between release and start of a fixed-rate task */
+  uint32_t deadlineMisses;    /*!< Number of runs of a fixed-rate task started one period or more after release */
+} Scheduler_TaskStatistics_t;
+
+/**
+ * Task of the scheduler
+ */
+typedef struct
+{
+  const char *name;                       /*!< Name used in reports */
+  Scheduler_Function_t function;          /*!< Function to be run */
+  uint8_t priority;                       /*!< Tasks with lower value run first within a round */
+  uint32_t period;                        /*!< Period of a fixed-rate task or #SCHEDULER_EVERY_ROUND [µs] */
+  uint32_t budget;                        /*!< Longest allowed run time or #SCHEDULER_NO_BUDGET [µs] */
+  uint64_t release;                       /*!< Time at which a fixed-rate task is due next, see Platform_timeMicros() [µs] */
+  Scheduler_TaskStatistics_t statistics;  /*!< Run time statistics */
+} Scheduler_Task_t;
+
+/**
+ * Statistics of the rounds. All times are given in µs.
+ */
+typedef struct
+{
+  uint32_t rounds;            /*!< Number of calls of #Scheduler_run */
+  uint32_t maxRoundTime;      /*!< Longest duration of one round */
+  uint32_t maxRoundInterval;  /*!< Longest time between the start of two rounds, that is worst case loop latency */
+} Scheduler_Statistics_t;
+
+/* ******************| External function declarations |**************** */
+extern void Scheduler_init(void);
+extern uint8_t Scheduler_addTask(const char *name, Scheduler_Function_t function, uint8_t priority, uint32_t period, uint32_t budget);
+extern void Scheduler_run(void);
+extern uint64_t Scheduler_nextRelease(void);
+extern void Scheduler_resetStatistics(void);
+
+/* ******************| External constants |**************************** */
+
+/* ******************| External variables |**************************** */
+extern Scheduler_Task_t Scheduler_tasks[SCHEDULER_MAX_TASKS];
+extern uint8_t Scheduler_numTasks;
+extern Scheduler_Statistics_t Scheduler_statistics;
+
+/** @} doxygen end group definition */
+#endif /* if !defined( SCHEDULER_INCLUDE_SCHEDULER_H_ ) */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,237 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * \addtogroup Scheduler
+ * @{
+ *
+ * \brief Scheduler source file
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ * Tasks are kept sorted by priority, thus, a round simply runs all due
+ * tasks from first to last. A fixed-rate task is released again one
+ * period after its last release, not after its last start, so late
+ * starts do not accumulate. If a task misses a whole period the release
+ * is moved to one period after the start instead of running the task
+ * several times in a row.
+ *
+ * @note Replaces the polling order of Marlin's loop() and idle()
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <string.h>
+#include "scheduler.h"
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+void Scheduler_init(void);
+uint8_t Scheduler_addTask(const char *name, Scheduler_Function_t function, uint8_t priority, uint32_t period, uint32_t budget);
+void Scheduler_run(void);
+uint64_t Scheduler_nextRelease(void);
+void Scheduler_resetStatistics(void);
+static void Scheduler_runTask(Scheduler_Task_t *task);
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Tasks sorted by priority
+ */
+Scheduler_Task_t Scheduler_tasks[SCHEDULER_MAX_TASKS];
+
+/**
+ * Number of valid entries in #Scheduler_tasks
+ */
+uint8_t Scheduler_numTasks = 0;
+
+/**
+ * Statistics of the rounds
+ */
+Scheduler_Statistics_t Scheduler_statistics;
+
+/**
+ * Start of the last round, see Platform_timeMicros() [µs]
+ */
+static uint64_t Scheduler_roundStart;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Initializes Scheduler module
+ *
+ * Removes all tasks and resets the statistics.
+ */
+void Scheduler_init(void)
+{
+  Scheduler_numTasks = 0;
+  Scheduler_resetStatistics();
+}
+
+/**
+ * \brief Adds a task
+ *
+ * Tasks with the same priority run in the order they were added. A
+ * fixed-rate task is due immediately.
+ * @param[in] name Name used in reports
+ * @param[in] function Function to be run
+ * @param[in] priority Tasks with lower value run first within a round
+ * @param[in] period Period of a fixed-rate task or #SCHEDULER_EVERY_ROUND
+ * [µs]
+ * @param[in] budget Longest allowed run time or #SCHEDULER_NO_BUDGET. Longer
+ * runs are counted as overrun [µs]
+ * @return RESULT_OK if the task was added, RESULT_NOT_OK if the maximum
+ * number of tasks was reached
+ */
+uint8_t Scheduler_addTask(const char *name, Scheduler_Function_t function, uint8_t priority, uint32_t period, uint32_t budget)
+{
+  uint8_t index = Scheduler_numTasks;
+
+  if (Scheduler_numTasks >= SCHEDULER_MAX_TASKS)
+    {
+      return RESULT_NOT_OK;
+    }
+  /* Insertion sort, tasks with the same priority keep their order */
+  while ((index > 0) && (Scheduler_tasks[index - 1].priority > priority))
+    {
+      Scheduler_tasks[index] = Scheduler_tasks[index - 1];
+      index--;
+    }
+  Scheduler_tasks[index].name = name;
+  Scheduler_tasks[index].function = function;
+  Scheduler_tasks[index].priority = priority;
+  Scheduler_tasks[index].period = period;
+  Scheduler_tasks[index].budget = budget;
+  Scheduler_tasks[index].release = Platform_timeMicros();
+  memset(&Scheduler_tasks[index].statistics, 0, sizeof(Scheduler_TaskStatistics_t));
+  Scheduler_numTasks++;
+  return RESULT_OK;
+}
+
+/**
+ * \brief Runs one task and updates its statistics
+ *
+ * @param[in] task Task to be run
+ */
+static void Scheduler_runTask(Scheduler_Task_t *task)
+{
+  Scheduler_TaskStatistics_t *statistics = &task->statistics;
+  uint64_t start = Platform_timeMicros();
+  uint32_t lateness;
+  uint32_t time;
+
+  task->function();
+  time = (uint32_t)(Platform_timeMicros() - start);
+
+  statistics->runs++;
+  statistics->totalTime += time;
+  statistics->maxTime = max(statistics->maxTime, time);
+  if ((task->budget != SCHEDULER_NO_BUDGET) && (time > task->budget))
+    {
+      statistics->overruns++;
+    }
+  if (task->period != SCHEDULER_EVERY_ROUND)
+    {
+      lateness = (uint32_t)min(start - task->release, (uint64_t)UINT32_MAX);
+      statistics->maxLateness = max(statistics->maxLateness, lateness);
+      if (lateness >= task->period)
+        {
+          statistics->deadlineMisses++;
+          task->release = start + task->period;
+        }
+      else
+        {
+          task->release += task->period;
+        }
+    }
+}
+
+/**
+ * \brief Runs one round
+ *
+ * Runs every task which is due once, in order of priority. Shall be called
+ * cyclically, e.g. from loop().
+ */
+void Scheduler_run(void)
+{
+  uint64_t start = Platform_timeMicros();
+  uint32_t time;
+  Scheduler_Task_t *task;
+
+  if (Scheduler_statistics.rounds > 0)
+    {
+      time = (uint32_t)min(start - Scheduler_roundStart, (uint64_t)UINT32_MAX);
+      Scheduler_statistics.maxRoundInterval = max(Scheduler_statistics.maxRoundInterval, time);
+    }
+  Scheduler_roundStart = start;
+  for (uint8_t i=0; i<Scheduler_numTasks; i++)
+    {
+      task = &Scheduler_tasks[i];
+      if ((task->period == SCHEDULER_EVERY_ROUND) || (Platform_timeMicros() >= task->release))
+        {
+          Scheduler_runTask(task);
+        }
+    }
+  time = (uint32_t)(Platform_timeMicros() - start);
+  Scheduler_statistics.rounds++;
+  Scheduler_statistics.maxRoundTime = max(Scheduler_statistics.maxRoundTime, time);
+}
+
+/**
+ * \brief Time at which the next fixed-rate task is due
+ *
+ * Tasks which run in every round are not considered. Thus, the result is
+ * only meaningful if the application has nothing to do, e.g. while
+ * BlueMarlin_isWaiting() is true.
+ * @return Earliest release of all fixed-rate tasks, see
+ * Platform_timeMicros(), or UINT64_MAX if there is no fixed-rate task [µs]
+ */
+uint64_t Scheduler_nextRelease(void)
+{
+  uint64_t release = UINT64_MAX;
+
+  for (uint8_t i=0; i<Scheduler_numTasks; i++)
+    {
+      if (Scheduler_tasks[i].period != SCHEDULER_EVERY_ROUND)
+        {
+          release = min(release, Scheduler_tasks[i].release);
+        }
+    }
+  return release;
+}
+
+/**
+ * \brief Resets the statistics of all tasks and rounds
+ *
+ * Allows to measure a certain phase, e.g. a print, without the start-up.
+ */
+void Scheduler_resetStatistics(void)
+{
+  for (uint8_t i=0; i<Scheduler_numTasks; i++)
+    {
+      memset(&Scheduler_tasks[i].statistics, 0, sizeof(Scheduler_TaskStatistics_t));
+    }
+  memset(&Scheduler_statistics, 0, sizeof(Scheduler_Statistics_t));
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,119 @@
+/**
+ * \file Scheduler_stub.c
+ *
+ * \brief Stubs for Scheduler unit tests
+ *
+ * All stubs needed for the unit test of this particular modules shall
+ * be done within this file.
+ * Platform_timeMicros() is replaced by a virtual clock. The test tasks record their
+ * runs and advance the clock by #SchedulerTest_runTime.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup Scheduler
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include "Scheduler_test.h"
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+void SchedulerTest_reset();
+void SchedulerTest_taskA();
+void SchedulerTest_taskB();
+void SchedulerTest_taskC();
+static void SchedulerTest_record(char task);
+uint64_t Platform_timeMicros(void);
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Virtual time [µs]
+ */
+uint32_t SchedulerTest_time;
+
+/**
+ * Time each run of a test task takes [µs]
+ */
+uint32_t SchedulerTest_runTime;
+
+/**
+ * Names of the test tasks in the order they were run
+ */
+char SchedulerTest_runs[SCHEDULERTEST_MAX_RUNS + 1];
+
+/**
+ * Number of entries in #SchedulerTest_runs
+ */
+uint8_t SchedulerTest_numRuns;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Resets virtual clock and recorded runs
+ */
+void SchedulerTest_reset()
+{
+  SchedulerTest_time = 0;
+  SchedulerTest_runTime = 0;
+  SchedulerTest_numRuns = 0;
+  SchedulerTest_runs[0] = '\0';
+}
+
+/**
+ * \brief Records one run and advances the virtual clock
+ *
+ * @param[in] task Name of the task
+ */
+static void SchedulerTest_record(char task)
+{
+  if (SchedulerTest_numRuns < SCHEDULERTEST_MAX_RUNS)
+    {
+      SchedulerTest_runs[SchedulerTest_numRuns++] = task;
+      SchedulerTest_runs[SchedulerTest_numRuns] = '\0';
+    }
+  SchedulerTest_time += SchedulerTest_runTime;
+}
+
+/**
+ * \brief Test task A
+ */
+void SchedulerTest_taskA()
+{
+  SchedulerTest_record('A');
+}
+
+/**
+ * \brief Test task B
+ */
+void SchedulerTest_taskB()
+{
+  SchedulerTest_record('B');
+}
+
+/**
+ * \brief Test task C
+ */
+void SchedulerTest_taskC()
+{
+  SchedulerTest_record('C');
+}
+
+/**
+ * \brief Virtual replacement of Platform_timeMicros()
+ *
+ * @return #SchedulerTest_time [µs]
+ */
+uint64_t Platform_timeMicros(void)
+{
+  return SchedulerTest_time;
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,195 @@
+/**
+ * \file Scheduler_test.c
+ *
+ * \brief Scheduler unit test implementation
+ *
+ * Please see http://embunit.sourceforge.net/ for more information. For
+ * detailed documentation see http://embunit.sourceforge.net/embunit/index.html
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup Scheduler
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <string.h>
+#include "Scheduler_test.h"
+/* Include .cpp file to be tested in order to get access to all private
+ * or static functions */
+#include "../src/scheduler.cpp"
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+
+/* ******************| Global Variables |****************************** */
+
+/* ******************| Function Implementation |*********************** */
+
+/**
+ * Priorities
+ * Test if tasks run in order of priority independent of the order they
+ * were added, tasks with the same priority in the order they were added
+ */
+static void Scheduler_Scheduler_run_1(void)
+{
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, Scheduler_addTask("C", SchedulerTest_taskC, 2, SCHEDULER_EVERY_ROUND, SCHEDULER_NO_BUDGET));
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, Scheduler_addTask("B", SchedulerTest_taskB, 1, SCHEDULER_EVERY_ROUND, SCHEDULER_NO_BUDGET));
+  TEST_ASSERT_EQUAL_INT(RESULT_OK, Scheduler_addTask("A", SchedulerTest_taskA, 1, SCHEDULER_EVERY_ROUND, SCHEDULER_NO_BUDGET));
+  Scheduler_run();
+  Scheduler_run();
+  TEST_ASSERT_EQUAL_STRING("BACBAC", SchedulerTest_runs);
+  TEST_ASSERT_EQUAL_INT(2, Scheduler_statistics.rounds);
+}
+
+/**
+ * Fixed rate
+ * Test if a fixed-rate task runs immediately and then once per period
+ * while a task of every round runs in each round. Late starts must not
+ * shift the following releases.
+ */
+static void Scheduler_Scheduler_run_2(void)
+{
+  Scheduler_addTask("A", SchedulerTest_taskA, 0, 1000, SCHEDULER_NO_BUDGET);
+  Scheduler_addTask("B", SchedulerTest_taskB, 1, SCHEDULER_EVERY_ROUND, SCHEDULER_NO_BUDGET);
+  for (uint32_t time=0; time<3000; time+=300)
+    {
+      SchedulerTest_time = time;
+      Scheduler_run();
+    }
+  /* Rounds at 0, 300, ..., 2700: A is due at 0, 1000 (run at 1200) and
+   * 2000 (run at 2100) */
+  TEST_ASSERT_EQUAL_STRING("ABBBBABBBABBB", SchedulerTest_runs);
+  TEST_ASSERT_EQUAL_INT(3, Scheduler_tasks[0].statistics.runs);
+  TEST_ASSERT_EQUAL_INT(3000, Scheduler_tasks[0].release);
+  TEST_ASSERT_EQUAL_INT(200, Scheduler_tasks[0].statistics.maxLateness);
+  TEST_ASSERT_EQUAL_INT(0, Scheduler_tasks[0].statistics.deadlineMisses);
+}
+
+/**
+ * Deadline misses and overruns
+ * Test if a fixed-rate task started a whole period late is counted as
+ * deadline miss and released one period after its start, and if runs
+ * longer than the budget are counted as overrun
+ */
+static void Scheduler_Scheduler_run_3(void)
+{
+  Scheduler_addTask("A", SchedulerTest_taskA, 0, 1000, 100);
+  Scheduler_run();
+  SchedulerTest_time = 3500;
+  SchedulerTest_runTime = 150;
+  Scheduler_run();
+  TEST_ASSERT_EQUAL_INT(1, Scheduler_tasks[0].statistics.deadlineMisses);
+  TEST_ASSERT_EQUAL_INT(2500, Scheduler_tasks[0].statistics.maxLateness);
+  TEST_ASSERT_EQUAL_INT(4500, Scheduler_tasks[0].release);
+  TEST_ASSERT_EQUAL_INT(1, Scheduler_tasks[0].statistics.overruns);
+  TEST_ASSERT_EQUAL_INT(150, Scheduler_tasks[0].statistics.maxTime);
+  TEST_ASSERT_EQUAL_INT(150, Scheduler_tasks[0].statistics.totalTime);
+  /* Not due until 4500 */
+  Scheduler_run();
+  TEST_ASSERT_EQUAL_INT(2, Scheduler_tasks[0].statistics.runs);
+}
+
+/**
+ * Round statistics
+ * Test if duration of the longest round and the longest time between two
+ * rounds are recorded, and if the statistics can be reset
+ */
+static void Scheduler_Scheduler_run_4(void)
+{
+  Scheduler_addTask("A", SchedulerTest_taskA, 0, SCHEDULER_EVERY_ROUND, SCHEDULER_NO_BUDGET);
+  Scheduler_addTask("B", SchedulerTest_taskB, 0, SCHEDULER_EVERY_ROUND, SCHEDULER_NO_BUDGET);
+  SchedulerTest_runTime = 10;
+  Scheduler_run();
+  SchedulerTest_time += 500;
+  Scheduler_run();
+  TEST_ASSERT_EQUAL_INT(20, Scheduler_statistics.maxRoundTime);
+  TEST_ASSERT_EQUAL_INT(520, Scheduler_statistics.maxRoundInterval);
+  Scheduler_resetStatistics();
+  TEST_ASSERT_EQUAL_INT(0, Scheduler_statistics.rounds);
+  TEST_ASSERT_EQUAL_INT(0, Scheduler_statistics.maxRoundInterval);
+  TEST_ASSERT_EQUAL_INT(0, Scheduler_tasks[1].statistics.runs);
+}
+
+/**
+ * Next release
+ * Test if the earliest release of all fixed-rate tasks is returned and
+ * tasks of every round are ignored
+ */
+static void Scheduler_Scheduler_nextRelease_1(void)
+{
+  TEST_ASSERT(Scheduler_nextRelease() == UINT64_MAX);
+  Scheduler_addTask("A", SchedulerTest_taskA, 0, SCHEDULER_EVERY_ROUND, SCHEDULER_NO_BUDGET);
+  TEST_ASSERT(Scheduler_nextRelease() == UINT64_MAX);
+  Scheduler_addTask("B", SchedulerTest_taskB, 1, 1000, SCHEDULER_NO_BUDGET);
+  Scheduler_addTask("C", SchedulerTest_taskC, 2, 300, SCHEDULER_NO_BUDGET);
+  TEST_ASSERT_EQUAL_INT(0, Scheduler_nextRelease());
+  Scheduler_run();
+  TEST_ASSERT_EQUAL_INT(300, Scheduler_nextRelease());
+  SchedulerTest_time = 300;
+  Scheduler_run();
+  TEST_ASSERT_EQUAL_INT(600, Scheduler_nextRelease());
+}
+
+/**
+ * Test if no more than #SCHEDULER_MAX_TASKS tasks can be added
+ */
+static void Scheduler_Scheduler_addTask_1(void)
+{
+  for (uint8_t i=0; i<SCHEDULER_MAX_TASKS; i++)
+    {
+      TEST_ASSERT_EQUAL_INT(RESULT_OK, Scheduler_addTask("A", SchedulerTest_taskA, 0, SCHEDULER_EVERY_ROUND, SCHEDULER_NO_BUDGET));
+    }
+  TEST_ASSERT_EQUAL_INT(RESULT_NOT_OK, Scheduler_addTask("B", SchedulerTest_taskB, 0, SCHEDULER_EVERY_ROUND, SCHEDULER_NO_BUDGET));
+  TEST_ASSERT_EQUAL_INT(SCHEDULER_MAX_TASKS, Scheduler_numTasks);
+}
+
+/**
+ * Test Setup function which is called before all each test case
+ */
+static void setUpScheduler(void)
+{
+  SchedulerTest_reset();
+  Scheduler_init();
+}
+
+/**
+ * Test Teardown function which is called for after each test
+ */
+static void tearDownScheduler(void)
+{
+}
+
+TestRef Scheduler_test_RunTests(void)
+{
+  EMB_UNIT_TESTFIXTURES(fixtures) {
+    new_TestFixture("Test case Scheduler_Scheduler_run_1", Scheduler_Scheduler_run_1),
+    new_TestFixture("Test case Scheduler_Scheduler_run_2", Scheduler_Scheduler_run_2),
+    new_TestFixture("Test case Scheduler_Scheduler_run_3", Scheduler_Scheduler_run_3),
+    new_TestFixture("Test case Scheduler_Scheduler_run_4", Scheduler_Scheduler_run_4),
+    new_TestFixture("Test case Scheduler_Scheduler_nextRelease_1", Scheduler_Scheduler_nextRelease_1),
+    new_TestFixture("Test case Scheduler_Scheduler_addTask_1", Scheduler_Scheduler_addTask_1)
+  };
+  EMB_UNIT_TESTCALLER(Scheduler_tests,"Scheduler Unit test",setUpScheduler,tearDownScheduler,fixtures);
+  return (TestRef)&Scheduler_tests;
+}
+
+/**
+ *
+ */
+int main(void)
+{
+  TestRunner_start();
+  TestRunner_runTest(Scheduler_test_RunTests());
+  TestRunner_end();
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
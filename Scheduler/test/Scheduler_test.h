@@ -0,0 +1,47 @@
+#if (!defined SCHEDULER_TEST_H_)
+/* Preprocessor exclusion definition */
+#define SCHEDULER_TEST_H_
+/**
+ * \file Scheduler_test.h
+ *
+ * \brief Scheduler include file for test driver
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup Scheduler
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <embUnit/embUnit.h>
+#include <platform.h>
+
+/* ******************| Macros |**************************************** */
+/**
+ * Maximum number of task runs recorded
+ */
+#define SCHEDULERTEST_MAX_RUNS        (uint8_t)32
+
+/* ******************| Type definitions |****************************** */
+
+/* ******************| External function declarations |**************** */
+extern void SchedulerTest_reset();
+extern void SchedulerTest_taskA();
+extern void SchedulerTest_taskB();
+extern void SchedulerTest_taskC();
+
+/* ******************| External constants |**************************** */
+
+/* ******************| External variables |**************************** */
+extern uint32_t SchedulerTest_time;
+extern uint32_t SchedulerTest_runTime;
+extern char SchedulerTest_runs[SCHEDULERTEST_MAX_RUNS + 1];
+extern uint8_t SchedulerTest_numRuns;
+
+/** @} doxygen end group definition */
+#endif /* if !defined( SCHEDULER_TEST_H_ ) */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,101 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#if (!defined SERIAL_INCLUDE_SERIAL_H_)
+/* Preprocessor exclusion definition */
+#define SERIAL_INCLUDE_SERIAL_H_
+/**
+ * \brief Serial include file
+ *
+ * Receive side of the serial driver. The receive interrupt of the
+ * platform hands every byte to #Serial_receive which writes it straight
+ * into #Serial_rxRingBuffer and counts line endings. The consumer, i.e.
+ * GCodeReader, reads complete lines byte by byte from the ring buffer.
+ * No line is assembled in between.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup Serial
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <platform.h>
+#include <ringBuffer.h>
+
+/* ******************| Macros |**************************************** */
+/**
+ * Size of the receive ring buffer [bytes]. Must be a power of two. The
+ * buffer must hold all bytes received while the consumer does not run,
+ * e.g. 128 bytes last 640 µs at 2 Mbaud.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DSERIAL_RX_BUFFER_SIZE 128
+ */
+#ifndef SERIAL_RX_BUFFER_SIZE
+#define SERIAL_RX_BUFFER_SIZE         (uint8_t)128
+#endif
+
+/**
+ * Line ending stored in #Serial_rxRingBuffer. Carriage return, line feed
+ * and both in a row are all stored as this character.
+ */
+#define SERIAL_LINE_END               (uint8_t)'\n'
+
+/**
+ * Marker stored in #Serial_rxRingBuffer right before #SERIAL_LINE_END if
+ * bytes of the line were lost. The consumer must drop such a line, as its
+ * rest, e.g. the checksum, is missing.
+ */
+#define SERIAL_LINE_TRUNCATED         (uint8_t)0x18
+
+/* ******************| Type definitions |****************************** */
+/**
+ * Statistics of the receive side. Each counter has a single writer and is
+ * stored atomically, as reports read them from another context.
+ */
+typedef struct
+{
+  uint32_t bytes;             /*!< Number of bytes stored in #Serial_rxRingBuffer */
+  uint32_t lines;             /*!< Number of line endings stored in #Serial_rxRingBuffer */
+  uint32_t linesRead;         /*!< Number of lines completely read by the consumer */
+  uint32_t overruns;          /*!< Number of bytes lost because #Serial_rxRingBuffer was full */
+} Serial_Statistics_t;
+
+/* ******************| External function declarations |**************** */
+extern void Serial_receive(uint8_t character);
+extern uint8_t Serial_free(void);
+extern uint8_t Serial_lines(void);
+extern uint8_t Serial_read(uint8_t *character);
+
+/* ******************| External constants |**************************** */
+
+/* ******************| External variables |**************************** */
+extern RingBuffer<uint8_t, SERIAL_RX_BUFFER_SIZE> Serial_rxRingBuffer;
+extern Serial_Statistics_t Serial_statistics;
+
+/** @} doxygen end group definition */
+#endif /* if !defined( SERIAL_INCLUDE_SERIAL_H_ ) */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,209 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * \addtogroup Serial
+ * @{
+ *
+ * \brief Serial source file
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ * The receive interrupt is the only producer and GCodeReader the only
+ * consumer of #Serial_rxRingBuffer. Like head and tail of the ring
+ * buffer, complete lines are tracked by two free running counters, one
+ * written by each side. Thus, no interrupt needs to be locked.
+ * The last two free bytes of the ring buffer are kept for a line ending
+ * and #SERIAL_LINE_TRUNCATED. A line longer than the buffer is truncated
+ * but still ends, so the consumer never waits for a line which can't be
+ * completed. The marker tells the consumer that the line is incomplete.
+ *
+ * @note Replaces the receive interrupt of Marlin's MarlinSerial
+ */
+
+/* ******************| Inclusions |************************************ */
+#include "serial.h"
+
+/* ******************| Macros |**************************************** */
+/**
+ * Number of bytes kept free for the end of the current line, i.e.
+ * #SERIAL_LINE_TRUNCATED and #SERIAL_LINE_END
+ */
+#define SERIAL_LINE_END_RESERVE       (uint8_t)2
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+void Serial_receive(uint8_t character);
+uint8_t Serial_free(void);
+uint8_t Serial_lines(void);
+uint8_t Serial_read(uint8_t *character);
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Received bytes waiting for the consumer. Line endings are stored as
+ * #SERIAL_LINE_END.
+ */
+RingBuffer<uint8_t, SERIAL_RX_BUFFER_SIZE> Serial_rxRingBuffer;
+
+/**
+ * Statistics of the receive side
+ */
+Serial_Statistics_t Serial_statistics;
+
+/**
+ * Number of line endings written to #Serial_rxRingBuffer (modulo 256).
+ * Only changed by the producer.
+ */
+static uint8_t Serial_linesWritten = 0;
+
+/**
+ * Number of line endings read from #Serial_rxRingBuffer (modulo 256).
+ * Only changed by the consumer.
+ */
+static uint8_t Serial_linesRead = 0;
+
+/**
+ * True if the last byte received was a carriage return. A line feed
+ * following it belongs to the same line ending.
+ */
+static bool Serial_carriageReturn = false;
+
+/**
+ * True if bytes of the current line were lost. Only changed by the
+ * producer.
+ */
+static bool Serial_truncated = false;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Stores one received byte
+ *
+ * To be called by the receive interrupt of the platform for every byte.
+ * Bytes which do not fit into #Serial_rxRingBuffer are lost and counted
+ * as overrun. The line they belong to is ended with
+ * #SERIAL_LINE_TRUNCATED. If the line ending itself is lost, the line is
+ * merged with the next one and both are marked together.
+ * @param[in] character Received byte
+ */
+void Serial_receive(uint8_t character)
+{
+  uint8_t space = SERIAL_RX_BUFFER_SIZE - Serial_rxRingBuffer.available();
+
+  if ((character == '\n') && Serial_carriageReturn)
+    {
+      Serial_carriageReturn = false;
+      return;
+    }
+  Serial_carriageReturn = (character == '\r');
+  if ((character == '\n') || (character == '\r'))
+    {
+      if (space >= (Serial_truncated ? 2 : 1))
+        {
+          if (Serial_truncated)
+            {
+              Serial_rxRingBuffer.write(SERIAL_LINE_TRUNCATED);
+              __atomic_store_n(&Serial_statistics.bytes, Serial_statistics.bytes + 1, __ATOMIC_RELAXED);
+              Serial_truncated = false;
+            }
+          Serial_rxRingBuffer.write(SERIAL_LINE_END);
+          __atomic_store_n(&Serial_statistics.bytes, Serial_statistics.bytes + 1, __ATOMIC_RELAXED);
+          __atomic_store_n(&Serial_statistics.lines, Serial_statistics.lines + 1, __ATOMIC_RELAXED);
+          /* Release publishes the line after its last byte */
+          __atomic_store_n(&Serial_linesWritten, (uint8_t)(Serial_linesWritten + 1), __ATOMIC_RELEASE);
+        }
+      else
+        {
+          Serial_truncated = true;
+          __atomic_store_n(&Serial_statistics.overruns, Serial_statistics.overruns + 1, __ATOMIC_RELAXED);
+        }
+    }
+  else if ((space > SERIAL_LINE_END_RESERVE) && (Serial_rxRingBuffer.write(character) == RESULT_OK))
+    {
+      __atomic_store_n(&Serial_statistics.bytes, Serial_statistics.bytes + 1, __ATOMIC_RELAXED);
+    }
+  else
+    {
+      Serial_truncated = true;
+      __atomic_store_n(&Serial_statistics.overruns, Serial_statistics.overruns + 1, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * \brief Returns the number of bytes which can be received without loss
+ *
+ * Used by receivers which can hold data back, e.g. DMA or the pseudo
+ * terminal of a host, to not fetch more than fits. While a line fills the
+ * whole buffer one byte is reported so that the rest of the line is
+ * fetched and dropped up to its ending.
+ * @return Number of bytes to be passed to #Serial_receive at most
+ */
+uint8_t Serial_free(void)
+{
+  uint8_t space = SERIAL_RX_BUFFER_SIZE - Serial_rxRingBuffer.available();
+
+  if (space > SERIAL_LINE_END_RESERVE)
+    {
+      return space - SERIAL_LINE_END_RESERVE;
+    }
+  return ((space > 0) && (Serial_lines() == 0)) ? 1 : 0;
+}
+
+/**
+ * \brief Returns the number of complete lines in #Serial_rxRingBuffer
+ *
+ * @return Number of lines whose line ending was received but not yet read
+ */
+uint8_t Serial_lines(void)
+{
+  uint8_t written = __atomic_load_n(&Serial_linesWritten, __ATOMIC_ACQUIRE);
+  uint8_t read = __atomic_load_n(&Serial_linesRead, __ATOMIC_ACQUIRE);
+
+  return (uint8_t)(written - read);
+}
+
+/**
+ * \brief Reads one byte from #Serial_rxRingBuffer
+ *
+ * Reading #SERIAL_LINE_END completes a line.
+ * @param[out] character Next received byte. Not changed if no byte is
+ * available.
+ * @return RESULT_OK if a byte was read, RESULT_NOT_OK if not
+ * @pre #Serial_lines is not 0, otherwise a line may be read before it
+ * was completely received
+ */
+uint8_t Serial_read(uint8_t *character)
+{
+  if (Serial_rxRingBuffer.read(character) != RESULT_OK)
+    {
+      return RESULT_NOT_OK;
+    }
+  if (*character == SERIAL_LINE_END)
+    {
+      Serial_statistics.linesRead++;
+      __atomic_store_n(&Serial_linesRead, (uint8_t)(Serial_linesRead + 1), __ATOMIC_RELEASE);
+    }
+  return RESULT_OK;
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,84 @@
+/**
+ * \file Serial_stub.c
+ *
+ * \brief Stubs for Serial unit tests
+ *
+ * All stubs needed for the unit test of this particular modules shall
+ * be done within this file.
+ * The receive interrupt is replaced by a function passing a string byte
+ * by byte to Serial_receive().
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup Serial
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include "Serial_test.h"
+#include <serial.h>
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+void SerialTest_receive(const char *data);
+uint8_t SerialTest_readLine(char *line, uint8_t size);
+
+/* ******************| Global Variables |****************************** */
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Receives a string as if it came from the serial line
+ *
+ * @param[in] data Null terminated string
+ */
+void SerialTest_receive(const char *data)
+{
+  while (*data != '\0')
+    {
+      Serial_receive((uint8_t)*data++);
+    }
+}
+
+/**
+ * \brief Reads one line as GCodeReader does
+ *
+ * @param[out] line Line without line ending, null terminated
+ * @param[in] size Size of #line. Longer lines are truncated.
+ * @return Number of characters read including the line ending, 0 if no
+ * complete line was available
+ */
+uint8_t SerialTest_readLine(char *line, uint8_t size)
+{
+  uint8_t character;
+  uint8_t length = 0;
+  uint8_t count = 0;
+
+  if (Serial_lines() == 0)
+    {
+      return 0;
+    }
+  while (Serial_read(&character) == RESULT_OK)
+    {
+      count++;
+      if (character == SERIAL_LINE_END)
+        {
+          break;
+        }
+      if (length < (size - 1))
+        {
+          line[length++] = (char)character;
+        }
+    }
+  line[length] = '\0';
+  return count;
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,187 @@
+/**
+ * \file Serial_test.c
+ *
+ * \brief Serial unit test implementation
+ *
+ * Please see http://embunit.sourceforge.net/ for more information. For
+ * detailed documentation see http://embunit.sourceforge.net/embunit/index.html
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup Serial
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <string.h>
+#include "Serial_test.h"
+/* Include .cpp file to be tested in order to get access to all private
+ * or static functions */
+#include "../src/serial.cpp"
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+
+/* ******************| Global Variables |****************************** */
+
+/* ******************| Function Implementation |*********************** */
+
+/**
+ * Line endings
+ * Test if carriage return, line feed and both in a row each end one line
+ * Test if an incomplete line is not reported until its ending is received
+ * Test if empty lines are reported
+ */
+static void Serial_Serial_receive_1(void)
+{
+  char line[32];
+
+  SerialTest_receive("G1 X1\r\nG1 X2\nG1 X3\rG1");
+  TEST_ASSERT_EQUAL_INT(3, Serial_lines());
+  TEST_ASSERT_EQUAL_INT(6, SerialTest_readLine(line, sizeof(line)));
+  TEST_ASSERT_EQUAL_STRING("G1 X1", line);
+  TEST_ASSERT_EQUAL_INT(6, SerialTest_readLine(line, sizeof(line)));
+  TEST_ASSERT_EQUAL_STRING("G1 X2", line);
+  TEST_ASSERT_EQUAL_INT(6, SerialTest_readLine(line, sizeof(line)));
+  TEST_ASSERT_EQUAL_STRING("G1 X3", line);
+  TEST_ASSERT_EQUAL_INT(0, SerialTest_readLine(line, sizeof(line)));
+
+  SerialTest_receive("\n\r\r");
+  TEST_ASSERT_EQUAL_INT(3, Serial_lines());
+  TEST_ASSERT_EQUAL_INT(3, SerialTest_readLine(line, sizeof(line)));
+  TEST_ASSERT_EQUAL_STRING("G1", line);
+  TEST_ASSERT_EQUAL_INT(1, SerialTest_readLine(line, sizeof(line)));
+  TEST_ASSERT_EQUAL_STRING("", line);
+  TEST_ASSERT_EQUAL_INT(1, SerialTest_readLine(line, sizeof(line)));
+  TEST_ASSERT_EQUAL_INT(0, Serial_lines());
+
+  TEST_ASSERT_EQUAL_INT(6, Serial_statistics.lines);
+  TEST_ASSERT_EQUAL_INT(6, Serial_statistics.linesRead);
+  TEST_ASSERT_EQUAL_INT(0, Serial_statistics.overruns);
+}
+
+/**
+ * Overrun
+ * Test if a line longer than the ring buffer is truncated and counted as
+ * overrun
+ * Test if the line ending of a truncated line is still stored after the
+ * truncation marker
+ * Test if a line whose line ending was lost is merged with the next line
+ * and marked as truncated
+ */
+static void Serial_Serial_receive_2(void)
+{
+  char data[201];
+  char line[SERIAL_RX_BUFFER_SIZE + 1];
+
+  memset(data, 'X', 200);
+  data[200] = '\0';
+  SerialTest_receive(data);
+  TEST_ASSERT_EQUAL_INT(0, Serial_lines());
+  TEST_ASSERT_EQUAL_INT(200 - (SERIAL_RX_BUFFER_SIZE - 2), Serial_statistics.overruns);
+  /* The rest of the line is fetched up to its ending */
+  TEST_ASSERT_EQUAL_INT(1, Serial_free());
+
+  SerialTest_receive("\nG1\n");
+  TEST_ASSERT_EQUAL_INT(1, Serial_lines());
+  TEST_ASSERT_EQUAL_INT(0, Serial_free());
+  TEST_ASSERT_EQUAL_INT(SERIAL_RX_BUFFER_SIZE, SerialTest_readLine(line, sizeof(line)));
+  TEST_ASSERT_EQUAL_INT(SERIAL_RX_BUFFER_SIZE - 1, strlen(line));
+  TEST_ASSERT_EQUAL_INT(SERIAL_LINE_TRUNCATED, (uint8_t)line[SERIAL_RX_BUFFER_SIZE - 2]);
+  TEST_ASSERT_EQUAL_INT(200 - (SERIAL_RX_BUFFER_SIZE - 2) + 3, Serial_statistics.overruns);
+
+  SerialTest_receive("G2\n");
+  TEST_ASSERT_EQUAL_INT(4, SerialTest_readLine(line, sizeof(line)));
+  TEST_ASSERT_EQUAL_INT(SERIAL_LINE_TRUNCATED, (uint8_t)line[2]);
+}
+
+/**
+ * Overrun of a g-code line
+ * Test if a 200 byte line loses its checksum and is marked as truncated
+ * Test if the following line is received completely and not marked
+ */
+static void Serial_Serial_receive_3(void)
+{
+  char data[201];
+  char line[SERIAL_RX_BUFFER_SIZE + 1];
+
+  memset(data, 'A', 200);
+  memcpy(data, "N1 G1 X5 ;", 10);
+  memcpy(&data[195], "*123\n", 6);
+  SerialTest_receive(data);
+  TEST_ASSERT_EQUAL_INT(1, Serial_lines());
+  TEST_ASSERT_EQUAL_INT(SERIAL_RX_BUFFER_SIZE, SerialTest_readLine(line, sizeof(line)));
+  TEST_ASSERT(strncmp(line, "N1 G1 X5 ;AAA", 13) == 0);
+  TEST_ASSERT(strchr(line, '*') == NULL);
+  TEST_ASSERT_EQUAL_INT(SERIAL_LINE_TRUNCATED, (uint8_t)line[SERIAL_RX_BUFFER_SIZE - 2]);
+
+  SerialTest_receive("G1 X6\n");
+  TEST_ASSERT_EQUAL_INT(6, SerialTest_readLine(line, sizeof(line)));
+  TEST_ASSERT_EQUAL_STRING("G1 X6", line);
+}
+
+/**
+ * Free space
+ * Test if two bytes are kept for a line ending and the truncation marker
+ */
+static void Serial_Serial_free_1(void)
+{
+  TEST_ASSERT_EQUAL_INT(SERIAL_RX_BUFFER_SIZE - 2, Serial_free());
+  SerialTest_receive("G1\n");
+  TEST_ASSERT_EQUAL_INT(SERIAL_RX_BUFFER_SIZE - 5, Serial_free());
+  TEST_ASSERT_EQUAL_INT(3, Serial_statistics.bytes);
+}
+
+/**
+ * Test Setup function which is called before all each test case
+ */
+static void setUpSerial(void)
+{
+  uint8_t character;
+
+  while (Serial_rxRingBuffer.read(&character) == RESULT_OK);
+  Serial_linesWritten = 0;
+  Serial_linesRead = 0;
+  Serial_carriageReturn = false;
+  Serial_truncated = false;
+  memset(&Serial_statistics, 0, sizeof(Serial_statistics));
+}
+
+/**
+ * Test Teardown function which is called for after each test
+ */
+static void tearDownSerial(void)
+{
+}
+
+TestRef Serial_test_RunTests(void)
+{
+  EMB_UNIT_TESTFIXTURES(fixtures) {
+    new_TestFixture("Test case Serial_Serial_receive_1", Serial_Serial_receive_1),
+    new_TestFixture("Test case Serial_Serial_receive_2", Serial_Serial_receive_2),
+    new_TestFixture("Test case Serial_Serial_receive_3", Serial_Serial_receive_3),
+    new_TestFixture("Test case Serial_Serial_free_1", Serial_Serial_free_1)
+  };
+  EMB_UNIT_TESTCALLER(Serial_tests,"Serial Unit test",setUpSerial,tearDownSerial,fixtures);
+  return (TestRef)&Serial_tests;
+}
+
+/**
+ *
+ */
+int main(void)
+{
+  TestRunner_start();
+  TestRunner_runTest(Serial_test_RunTests());
+  TestRunner_end();
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
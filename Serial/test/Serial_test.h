@@ -1,31 +1,37 @@
-#if (!defined TEMPLATE_TEST_DRV_H_)
+#if (!defined SERIAL_TEST_H_)
 /* Preprocessor exclusion definition */
-#define TEMPLATE_TEST_DRV_H_
-/** 
- * \brief Template include file for test driver
+#define SERIAL_TEST_H_
+/**
+ * \file Serial_test.h
+ *
+ * \brief Serial include file for test driver
  *
  * \project BlueMarlin
- * \author <FULL NAME>
+ * \author kein0r
  *
  */
 
 
-/** \addtogroup Template_unittest
+/** \addtogroup Serial
  * @{
  */
 
 /* ******************| Inclusions |************************************ */
+#include <embUnit/embUnit.h>
+#include <platform.h>
 
 /* ******************| Macros |**************************************** */
 
 /* ******************| Type definitions |****************************** */
 
 /* ******************| External function declarations |**************** */
+extern void SerialTest_receive(const char *data);
+extern uint8_t SerialTest_readLine(char *line, uint8_t size);
 
 /* ******************| External constants |**************************** */
 
 /* ******************| External variables |**************************** */
 
 /** @} doxygen end group definition */
-#endif /* if !defined( TEMPLATE_TEST_DRV_H_ ) */
+#endif /* if !defined( SERIAL_TEST_H_ ) */
 /* ******************| End of file |*********************************** */
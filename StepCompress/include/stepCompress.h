@@ -0,0 +1,199 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#if (!defined STEPCOMPRESS_INCLUDE_STEPCOMPRESS_H_)
+/* Preprocessor exclusion definition */
+#define STEPCOMPRESS_INCLUDE_STEPCOMPRESS_H_
+/**
+ * \brief StepCompress include file
+ *
+ * Alternative step generator. All timing calculations are done outside of
+ * interrupt context by #StepCompress_run: The step events of each block of
+ * #motionBuffer are converted into step times for each stepper which are
+ * then compressed into schedules of the form (interval, count, add), that
+ * is count steps where the interval between two steps changes by add
+ * after each step. The schedules are stored in one queue per stepper.
+ * #StepCompress_isr only replays these schedules using additions.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup StepCompress
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <blueMarlin.h>
+#include <ringBuffer.h>
+#include <motionBuffer.h>
+#include <stepper.h>
+#include <metrics.h>
+
+/* ******************| Macros |**************************************** */
+/**
+ * Maximum deviation of a replayed step from its exact time [ticks of
+ * #STEPPER_TIMER_FREQUENCY].
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DSTEPCOMPRESS_MAXIMUM_ERROR 50
+ */
+#ifndef STEPCOMPRESS_MAXIMUM_ERROR
+#define STEPCOMPRESS_MAXIMUM_ERROR      (int32_t)50
+#endif
+
+/**
+ * Number of step times per stepper collected before a schedule is
+ * fitted. More step times allow longer schedules.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DSTEPCOMPRESS_PENDING_SIZE 64
+ */
+#ifndef STEPCOMPRESS_PENDING_SIZE
+#define STEPCOMPRESS_PENDING_SIZE       (uint8_t)64
+#endif
+
+/**
+ * Number of schedules in the queue of each stepper.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DSTEPCOMPRESS_QUEUE_SIZE 16
+ */
+#ifndef STEPCOMPRESS_QUEUE_SIZE
+#define STEPCOMPRESS_QUEUE_SIZE         (uint8_t)16
+#endif
+
+/**
+ * Time between the start of the replay after standstill and the first
+ * step [ticks of #STEPPER_TIMER_FREQUENCY]. Gives #StepCompress_run time
+ * to fill the queues.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DSTEPCOMPRESS_START_DELAY 20000
+ */
+#ifndef STEPCOMPRESS_START_DELAY
+#define STEPCOMPRESS_START_DELAY        (uint32_t)20000
+#endif
+
+/* ******************| Type definitions |****************************** */
+/**
+ * Compressed steps of one stepper. The first step is issued interval
+ * ticks after the previous step of the stepper, each following step
+ * interval + n*add ticks after its predecessor.
+ */
+typedef struct
+{
+  uint32_t interval;     /*!< Interval to the first step [ticks] */
+  uint16_t count;        /*!< Number of steps */
+  int16_t add;           /*!< Change of interval after each step [ticks] */
+  uint8_t direction;     /*!< #STEPPER_DIRECTION_NEGATIVE or #STEPPER_DIRECTION_POSITIVE */
+} StepCompress_Schedule_t;
+
+/**
+ * Step not yet compressed
+ */
+typedef struct
+{
+  uint32_t time;         /*!< Absolute time of the step [ticks] */
+  uint8_t direction;     /*!< #STEPPER_DIRECTION_NEGATIVE or #STEPPER_DIRECTION_POSITIVE */
+} StepCompress_Step_t;
+
+/**
+ * Compression state of one stepper
+ */
+typedef struct
+{
+  StepCompress_Step_t pending[STEPCOMPRESS_PENDING_SIZE];  /*!< Steps not yet compressed, oldest first */
+  uint8_t pendingCount;                                    /*!< Number of entries in pending */
+  uint32_t lastStepTime;                                   /*!< Replayed time of the last compressed step [ticks] */
+  uint32_t exactStepTime;                                  /*!< Exact time of the last compressed step [ticks] */
+} StepCompress_Stepper_t;
+
+/**
+ * Replay state of one stepper
+ */
+typedef struct
+{
+  uint32_t stepTime;     /*!< Time of the next step, or of the last step if count is zero [ticks] */
+  uint32_t interval;     /*!< Current interval [ticks] */
+  uint16_t count;        /*!< Steps left in current schedule */
+  int16_t add;           /*!< Change of interval after each step [ticks] */
+} StepCompress_Replay_t;
+
+/**
+ * Trapezoid of the block being converted, prepared once per block. All
+ * times in ticks relative to the start of the block. The reciprocals of
+ * the rates are kept as well, thus, timing a step event needs no
+ * division.
+ */
+typedef struct
+{
+  float initialRate;     /*!< Rate at the start of the block [steps/sec] */
+  float cruiseRate;      /*!< Rate between acceleration and deceleration [steps/sec] */
+  float decelerateRate;  /*!< Rate at the start of the deceleration [steps/sec] */
+  float finalRate;       /*!< Rate at the end of the block [steps/sec] */
+  float accelerationRate;/*!< Acceleration [steps/sec^2] */
+  float accelerateTime;  /*!< Time at the end of the acceleration [ticks] */
+  float decelerateTime;  /*!< Time at the start of the deceleration [ticks] */
+  float finalSteps;      /*!< Step events after decelerateAfter until finalRate is reached */
+  float finalTime;       /*!< Time after decelerateAfter until finalRate is reached [ticks] */
+  float initialInterval; /*!< Interval at initialRate [ticks/step] */
+  float cruiseInterval;  /*!< Interval at cruiseRate [ticks/step] */
+  float finalInterval;   /*!< Interval at finalRate [ticks/step] */
+  float accelerationTime;/*!< Reciprocal of accelerationRate in ticks, zero without acceleration [ticks*sec/steps] */
+} StepCompress_Trapezoid_t;
+
+/**
+ * State of the compression
+ */
+typedef struct
+{
+  MotionBlock_t block;                                  /*!< Block being converted */
+  bool blockActive;                                     /*!< True while block is converted */
+  StepCompress_Trapezoid_t trapezoid;                   /*!< Trapezoid of block */
+  StepperCoordinate_t counter[STEPPER_NUM_STEPPER];     /*!< Steps of each stepper converted so far */
+  float eventsPerStep[STEPPER_NUM_STEPPER];             /*!< Step events of the block per step of each stepper */
+  StepperCoordinate_t stepEventsCompleted;              /*!< Number of step events of the block converted so far */
+  uint32_t blockStartTime;                              /*!< Absolute start time of the block [ticks] */
+  StepCompress_Stepper_t stepper[STEPPER_NUM_STEPPER];  /*!< Compression state of each stepper */
+  uint32_t steps;                                       /*!< Number of steps compressed (statistics) */
+  uint32_t schedules;                                   /*!< Number of schedules created (statistics) */
+} StepCompress_State_t;
+
+/* ******************| External function declarations |**************** */
+extern void StepCompress_init();
+extern void StepCompress_run();
+extern uint32_t StepCompress_isr();
+extern bool StepCompress_isIdle();
+
+/* ******************| External constants |**************************** */
+
+/* ******************| External variables |**************************** */
+extern StepCompress_State_t stepCompressState;
+extern RingBuffer<StepCompress_Schedule_t, STEPCOMPRESS_QUEUE_SIZE> stepCompressQueue[STEPPER_NUM_STEPPER];
+extern uint32_t StepCompress_replayTime;
+extern Metrics_Histogram_t StepCompress_isrCycles;
+
+/** @} doxygen end group definition */
+#endif /* if !defined( STEPCOMPRESS_INCLUDE_STEPCOMPRESS_H_ ) */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,626 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * \addtogroup StepCompress
+ * @{
+ *
+ * \brief StepCompress source file
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ * The step events of a block are timed analytically from its trapezoid.
+ * In contrast to the Bresenham algorithm used by #Stepper each stepper
+ * steps at its exact position within the block, that is step k of a
+ * stepper with s steps at step event k*stepEventCount/s. Thus, steppers
+ * slower than the fastest one get regular intervals which compress well.
+ * A schedule is fitted to the oldest pending steps of a stepper by
+ * taking the first interval as is and deriving add from the last step.
+ * The number of steps is maximized by exponential and binary search.
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <string.h>
+#include "stepCompress.h"
+#include <trace.h>
+
+/* ******************| Macros |**************************************** */
+/**
+ * Range of add of a schedule
+ */
+#define STEPCOMPRESS_ADD_MIN    (int64_t)-32768
+#define STEPCOMPRESS_ADD_MAX    (int64_t)32767
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+void StepCompress_init();
+void StepCompress_run();
+uint32_t StepCompress_isr();
+bool StepCompress_isIdle();
+static bool StepCompress_isStepperIdle(uint8_t stepper);
+static void StepCompress_startBlock();
+static float StepCompress_eventTime(float stepEvent);
+static bool StepCompress_fit(const StepCompress_Stepper_t &stepper, uint16_t count, uint32_t *interval, int16_t *add);
+static void StepCompress_compress(uint8_t stepper);
+static void StepCompress_flush();
+static void StepCompress_load(uint8_t stepper);
+
+/* ******************| Global Variables |****************************** */
+StepCompress_State_t stepCompressState;
+
+/**
+ * Schedules of each stepper. Written by #StepCompress_run, read by
+ * #StepCompress_isr
+ */
+RingBuffer<StepCompress_Schedule_t, STEPCOMPRESS_QUEUE_SIZE> stepCompressQueue[STEPPER_NUM_STEPPER];
+
+/**
+ * Time of the replay, advanced by #StepCompress_isr [ticks]. Only accessed
+ * atomically outside of #StepCompress_isr.
+ */
+uint32_t StepCompress_replayTime;
+
+/**
+ * Duration of the calls of #StepCompress_isr which issued steps
+ */
+Metrics_Histogram_t StepCompress_isrCycles;
+
+/**
+ * Replay state of each stepper. Only the count is read outside of
+ * #StepCompress_isr, see #StepCompress_isIdle.
+ */
+static StepCompress_Replay_t StepCompress_replay[STEPPER_NUM_STEPPER];
+
+/**
+ * Direction bits currently applied by the replay
+ */
+static uint8_t StepCompress_directionBits;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Initializes StepCompress module
+ *
+ * Discards all pending steps and schedules.
+ */
+void StepCompress_init()
+{
+  StepCompress_Schedule_t schedule;
+
+  for (uint8_t i=0; i<STEPPER_NUM_STEPPER; i++)
+    {
+      while (stepCompressQueue[i].read(&schedule) == RESULT_OK);
+      stepCompressState.stepper[i].pendingCount = 0;
+      stepCompressState.stepper[i].lastStepTime = 0;
+      stepCompressState.stepper[i].exactStepTime = 0;
+      StepCompress_replay[i].stepTime = 0;
+      StepCompress_replay[i].count = 0;
+    }
+  stepCompressState.blockActive = false;
+  stepCompressState.blockStartTime = 0;
+  stepCompressState.steps = 0;
+  stepCompressState.schedules = 0;
+  StepCompress_replayTime = 0;
+  StepCompress_directionBits = 0;
+}
+
+/**
+ * \brief Checks if all steppers stand still
+ *
+ * @return True if neither a block is converted nor steps are waiting to
+ * be compressed or replayed. Blocks waiting in #motionBuffer are not
+ * considered.
+ */
+bool StepCompress_isIdle()
+{
+  if (stepCompressState.blockActive)
+    {
+      return false;
+    }
+  for (uint8_t i=0; i<STEPPER_NUM_STEPPER; i++)
+    {
+      if (!StepCompress_isStepperIdle(i))
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+/**
+ * \brief Checks if one stepper has no steps left
+ *
+ * The queue is checked before the replay: A schedule is marked loaded
+ * before it is taken from the queue, thus, it is never missed by both
+ * checks. Once idle, #StepCompress_isr does not access the replay of the
+ * stepper until the next schedule is written to its queue.
+ * @param[in] stepper Number of the stepper
+ * @return True if no steps are waiting to be compressed or replayed
+ */
+static bool StepCompress_isStepperIdle(uint8_t stepper)
+{
+  return (stepCompressState.stepper[stepper].pendingCount == 0) && (stepCompressQueue[stepper].available() == 0) &&
+         (__atomic_load_n(&StepCompress_replay[stepper].count, __ATOMIC_ACQUIRE) == 0);
+}
+
+/**
+ * \brief Prepares conversion of the block in #stepCompressState
+ *
+ * Everything needed to time the step events of the block is calculated
+ * here once. If the replay is already closer than #STEPCOMPRESS_START_DELAY
+ * to the end of the previous block (standstill or underrun) the block is
+ * moved into the future.
+ * Times are compared as signed differences, which only works for times
+ * less than 2^31 ticks apart. Thus, the times of steppers which stand
+ * still are moved up to the start of the block. Otherwise a stepper which
+ * did not step for a long time, e.g. the extruder during travel or all
+ * steppers after a long dwell, would step up to 2^32 ticks late.
+ */
+static void StepCompress_startBlock()
+{
+  const MotionBlock_t &block = stepCompressState.block;
+  StepCompress_Trapezoid_t &trapezoid = stepCompressState.trapezoid;
+  uint32_t earliestStart = __atomic_load_n(&StepCompress_replayTime, __ATOMIC_ACQUIRE) + STEPCOMPRESS_START_DELAY;
+  bool idle[STEPPER_NUM_STEPPER];
+  bool allIdle = true;
+
+  for (uint8_t i=0; i<STEPPER_NUM_STEPPER; i++)
+    {
+      StepperCoordinate_t steps = (i < MACHINE_NUM_AXIS) ? block.steps.steps[i] : block.steps.extruder[i - MACHINE_NUM_AXIS];
+
+      stepCompressState.counter[i] = 0;
+      /* Avoids a division for each step in StepCompress_run */
+      stepCompressState.eventsPerStep[i] = (steps > 0) ? (float)block.stepEventCount / steps : 0.0;
+      idle[i] = StepCompress_isStepperIdle(i);
+      allIdle = allIdle && idle[i];
+    }
+  stepCompressState.stepEventsCompleted = 0;
+  /* If all steppers stand still the previous block was replayed
+   * completely, no matter how long ago */
+  if (allIdle || ((int32_t)(earliestStart - stepCompressState.blockStartTime) > 0))
+    {
+      stepCompressState.blockStartTime = earliestStart;
+    }
+  for (uint8_t i=0; i<STEPPER_NUM_STEPPER; i++)
+    {
+      if (idle[i])
+        {
+          /* The last step was replayed already, thus, it is before the
+           * start of the block. The replay is published to the interrupt
+           * with the next schedule of the stepper. */
+          stepCompressState.stepper[i].lastStepTime = stepCompressState.blockStartTime;
+          stepCompressState.stepper[i].exactStepTime = stepCompressState.blockStartTime;
+          StepCompress_replay[i].stepTime = stepCompressState.blockStartTime;
+        }
+    }
+
+  trapezoid.initialRate = max(block.initialRate, STEPPER_MINIMUM_RATE);
+  trapezoid.cruiseRate = max(block.nominalRate, STEPPER_MINIMUM_RATE);
+  trapezoid.finalRate = max(block.finalRate, STEPPER_MINIMUM_RATE);
+  trapezoid.accelerationRate = block.accelerationRate;
+  trapezoid.initialInterval = STEPPER_TIMER_FREQUENCY / trapezoid.initialRate;
+  trapezoid.cruiseInterval = STEPPER_TIMER_FREQUENCY / trapezoid.cruiseRate;
+  trapezoid.finalInterval = STEPPER_TIMER_FREQUENCY / trapezoid.finalRate;
+  trapezoid.accelerationTime = (block.accelerationRate > 0) ? STEPPER_TIMER_FREQUENCY / trapezoid.accelerationRate : 0.0;
+  if (block.accelerationRate > 0)
+    {
+      trapezoid.accelerateTime = (sqrt(sq(trapezoid.initialRate) + 2.0 * trapezoid.accelerationRate * block.accelerateUntil) - trapezoid.initialRate) *
+                                 trapezoid.accelerationTime;
+    }
+  else
+    {
+      trapezoid.accelerateTime = block.accelerateUntil * trapezoid.initialInterval;
+    }
+  trapezoid.decelerateTime = trapezoid.accelerateTime;
+  if (block.decelerateAfter > block.accelerateUntil)
+    {
+      trapezoid.decelerateTime += (block.decelerateAfter - block.accelerateUntil) * trapezoid.cruiseInterval;
+      trapezoid.decelerateRate = trapezoid.cruiseRate;
+    }
+  else
+    {
+      trapezoid.decelerateRate = trapezoid.initialRate + trapezoid.accelerationRate * trapezoid.accelerateTime / STEPPER_TIMER_FREQUENCY;
+    }
+  if ((block.accelerationRate > 0) && (trapezoid.decelerateRate > trapezoid.finalRate))
+    {
+      trapezoid.finalSteps = (sq(trapezoid.decelerateRate) - sq(trapezoid.finalRate)) / (2.0 * trapezoid.accelerationRate);
+      trapezoid.finalTime = (trapezoid.decelerateRate - trapezoid.finalRate) * trapezoid.accelerationTime;
+    }
+  else
+    {
+      trapezoid.finalSteps = 0.0;
+      trapezoid.finalTime = 0.0;
+    }
+  stepCompressState.blockActive = true;
+}
+
+/**
+ * \brief Time of a step event relative to the start of the block
+ *
+ * The step event is issued at the end of its step, thus, the last step
+ * event of a block is issued at the end of the block.
+ * @param[in] stepEvent Number of the step event starting with 1, may be
+ * fractional
+ * @return Time [ticks]
+ */
+static float StepCompress_eventTime(float stepEvent)
+{
+  const MotionBlock_t &block = stepCompressState.block;
+  const StepCompress_Trapezoid_t &trapezoid = stepCompressState.trapezoid;
+  float steps;
+
+  if (stepEvent <= block.accelerateUntil)
+    {
+      if (trapezoid.accelerationRate > 0)
+        {
+          return (sqrt(sq(trapezoid.initialRate) + 2.0 * trapezoid.accelerationRate * stepEvent) - trapezoid.initialRate) *
+                 trapezoid.accelerationTime;
+        }
+      return stepEvent * trapezoid.initialInterval;
+    }
+  if (stepEvent <= block.decelerateAfter)
+    {
+      return trapezoid.accelerateTime + (stepEvent - block.accelerateUntil) * trapezoid.cruiseInterval;
+    }
+  steps = stepEvent - max(block.decelerateAfter, block.accelerateUntil);
+  if (steps <= trapezoid.finalSteps)
+    {
+      return trapezoid.decelerateTime + (trapezoid.decelerateRate - sqrt(sq(trapezoid.decelerateRate) - 2.0 * trapezoid.accelerationRate * steps)) *
+             trapezoid.accelerationTime;
+    }
+  return trapezoid.decelerateTime + trapezoid.finalTime + (steps - trapezoid.finalSteps) * trapezoid.finalInterval;
+}
+
+/**
+ * \brief Checks if the oldest pending steps can be replayed by one schedule
+ *
+ * interval and add are fitted by least squares to the step times, once
+ * relative to the exact and once relative to the replayed time of the last
+ * step. The first follows the motion, the second also corrects the error
+ * of the previous schedule. interval is rounded up and down, add to the
+ * nearest integer. Relative to the replayed time of the last step every
+ * step must then be within #STEPCOMPRESS_MAXIMUM_ERROR and the interval
+ * must stay positive.
+ * @param[in] stepper Compression state of the stepper
+ * @param[in] count Number of steps
+ * @param[out] interval Interval to the first step [ticks]
+ * @param[out] add Change of interval after each step [ticks]
+ * @return True if all steps are within the error bound
+ */
+static bool StepCompress_fit(const StepCompress_Stepper_t &stepper, uint16_t count, uint32_t *interval, int16_t *add)
+{
+  double sumK = 0.0, sumT = 0.0, sumKK = 0.0, sumKT = 0.0, sumTT = 0.0, sumKX = 0.0, sumTX = 0.0;
+  double sumKY, sumTY;
+  double k, t, x;
+  double offset = (int32_t)(stepper.exactStepTime - stepper.lastStepTime);
+  double fittedInterval;
+  int64_t candidateInterval;
+  int64_t candidateAdd;
+  int64_t time;
+  bool fits;
+
+  /* Model: x_k = k*interval + t_k*add with t_k = k(k-1)/2 */
+  for (uint16_t i=1; i<=count; i++)
+    {
+      k = i;
+      t = k * (k - 1) / 2;
+      x = (int32_t)(stepper.pending[i-1].time - stepper.exactStepTime);
+      sumK += k;
+      sumT += t;
+      sumKK += k * k;
+      sumKT += k * t;
+      sumTT += t * t;
+      sumKX += k * x;
+      sumTX += t * x;
+    }
+
+  for (uint8_t reference=0; reference<2; reference++)
+    {
+      /* Relative to replayed time the step times are shifted by offset */
+      sumKY = sumKX + reference * offset * sumK;
+      sumTY = sumTX + reference * offset * sumT;
+      if (count == 1)
+        {
+          fittedInterval = sumKY;
+        }
+      else
+        {
+          fittedInterval = (sumKY * sumTT - sumKT * sumTY) / (sumKK * sumTT - sq(sumKT));
+        }
+      for (candidateInterval = (int64_t)floor(fittedInterval); candidateInterval <= (int64_t)floor(fittedInterval) + 1; candidateInterval++)
+        {
+          /* Best add for this interval */
+          candidateAdd = (count == 1) ? 0 : (int64_t)lround((sumTY - candidateInterval * sumKT) / sumTT);
+          if ((candidateInterval <= 0) || (candidateAdd < STEPCOMPRESS_ADD_MIN) || (candidateAdd > STEPCOMPRESS_ADD_MAX) ||
+              (candidateInterval + candidateAdd * (count - 1) <= 0))
+            {
+              continue;
+            }
+          fits = true;
+          for (uint16_t i=1; (i<=count) && fits; i++)
+            {
+              time = i * candidateInterval + candidateAdd * i * (i - 1) / 2;
+              time -= (int32_t)(stepper.pending[i-1].time - stepper.lastStepTime);
+              fits = (time <= STEPCOMPRESS_MAXIMUM_ERROR) && (time >= -STEPCOMPRESS_MAXIMUM_ERROR);
+            }
+          if (fits)
+            {
+              *interval = (uint32_t)candidateInterval;
+              *add = (int16_t)candidateAdd;
+              return true;
+            }
+        }
+    }
+  return false;
+}
+
+/**
+ * \brief Compresses the oldest pending steps of a stepper into one schedule
+ *
+ * @param[in] stepper Number of the stepper
+ * @pre Queue of stepper is not full and stepper has pending steps
+ */
+static void StepCompress_compress(uint8_t stepper)
+{
+  StepCompress_Stepper_t &state = stepCompressState.stepper[stepper];
+  StepCompress_Schedule_t schedule;
+  uint16_t sameDirection = 1;
+  uint16_t good = 1;
+  uint16_t bad;
+  uint16_t count;
+  uint32_t interval;
+  int16_t add;
+
+  /* One schedule never changes direction */
+  while ((sameDirection < state.pendingCount) && (state.pending[sameDirection].direction == state.pending[0].direction))
+    {
+      sameDirection++;
+    }
+  /* A single step always fits, even if the replayed previous step was late */
+  schedule.interval = max((int32_t)(state.pending[0].time - state.lastStepTime), (int32_t)1);
+  schedule.add = 0;
+  schedule.direction = state.pending[0].direction;
+
+  /* Double the count as long as the steps fit, then bisect */
+  bad = sameDirection + 1;
+  count = 2;
+  while (count <= sameDirection)
+    {
+      if (!StepCompress_fit(state, count, &interval, &add))
+        {
+          bad = count;
+          break;
+        }
+      good = count;
+      schedule.interval = interval;
+      schedule.add = add;
+      if (count == sameDirection)
+        {
+          break;
+        }
+      count = min(count * 2, sameDirection);
+    }
+  while (bad - good > 1)
+    {
+      count = good + (bad - good) / 2;
+      if (StepCompress_fit(state, count, &interval, &add))
+        {
+          good = count;
+          schedule.interval = interval;
+          schedule.add = add;
+        }
+      else
+        {
+          bad = count;
+        }
+    }
+  schedule.count = good;
+  stepCompressQueue[stepper].write(schedule);
+
+  /* Next schedule continues from the replayed, not the exact, time of the
+   * last step */
+  state.lastStepTime += (uint32_t)((int64_t)good * schedule.interval + (int64_t)schedule.add * good * (good - 1) / 2);
+  state.exactStepTime = state.pending[good-1].time;
+  state.pendingCount -= good;
+  memmove(&state.pending[0], &state.pending[good], state.pendingCount * sizeof(StepCompress_Step_t));
+  stepCompressState.steps += good;
+  stepCompressState.schedules++;
+}
+
+/**
+ * \brief Compresses all pending steps as far as the queues allow
+ */
+static void StepCompress_flush()
+{
+  for (uint8_t i=0; i<STEPPER_NUM_STEPPER; i++)
+    {
+      while ((stepCompressState.stepper[i].pendingCount > 0) &&
+             (stepCompressQueue[i].available() < STEPCOMPRESS_QUEUE_SIZE))
+        {
+          StepCompress_compress(i);
+        }
+    }
+}
+
+/**
+ * \brief Converts blocks of #motionBuffer into schedules
+ *
+ * Shall be called cyclically from the main loop. Returns as soon as the
+ * queue of one stepper is full and continues with the same step event on
+ * the next call. If #motionBuffer runs empty all pending steps are
+ * compressed so that the movement is completed.
+ */
+void StepCompress_run()
+{
+  MotionBlock_t &block = stepCompressState.block;
+  uint32_t time;
+  uint8_t direction;
+
+  while (true)
+    {
+      /* A step event compresses at most one schedule per stepper */
+      for (uint8_t i=0; i<STEPPER_NUM_STEPPER; i++)
+        {
+          if (stepCompressQueue[i].available() >= STEPCOMPRESS_QUEUE_SIZE)
+            {
+              return;
+            }
+        }
+      if (!stepCompressState.blockActive)
+        {
+          if (MotionBuffer_read(&block) != RESULT_OK)
+            {
+              StepCompress_flush();
+              return;
+            }
+          StepCompress_startBlock();
+        }
+
+      stepCompressState.stepEventsCompleted++;
+      for (uint8_t i=0; i<STEPPER_NUM_STEPPER; i++)
+        {
+          StepCompress_Stepper_t &stepper = stepCompressState.stepper[i];
+          StepperCoordinate_t steps = (i < MACHINE_NUM_AXIS) ? block.steps.steps[i] : block.steps.extruder[i - MACHINE_NUM_AXIS];
+
+          /* Next step of this stepper within this step event? */
+          if ((uint64_t)(stepCompressState.counter[i] + 1) * block.stepEventCount <= (uint64_t)stepCompressState.stepEventsCompleted * steps)
+            {
+              stepCompressState.counter[i]++;
+              time = stepCompressState.blockStartTime +
+                     (uint32_t)(StepCompress_eventTime(stepCompressState.counter[i] * stepCompressState.eventsPerStep[i]) + 0.5);
+              direction = (block.steps.directionBits & _BV(i)) ? STEPPER_DIRECTION_NEGATIVE : STEPPER_DIRECTION_POSITIVE;
+              if (stepper.pendingCount >= STEPCOMPRESS_PENDING_SIZE)
+                {
+                  StepCompress_compress(i);
+                }
+              stepper.pending[stepper.pendingCount].time = time;
+              stepper.pending[stepper.pendingCount].direction = direction;
+              stepper.pendingCount++;
+            }
+        }
+      if (stepCompressState.stepEventsCompleted >= block.stepEventCount)
+        {
+          stepCompressState.blockStartTime += (uint32_t)(StepCompress_eventTime(block.stepEventCount) + 0.5);
+          stepCompressState.blockActive = false;
+        }
+    }
+}
+
+/**
+ * \brief Loads the next schedule of a stepper for replay
+ *
+ * Changes the direction of the stepper if needed.
+ * @param[in] stepper Number of the stepper
+ */
+static void StepCompress_load(uint8_t stepper)
+{
+  StepCompress_Replay_t &replay = StepCompress_replay[stepper];
+  StepCompress_Schedule_t schedule;
+  uint8_t directionBits;
+
+  if (stepCompressQueue[stepper].available() == 0)
+    {
+      return;
+    }
+  /* Published by the release of the read, see #StepCompress_isIdle */
+  __atomic_store_n(&replay.count, (uint16_t)1, __ATOMIC_RELAXED);
+  if (stepCompressQueue[stepper].read(&schedule) != RESULT_OK)
+    {
+      __atomic_store_n(&replay.count, (uint16_t)0, __ATOMIC_RELEASE);
+      return;
+    }
+  replay.interval = schedule.interval;
+  __atomic_store_n(&replay.count, schedule.count, __ATOMIC_RELEASE);
+  replay.add = schedule.add;
+  replay.stepTime += schedule.interval;
+
+  directionBits = (schedule.direction == STEPPER_DIRECTION_NEGATIVE) ? (StepCompress_directionBits | _BV(stepper))
+                                                                     : (StepCompress_directionBits & ~_BV(stepper));
+  if (directionBits != StepCompress_directionBits)
+    {
+      StepCompress_directionBits = directionBits;
+      Platform_stepperWriteDirection(directionBits);
+    }
+}
+
+/**
+ * \brief Step timer interrupt replaying the schedules
+ *
+ * Issues the steps of all steppers which are due, advances their
+ * schedules and loads the next schedule if one is finished. Steps which
+ * are late are issued immediately.
+ * @return Time until the next call [ticks of #STEPPER_TIMER_FREQUENCY]
+ */
+uint32_t StepCompress_isr()
+{
+  uint8_t stepBits = 0;
+  int32_t interval = STEPPER_IDLE_INTERVAL;
+  int32_t wait;
+  TRACE_SPAN_START(start);
+  METRICS_SPAN_START(metricsStart);
+
+  for (uint8_t i=0; i<STEPPER_NUM_STEPPER; i++)
+    {
+      StepCompress_Replay_t &replay = StepCompress_replay[i];
+
+      if ((replay.count > 0) && ((int32_t)(replay.stepTime - StepCompress_replayTime) <= 0))
+        {
+          stepBits |= _BV(i);
+          __atomic_store_n(&replay.count, (uint16_t)(replay.count - 1), __ATOMIC_RELEASE);
+          if (replay.count > 0)
+            {
+              replay.interval += replay.add;
+              replay.stepTime += replay.interval;
+            }
+        }
+    }
+  if (stepBits)
+    {
+      Platform_stepperWriteStep(stepBits);
+    }
+
+  /* Direction is changed only after the last step of a schedule */
+  for (uint8_t i=0; i<STEPPER_NUM_STEPPER; i++)
+    {
+      StepCompress_Replay_t &replay = StepCompress_replay[i];
+
+      if (replay.count == 0)
+        {
+          StepCompress_load(i);
+        }
+      if (replay.count > 0)
+        {
+          wait = (int32_t)(replay.stepTime - StepCompress_replayTime);
+          interval = min(interval, max(wait, (int32_t)1));
+        }
+    }
+  __atomic_store_n(&StepCompress_replayTime, StepCompress_replayTime + interval, __ATOMIC_RELEASE);
+  if (stepBits)
+    {
+      TRACE_SPAN(1, TRACE_EVENT_STEP, start);
+      METRICS_SPAN(&StepCompress_isrCycles, metricsStart);
+    }
+  return interval;
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
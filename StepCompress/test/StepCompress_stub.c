@@ -0,0 +1,109 @@
+/**
+ * \file StepCompress_stub.c
+ *
+ * \brief Stubs for StepCompress unit tests
+ *
+ * All stubs needed for the unit test of this particular modules shall
+ * be done within this file.
+ * The stepper outputs of the platform are replaced by functions which
+ * record the position of each stepper and the replay time of each step of
+ * the first stepper.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup StepCompress
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include "StepCompress_test.h"
+#include <stepCompress.h>
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+uint64_t Platform_timeCycles(void);
+void StepCompressTest_reset();
+void Platform_stepperWriteDirection(uint8_t directionBits);
+void Platform_stepperWriteStep(uint8_t stepBits);
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Last direction bits written
+ */
+uint8_t StepCompressTest_directionBits;
+
+/**
+ * Position of each stepper counted from step bits [steps]
+ */
+int32_t StepCompressTest_position[8];
+
+/**
+ * Highest position of the first stepper [steps]
+ */
+int32_t StepCompressTest_maximumPosition;
+
+/**
+ * Replay time of each step of the first stepper [ticks]
+ */
+uint32_t StepCompressTest_stepTime[STEPCOMPRESS_TEST_STEP_TIMES];
+
+/**
+ * Number of steps of the first stepper
+ */
+uint16_t StepCompressTest_steps;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Cycle counter for the latency probes, durations are not tested
+ *
+ * @return Always 0
+ */
+uint64_t Platform_timeCycles(void)
+{
+  return 0;
+}
+
+/**
+ * \brief Resets all recorded values
+ */
+void StepCompressTest_reset()
+{
+  StepCompressTest_directionBits = 0;
+  StepCompressTest_maximumPosition = 0;
+  StepCompressTest_steps = 0;
+  for (uint8_t i=0; i<8; i++) StepCompressTest_position[i] = 0;
+}
+
+void Platform_stepperWriteDirection(uint8_t directionBits)
+{
+  StepCompressTest_directionBits = directionBits;
+}
+
+void Platform_stepperWriteStep(uint8_t stepBits)
+{
+  for (uint8_t i=0; i<8; i++)
+    {
+      if (stepBits & _BV(i))
+        {
+          StepCompressTest_position[i] += (StepCompressTest_directionBits & _BV(i)) ? -1 : 1;
+        }
+    }
+  if (stepBits & _BV(0))
+    {
+      StepCompressTest_maximumPosition = max(StepCompressTest_maximumPosition, StepCompressTest_position[0]);
+      if (StepCompressTest_steps < STEPCOMPRESS_TEST_STEP_TIMES)
+        {
+          StepCompressTest_stepTime[StepCompressTest_steps++] = StepCompress_replayTime;
+        }
+    }
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,245 @@
+/**
+ * \file StepCompress_test.c
+ *
+ * \brief StepCompress unit test implementation
+ *
+ * Please see http://embunit.sourceforge.net/ for more information. For
+ * detailed documentation see http://embunit.sourceforge.net/embunit/index.html
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup StepCompress
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include "StepCompress_test.h"
+/* Include .cpp file to be tested in order to get access to all private
+ * or static functions. The motion buffer is included as well because the
+ * ring buffer is a template. */
+#include "../../RingBuffer/src/ringBuffer.cpp"
+#include "../../MotionBuffer/src/motionBuffer.cpp"
+#include "../src/stepCompress.cpp"
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+
+/* ******************| Global Variables |****************************** */
+
+/* ******************| Function Implementation |*********************** */
+
+/**
+ * \brief Creates a trapezoid block
+ * @param[in] stepEventCount Number of step events
+ * @param[in] rate Nominal rate [steps/sec]
+ * @param[in] accelerationRate Acceleration [steps/sec^2]
+ * @return Block accelerating from and decelerating to 1/10 of rate
+ */
+static MotionBlock_t StepCompressTest_block(StepperCoordinate_t stepEventCount, StepperCoordinate_t rate, StepperCoordinate_t accelerationRate)
+{
+  MotionBlock_t block = {};
+  StepperCoordinate_t rampSteps = 0;
+
+  block.stepEventCount = stepEventCount;
+  block.steps.steps[0] = stepEventCount;
+  block.nominalRate = rate;
+  block.initialRate = block.finalRate = (accelerationRate > 0) ? rate / 10 : rate;
+  block.accelerationRate = accelerationRate;
+  if (accelerationRate > 0)
+    {
+      rampSteps = (StepperCoordinate_t)((sq((float)rate) - sq((float)block.initialRate)) / (2.0 * accelerationRate));
+    }
+  block.accelerateUntil = rampSteps;
+  block.decelerateAfter = stepEventCount - rampSteps;
+  return block;
+}
+
+/**
+ * \brief Runs compression and replay until all steps are issued
+ */
+static void StepCompressTest_execute()
+{
+  uint8_t busy;
+
+  do
+    {
+      StepCompress_run();
+      StepCompress_isr();
+      busy = stepCompressState.blockActive || motionBuffer.available();
+      for (uint8_t i=0; i<STEPPER_NUM_STEPPER; i++)
+        {
+          busy |= (stepCompressState.stepper[i].pendingCount > 0) || stepCompressQueue[i].available() || StepCompress_replay[i].count;
+        }
+    } while (busy);
+}
+
+/**
+ * Constant rate
+ * Test if all steps are compressed
+ * Test if a constant rate needs no more than one schedule per pending
+ * buffer
+ * Test if all steps are replayed with the exact interval
+ */
+static void StepCompress_StepCompress_run_1(void)
+{
+  MotionBlock_t block = StepCompressTest_block(1000, 10000, 0);
+
+  block.steps.steps[1] = 500;
+  TEST_ASSERT(MotionBuffer_write(block) == RESULT_OK);
+  StepCompressTest_execute();
+
+  TEST_ASSERT_EQUAL_INT(1500, stepCompressState.steps);
+  TEST_ASSERT(stepCompressState.schedules <= 2 * (1000 / STEPCOMPRESS_PENDING_SIZE + 1));
+  TEST_ASSERT_EQUAL_INT(1000, StepCompressTest_position[0]);
+  TEST_ASSERT_EQUAL_INT(500, StepCompressTest_position[1]);
+  TEST_ASSERT_EQUAL_INT(STEPCOMPRESS_START_DELAY + STEPPER_TIMER_FREQUENCY / 10000, StepCompressTest_stepTime[0]);
+  for (uint16_t i=1; i<1000; i++)
+    {
+      TEST_ASSERT_EQUAL_INT(STEPPER_TIMER_FREQUENCY / 10000, StepCompressTest_stepTime[i] - StepCompressTest_stepTime[i-1]);
+    }
+}
+
+/**
+ * Trapezoid
+ * Test if every replayed step is within STEPCOMPRESS_MAXIMUM_ERROR of its
+ * exact time
+ * Test if acceleration is compressed into less schedules than steps
+ */
+static void StepCompress_StepCompress_isr_1(void)
+{
+  MotionBlock_t block = StepCompressTest_block(STEPCOMPRESS_TEST_STEP_TIMES, 20000, 400000);
+  float exact;
+
+  TEST_ASSERT(MotionBuffer_write(block) == RESULT_OK);
+  StepCompressTest_execute();
+
+  TEST_ASSERT_EQUAL_INT(STEPCOMPRESS_TEST_STEP_TIMES, StepCompressTest_steps);
+  TEST_ASSERT(stepCompressState.schedules * 10 < STEPCOMPRESS_TEST_STEP_TIMES);
+  for (uint16_t i=0; i<STEPCOMPRESS_TEST_STEP_TIMES; i++)
+    {
+      exact = STEPCOMPRESS_START_DELAY + StepCompress_eventTime(i + 1);
+      TEST_ASSERT(fabs(StepCompressTest_stepTime[i] - exact) <= STEPCOMPRESS_MAXIMUM_ERROR + 1);
+    }
+}
+
+/**
+ * Direction change
+ * Test if a schedule never spans a direction change
+ * Test if the direction is changed after the last step of the previous
+ * block only
+ */
+static void StepCompress_StepCompress_isr_2(void)
+{
+  MotionBlock_t block = StepCompressTest_block(100, 5000, 0);
+
+  TEST_ASSERT(MotionBuffer_write(block) == RESULT_OK);
+  block.steps.directionBits = _BV(0);
+  TEST_ASSERT(MotionBuffer_write(block) == RESULT_OK);
+  StepCompressTest_execute();
+
+  TEST_ASSERT_EQUAL_INT(100, StepCompressTest_maximumPosition);
+  TEST_ASSERT_EQUAL_INT(0, StepCompressTest_position[0]);
+  TEST_ASSERT_EQUAL_INT(200, StepCompressTest_steps);
+}
+
+/**
+ * Standstill
+ * Test if a block after standstill starts STEPCOMPRESS_START_DELAY after
+ * the current replay time
+ */
+static void StepCompress_StepCompress_run_2(void)
+{
+  MotionBlock_t block = StepCompressTest_block(10, 5000, 0);
+  uint32_t start;
+
+  TEST_ASSERT(MotionBuffer_write(block) == RESULT_OK);
+  StepCompressTest_execute();
+  for (uint8_t i=0; i<100; i++)
+    {
+      StepCompress_isr();
+    }
+  start = StepCompress_replayTime;
+  TEST_ASSERT(MotionBuffer_write(block) == RESULT_OK);
+  StepCompressTest_execute();
+
+  TEST_ASSERT_EQUAL_INT(20, StepCompressTest_steps);
+  TEST_ASSERT_EQUAL_INT(start + STEPCOMPRESS_START_DELAY + STEPPER_TIMER_FREQUENCY / 5000, StepCompressTest_stepTime[10]);
+}
+
+/**
+ * Long standstill, e.g. G4 S1200
+ * Test if a block after more than 2^31 ticks of standstill starts
+ * STEPCOMPRESS_START_DELAY after the current replay time
+ * Test if a stepper which never stepped before steps in time as well
+ */
+static void StepCompress_StepCompress_run_3(void)
+{
+  MotionBlock_t block = StepCompressTest_block(10, 5000, 0);
+  uint32_t start;
+
+  TEST_ASSERT(MotionBuffer_write(block) == RESULT_OK);
+  StepCompressTest_execute();
+  StepCompress_replayTime += (uint32_t)2400000000;
+  start = StepCompress_replayTime;
+  block.steps.steps[1] = 10;
+  TEST_ASSERT(MotionBuffer_write(block) == RESULT_OK);
+  StepCompressTest_execute();
+
+  TEST_ASSERT_EQUAL_INT(20, StepCompressTest_steps);
+  TEST_ASSERT_EQUAL_INT(10, StepCompressTest_position[1]);
+  TEST_ASSERT_EQUAL_INT(start + STEPCOMPRESS_START_DELAY + STEPPER_TIMER_FREQUENCY / 5000, StepCompressTest_stepTime[10]);
+  TEST_ASSERT_EQUAL_INT(start + STEPCOMPRESS_START_DELAY + 10 * STEPPER_TIMER_FREQUENCY / 5000, StepCompressTest_stepTime[19]);
+  TEST_ASSERT(StepCompress_replayTime - start < STEPPER_TIMER_FREQUENCY);
+}
+
+/**
+ * Test Setup function which is called for each test
+ */
+static void setUpStepCompress(void)
+{
+  MotionBlock_t block;
+
+  while (MotionBuffer_read(&block) == RESULT_OK);
+  StepCompressTest_reset();
+  StepCompress_init();
+}
+
+/**
+ * Test Teardown function which is called for after each test
+ */
+static void tearDownStepCompress(void)
+{
+}
+
+TestRef StepCompress_test_RunTests(void)
+{
+  EMB_UNIT_TESTFIXTURES(fixtures) {
+    new_TestFixture("Test case StepCompress_StepCompress_run_1", StepCompress_StepCompress_run_1),
+    new_TestFixture("Test case StepCompress_StepCompress_run_2", StepCompress_StepCompress_run_2),
+    new_TestFixture("Test case StepCompress_StepCompress_run_3", StepCompress_StepCompress_run_3),
+    new_TestFixture("Test case StepCompress_StepCompress_isr_1", StepCompress_StepCompress_isr_1),
+    new_TestFixture("Test case StepCompress_StepCompress_isr_2", StepCompress_StepCompress_isr_2)
+  };
+  EMB_UNIT_TESTCALLER(StepCompress_tests,"StepCompress Unit test",setUpStepCompress,tearDownStepCompress,fixtures);
+  return (TestRef)&StepCompress_tests;
+}
+
+/**
+ *
+ */
+int main(void)
+{
+  TestRunner_start();
+  TestRunner_runTest(StepCompress_test_RunTests());
+  TestRunner_end();
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,45 @@
+#if (!defined STEPCOMPRESS_TEST_H_)
+/* Preprocessor exclusion definition */
+#define STEPCOMPRESS_TEST_H_
+/**
+ * \file StepCompress_test.h
+ *
+ * \brief StepCompress include file for test driver
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup StepCompress
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <embUnit/embUnit.h>
+#include <platform.h>
+
+/* ******************| Macros |**************************************** */
+/**
+ * Number of step times of the first stepper recorded
+ */
+#define STEPCOMPRESS_TEST_STEP_TIMES      (uint16_t)2000
+
+/* ******************| Type definitions |****************************** */
+
+/* ******************| External function declarations |**************** */
+extern void StepCompressTest_reset();
+
+/* ******************| External constants |**************************** */
+
+/* ******************| External variables |**************************** */
+extern uint8_t StepCompressTest_directionBits;
+extern int32_t StepCompressTest_position[8];
+extern int32_t StepCompressTest_maximumPosition;
+extern uint32_t StepCompressTest_stepTime[STEPCOMPRESS_TEST_STEP_TIMES];
+extern uint16_t StepCompressTest_steps;
+
+/** @} doxygen end group definition */
+#endif /* if !defined( STEPCOMPRESS_TEST_H_ ) */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,187 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#if (!defined STEPPER_INCLUDE_STEPPER_H_)
+/* Preprocessor exclusion definition */
+#define STEPPER_INCLUDE_STEPPER_H_
+/**
+ * \brief Stepper include file
+ *
+ * Step generator. Executes the blocks of #motionBuffer by issuing step
+ * events for all axis and extruder steppers using the Bresenham algorithm
+ * and changes the step rate according to the trapezoid of each block.
+ * The step generator does not know about timers. #Stepper_isr shall be
+ * called by the platform from a timer interrupt and returns the time until
+ * it shall be called next.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup Stepper
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <blueMarlin.h>
+#include <motionBuffer.h>
+#include <metrics.h>
+
+/* ******************| Macros |**************************************** */
+/**
+ * Supported step generators. Bresenham executes the blocks of
+ * #motionBuffer directly in #Stepper_isr. StepCompress converts them into
+ * compressed step schedules outside of interrupt context which are
+ * replayed by #StepCompress_isr.
+ */
+#define STEPPER_GENERATOR_BRESENHAM     0
+#define STEPPER_GENERATOR_STEPCOMPRESS  1
+
+/**
+ * Step generator called by the step timer of the platform.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DSTEPPER_GENERATOR=STEPPER_GENERATOR_STEPCOMPRESS
+ */
+#ifndef STEPPER_GENERATOR
+#define STEPPER_GENERATOR               STEPPER_GENERATOR_BRESENHAM
+#endif
+
+/**
+ * Frequency of the step timer in Hz. All intervals returned by
+ * #Stepper_isr are given in ticks of this timer.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DSTEPPER_TIMER_FREQUENCY 2000000
+ */
+#ifndef STEPPER_TIMER_FREQUENCY
+#define STEPPER_TIMER_FREQUENCY       (uint32_t)2000000
+#endif
+
+/**
+ * Lowest step rate in steps/sec. Lower rates are raised to this value to
+ * keep the interval within the range of the step timer.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DSTEPPER_MINIMUM_RATE 32
+ */
+#ifndef STEPPER_MINIMUM_RATE
+#define STEPPER_MINIMUM_RATE          (uint32_t)32
+#endif
+
+/**
+ * Interval in ticks after which the motion buffer is checked again if
+ * there is no block to be executed.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DSTEPPER_IDLE_INTERVAL 2000
+ */
+#ifndef STEPPER_IDLE_INTERVAL
+#define STEPPER_IDLE_INTERVAL         (uint32_t)2000
+#endif
+
+/**
+ * Highest rate of #Stepper_isr calls in calls/sec. If the nominal rate of
+ * a block exceeds this rate, 2, 4 or 8 step events are issued per call
+ * (multi-stepping).
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DSTEPPER_MAXIMUM_ISR_RATE 10000
+ */
+#ifndef STEPPER_MAXIMUM_ISR_RATE
+#define STEPPER_MAXIMUM_ISR_RATE      (uint32_t)10000
+#endif
+
+/**
+ * Maximum number of step events per #Stepper_isr call. Must be a power
+ * of two.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DSTEPPER_MAXIMUM_STEP_LOOPS 8
+ */
+#ifndef STEPPER_MAXIMUM_STEP_LOOPS
+#define STEPPER_MAXIMUM_STEP_LOOPS    (uint8_t)8
+#endif
+
+/**
+ * Hysteresis for switching back to less step events per call in percent
+ * of #STEPPER_MAXIMUM_ISR_RATE. Avoids toggling between two modes for
+ * blocks with a rate close to the switching point.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DSTEPPER_STEP_LOOPS_HYSTERESIS 10
+ */
+#ifndef STEPPER_STEP_LOOPS_HYSTERESIS
+#define STEPPER_STEP_LOOPS_HYSTERESIS (uint32_t)10
+#endif
+
+/**
+ * Number of steppers, that is axis and extruder steppers
+ */
+#define STEPPER_NUM_STEPPER           (MACHINE_NUM_AXIS + MACHINE_NUM_EXTRUDER)
+
+/* ******************| Type definitions |****************************** */
+/**
+ * State of the step generator
+ */
+typedef struct
+{
+  MotionBlock_t block;                      /*!< Block currently executed */
+  bool blockActive;                         /*!< True while block is executed */
+  int32_t counter[STEPPER_NUM_STEPPER];     /*!< Bresenham error term for each stepper */
+  StepperCoordinate_t stepEventsCompleted;  /*!< Number of step events of the block issued so far */
+  uint32_t accelerationTime;                /*!< Time since start of the acceleration [ticks] */
+  uint32_t decelerationTime;                /*!< Time since start of the deceleration [ticks] */
+  uint32_t accelerationFactor;              /*!< accelerationRate of the block scaled by 2^24/#STEPPER_TIMER_FREQUENCY */
+  StepperCoordinate_t accelerationStepRate; /*!< Step rate reached at the end of the acceleration */
+  uint32_t nominalInterval;                 /*!< Interval at nominal rate for all step events of one call [ticks] */
+  uint8_t stepLoops;                        /*!< Number of step events per call of #Stepper_isr */
+  uint32_t loopFrequency;                   /*!< #STEPPER_TIMER_FREQUENCY multiplied by stepLoops */
+} Stepper_State_t;
+
+/* ******************| External function declarations |**************** */
+extern void Stepper_init();
+extern uint32_t Stepper_isr();
+extern bool Stepper_isIdle();
+
+/* ******************| External constants |**************************** */
+
+/* ******************| External variables |**************************** */
+extern Stepper_State_t stepperState;
+extern Metrics_Histogram_t Stepper_isrCycles;
+
+/**
+ * \brief Calculates the timer interval for a step rate
+ *
+ * @param[in] rate Step rate in steps/sec
+ * @return Interval between two calls of #Stepper_isr in ticks, that is
+ * for stepLoops step events
+ */
+inline uint32_t Stepper_interval(StepperCoordinate_t rate)
+{
+  return stepperState.loopFrequency / max(rate, STEPPER_MINIMUM_RATE);
+}
+
+/** @} doxygen end group definition */
+#endif /* if !defined( STEPPER_INCLUDE_STEPPER_H_ ) */
+/* ******************| End of file |*********************************** */
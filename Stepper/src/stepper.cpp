@@ -0,0 +1,255 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * \addtogroup Stepper
+ * @{
+ *
+ * \brief Stepper source file
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ * Up to #STEPPER_MAXIMUM_STEP_LOOPS step events are issued per call of
+ * #Stepper_isr, depending on the nominal rate of the block. The step rate
+ * during acceleration and deceleration is calculated from the time since
+ * the start of the respective phase, that is v = v0 + a*t. To avoid a
+ * division during acceleration the acceleration is scaled once per block.
+ *
+ * @note Replaces ISR(TIMER1_COMPA_vect) and trapezoid_generator_reset
+ */
+
+/* ******************| Inclusions |************************************ */
+#include "stepper.h"
+#include <trace.h>
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+void Stepper_init();
+uint32_t Stepper_isr();
+bool Stepper_isIdle();
+static void Stepper_startBlock();
+static void Stepper_selectStepLoops(StepperCoordinate_t rate);
+
+/* ******************| Global Variables |****************************** */
+Stepper_State_t stepperState;
+
+/**
+ * Duration of the calls of #Stepper_isr which had a block to execute
+ */
+Metrics_Histogram_t Stepper_isrCycles;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Initializes Stepper module
+ *
+ * Stops execution of the current block, if any.
+ */
+void Stepper_init()
+{
+  stepperState.blockActive = false;
+  stepperState.stepLoops = 1;
+  stepperState.loopFrequency = STEPPER_TIMER_FREQUENCY;
+}
+
+/**
+ * \brief Checks if all steppers stand still
+ *
+ * May be called from another context than #Stepper_isr. Check
+ * #motionBuffer before: A block is marked active before it is taken from
+ * #motionBuffer, thus, a block is never missed by both checks.
+ * @return True if no block is executed. Blocks waiting in #motionBuffer
+ * are not considered.
+ */
+bool Stepper_isIdle()
+{
+  return !__atomic_load_n(&stepperState.blockActive, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * \brief Selects number of step events per call for a block
+ *
+ * The number of step events per call is doubled until the resulting call
+ * rate does not exceed #STEPPER_MAXIMUM_ISR_RATE. It is only halved again
+ * if the call rate with half the step events would stay below
+ * #STEPPER_MAXIMUM_ISR_RATE by #STEPPER_STEP_LOOPS_HYSTERESIS.
+ * @param[in] rate Nominal rate of the block [steps/sec]
+ */
+static void Stepper_selectStepLoops(StepperCoordinate_t rate)
+{
+  while ((stepperState.stepLoops < STEPPER_MAXIMUM_STEP_LOOPS) &&
+         (rate > STEPPER_MAXIMUM_ISR_RATE * stepperState.stepLoops))
+    {
+      stepperState.stepLoops <<= 1;
+    }
+  while ((stepperState.stepLoops > 1) &&
+         (rate * 100 < STEPPER_MAXIMUM_ISR_RATE * (stepperState.stepLoops >> 1) * (100 - STEPPER_STEP_LOOPS_HYSTERESIS)))
+    {
+      stepperState.stepLoops >>= 1;
+    }
+  stepperState.loopFrequency = STEPPER_TIMER_FREQUENCY * stepperState.stepLoops;
+}
+
+/**
+ * \brief Prepares execution of the block in #stepperState
+ *
+ * Resets the Bresenham counters and the trapezoid generator, selects the
+ * number of step events per call and sets the direction of all steppers.
+ * Everything which does not change during the block is calculated here.
+ */
+static void Stepper_startBlock()
+{
+  /* Start in the middle to distribute the steps evenly */
+  for (uint8_t i=0; i<STEPPER_NUM_STEPPER; i++)
+    {
+      stepperState.counter[i] = -(int32_t)(stepperState.block.stepEventCount >> 1);
+    }
+  stepperState.stepEventsCompleted = 0;
+  stepperState.accelerationTime = 0;
+  stepperState.decelerationTime = 0;
+  stepperState.accelerationFactor = (uint32_t)(((uint64_t)stepperState.block.accelerationRate << 24) / STEPPER_TIMER_FREQUENCY);
+  stepperState.accelerationStepRate = stepperState.block.initialRate;
+  Stepper_selectStepLoops(stepperState.block.nominalRate);
+  stepperState.nominalInterval = Stepper_interval(stepperState.block.nominalRate);
+
+  Platform_stepperWriteDirection(stepperState.block.steps.directionBits);
+}
+
+/**
+ * \brief Step timer interrupt
+ *
+ * Issues the next step events of the current block. If no block is active
+ * the next block is taken from #motionBuffer.
+ * Multi-stepping: stepLoops step events are issued back to back and the
+ * interval is stretched accordingly. Step events are never carried over
+ * into the next block. Thus, the last call of a block may issue less step
+ * events and its interval is shortened to the step events issued.
+ * Bresenham: Each stepper accumulates its number of steps per step event.
+ * Whenever the sum gets positive a step is issued and stepEventCount is
+ * subtracted again.
+ * Trapezoid: Until accelerateUntil step events the rate increases from
+ * initialRate with accelerationRate. After decelerateAfter step events it
+ * decreases from the reached rate down to finalRate. In between the block
+ * is executed at nominalRate.
+ * @return Time until the next call [ticks of #STEPPER_TIMER_FREQUENCY]
+ */
+uint32_t Stepper_isr()
+{
+  uint8_t stepBits;
+  uint8_t stepEvents = 0;
+  uint32_t interval;
+  StepperCoordinate_t stepRate;
+  TRACE_SPAN_START(start);
+  METRICS_SPAN_START(metricsStart);
+
+  if (!stepperState.blockActive)
+    {
+      if (motionBuffer.available() == 0)
+        {
+          return STEPPER_IDLE_INTERVAL;
+        }
+      /* Published by the release of the read, see #Stepper_isIdle */
+      __atomic_store_n(&stepperState.blockActive, true, __ATOMIC_RELAXED);
+      if (MotionBuffer_read(&stepperState.block) != RESULT_OK)
+        {
+          __atomic_store_n(&stepperState.blockActive, false, __ATOMIC_RELEASE);
+          return STEPPER_IDLE_INTERVAL;
+        }
+      Stepper_startBlock();
+    }
+
+  for (uint8_t loop=0; loop<stepperState.stepLoops; loop++)
+    {
+      stepBits = 0;
+      /* Bresenham for all axis and extruder steppers. Extruder bits follow the axis bits */
+      for (uint8_t i=0; i<MACHINE_NUM_AXIS; i++)
+        {
+          stepperState.counter[i] += stepperState.block.steps.steps[i];
+          if (stepperState.counter[i] > 0)
+            {
+              stepBits |= _BV(i);
+              stepperState.counter[i] -= stepperState.block.stepEventCount;
+            }
+        }
+      for (uint8_t i=0; i<MACHINE_NUM_EXTRUDER; i++)
+        {
+          stepperState.counter[MACHINE_NUM_AXIS + i] += stepperState.block.steps.extruder[i];
+          if (stepperState.counter[MACHINE_NUM_AXIS + i] > 0)
+            {
+              stepBits |= _BV(MACHINE_NUM_AXIS + i);
+              stepperState.counter[MACHINE_NUM_AXIS + i] -= stepperState.block.stepEventCount;
+            }
+        }
+      Platform_stepperWriteStep(stepBits);
+      stepEvents++;
+      stepperState.stepEventsCompleted++;
+      if (stepperState.stepEventsCompleted >= stepperState.block.stepEventCount)
+        {
+          break;
+        }
+    }
+
+  /* Trapezoid */
+  if (stepperState.stepEventsCompleted <= stepperState.block.accelerateUntil)
+    {
+      stepRate = stepperState.block.initialRate +
+                 (StepperCoordinate_t)(((uint64_t)stepperState.accelerationFactor * stepperState.accelerationTime) >> 24);
+      stepRate = min(stepRate, stepperState.block.nominalRate);
+      stepperState.accelerationStepRate = stepRate;
+      interval = Stepper_interval(stepRate);
+      stepperState.accelerationTime += interval;
+    }
+  else if (stepperState.stepEventsCompleted > stepperState.block.decelerateAfter)
+    {
+      stepRate = (StepperCoordinate_t)(((uint64_t)stepperState.accelerationFactor * stepperState.decelerationTime) >> 24);
+      if (stepRate < stepperState.accelerationStepRate)
+        {
+          stepRate = max(stepperState.accelerationStepRate - stepRate, stepperState.block.finalRate);
+        }
+      else
+        {
+          stepRate = stepperState.block.finalRate;
+        }
+      interval = Stepper_interval(stepRate);
+      stepperState.decelerationTime += interval;
+    }
+  else
+    {
+      interval = stepperState.nominalInterval;
+    }
+
+  if (stepperState.stepEventsCompleted >= stepperState.block.stepEventCount)
+    {
+      /* Otherwise the next block would start up to stepLoops - 1 step
+       * periods late */
+      interval = interval * stepEvents / stepperState.stepLoops;
+      __atomic_store_n(&stepperState.blockActive, false, __ATOMIC_RELEASE);
+    }
+  TRACE_SPAN(1, TRACE_EVENT_STEP, start);
+  METRICS_SPAN(&Stepper_isrCycles, metricsStart);
+  return interval;
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
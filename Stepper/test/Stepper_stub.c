@@ -0,0 +1,96 @@
+/**
+ * \file Stepper_stub.c
+ *
+ * \brief Stubs for Stepper unit tests
+ *
+ * All stubs needed for the unit test of this particular modules shall
+ * be done within this file.
+ * The stepper outputs of the platform are replaced by functions which
+ * record direction, step bits and the resulting position of each stepper.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup Stepper
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include "Stepper_test.h"
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+uint64_t Platform_timeCycles(void);
+void StepperTest_reset();
+void Platform_stepperWriteDirection(uint8_t directionBits);
+void Platform_stepperWriteStep(uint8_t stepBits);
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Last direction bits written
+ */
+uint8_t StepperTest_directionBits;
+
+/**
+ * Last step bits written
+ */
+uint8_t StepperTest_stepBits;
+
+/**
+ * Position of each stepper counted from step bits [steps]
+ */
+int32_t StepperTest_position[8];
+
+/**
+ * Number of step events, that is calls to #Platform_stepperWriteStep
+ */
+uint32_t StepperTest_stepEvents;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Cycle counter for the latency probes, durations are not tested
+ *
+ * @return Always 0
+ */
+uint64_t Platform_timeCycles(void)
+{
+  return 0;
+}
+
+/**
+ * \brief Resets all recorded values
+ */
+void StepperTest_reset()
+{
+  StepperTest_directionBits = 0;
+  StepperTest_stepBits = 0;
+  StepperTest_stepEvents = 0;
+  for (uint8_t i=0; i<8; i++) StepperTest_position[i] = 0;
+}
+
+void Platform_stepperWriteDirection(uint8_t directionBits)
+{
+  StepperTest_directionBits = directionBits;
+}
+
+void Platform_stepperWriteStep(uint8_t stepBits)
+{
+  StepperTest_stepBits = stepBits;
+  StepperTest_stepEvents++;
+  for (uint8_t i=0; i<8; i++)
+    {
+      if (stepBits & _BV(i))
+        {
+          StepperTest_position[i] += (StepperTest_directionBits & _BV(i)) ? -1 : 1;
+        }
+    }
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
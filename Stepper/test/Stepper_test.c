@@ -0,0 +1,296 @@
+/**
+ * \file Stepper_test.c
+ *
+ * \brief Stepper unit test implementation
+ *
+ * Please see http://embunit.sourceforge.net/ for more information. For
+ * detailed documentation see http://embunit.sourceforge.net/embunit/index.html
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup Stepper
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include "Stepper_test.h"
+/* Include .cpp file to be tested in order to get access to all private
+ * or static functions. The motion buffer is included as well because the
+ * ring buffer is a template. */
+#include "../../RingBuffer/src/ringBuffer.cpp"
+#include "../../MotionBuffer/src/motionBuffer.cpp"
+#include "../src/stepper.cpp"
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+
+/* ******************| Global Variables |****************************** */
+
+/* ******************| Function Implementation |*********************** */
+
+/**
+ * \brief Creates a block without acceleration and deceleration
+ * @param[in] stepEventCount Number of step events
+ * @param[in] rate Step rate [steps/sec]
+ * @return Block
+ */
+static MotionBlock_t StepperTest_block(StepperCoordinate_t stepEventCount, StepperCoordinate_t rate)
+{
+  MotionBlock_t block = {};
+
+  block.stepEventCount = stepEventCount;
+  block.initialRate = rate;
+  block.nominalRate = rate;
+  block.finalRate = rate;
+  block.accelerateUntil = 0;
+  block.decelerateAfter = stepEventCount;
+  return block;
+}
+
+/**
+ * Bresenham
+ * Test if all steps of all steppers are issued within stepEventCount step
+ * events
+ * Test if the steps of a slower stepper are evenly distributed
+ * Test if direction bits are applied
+ */
+static void Stepper_Stepper_isr_1(void)
+{
+  MotionBlock_t block = StepperTest_block(100, 1000);
+  uint32_t stepsY = 0;
+
+  block.steps.steps[0] = 100;
+  block.steps.steps[1] = 50;
+  block.steps.steps[2] = 0;
+  block.steps.extruder[0] = 25;
+  block.steps.directionBits = _BV(1) | _BV(MACHINE_NUM_AXIS);
+  TEST_ASSERT(MotionBuffer_write(block) == RESULT_OK);
+
+  Stepper_isr();
+  TEST_ASSERT(stepperState.blockActive);
+  TEST_ASSERT_EQUAL_INT((_BV(1) | _BV(MACHINE_NUM_AXIS)), StepperTest_directionBits);
+  while (stepperState.blockActive)
+    {
+      Stepper_isr();
+      /* Every second step event issues a step along Y */
+      if (StepperTest_stepBits & _BV(1))
+        {
+          stepsY++;
+          TEST_ASSERT_EQUAL_INT(0, StepperTest_stepEvents % 2);
+        }
+    }
+  TEST_ASSERT_EQUAL_INT(100, StepperTest_stepEvents);
+  TEST_ASSERT_EQUAL_INT(100, StepperTest_position[0]);
+  TEST_ASSERT_EQUAL_INT(-50, StepperTest_position[1]);
+  TEST_ASSERT_EQUAL_INT(0, StepperTest_position[2]);
+  TEST_ASSERT_EQUAL_INT(-25, StepperTest_position[MACHINE_NUM_AXIS]);
+  TEST_ASSERT_EQUAL_INT(50, stepsY);
+}
+
+/**
+ * Nominal rate
+ * Test if a block without acceleration is executed with the interval of
+ * its nominal rate
+ * Test if the next block is started directly after the previous one
+ */
+static void Stepper_Stepper_isr_2(void)
+{
+  MotionBlock_t block = StepperTest_block(10, 4000);
+
+  block.steps.steps[0] = 10;
+  TEST_ASSERT(MotionBuffer_write(block) == RESULT_OK);
+  block.nominalRate = block.initialRate = block.finalRate = 8000;
+  TEST_ASSERT(MotionBuffer_write(block) == RESULT_OK);
+
+  for (uint8_t i=0; i<10; i++)
+    {
+      TEST_ASSERT_EQUAL_INT(STEPPER_TIMER_FREQUENCY / 4000, Stepper_isr());
+    }
+  TEST_ASSERT(!stepperState.blockActive);
+  for (uint8_t i=0; i<10; i++)
+    {
+      TEST_ASSERT_EQUAL_INT(STEPPER_TIMER_FREQUENCY / 8000, Stepper_isr());
+    }
+  TEST_ASSERT_EQUAL_INT(20, StepperTest_position[0]);
+}
+
+/**
+ * Trapezoid
+ * Test if the interval decreases monotonically during acceleration
+ * Test if nominal rate is reached and not exceeded
+ * Test if the interval increases monotonically during deceleration and
+ * does not exceed the interval of the final rate
+ */
+static void Stepper_Stepper_isr_3(void)
+{
+  /* 1000 -> 8000 steps/sec with 200000 steps/sec^2 takes 158 steps */
+  MotionBlock_t block = StepperTest_block(1000, 8000);
+  uint32_t interval;
+  uint32_t lastInterval;
+
+  block.steps.steps[0] = 1000;
+  block.initialRate = 1000;
+  block.finalRate = 1000;
+  block.accelerationRate = 200000;
+  block.accelerateUntil = 158;
+  block.decelerateAfter = 1000 - 158;
+  TEST_ASSERT(MotionBuffer_write(block) == RESULT_OK);
+
+  lastInterval = Stepper_interval(block.initialRate);
+  for (uint32_t i=1; i<=block.stepEventCount; i++)
+    {
+      interval = Stepper_isr();
+      TEST_ASSERT(interval >= STEPPER_TIMER_FREQUENCY / block.nominalRate);
+      TEST_ASSERT(interval <= Stepper_interval(block.finalRate));
+      if (i <= block.accelerateUntil)
+        {
+          TEST_ASSERT(interval <= lastInterval);
+        }
+      else if (i > block.decelerateAfter)
+        {
+          TEST_ASSERT(interval >= lastInterval);
+        }
+      else
+        {
+          TEST_ASSERT_EQUAL_INT(STEPPER_TIMER_FREQUENCY / block.nominalRate, interval);
+        }
+      lastInterval = interval;
+    }
+  TEST_ASSERT(!stepperState.blockActive);
+  /* Deceleration ends close to final rate */
+  TEST_ASSERT(lastInterval > Stepper_interval(block.finalRate) * 3 / 4);
+  TEST_ASSERT_EQUAL_INT(1000, StepperTest_position[0]);
+}
+
+/**
+ * Idle
+ * Test if no step event is issued while the motion buffer is empty
+ */
+static void Stepper_Stepper_isr_4(void)
+{
+  TEST_ASSERT_EQUAL_INT(STEPPER_IDLE_INTERVAL, Stepper_isr());
+  TEST_ASSERT(!stepperState.blockActive);
+  TEST_ASSERT_EQUAL_INT(0, StepperTest_stepEvents);
+}
+
+/**
+ * Multi-stepping
+ * Test if the number of step events per call follows the nominal rate
+ * Test if switching back happens only below the hysteresis
+ * Test if the interval covers all step events of one call
+ * Test if blocks with a step event count which is not a multiple of the
+ * step events per call are executed exactly
+ */
+static void Stepper_Stepper_isr_5(void)
+{
+  const StepperCoordinate_t rates[] = {15000, 50000, 36000, 30000, 9500, 8000};
+  const uint8_t stepLoops[] = {2, 8, 8, 4, 2, 1};
+  MotionBlock_t block;
+  uint32_t stepEvents = 0;
+
+  for (uint8_t i=0; i<sizeof(rates)/sizeof(rates[0]); i++)
+    {
+      block = StepperTest_block(1003, rates[i]);
+      block.steps.steps[0] = 1003;
+      block.steps.steps[1] = 501;
+      TEST_ASSERT(MotionBuffer_write(block) == RESULT_OK);
+
+      TEST_ASSERT_EQUAL_INT(STEPPER_TIMER_FREQUENCY * stepLoops[i] / rates[i], Stepper_isr());
+      TEST_ASSERT_EQUAL_INT(stepLoops[i], stepperState.stepLoops);
+      TEST_ASSERT_EQUAL_INT(stepLoops[i], StepperTest_stepEvents - stepEvents);
+      while (stepperState.blockActive)
+        {
+          Stepper_isr();
+        }
+      stepEvents += 1003;
+      TEST_ASSERT_EQUAL_INT(stepEvents, StepperTest_stepEvents);
+    }
+  TEST_ASSERT_EQUAL_INT(6 * 1003, StepperTest_position[0]);
+  TEST_ASSERT_EQUAL_INT(6 * 501, StepperTest_position[1]);
+}
+
+/**
+ * Multi-stepping across blocks
+ * Test if the time from the call issuing the last step events of a block
+ * to the call issuing the first step events of the next block only covers
+ * the step events issued, if the block ends within a call
+ * Test if the next block then starts with all step events per call
+ */
+static void Stepper_Stepper_isr_6(void)
+{
+  /* 1003 step events at 8 per call leave 3 for the last call */
+  MotionBlock_t block = StepperTest_block(1003, 50000);
+  uint32_t interval = 0;
+  uint32_t stepEvents;
+
+  block.steps.steps[0] = 1003;
+  TEST_ASSERT(MotionBuffer_write(block) == RESULT_OK);
+  TEST_ASSERT(MotionBuffer_write(block) == RESULT_OK);
+
+  while (StepperTest_stepEvents < 1003)
+    {
+      stepEvents = StepperTest_stepEvents;
+      interval = Stepper_isr();
+      TEST_ASSERT_EQUAL_INT(8, stepperState.stepLoops);
+    }
+  TEST_ASSERT(!stepperState.blockActive);
+  TEST_ASSERT_EQUAL_INT(3, StepperTest_stepEvents - stepEvents);
+  TEST_ASSERT(interval <= STEPPER_TIMER_FREQUENCY * 3 / 50000 + 1);
+  TEST_ASSERT(interval >= STEPPER_TIMER_FREQUENCY * 3 / 50000 - 1);
+
+  TEST_ASSERT_EQUAL_INT(STEPPER_TIMER_FREQUENCY * 8 / 50000, Stepper_isr());
+  TEST_ASSERT_EQUAL_INT(1003 + 8, StepperTest_stepEvents);
+}
+
+/**
+ * Test Setup function which is called for each test
+ */
+static void setUpStepper(void)
+{
+  MotionBlock_t block;
+
+  while (MotionBuffer_read(&block) == RESULT_OK);
+  StepperTest_reset();
+  Stepper_init();
+}
+
+/**
+ * Test Teardown function which is called for after each test
+ */
+static void tearDownStepper(void)
+{
+}
+
+TestRef Stepper_test_RunTests(void)
+{
+  EMB_UNIT_TESTFIXTURES(fixtures) {
+    new_TestFixture("Test case Stepper_Stepper_isr_1", Stepper_Stepper_isr_1),
+    new_TestFixture("Test case Stepper_Stepper_isr_2", Stepper_Stepper_isr_2),
+    new_TestFixture("Test case Stepper_Stepper_isr_3", Stepper_Stepper_isr_3),
+    new_TestFixture("Test case Stepper_Stepper_isr_4", Stepper_Stepper_isr_4),
+    new_TestFixture("Test case Stepper_Stepper_isr_5", Stepper_Stepper_isr_5),
+    new_TestFixture("Test case Stepper_Stepper_isr_6", Stepper_Stepper_isr_6)
+  };
+  EMB_UNIT_TESTCALLER(Stepper_tests,"Stepper Unit test",setUpStepper,tearDownStepper,fixtures);
+  return (TestRef)&Stepper_tests;
+}
+
+/**
+ *
+ */
+int main(void)
+{
+  TestRunner_start();
+  TestRunner_runTest(Stepper_test_RunTests());
+  TestRunner_end();
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,40 @@
+#if (!defined STEPPER_TEST_H_)
+/* Preprocessor exclusion definition */
+#define STEPPER_TEST_H_
+/**
+ * \file Stepper_test.h
+ *
+ * \brief Stepper include file for test driver
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup Stepper
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <embUnit/embUnit.h>
+#include <platform.h>
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type definitions |****************************** */
+
+/* ******************| External function declarations |**************** */
+extern void StepperTest_reset();
+
+/* ******************| External constants |**************************** */
+
+/* ******************| External variables |**************************** */
+extern uint8_t StepperTest_directionBits;
+extern uint8_t StepperTest_stepBits;
+extern int32_t StepperTest_position[8];
+extern uint32_t StepperTest_stepEvents;
+
+/** @} doxygen end group definition */
+#endif /* if !defined( STEPPER_TEST_H_ ) */
+/* ******************| End of file |*********************************** */
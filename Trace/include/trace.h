@@ -0,0 +1,230 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#if (!defined TRACE_INCLUDE_TRACE_H_)
+/* Preprocessor exclusion definition */
+#define TRACE_INCLUDE_TRACE_H_
+/**
+ * \brief Trace include file
+ *
+ * Records pipeline events, e.g. a g-code entering #gCodeRingBuffer or a
+ * call of the step interrupt, with a time stamp in a ring of fixed-size
+ * records. The ring is overwritten when full, thus, it always holds the
+ * last #TRACE_BUFFER_SIZE events. Probes are placed with #TRACE and
+ * #TRACE_SPAN and vanish completely unless #TRACE_ENABLE is set. Recording an event
+ * takes one atomic increment, one read of #Platform_timeCycles and a few
+ * stores. Any context, including interrupts and other threads, may
+ * record.
+ * The platform dumps header and records, tools/trace converts the dump
+ * into the Chrome trace format.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup Trace
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <platform.h>
+
+/* ******************| Macros |**************************************** */
+/**
+ * Events recorded
+ * 0: none, all probes are removed during compile time
+ * 1: pipeline stages, that is g-codes read, line movements and calls of
+ *    the step interrupt
+ * 2: additionally every write to and read from a ring buffer
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DTRACE_ENABLE 1
+ */
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE                  0
+#endif
+
+/**
+ * Number of records kept. Must be a power of two. Each record takes 16
+ * bytes.
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DTRACE_BUFFER_SIZE 4096
+ */
+#ifndef TRACE_BUFFER_SIZE
+#define TRACE_BUFFER_SIZE             (uint32_t)4096
+#endif
+
+/**
+ * Maximum number of objects with a name, see #Trace_name
+ * It's possible to override default in the respective configuration file
+ * or by specifying the value during compile time with
+ * -DTRACE_MAX_NAMES 16
+ */
+#ifndef TRACE_MAX_NAMES
+#define TRACE_MAX_NAMES               (uint8_t)16
+#endif
+
+/**
+ * Maximum length of a name including the terminating zero
+ */
+#define TRACE_NAME_LENGTH             (uint8_t)22
+
+/**
+ * Version of the dump format, see #Trace_Header_t
+ */
+#define TRACE_VERSION                 (uint16_t)1
+
+/**
+ * Recorded events. Value and object of each event are given behind.
+ */
+#define TRACE_EVENT_GCODE             (uint8_t)0   /*!< G-code written to #gCodeRingBuffer. Value: number of g-codes waiting */
+#define TRACE_EVENT_LINE              (uint8_t)1   /*!< Line movement started by #MotionPlanner::addLineMovement or #MotionPlanner::flushLineMovement. Value: duration [cycles] */
+#define TRACE_EVENT_STEP              (uint8_t)2   /*!< Step interrupt which had a block to execute. Value: duration [cycles] */
+#define TRACE_EVENT_RINGBUFFER_WRITE  (uint8_t)3   /*!< Element written. Object: ring buffer, value: number of elements afterwards */
+#define TRACE_EVENT_RINGBUFFER_READ   (uint8_t)4   /*!< Element read. Object: ring buffer, value: number of elements afterwards */
+#define TRACE_EVENT_RINGBUFFER_FULL   (uint8_t)5   /*!< Element not written because the ring buffer is full. Object: ring buffer */
+
+/**
+ * \brief Records an event if tracing is enabled
+ *
+ * Expands to nothing if tracing is disabled, thus, arguments are not
+ * evaluated then.
+ * @param[in] level Lowest #TRACE_ENABLE the event is recorded with
+ * @param[in] event One of TRACE_EVENT_...
+ * @param[in] object Address of the object the event belongs to or NULL
+ * @param[in] value Value of the event, see TRACE_EVENT_...
+ */
+#if (TRACE_ENABLE)
+#define TRACE(level, event, object, value) \
+  do \
+    { \
+      if ((TRACE_ENABLE) >= (level)) \
+        { \
+          Trace_record((event), (object), (uint32_t)(value)); \
+        } \
+    } \
+  while (0)
+#else
+#define TRACE(level, event, object, value)
+#endif
+
+/**
+ * \brief Takes the start time of a span if tracing is enabled
+ *
+ * Declares the local variable start. Calls which turn out to have done
+ * nothing, e.g. polls, can so be left out of the trace.
+ * @param[in] start Name of the variable
+ */
+#if (TRACE_ENABLE)
+#define TRACE_SPAN_START(start)       uint64_t start = Platform_timeCycles()
+#else
+#define TRACE_SPAN_START(start)
+#endif
+
+/**
+ * \brief Records the end of a span started by #TRACE_SPAN_START
+ *
+ * The record holds the end time, its value the duration.
+ * @param[in] level Lowest #TRACE_ENABLE the event is recorded with
+ * @param[in] event One of TRACE_EVENT_...
+ * @param[in] start Variable given to #TRACE_SPAN_START
+ */
+#define TRACE_SPAN(level, event, start) TRACE(level, event, NULL, Platform_timeCycles() - (start))
+
+/* ******************| Type definitions |****************************** */
+/**
+ * One recorded event
+ */
+typedef struct {
+    uint64_t time;                           /*!< Time stamp [cycles], see #Platform_timeCycles */
+    uint32_t value;                          /*!< Value depending on the event */
+    uint16_t object;                         /*!< Lowest 16 bit of the address of the object, zero for none */
+    uint8_t event;                           /*!< One of TRACE_EVENT_... */
+    uint8_t reserved;
+} Trace_Record_t;
+
+/**
+ * Name of an object
+ */
+typedef struct {
+    uint16_t object;                         /*!< Lowest 16 bit of the address */
+    char name[TRACE_NAME_LENGTH];            /*!< Zero terminated name */
+} Trace_Name_t;
+
+/**
+ * Header of a dump. Followed by #records records, the oldest first.
+ * Cycles are converted to time with the two pairs of time stamps.
+ */
+typedef struct {
+    char magic[4];                           /*!< "BMTR" */
+    uint16_t version;                        /*!< #TRACE_VERSION */
+    uint16_t recordSize;                     /*!< Size of #Trace_Record_t */
+    uint32_t records;                        /*!< Number of records following */
+    uint32_t lostRecords;                    /*!< Number of records overwritten before the dump */
+    uint64_t startCycles;                    /*!< #Platform_timeCycles during #Trace_init */
+    uint64_t startMicros;                    /*!< #Platform_timeMicros during #Trace_init */
+    uint64_t endCycles;                      /*!< #Platform_timeCycles during #Trace_header */
+    uint64_t endMicros;                      /*!< #Platform_timeMicros during #Trace_header */
+    uint16_t headerSize;                     /*!< Size of the header, the records start behind */
+    uint8_t names;                           /*!< Number of valid entries in #name */
+    uint8_t reserved[5];
+    Trace_Name_t name[TRACE_MAX_NAMES];      /*!< Names of objects */
+} Trace_Header_t;
+
+/* ******************| External function declarations |**************** */
+extern void Trace_init(void);
+extern void Trace_name(const void *object, const char *name);
+extern void Trace_header(Trace_Header_t *header);
+extern const Trace_Record_t *Trace_get(uint32_t index);
+
+/* ******************| External constants |**************************** */
+
+/* ******************| External variables |**************************** */
+extern Trace_Record_t Trace_buffer[TRACE_BUFFER_SIZE];
+extern uint32_t Trace_head;
+
+/* ******************| Inline functions |****************************** */
+/**
+ * \brief Records one event
+ *
+ * Each caller reserves its own record with an atomic increment of
+ * #Trace_head. Thus, interrupts and threads may record concurrently.
+ * Use #TRACE instead of calling this function directly.
+ * @param[in] event One of TRACE_EVENT_...
+ * @param[in] object Address of the object the event belongs to or NULL
+ * @param[in] value Value of the event
+ */
+static inline void Trace_record(uint8_t event, const void *object, uint32_t value)
+{
+  Trace_Record_t *record = &Trace_buffer[__atomic_fetch_add(&Trace_head, 1, __ATOMIC_RELAXED) & (TRACE_BUFFER_SIZE - 1)];
+
+  record->time = Platform_timeCycles();
+  record->value = value;
+  record->object = (uint16_t)(__UINTPTR_TYPE__)object;
+  record->event = event;
+}
+
+/** @} doxygen end group definition */
+#endif /* if !defined( TRACE_INCLUDE_TRACE_H_ ) */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,149 @@
+/**
+ * BlueMarlin 3D Printer Firmware
+ * Copyright (C) 2016 BlueMarlinFirmware [https://github.com/kein0r/BlueMarlin]
+ *
+ * Based on Marlin, Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * \brief Trace source file
+ *
+ * GNU coding standard (https://www.gnu.org/prep/standards/) shall be
+ * followed beside the snake_case_thing. Please use camelCase instead.
+ *
+ * #Trace_head counts all events ever recorded. The record of an event
+ * is the count modulo #TRACE_BUFFER_SIZE, thus, the oldest records are
+ * overwritten. A dump shall only be taken while no event is recorded,
+ * e.g. at exit.
+ * Nothing is compiled if #TRACE_ENABLE is not set.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+/** \addtogroup Trace
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <string.h>
+#include "trace.h"
+
+#if (TRACE_ENABLE)
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+void Trace_init(void);
+void Trace_name(const void *object, const char *name);
+void Trace_header(Trace_Header_t *header);
+const Trace_Record_t *Trace_get(uint32_t index);
+
+/* ******************| Global Variables |****************************** */
+static_assert(!(TRACE_BUFFER_SIZE & (TRACE_BUFFER_SIZE - 1)), "TRACE_BUFFER_SIZE must be a power of two");
+static_assert(sizeof(Trace_Record_t) == 16, "Trace_Record_t must have the same size on all platforms");
+
+/**
+ * Recorded events
+ */
+Trace_Record_t Trace_buffer[TRACE_BUFFER_SIZE];
+
+/**
+ * Number of events recorded since #Trace_init
+ */
+uint32_t Trace_head = 0;
+
+/**
+ * Time stamps and names, completed by #Trace_header
+ */
+static Trace_Header_t Trace_state;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Initializes Trace module
+ *
+ * Drops all records and names and takes the first pair of time stamps.
+ */
+void Trace_init(void)
+{
+  memset(&Trace_state, 0, sizeof(Trace_state));
+  Trace_state.startCycles = Platform_timeCycles();
+  Trace_state.startMicros = Platform_timeMicros();
+  __atomic_store_n(&Trace_head, 0, __ATOMIC_RELAXED);
+}
+
+/**
+ * \brief Names an object, e.g. a ring buffer, for the decoder
+ *
+ * Names exceeding #TRACE_NAME_LENGTH are truncated, objects exceeding
+ * #TRACE_MAX_NAMES stay unnamed.
+ * @param[in] object Address of the object as passed to #TRACE
+ * @param[in] name Name
+ */
+void Trace_name(const void *object, const char *name)
+{
+  Trace_Name_t *entry;
+
+  if (Trace_state.names >= TRACE_MAX_NAMES)
+    {
+      return;
+    }
+  entry = &Trace_state.name[Trace_state.names++];
+  entry->object = (uint16_t)(__UINTPTR_TYPE__)object;
+  strncpy(entry->name, name, TRACE_NAME_LENGTH - 1);
+}
+
+/**
+ * \brief Returns the header of a dump
+ *
+ * Takes the second pair of time stamps.
+ * @param[out] header Header to be written before the records
+ */
+void Trace_header(Trace_Header_t *header)
+{
+  uint32_t head = __atomic_load_n(&Trace_head, __ATOMIC_RELAXED);
+
+  *header = Trace_state;
+  memcpy(header->magic, "BMTR", sizeof(header->magic));
+  header->version = TRACE_VERSION;
+  header->recordSize = sizeof(Trace_Record_t);
+  header->headerSize = sizeof(Trace_Header_t);
+  header->records = min(head, TRACE_BUFFER_SIZE);
+  header->lostRecords = head - header->records;
+  header->endCycles = Platform_timeCycles();
+  header->endMicros = Platform_timeMicros();
+}
+
+/**
+ * \brief Returns one record of a dump
+ *
+ * @param[in] index Index of the record, 0 is the oldest one
+ * @return Record
+ * @pre index is lower than records of #Trace_header
+ */
+const Trace_Record_t *Trace_get(uint32_t index)
+{
+  uint32_t head = __atomic_load_n(&Trace_head, __ATOMIC_RELAXED);
+
+  return &Trace_buffer[(head - min(head, TRACE_BUFFER_SIZE) + index) & (TRACE_BUFFER_SIZE - 1)];
+}
+
+#endif /* if (TRACE_ENABLE) */
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
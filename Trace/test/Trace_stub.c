@@ -0,0 +1,66 @@
+/**
+ * \file Trace_stub.c
+ *
+ * \brief Stubs for Trace unit tests
+ *
+ * All stubs needed for the unit test of this particular modules shall
+ * be done within this file.
+ * Both clocks of the platform are replaced by variables set by the
+ * tests. Reading the cycle counter advances it by one, thus, every
+ * record gets its own time stamp.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup Trace
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include "Trace_test.h"
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+uint64_t Platform_timeCycles(void);
+uint64_t Platform_timeMicros(void);
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Virtual cycle counter
+ */
+uint64_t TraceTest_cycles;
+
+/**
+ * Virtual time [µs]
+ */
+uint64_t TraceTest_micros;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Virtual replacement of Platform_timeCycles()
+ *
+ * @return #TraceTest_cycles before it is incremented
+ */
+uint64_t Platform_timeCycles(void)
+{
+  return TraceTest_cycles++;
+}
+
+/**
+ * \brief Virtual replacement of Platform_timeMicros()
+ *
+ * @return #TraceTest_micros
+ */
+uint64_t Platform_timeMicros(void)
+{
+  return TraceTest_micros;
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,173 @@
+/**
+ * \file Trace_test.c
+ *
+ * \brief Trace unit test implementation
+ *
+ * Please see http://embunit.sourceforge.net/ for more information. For
+ * detailed documentation see http://embunit.sourceforge.net/embunit/index.html
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+
+/** \addtogroup Trace
+ * @{
+ */
+
+/* ******************| Inclusions |************************************ */
+#include "Trace_test.h"
+#include <ringBuffer.h>
+/* Include .cpp file to be tested in order to get access to all private
+ * or static functions */
+#include "../src/trace.cpp"
+
+/* ******************| Macros |**************************************** */
+
+/* ******************| Type Definitions |****************************** */
+
+/* ******************| Function Prototypes |*************************** */
+
+/* ******************| Global Variables |****************************** */
+
+/* ******************| Function Implementation |*********************** */
+
+/**
+ * Record and dump
+ * Test if events are dumped in order with value, object and time stamp
+ * Test if the header holds both pairs of time stamps and the names
+ */
+static void Trace_Trace_record_1(void)
+{
+  Trace_Header_t header;
+  uint8_t object = 0;
+
+  Trace_name(&object, "object");
+  TRACE(1, TRACE_EVENT_GCODE, NULL, 3);
+  TRACE(1, TRACE_EVENT_RINGBUFFER_FULL, &object, 0);
+  TRACE_SPAN_START(start);
+  TraceTest_cycles += 100;
+  TRACE_SPAN(1, TRACE_EVENT_STEP, start);
+
+  TraceTest_micros = 1000;
+  Trace_header(&header);
+  TEST_ASSERT_EQUAL_INT(0, memcmp(header.magic, "BMTR", 4));
+  TEST_ASSERT_EQUAL_INT(TRACE_VERSION, header.version);
+  TEST_ASSERT_EQUAL_INT(sizeof(Trace_Record_t), header.recordSize);
+  TEST_ASSERT_EQUAL_INT(sizeof(Trace_Header_t), header.headerSize);
+  TEST_ASSERT_EQUAL_INT(3, header.records);
+  TEST_ASSERT_EQUAL_INT(0, header.lostRecords);
+  TEST_ASSERT_EQUAL_INT(10, header.startCycles);
+  TEST_ASSERT_EQUAL_INT(500, header.startMicros);
+  TEST_ASSERT_EQUAL_INT(116, header.endCycles);
+  TEST_ASSERT_EQUAL_INT(1000, header.endMicros);
+  TEST_ASSERT_EQUAL_INT(1, header.names);
+  TEST_ASSERT_EQUAL_INT((uint16_t)(__UINTPTR_TYPE__)&object, header.name[0].object);
+  TEST_ASSERT_EQUAL_STRING("object", header.name[0].name);
+
+  TEST_ASSERT_EQUAL_INT(TRACE_EVENT_GCODE, Trace_get(0)->event);
+  TEST_ASSERT_EQUAL_INT(3, Trace_get(0)->value);
+  TEST_ASSERT_EQUAL_INT(0, Trace_get(0)->object);
+  TEST_ASSERT_EQUAL_INT(11, Trace_get(0)->time);
+  TEST_ASSERT_EQUAL_INT(TRACE_EVENT_RINGBUFFER_FULL, Trace_get(1)->event);
+  TEST_ASSERT_EQUAL_INT(header.name[0].object, Trace_get(1)->object);
+  /* Span: started at 13, ended at 114 and recorded at 115 */
+  TEST_ASSERT_EQUAL_INT(TRACE_EVENT_STEP, Trace_get(2)->event);
+  TEST_ASSERT_EQUAL_INT(101, Trace_get(2)->value);
+  TEST_ASSERT_EQUAL_INT(115, Trace_get(2)->time);
+}
+
+/**
+ * Overwriting
+ * Test if the ring keeps the newest TRACE_BUFFER_SIZE events, oldest
+ * first, and counts the lost ones
+ */
+static void Trace_Trace_record_2(void)
+{
+  Trace_Header_t header;
+
+  for (uint32_t i=0; i<TRACE_BUFFER_SIZE + 3; i++)
+    {
+      TRACE(1, TRACE_EVENT_GCODE, NULL, i);
+    }
+  Trace_header(&header);
+  TEST_ASSERT_EQUAL_INT(TRACE_BUFFER_SIZE, header.records);
+  TEST_ASSERT_EQUAL_INT(3, header.lostRecords);
+  for (uint32_t i=0; i<TRACE_BUFFER_SIZE; i++)
+    {
+      TEST_ASSERT_EQUAL_INT(i + 3, Trace_get(i)->value);
+    }
+}
+
+/**
+ * Ring buffer probes
+ * Test if writes, reads and writes to a full ring buffer are recorded
+ * with the number of elements afterwards
+ */
+static void Trace_Trace_record_3(void)
+{
+  RingBuffer<uint8_t, 2> ringBuffer;
+  Trace_Header_t header;
+  uint8_t data;
+
+  ringBuffer.write(1);
+  ringBuffer.write(2);
+  ringBuffer.write(3);
+  ringBuffer.read(&data);
+  ringBuffer.read(&data);
+  /* Reading an empty ring buffer is polling and not recorded */
+  ringBuffer.read(&data);
+
+  Trace_header(&header);
+  TEST_ASSERT_EQUAL_INT(5, header.records);
+  TEST_ASSERT_EQUAL_INT(TRACE_EVENT_RINGBUFFER_WRITE, Trace_get(0)->event);
+  TEST_ASSERT_EQUAL_INT(1, Trace_get(0)->value);
+  TEST_ASSERT_EQUAL_INT((uint16_t)(__UINTPTR_TYPE__)&ringBuffer, Trace_get(0)->object);
+  TEST_ASSERT_EQUAL_INT(2, Trace_get(1)->value);
+  TEST_ASSERT_EQUAL_INT(TRACE_EVENT_RINGBUFFER_FULL, Trace_get(2)->event);
+  TEST_ASSERT_EQUAL_INT(TRACE_EVENT_RINGBUFFER_READ, Trace_get(3)->event);
+  TEST_ASSERT_EQUAL_INT(1, Trace_get(3)->value);
+  TEST_ASSERT_EQUAL_INT(0, Trace_get(4)->value);
+}
+
+/**
+ * Test Setup function which is called before all each test case
+ */
+static void setUpTrace(void)
+{
+  TraceTest_cycles = 10;
+  TraceTest_micros = 500;
+  Trace_init();
+}
+
+/**
+ * Test Teardown function which is called for after each test
+ */
+static void tearDownTrace(void)
+{
+}
+
+TestRef Trace_test_RunTests(void)
+{
+  EMB_UNIT_TESTFIXTURES(fixtures) {
+    new_TestFixture("Test case Trace_Trace_record_1", Trace_Trace_record_1),
+    new_TestFixture("Test case Trace_Trace_record_2", Trace_Trace_record_2),
+    new_TestFixture("Test case Trace_Trace_record_3", Trace_Trace_record_3)
+  };
+  EMB_UNIT_TESTCALLER(Trace_tests,"Trace Unit test",setUpTrace,tearDownTrace,fixtures);
+  return (TestRef)&Trace_tests;
+}
+
+/**
+ *
+ */
+int main(void)
+{
+  TestRunner_start();
+  TestRunner_runTest(Trace_test_RunTests());
+  TestRunner_end();
+}
+
+/** @} doxygen end group definition */
+/* ******************| End of file |*********************************** */
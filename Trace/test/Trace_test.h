@@ -1,20 +1,25 @@
-#if (!defined TEMPLATE_TEST_DRV_H_)
+#if (!defined TRACE_TEST_H_)
 /* Preprocessor exclusion definition */
-#define TEMPLATE_TEST_DRV_H_
-/** 
- * \brief Template include file for test driver
+#define TRACE_TEST_H_
+/**
+ * \file Trace_test.h
+ *
+ * \brief Trace include file for test driver
  *
  * \project BlueMarlin
- * \author <FULL NAME>
+ * \author kein0r
  *
  */
 
 
-/** \addtogroup Template_unittest
+/** \addtogroup Trace
  * @{
  */
 
 /* ******************| Inclusions |************************************ */
+#include <embUnit/embUnit.h>
+#include <platform.h>
+#include <trace.h>
 
 /* ******************| Macros |**************************************** */
 
@@ -25,7 +30,9 @@
 /* ******************| External constants |**************************** */
 
 /* ******************| External variables |**************************** */
+extern uint64_t TraceTest_cycles;
+extern uint64_t TraceTest_micros;
 
 /** @} doxygen end group definition */
-#endif /* if !defined( TEMPLATE_TEST_DRV_H_ ) */
+#endif /* if !defined( TRACE_TEST_H_ ) */
 /* ******************| End of file |*********************************** */
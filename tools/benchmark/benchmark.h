@@ -0,0 +1,190 @@
+#if (!defined BENCHMARK_BENCHMARK_H_)
+/* Preprocessor exclusion definition */
+#define BENCHMARK_BENCHMARK_H_
+/**
+ * \file benchmark.h
+ *
+ * \brief Harness of the micro benchmarks on the host
+ *
+ * A case is a function doing a fixed number of operations, e.g. 64 writes
+ * to a ring buffer. It is run #BENCHMARK_WARMUP times to fill caches and
+ * branch predictors and afterwards #BENCHMARK_REPETITIONS times measured.
+ * An optional setup function runs before each repetition and is not
+ * measured. The overhead of taking the time stamps is measured once and
+ * subtracted.
+ * Each case prints one JSON object per line with median and 99th
+ * percentile of the repetitions in ns and cycles per operation. Results
+ * of several runs or benchmarks can therefore simply be concatenated.
+ * Must be included before the module sources, as platform.h defines min
+ * and max as macros.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <algorithm>
+#include <chrono>
+#include <x86intrin.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* ******************| Macros |**************************************** */
+/**
+ * Number of repetitions of each case which are not measured
+ * It's possible to override default by specifying the value during compile
+ * time with -DBENCHMARK_WARMUP 20
+ */
+#ifndef BENCHMARK_WARMUP
+#define BENCHMARK_WARMUP              (uint32_t)20
+#endif
+
+/**
+ * Number of measured repetitions of each case
+ * It's possible to override default by specifying the value during compile
+ * time with -DBENCHMARK_REPETITIONS 500
+ */
+#ifndef BENCHMARK_REPETITIONS
+#define BENCHMARK_REPETITIONS         (uint32_t)500
+#endif
+
+/* ******************| Type definitions |****************************** */
+/**
+ * Time and cycles of one measurement
+ */
+typedef struct
+{
+  double nanoseconds;       /*!< Host time [ns] */
+  double cycles;            /*!< Time stamp counter of the CPU [cycles] */
+} Benchmark_Sample_t;
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Overhead of one measurement, see #Benchmark_measure
+ */
+static Benchmark_Sample_t Benchmark_overhead = {0.0, 0.0};
+
+/**
+ * Sink for results which must not be optimized away
+ */
+static volatile uint32_t Benchmark_sink;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Measures one call of a function
+ *
+ * @param[in] function Function to be called
+ * @return Time and cycles of the call including #Benchmark_overhead
+ */
+template <typename Function> static Benchmark_Sample_t Benchmark_measure(Function function)
+{
+  Benchmark_Sample_t sample;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  uint64_t startCycles = __rdtsc();
+
+  function();
+  sample.cycles = (double)(__rdtsc() - startCycles);
+  sample.nanoseconds = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+  return sample;
+}
+
+/**
+ * \brief Returns a percentile of sorted values
+ *
+ * @param[in] values Values in ascending order
+ * @param[in] count Number of values
+ * @param[in] percentile Percentile, e.g. 50 for the median
+ * @return Smallest value not exceeded by percentile percent of all values
+ */
+static double Benchmark_percentile(const double *values, uint32_t count, uint32_t percentile)
+{
+  uint32_t index = (count * percentile + 99) / 100;
+
+  return values[(index > 0) ? (index - 1) : 0];
+}
+
+/**
+ * \brief Measures the overhead of taking the time stamps
+ *
+ * Must be called once before the first case. The median of many empty
+ * measurements is used.
+ */
+static void Benchmark_init(void)
+{
+  static double nanoseconds[BENCHMARK_REPETITIONS];
+  static double cycles[BENCHMARK_REPETITIONS];
+  Benchmark_Sample_t sample;
+
+  for (uint32_t i=0; i<BENCHMARK_WARMUP + BENCHMARK_REPETITIONS; i++)
+    {
+      sample = Benchmark_measure([]() {});
+      if (i >= BENCHMARK_WARMUP)
+        {
+          nanoseconds[i - BENCHMARK_WARMUP] = sample.nanoseconds;
+          cycles[i - BENCHMARK_WARMUP] = sample.cycles;
+        }
+    }
+  std::sort(nanoseconds, nanoseconds + BENCHMARK_REPETITIONS);
+  std::sort(cycles, cycles + BENCHMARK_REPETITIONS);
+  Benchmark_overhead.nanoseconds = Benchmark_percentile(nanoseconds, BENCHMARK_REPETITIONS, 50);
+  Benchmark_overhead.cycles = Benchmark_percentile(cycles, BENCHMARK_REPETITIONS, 50);
+}
+
+/**
+ * \brief Runs one case and prints its result
+ *
+ * Prints e.g.
+ * {"suite":"RingBuffer","case":"write 1B","operations":64,"repetitions":500,
+ *  "median_ns":1.12,"p99_ns":1.40,"median_cycles":3.6,"p99_cycles":4.5}
+ * @param[in] suite Module under test
+ * @param[in] name Name of the case within the suite
+ * @param[in] operations Number of operations done by each call of function
+ * @param[in] setup Called before each repetition, not measured
+ * @param[in] function Does the operations
+ */
+template <typename Setup, typename Function>
+static void Benchmark_run(const char *suite, const char *name, uint32_t operations, Setup setup, Function function)
+{
+  static double nanoseconds[BENCHMARK_REPETITIONS];
+  static double cycles[BENCHMARK_REPETITIONS];
+  Benchmark_Sample_t sample;
+
+  for (uint32_t i=0; i<BENCHMARK_WARMUP + BENCHMARK_REPETITIONS; i++)
+    {
+      setup();
+      sample = Benchmark_measure(function);
+      if (i >= BENCHMARK_WARMUP)
+        {
+          /* Measurements below the overhead are noise of the overhead */
+          sample.nanoseconds = (sample.nanoseconds > Benchmark_overhead.nanoseconds) ? sample.nanoseconds - Benchmark_overhead.nanoseconds : 0.0;
+          sample.cycles = (sample.cycles > Benchmark_overhead.cycles) ? sample.cycles - Benchmark_overhead.cycles : 0.0;
+          nanoseconds[i - BENCHMARK_WARMUP] = sample.nanoseconds / operations;
+          cycles[i - BENCHMARK_WARMUP] = sample.cycles / operations;
+        }
+    }
+  std::sort(nanoseconds, nanoseconds + BENCHMARK_REPETITIONS);
+  std::sort(cycles, cycles + BENCHMARK_REPETITIONS);
+  printf("{\"suite\":\"%s\",\"case\":\"%s\",\"operations\":%u,\"repetitions\":%u,"
+         "\"median_ns\":%.2f,\"p99_ns\":%.2f,\"median_cycles\":%.1f,\"p99_cycles\":%.1f}\n",
+         suite, name, operations, BENCHMARK_REPETITIONS,
+         Benchmark_percentile(nanoseconds, BENCHMARK_REPETITIONS, 50), Benchmark_percentile(nanoseconds, BENCHMARK_REPETITIONS, 99),
+         Benchmark_percentile(cycles, BENCHMARK_REPETITIONS, 50), Benchmark_percentile(cycles, BENCHMARK_REPETITIONS, 99));
+}
+
+/**
+ * \brief Runs one case without setup and prints its result
+ *
+ * @param[in] suite Module under test
+ * @param[in] name Name of the case within the suite
+ * @param[in] operations Number of operations done by each call of function
+ * @param[in] function Does the operations
+ */
+template <typename Function>
+static void Benchmark_run(const char *suite, const char *name, uint32_t operations, Function function)
+{
+  Benchmark_run(suite, name, operations, []() {}, function);
+}
+
+#endif /* if !defined( BENCHMARK_BENCHMARK_H_ ) */
+/* ******************| End of file |*********************************** */
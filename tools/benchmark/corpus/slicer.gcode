@@ -0,0 +1,1663 @@
+; Benchmark corpus in the layout of PrusaSlicer 2.x output: a 20x20x2 mm
+; hollow square with two perimeters and rectilinear infill. Generated for
+; tools/benchmark/gCodeReaderBenchmark, not printed.
+
+M73 P0 R3
+M201 X1000 Y1000 Z200 E5000 ; sets maximum accelerations, mm/sec^2
+M203 X200 Y200 Z12 E120 ; sets maximum feedrates, mm / sec
+M204 P1250 R1250 T1250 ; sets acceleration (P, T) and retract acceleration (R), mm/sec^2
+M205 X8.00 Y8.00 Z0.40 E4.50 ; sets the jerk limits, mm/sec
+M107
+M190 S60 ; set bed temperature and wait for it to be reached
+M104 S215 ; set temperature
+G28 ; home all axes
+G1 Z5 F5000 ; lift nozzle
+M109 S215 ; set temperature and wait for it to be reached
+G21 ; set units to millimeters
+G90 ; use absolute coordinates
+M82 ; use absolute distances for extrusion
+G92 E0
+G1 Z.2 F7800
+G1 E-.8 F2100
+;LAYER_CHANGE
+;TYPE:Perimeter
+;WIDTH:0.45
+G1 X90.000 Y90.000 F10800
+G1 E0.00000 F2100
+G1 F1800
+G1 X92.497 Y90.003 E0.08315
+G1 X95.002 Y89.998 E0.16630
+G1 X97.500 Y90.000 E0.24945
+G1 X100.001 Y90.002 E0.33260
+G1 X102.497 Y89.996 E0.41575
+G1 X105.003 Y89.999 E0.49890
+G1 X107.502 Y89.996 E0.58205
+G1 X110.000 Y90.002 E0.66520
+G1 X109.998 Y92.504 E0.74835
+G1 X110.003 Y94.996 E0.83150
+G1 X109.996 Y97.500 E0.91465
+G1 X110.004 Y99.999 E0.99780
+G1 X109.998 Y102.499 E1.08095
+G1 X109.996 Y104.998 E1.16410
+G1 X110.000 Y107.500 E1.24725
+G1 X109.998 Y109.998 E1.33040
+G1 X107.498 Y110.000 E1.41355
+G1 X104.998 Y109.996 E1.49670
+G1 X102.503 Y110.000 E1.57985
+G1 X100.001 Y109.997 E1.66300
+G1 X97.504 Y110.003 E1.74615
+G1 X94.997 Y109.999 E1.82930
+G1 X92.502 Y110.002 E1.91245
+G1 X90.003 Y109.999 E1.99560
+G1 X90.003 Y107.501 E2.07875
+G1 X89.998 Y105.001 E2.16190
+G1 X90.003 Y102.503 E2.24505
+G1 X90.000 Y100.001 E2.32820
+G1 X89.996 Y97.498 E2.41135
+G1 X90.002 Y94.999 E2.49450
+G1 X89.997 Y92.500 E2.57765
+G1 X90.002 Y90.001 E2.66080
+G1 X90.450 Y90.450 F10800
+G1 E2.66080 F2100
+G1 F1800
+G1 X92.836 Y90.450 E2.74021
+G1 X95.225 Y90.452 E2.81962
+G1 X97.613 Y90.449 E2.89902
+G1 X100.000 Y90.446 E2.97843
+G1 X102.384 Y90.452 E3.05784
+G1 X104.779 Y90.451 E3.13725
+G1 X107.162 Y90.447 E3.21666
+G1 X109.550 Y90.454 E3.29607
+G1 X109.552 Y92.838 E3.37547
+G1 X109.553 Y95.223 E3.45488
+G1 X109.550 Y97.616 E3.53429
+G1 X109.551 Y100.000 E3.61370
+G1 X109.548 Y102.388 E3.69311
+G1 X109.554 Y104.771 E3.77252
+G1 X109.552 Y107.165 E3.85192
+G1 X109.553 Y109.552 E3.93133
+G1 X107.165 Y109.550 E4.01074
+G1 X104.775 Y109.549 E4.09015
+G1 X102.384 Y109.553 E4.16956
+G1 X100.001 Y109.548 E4.24897
+G1 X97.613 Y109.550 E4.32837
+G1 X95.224 Y109.549 E4.40778
+G1 X92.838 Y109.551 E4.48719
+G1 X90.451 Y109.550 E4.56660
+G1 X90.446 Y107.160 E4.64601
+G1 X90.447 Y104.776 E4.72541
+G1 X90.453 Y102.390 E4.80482
+G1 X90.452 Y100.003 E4.88423
+G1 X90.448 Y97.615 E4.96364
+G1 X90.451 Y95.222 E5.04305
+G1 X90.446 Y92.834 E5.12246
+G1 X90.452 Y90.448 E5.20186
+;TYPE:Internal infill
+;WIDTH:0.45
+G1 E4.40186 F2100
+G1 X91.000 Y91.000 F10800
+G1 E5.20186 F2100
+G1 F2400
+G1 X109.000 Y91.000 E5.80054
+G1 X109.000 Y91.450 E5.81551
+G1 X91.000 Y91.450 E6.41419
+G1 X91.000 Y91.900 E6.42916
+G1 X109.000 Y91.900 E7.02784
+G1 X109.000 Y92.350 E7.04281
+G1 X91.000 Y92.350 E7.64149
+G1 X91.000 Y92.800 E7.65645
+G1 X109.000 Y92.800 E8.25513
+G1 X109.000 Y93.250 E8.27010
+G1 X91.000 Y93.250 E8.86878
+G1 X91.000 Y93.700 E8.88375
+G1 X109.000 Y93.700 E9.48243
+G1 X109.000 Y94.150 E9.49739
+G1 X91.000 Y94.150 E10.09607
+G1 X91.000 Y94.600 E10.11104
+G1 X109.000 Y94.600 E10.70972
+G1 X109.000 Y95.050 E10.72469
+G1 X91.000 Y95.050 E11.32337
+G1 X91.000 Y95.500 E11.33833
+G1 X109.000 Y95.500 E11.93701
+G1 X109.000 Y95.950 E11.95198
+G1 X91.000 Y95.950 E12.55066
+G1 X91.000 Y96.400 E12.56563
+G1 X109.000 Y96.400 E13.16431
+G1 X109.000 Y96.850 E13.17928
+G1 X91.000 Y96.850 E13.77796
+G1 X91.000 Y97.300 E13.79292
+G1 X109.000 Y97.300 E14.39160
+G1 X109.000 Y97.750 E14.40657
+G1 X91.000 Y97.750 E15.00525
+G1 X91.000 Y98.200 E15.02022
+G1 X109.000 Y98.200 E15.61890
+G1 X109.000 Y98.650 E15.63386
+G1 X91.000 Y98.650 E16.23254
+G1 X91.000 Y99.100 E16.24751
+G1 X109.000 Y99.100 E16.84619
+G1 X109.000 Y99.550 E16.86116
+G1 X91.000 Y99.550 E17.45984
+G1 X91.000 Y100.000 E17.47480
+G1 X109.000 Y100.000 E18.07348
+G1 X109.000 Y100.450 E18.08845
+G1 X91.000 Y100.450 E18.68713
+G1 X91.000 Y100.900 E18.70210
+G1 X109.000 Y100.900 E19.30078
+G1 X109.000 Y101.350 E19.31575
+G1 X91.000 Y101.350 E19.91443
+G1 X91.000 Y101.800 E19.92939
+G1 X109.000 Y101.800 E20.52807
+G1 X109.000 Y102.250 E20.54304
+G1 X91.000 Y102.250 E21.14172
+G1 X91.000 Y102.700 E21.15669
+G1 X109.000 Y102.700 E21.75537
+G1 X109.000 Y103.150 E21.77033
+G1 X91.000 Y103.150 E22.36901
+G1 X91.000 Y103.600 E22.38398
+G1 X109.000 Y103.600 E22.98266
+G1 X109.000 Y104.050 E22.99763
+G1 X91.000 Y104.050 E23.59631
+G1 X91.000 Y104.500 E23.61127
+G1 X109.000 Y104.500 E24.20995
+G1 X109.000 Y104.950 E24.22492
+G1 X91.000 Y104.950 E24.82360
+G1 X91.000 Y105.400 E24.83857
+G1 X109.000 Y105.400 E25.43725
+G1 X109.000 Y105.850 E25.45222
+G1 X91.000 Y105.850 E26.05090
+G1 X91.000 Y106.300 E26.06586
+G1 X109.000 Y106.300 E26.66454
+G1 X109.000 Y106.750 E26.67951
+G1 X91.000 Y106.750 E27.27819
+G1 X91.000 Y107.200 E27.29316
+G1 X109.000 Y107.200 E27.89184
+G1 X109.000 Y107.650 E27.90680
+G1 X91.000 Y107.650 E28.50548
+G1 X91.000 Y108.100 E28.52045
+G1 X109.000 Y108.100 E29.11913
+G1 X109.000 Y108.550 E29.13410
+G1 X91.000 Y108.550 E29.73278
+M106 S0
+M73 P0 R3
+;LAYER_CHANGE
+;Z:0.4
+;HEIGHT:0.2
+G1 E28.93278 F2100
+G1 Z0.400 F7800
+;TYPE:Perimeter
+;WIDTH:0.45
+G1 X90.000 Y90.000 F10800
+G1 E29.73278 F2100
+G1 F1800
+G1 X92.497 Y90.001 E29.81593
+G1 X94.999 Y89.997 E29.89908
+G1 X97.497 Y90.000 E29.98223
+G1 X99.997 Y89.998 E30.06538
+G1 X102.502 Y90.000 E30.14853
+G1 X104.999 Y90.000 E30.23168
+G1 X107.496 Y89.999 E30.31483
+G1 X109.999 Y89.998 E30.39798
+G1 X109.997 Y92.503 E30.48113
+G1 X110.000 Y94.998 E30.56428
+G1 X110.001 Y97.503 E30.64743
+G1 X109.996 Y99.996 E30.73058
+G1 X109.997 Y102.502 E30.81373
+G1 X109.997 Y105.002 E30.89688
+G1 X110.001 Y107.500 E30.98003
+G1 X109.998 Y110.004 E31.06318
+G1 X107.502 Y110.000 E31.14633
+G1 X104.998 Y110.001 E31.22948
+G1 X102.499 Y110.001 E31.31263
+G1 X99.999 Y110.001 E31.39578
+G1 X97.496 Y109.998 E31.47893
+G1 X95.004 Y110.003 E31.56208
+G1 X92.498 Y110.003 E31.64523
+G1 X89.998 Y110.004 E31.72838
+G1 X90.002 Y107.499 E31.81153
+G1 X89.998 Y104.996 E31.89468
+G1 X90.003 Y102.496 E31.97783
+G1 X90.003 Y100.004 E32.06098
+G1 X90.001 Y97.497 E32.14413
+G1 X90.003 Y95.004 E32.22728
+G1 X90.002 Y92.500 E32.31043
+G1 X89.999 Y89.999 E32.39358
+G1 X90.450 Y90.450 F10800
+G1 E32.39358 F2100
+G1 F1800
+G1 X92.835 Y90.451 E32.47299
+G1 X95.224 Y90.448 E32.55239
+G1 X97.609 Y90.451 E32.63180
+G1 X99.998 Y90.450 E32.71121
+G1 X102.386 Y90.453 E32.79062
+G1 X104.778 Y90.446 E32.87003
+G1 X107.160 Y90.449 E32.94943
+G1 X109.554 Y90.452 E33.02884
+G1 X109.549 Y92.835 E33.10825
+G1 X109.551 Y95.228 E33.18766
+G1 X109.553 Y97.611 E33.26707
+G1 X109.553 Y100.001 E33.34648
+G1 X109.550 Y102.391 E33.42588
+G1 X109.548 Y104.777 E33.50529
+G1 X109.547 Y107.160 E33.58470
+G1 X109.553 Y109.548 E33.66411
+G1 X107.165 Y109.551 E33.74352
+G1 X104.778 Y109.549 E33.82293
+G1 X102.386 Y109.548 E33.90233
+G1 X100.003 Y109.551 E33.98174
+G1 X97.616 Y109.553 E34.06115
+G1 X95.222 Y109.550 E34.14056
+G1 X92.834 Y109.546 E34.21997
+G1 X90.447 Y109.553 E34.29938
+G1 X90.452 Y107.165 E34.37878
+G1 X90.449 Y104.776 E34.45819
+G1 X90.452 Y102.387 E34.53760
+G1 X90.451 Y99.998 E34.61701
+G1 X90.447 Y97.611 E34.69642
+G1 X90.453 Y95.226 E34.77582
+G1 X90.453 Y92.837 E34.85523
+G1 X90.448 Y90.452 E34.93464
+;TYPE:Internal infill
+;WIDTH:0.45
+G1 E34.13464 F2100
+G1 X91.000 Y91.000 F10800
+G1 E34.93464 F2100
+G1 F2400
+G1 X109.000 Y91.000 E35.53332
+G1 X109.000 Y91.450 E35.54829
+G1 X91.000 Y91.450 E36.14697
+G1 X91.000 Y91.900 E36.16194
+G1 X109.000 Y91.900 E36.76062
+G1 X109.000 Y92.350 E36.77558
+G1 X91.000 Y92.350 E37.37426
+G1 X91.000 Y92.800 E37.38923
+G1 X109.000 Y92.800 E37.98791
+G1 X109.000 Y93.250 E38.00288
+G1 X91.000 Y93.250 E38.60156
+G1 X91.000 Y93.700 E38.61652
+G1 X109.000 Y93.700 E39.21520
+G1 X109.000 Y94.150 E39.23017
+G1 X91.000 Y94.150 E39.82885
+G1 X91.000 Y94.600 E39.84382
+G1 X109.000 Y94.600 E40.44250
+G1 X109.000 Y95.050 E40.45746
+G1 X91.000 Y95.050 E41.05614
+G1 X91.000 Y95.500 E41.07111
+G1 X109.000 Y95.500 E41.66979
+G1 X109.000 Y95.950 E41.68476
+G1 X91.000 Y95.950 E42.28344
+G1 X91.000 Y96.400 E42.29841
+G1 X109.000 Y96.400 E42.89709
+G1 X109.000 Y96.850 E42.91205
+G1 X91.000 Y96.850 E43.51073
+G1 X91.000 Y97.300 E43.52570
+G1 X109.000 Y97.300 E44.12438
+G1 X109.000 Y97.750 E44.13935
+G1 X91.000 Y97.750 E44.73803
+G1 X91.000 Y98.200 E44.75299
+G1 X109.000 Y98.200 E45.35167
+G1 X109.000 Y98.650 E45.36664
+G1 X91.000 Y98.650 E45.96532
+G1 X91.000 Y99.100 E45.98029
+G1 X109.000 Y99.100 E46.57897
+G1 X109.000 Y99.550 E46.59393
+G1 X91.000 Y99.550 E47.19261
+G1 X91.000 Y100.000 E47.20758
+G1 X109.000 Y100.000 E47.80626
+G1 X109.000 Y100.450 E47.82123
+G1 X91.000 Y100.450 E48.41991
+G1 X91.000 Y100.900 E48.43488
+G1 X109.000 Y100.900 E49.03356
+G1 X109.000 Y101.350 E49.04852
+G1 X91.000 Y101.350 E49.64720
+G1 X91.000 Y101.800 E49.66217
+G1 X109.000 Y101.800 E50.26085
+G1 X109.000 Y102.250 E50.27582
+G1 X91.000 Y102.250 E50.87450
+G1 X91.000 Y102.700 E50.88946
+G1 X109.000 Y102.700 E51.48814
+G1 X109.000 Y103.150 E51.50311
+G1 X91.000 Y103.150 E52.10179
+G1 X91.000 Y103.600 E52.11676
+G1 X109.000 Y103.600 E52.71544
+G1 X109.000 Y104.050 E52.73040
+G1 X91.000 Y104.050 E53.32908
+G1 X91.000 Y104.500 E53.34405
+G1 X109.000 Y104.500 E53.94273
+G1 X109.000 Y104.950 E53.95770
+G1 X91.000 Y104.950 E54.55638
+G1 X91.000 Y105.400 E54.57135
+G1 X109.000 Y105.400 E55.17003
+G1 X109.000 Y105.850 E55.18499
+G1 X91.000 Y105.850 E55.78367
+G1 X91.000 Y106.300 E55.79864
+G1 X109.000 Y106.300 E56.39732
+G1 X109.000 Y106.750 E56.41229
+G1 X91.000 Y106.750 E57.01097
+G1 X91.000 Y107.200 E57.02593
+G1 X109.000 Y107.200 E57.62461
+G1 X109.000 Y107.650 E57.63958
+G1 X91.000 Y107.650 E58.23826
+G1 X91.000 Y108.100 E58.25323
+G1 X109.000 Y108.100 E58.85191
+G1 X109.000 Y108.550 E58.86687
+G1 X91.000 Y108.550 E59.46555
+M106 S40
+M73 P5 R3
+;LAYER_CHANGE
+;Z:0.6
+;HEIGHT:0.2
+G1 E58.66555 F2100
+G1 Z0.600 F7800
+;TYPE:Perimeter
+;WIDTH:0.45
+G1 X90.000 Y90.000 F10800
+G1 E59.46555 F2100
+G1 F1800
+G1 X92.503 Y89.996 E59.54870
+G1 X95.001 Y89.997 E59.63185
+G1 X97.497 Y90.003 E59.71500
+G1 X99.996 Y89.998 E59.79815
+G1 X102.504 Y89.999 E59.88130
+G1 X104.997 Y89.997 E59.96445
+G1 X107.498 Y90.002 E60.04760
+G1 X109.997 Y90.003 E60.13075
+G1 X109.999 Y92.504 E60.21390
+G1 X110.003 Y94.998 E60.29705
+G1 X109.998 Y97.500 E60.38020
+G1 X109.997 Y100.001 E60.46335
+G1 X109.996 Y102.496 E60.54650
+G1 X110.004 Y104.998 E60.62965
+G1 X110.001 Y107.500 E60.71280
+G1 X109.999 Y109.997 E60.79595
+G1 X107.503 Y110.004 E60.87910
+G1 X105.004 Y109.997 E60.96225
+G1 X102.498 Y110.001 E61.04540
+G1 X100.004 Y110.000 E61.12855
+G1 X97.502 Y110.001 E61.21170
+G1 X94.998 Y110.000 E61.29485
+G1 X92.498 Y109.998 E61.37800
+G1 X89.997 Y109.998 E61.46115
+G1 X90.004 Y107.500 E61.54430
+G1 X90.001 Y105.001 E61.62745
+G1 X90.004 Y102.499 E61.71060
+G1 X89.998 Y99.999 E61.79375
+G1 X89.999 Y97.503 E61.87690
+G1 X90.003 Y94.998 E61.96005
+G1 X89.999 Y92.500 E62.04320
+G1 X90.001 Y90.001 E62.12635
+G1 X90.450 Y90.450 F10800
+G1 E62.12635 F2100
+G1 F1800
+G1 X92.835 Y90.446 E62.20576
+G1 X95.223 Y90.447 E62.28517
+G1 X97.613 Y90.447 E62.36458
+G1 X99.997 Y90.451 E62.44399
+G1 X102.386 Y90.452 E62.52340
+G1 X104.775 Y90.453 E62.60280
+G1 X107.160 Y90.450 E62.68221
+G1 X109.552 Y90.447 E62.76162
+G1 X109.554 Y92.835 E62.84103
+G1 X109.552 Y95.229 E62.92044
+G1 X109.553 Y97.611 E62.99984
+G1 X109.547 Y100.000 E63.07925
+G1 X109.553 Y102.386 E63.15866
+G1 X109.553 Y104.772 E63.23807
+G1 X109.553 Y107.159 E63.31748
+G1 X109.549 Y109.553 E63.39689
+G1 X107.165 Y109.553 E63.47629
+G1 X104.778 Y109.552 E63.55570
+G1 X102.389 Y109.547 E63.63511
+G1 X99.999 Y109.547 E63.71452
+G1 X97.614 Y109.551 E63.79393
+G1 X95.223 Y109.547 E63.87334
+G1 X92.841 Y109.552 E63.95274
+G1 X90.450 Y109.550 E64.03215
+G1 X90.453 Y107.162 E64.11156
+G1 X90.449 Y104.774 E64.19097
+G1 X90.448 Y102.384 E64.27038
+G1 X90.451 Y99.999 E64.34979
+G1 X90.451 Y97.609 E64.42919
+G1 X90.449 Y95.222 E64.50860
+G1 X90.447 Y92.836 E64.58801
+G1 X90.453 Y90.449 E64.66742
+;TYPE:Internal infill
+;WIDTH:0.45
+G1 E63.86742 F2100
+G1 X91.000 Y91.000 F10800
+G1 E64.66742 F2100
+G1 F2400
+G1 X109.000 Y91.000 E65.26610
+G1 X109.000 Y91.450 E65.28107
+G1 X91.000 Y91.450 E65.87975
+G1 X91.000 Y91.900 E65.89471
+G1 X109.000 Y91.900 E66.49339
+G1 X109.000 Y92.350 E66.50836
+G1 X91.000 Y92.350 E67.10704
+G1 X91.000 Y92.800 E67.12201
+G1 X109.000 Y92.800 E67.72069
+G1 X109.000 Y93.250 E67.73565
+G1 X91.000 Y93.250 E68.33433
+G1 X91.000 Y93.700 E68.34930
+G1 X109.000 Y93.700 E68.94798
+G1 X109.000 Y94.150 E68.96295
+G1 X91.000 Y94.150 E69.56163
+G1 X91.000 Y94.600 E69.57659
+G1 X109.000 Y94.600 E70.17527
+G1 X109.000 Y95.050 E70.19024
+G1 X91.000 Y95.050 E70.78892
+G1 X91.000 Y95.500 E70.80389
+G1 X109.000 Y95.500 E71.40257
+G1 X109.000 Y95.950 E71.41754
+G1 X91.000 Y95.950 E72.01622
+G1 X91.000 Y96.400 E72.03118
+G1 X109.000 Y96.400 E72.62986
+G1 X109.000 Y96.850 E72.64483
+G1 X91.000 Y96.850 E73.24351
+G1 X91.000 Y97.300 E73.25848
+G1 X109.000 Y97.300 E73.85716
+G1 X109.000 Y97.750 E73.87212
+G1 X91.000 Y97.750 E74.47080
+G1 X91.000 Y98.200 E74.48577
+G1 X109.000 Y98.200 E75.08445
+G1 X109.000 Y98.650 E75.09942
+G1 X91.000 Y98.650 E75.69810
+G1 X91.000 Y99.100 E75.71306
+G1 X109.000 Y99.100 E76.31174
+G1 X109.000 Y99.550 E76.32671
+G1 X91.000 Y99.550 E76.92539
+G1 X91.000 Y100.000 E76.94036
+G1 X109.000 Y100.000 E77.53904
+G1 X109.000 Y100.450 E77.55401
+G1 X91.000 Y100.450 E78.15269
+G1 X91.000 Y100.900 E78.16765
+G1 X109.000 Y100.900 E78.76633
+G1 X109.000 Y101.350 E78.78130
+G1 X91.000 Y101.350 E79.37998
+G1 X91.000 Y101.800 E79.39495
+G1 X109.000 Y101.800 E79.99363
+G1 X109.000 Y102.250 E80.00859
+G1 X91.000 Y102.250 E80.60727
+G1 X91.000 Y102.700 E80.62224
+G1 X109.000 Y102.700 E81.22092
+G1 X109.000 Y103.150 E81.23589
+G1 X91.000 Y103.150 E81.83457
+G1 X91.000 Y103.600 E81.84953
+G1 X109.000 Y103.600 E82.44821
+G1 X109.000 Y104.050 E82.46318
+G1 X91.000 Y104.050 E83.06186
+G1 X91.000 Y104.500 E83.07683
+G1 X109.000 Y104.500 E83.67551
+G1 X109.000 Y104.950 E83.69048
+G1 X91.000 Y104.950 E84.28916
+G1 X91.000 Y105.400 E84.30412
+G1 X109.000 Y105.400 E84.90280
+G1 X109.000 Y105.850 E84.91777
+G1 X91.000 Y105.850 E85.51645
+G1 X91.000 Y106.300 E85.53142
+G1 X109.000 Y106.300 E86.13010
+G1 X109.000 Y106.750 E86.14506
+G1 X91.000 Y106.750 E86.74374
+G1 X91.000 Y107.200 E86.75871
+G1 X109.000 Y107.200 E87.35739
+G1 X109.000 Y107.650 E87.37236
+G1 X91.000 Y107.650 E87.97104
+G1 X91.000 Y108.100 E87.98600
+G1 X109.000 Y108.100 E88.58468
+G1 X109.000 Y108.550 E88.59965
+G1 X91.000 Y108.550 E89.19833
+M106 S80
+M73 P10 R3
+;LAYER_CHANGE
+;Z:0.8
+;HEIGHT:0.2
+G1 E88.39833 F2100
+G1 Z0.800 F7800
+;TYPE:Perimeter
+;WIDTH:0.45
+G1 X90.000 Y90.000 F10800
+G1 E89.19833 F2100
+G1 F1800
+G1 X92.499 Y90.001 E89.28148
+G1 X94.998 Y89.996 E89.36463
+G1 X97.500 Y90.000 E89.44778
+G1 X100.001 Y90.000 E89.53093
+G1 X102.501 Y90.002 E89.61408
+G1 X104.998 Y90.000 E89.69723
+G1 X107.500 Y89.998 E89.78038
+G1 X109.999 Y90.000 E89.86353
+G1 X110.003 Y92.503 E89.94668
+G1 X109.998 Y95.001 E90.02983
+G1 X109.996 Y97.497 E90.11298
+G1 X110.000 Y100.003 E90.19613
+G1 X109.997 Y102.502 E90.27928
+G1 X110.003 Y104.998 E90.36243
+G1 X110.002 Y107.503 E90.44558
+G1 X109.999 Y110.002 E90.52873
+G1 X107.502 Y110.001 E90.61188
+G1 X105.003 Y110.003 E90.69503
+G1 X102.504 Y110.001 E90.77818
+G1 X99.997 Y109.998 E90.86133
+G1 X97.498 Y110.001 E90.94448
+G1 X95.002 Y109.996 E91.02763
+G1 X92.501 Y110.002 E91.11078
+G1 X89.999 Y110.000 E91.19393
+G1 X89.997 Y107.502 E91.27708
+G1 X89.996 Y105.004 E91.36023
+G1 X90.002 Y102.501 E91.44338
+G1 X89.998 Y100.003 E91.52653
+G1 X90.004 Y97.497 E91.60968
+G1 X90.002 Y95.003 E91.69283
+G1 X90.001 Y92.502 E91.77598
+G1 X90.000 Y90.003 E91.85913
+G1 X90.450 Y90.450 F10800
+G1 E91.85913 F2100
+G1 F1800
+G1 X92.841 Y90.449 E91.93854
+G1 X95.227 Y90.449 E92.01795
+G1 X97.610 Y90.449 E92.09736
+G1 X99.997 Y90.453 E92.17676
+G1 X102.391 Y90.447 E92.25617
+G1 X104.776 Y90.449 E92.33558
+G1 X107.159 Y90.448 E92.41499
+G1 X109.548 Y90.452 E92.49440
+G1 X109.546 Y92.835 E92.57381
+G1 X109.550 Y95.221 E92.65321
+G1 X109.551 Y97.613 E92.73262
+G1 X109.553 Y99.998 E92.81203
+G1 X109.548 Y102.388 E92.89144
+G1 X109.548 Y104.776 E92.97085
+G1 X109.548 Y107.164 E93.05025
+G1 X109.552 Y109.552 E93.12966
+G1 X107.166 Y109.550 E93.20907
+G1 X104.775 Y109.553 E93.28848
+G1 X102.390 Y109.551 E93.36789
+G1 X99.999 Y109.548 E93.44730
+G1 X97.609 Y109.552 E93.52670
+G1 X95.222 Y109.552 E93.60611
+G1 X92.838 Y109.554 E93.68552
+G1 X90.452 Y109.554 E93.76493
+G1 X90.447 Y107.163 E93.84434
+G1 X90.451 Y104.773 E93.92375
+G1 X90.450 Y102.386 E94.00315
+G1 X90.450 Y99.996 E94.08256
+G1 X90.450 Y97.612 E94.16197
+G1 X90.448 Y95.224 E94.24138
+G1 X90.452 Y92.839 E94.32079
+G1 X90.450 Y90.451 E94.40020
+;TYPE:Internal infill
+;WIDTH:0.45
+G1 E93.60020 F2100
+G1 X91.000 Y91.000 F10800
+G1 E94.40020 F2100
+G1 F2400
+G1 X109.000 Y91.000 E94.99888
+G1 X109.000 Y91.450 E95.01384
+G1 X91.000 Y91.450 E95.61252
+G1 X91.000 Y91.900 E95.62749
+G1 X109.000 Y91.900 E96.22617
+G1 X109.000 Y92.350 E96.24114
+G1 X91.000 Y92.350 E96.83982
+G1 X91.000 Y92.800 E96.85478
+G1 X109.000 Y92.800 E97.45346
+G1 X109.000 Y93.250 E97.46843
+G1 X91.000 Y93.250 E98.06711
+G1 X91.000 Y93.700 E98.08208
+G1 X109.000 Y93.700 E98.68076
+G1 X109.000 Y94.150 E98.69572
+G1 X91.000 Y94.150 E99.29440
+G1 X91.000 Y94.600 E99.30937
+G1 X109.000 Y94.600 E99.90805
+G1 X109.000 Y95.050 E99.92302
+G1 X91.000 Y95.050 E100.52170
+G1 X91.000 Y95.500 E100.53667
+G1 X109.000 Y95.500 E101.13535
+G1 X109.000 Y95.950 E101.15031
+G1 X91.000 Y95.950 E101.74899
+G1 X91.000 Y96.400 E101.76396
+G1 X109.000 Y96.400 E102.36264
+G1 X109.000 Y96.850 E102.37761
+G1 X91.000 Y96.850 E102.97629
+G1 X91.000 Y97.300 E102.99125
+G1 X109.000 Y97.300 E103.58993
+G1 X109.000 Y97.750 E103.60490
+G1 X91.000 Y97.750 E104.20358
+G1 X91.000 Y98.200 E104.21855
+G1 X109.000 Y98.200 E104.81723
+G1 X109.000 Y98.650 E104.83219
+G1 X91.000 Y98.650 E105.43087
+G1 X91.000 Y99.100 E105.44584
+G1 X109.000 Y99.100 E106.04452
+G1 X109.000 Y99.550 E106.05949
+G1 X91.000 Y99.550 E106.65817
+G1 X91.000 Y100.000 E106.67314
+G1 X109.000 Y100.000 E107.27182
+G1 X109.000 Y100.450 E107.28678
+G1 X91.000 Y100.450 E107.88546
+G1 X91.000 Y100.900 E107.90043
+G1 X109.000 Y100.900 E108.49911
+G1 X109.000 Y101.350 E108.51408
+G1 X91.000 Y101.350 E109.11276
+G1 X91.000 Y101.800 E109.12772
+G1 X109.000 Y101.800 E109.72640
+G1 X109.000 Y102.250 E109.74137
+G1 X91.000 Y102.250 E110.34005
+G1 X91.000 Y102.700 E110.35502
+G1 X109.000 Y102.700 E110.95370
+G1 X109.000 Y103.150 E110.96866
+G1 X91.000 Y103.150 E111.56734
+G1 X91.000 Y103.600 E111.58231
+G1 X109.000 Y103.600 E112.18099
+G1 X109.000 Y104.050 E112.19596
+G1 X91.000 Y104.050 E112.79464
+G1 X91.000 Y104.500 E112.80961
+G1 X109.000 Y104.500 E113.40829
+G1 X109.000 Y104.950 E113.42325
+G1 X91.000 Y104.950 E114.02193
+G1 X91.000 Y105.400 E114.03690
+G1 X109.000 Y105.400 E114.63558
+G1 X109.000 Y105.850 E114.65055
+G1 X91.000 Y105.850 E115.24923
+G1 X91.000 Y106.300 E115.26419
+G1 X109.000 Y106.300 E115.86287
+G1 X109.000 Y106.750 E115.87784
+G1 X91.000 Y106.750 E116.47652
+G1 X91.000 Y107.200 E116.49149
+G1 X109.000 Y107.200 E117.09017
+G1 X109.000 Y107.650 E117.10513
+G1 X91.000 Y107.650 E117.70381
+G1 X91.000 Y108.100 E117.71878
+G1 X109.000 Y108.100 E118.31746
+G1 X109.000 Y108.550 E118.33243
+G1 X91.000 Y108.550 E118.93111
+M106 S120
+M73 P15 R3
+;LAYER_CHANGE
+;Z:1.0
+;HEIGHT:0.2
+G1 E118.13111 F2100
+G1 Z1.000 F7800
+;TYPE:Perimeter
+;WIDTH:0.45
+G1 X90.000 Y90.000 F10800
+G1 E118.93111 F2100
+G1 F1800
+G1 X92.499 Y89.998 E119.01426
+G1 X94.996 Y89.998 E119.09741
+G1 X97.501 Y90.003 E119.18056
+G1 X100.003 Y90.000 E119.26371
+G1 X102.504 Y90.000 E119.34686
+G1 X105.003 Y89.999 E119.43001
+G1 X107.502 Y90.004 E119.51316
+G1 X109.998 Y89.997 E119.59631
+G1 X110.001 Y92.500 E119.67946
+G1 X109.999 Y94.996 E119.76261
+G1 X109.999 Y97.499 E119.84576
+G1 X109.999 Y100.003 E119.92891
+G1 X110.001 Y102.502 E120.01206
+G1 X110.003 Y105.002 E120.09521
+G1 X110.000 Y107.502 E120.17836
+G1 X110.001 Y110.001 E120.26151
+G1 X107.501 Y109.999 E120.34466
+G1 X105.001 Y110.001 E120.42781
+G1 X102.503 Y110.002 E120.51096
+G1 X100.003 Y110.002 E120.59411
+G1 X97.503 Y110.001 E120.67726
+G1 X94.999 Y109.998 E120.76041
+G1 X92.502 Y110.003 E120.84356
+G1 X90.000 Y109.997 E120.92671
+G1 X90.003 Y107.500 E121.00986
+G1 X90.000 Y104.996 E121.09301
+G1 X90.000 Y102.502 E121.17616
+G1 X89.999 Y99.999 E121.25931
+G1 X90.001 Y97.496 E121.34246
+G1 X90.000 Y95.004 E121.42561
+G1 X90.002 Y92.499 E121.50876
+G1 X90.002 Y90.001 E121.59191
+G1 X90.450 Y90.450 F10800
+G1 E121.59191 F2100
+G1 F1800
+G1 X92.835 Y90.448 E121.67132
+G1 X95.228 Y90.448 E121.75072
+G1 X97.609 Y90.453 E121.83013
+G1 X100.000 Y90.449 E121.90954
+G1 X102.388 Y90.452 E121.98895
+G1 X104.772 Y90.451 E122.06836
+G1 X107.164 Y90.453 E122.14777
+G1 X109.548 Y90.451 E122.22717
+G1 X109.548 Y92.838 E122.30658
+G1 X109.547 Y95.227 E122.38599
+G1 X109.553 Y97.611 E122.46540
+G1 X109.548 Y100.004 E122.54481
+G1 X109.552 Y102.390 E122.62422
+G1 X109.546 Y104.778 E122.70362
+G1 X109.551 Y107.161 E122.78303
+G1 X109.549 Y109.552 E122.86244
+G1 X107.165 Y109.548 E122.94185
+G1 X104.776 Y109.547 E123.02126
+G1 X102.391 Y109.550 E123.10066
+G1 X100.003 Y109.552 E123.18007
+G1 X97.613 Y109.548 E123.25948
+G1 X95.225 Y109.547 E123.33889
+G1 X92.835 Y109.552 E123.41830
+G1 X90.449 Y109.552 E123.49771
+G1 X90.448 Y107.164 E123.57711
+G1 X90.452 Y104.773 E123.65652
+G1 X90.447 Y102.387 E123.73593
+G1 X90.450 Y99.997 E123.81534
+G1 X90.447 Y97.609 E123.89475
+G1 X90.451 Y95.228 E123.97416
+G1 X90.448 Y92.834 E124.05356
+G1 X90.452 Y90.453 E124.13297
+;TYPE:Internal infill
+;WIDTH:0.45
+G1 E123.33297 F2100
+G1 X91.000 Y91.000 F10800
+G1 E124.13297 F2100
+G1 F2400
+G1 X109.000 Y91.000 E124.73165
+G1 X109.000 Y91.450 E124.74662
+G1 X91.000 Y91.450 E125.34530
+G1 X91.000 Y91.900 E125.36027
+G1 X109.000 Y91.900 E125.95895
+G1 X109.000 Y92.350 E125.97391
+G1 X91.000 Y92.350 E126.57259
+G1 X91.000 Y92.800 E126.58756
+G1 X109.000 Y92.800 E127.18624
+G1 X109.000 Y93.250 E127.20121
+G1 X91.000 Y93.250 E127.79989
+G1 X91.000 Y93.700 E127.81485
+G1 X109.000 Y93.700 E128.41353
+G1 X109.000 Y94.150 E128.42850
+G1 X91.000 Y94.150 E129.02718
+G1 X91.000 Y94.600 E129.04215
+G1 X109.000 Y94.600 E129.64083
+G1 X109.000 Y95.050 E129.65580
+G1 X91.000 Y95.050 E130.25448
+G1 X91.000 Y95.500 E130.26944
+G1 X109.000 Y95.500 E130.86812
+G1 X109.000 Y95.950 E130.88309
+G1 X91.000 Y95.950 E131.48177
+G1 X91.000 Y96.400 E131.49674
+G1 X109.000 Y96.400 E132.09542
+G1 X109.000 Y96.850 E132.11038
+G1 X91.000 Y96.850 E132.70906
+G1 X91.000 Y97.300 E132.72403
+G1 X109.000 Y97.300 E133.32271
+G1 X109.000 Y97.750 E133.33768
+G1 X91.000 Y97.750 E133.93636
+G1 X91.000 Y98.200 E133.95132
+G1 X109.000 Y98.200 E134.55000
+G1 X109.000 Y98.650 E134.56497
+G1 X91.000 Y98.650 E135.16365
+G1 X91.000 Y99.100 E135.17862
+G1 X109.000 Y99.100 E135.77730
+G1 X109.000 Y99.550 E135.79227
+G1 X91.000 Y99.550 E136.39095
+G1 X91.000 Y100.000 E136.40591
+G1 X109.000 Y100.000 E137.00459
+G1 X109.000 Y100.450 E137.01956
+G1 X91.000 Y100.450 E137.61824
+G1 X91.000 Y100.900 E137.63321
+G1 X109.000 Y100.900 E138.23189
+G1 X109.000 Y101.350 E138.24685
+G1 X91.000 Y101.350 E138.84553
+G1 X91.000 Y101.800 E138.86050
+G1 X109.000 Y101.800 E139.45918
+G1 X109.000 Y102.250 E139.47415
+G1 X91.000 Y102.250 E140.07283
+G1 X91.000 Y102.700 E140.08779
+G1 X109.000 Y102.700 E140.68647
+G1 X109.000 Y103.150 E140.70144
+G1 X91.000 Y103.150 E141.30012
+G1 X91.000 Y103.600 E141.31509
+G1 X109.000 Y103.600 E141.91377
+G1 X109.000 Y104.050 E141.92874
+G1 X91.000 Y104.050 E142.52742
+G1 X91.000 Y104.500 E142.54238
+G1 X109.000 Y104.500 E143.14106
+G1 X109.000 Y104.950 E143.15603
+G1 X91.000 Y104.950 E143.75471
+G1 X91.000 Y105.400 E143.76968
+G1 X109.000 Y105.400 E144.36836
+G1 X109.000 Y105.850 E144.38332
+G1 X91.000 Y105.850 E144.98200
+G1 X91.000 Y106.300 E144.99697
+G1 X109.000 Y106.300 E145.59565
+G1 X109.000 Y106.750 E145.61062
+G1 X91.000 Y106.750 E146.20930
+G1 X91.000 Y107.200 E146.22426
+G1 X109.000 Y107.200 E146.82294
+G1 X109.000 Y107.650 E146.83791
+G1 X91.000 Y107.650 E147.43659
+G1 X91.000 Y108.100 E147.45156
+G1 X109.000 Y108.100 E148.05024
+G1 X109.000 Y108.550 E148.06521
+G1 X91.000 Y108.550 E148.66389
+M106 S160
+M73 P20 R3
+;LAYER_CHANGE
+;Z:1.2
+;HEIGHT:0.2
+G1 E147.86389 F2100
+G1 Z1.200 F7800
+;TYPE:Perimeter
+;WIDTH:0.45
+G1 X90.000 Y90.000 F10800
+G1 E148.66389 F2100
+G1 F1800
+G1 X92.504 Y90.001 E148.74704
+G1 X94.999 Y90.003 E148.83019
+G1 X97.497 Y90.002 E148.91334
+G1 X99.997 Y89.999 E148.99649
+G1 X102.500 Y89.999 E149.07964
+G1 X104.997 Y89.998 E149.16279
+G1 X107.503 Y90.000 E149.24594
+G1 X110.001 Y89.998 E149.32909
+G1 X110.002 Y92.499 E149.41224
+G1 X110.001 Y95.003 E149.49539
+G1 X110.004 Y97.496 E149.57854
+G1 X110.002 Y100.003 E149.66169
+G1 X109.999 Y102.499 E149.74484
+G1 X110.001 Y105.003 E149.82799
+G1 X109.999 Y107.503 E149.91114
+G1 X110.002 Y109.997 E149.99429
+G1 X107.503 Y109.996 E150.07744
+G1 X104.997 Y110.001 E150.16059
+G1 X102.496 Y109.999 E150.24374
+G1 X99.997 Y110.000 E150.32689
+G1 X97.503 Y110.003 E150.41004
+G1 X94.996 Y109.996 E150.49319
+G1 X92.503 Y109.996 E150.57634
+G1 X89.998 Y109.997 E150.65949
+G1 X89.997 Y107.496 E150.74264
+G1 X90.001 Y105.002 E150.82579
+G1 X90.001 Y102.503 E150.90894
+G1 X90.001 Y99.999 E150.99209
+G1 X90.001 Y97.504 E151.07524
+G1 X90.001 Y94.998 E151.15839
+G1 X89.996 Y92.503 E151.24154
+G1 X90.001 Y89.999 E151.32469
+G1 X90.450 Y90.450 F10800
+G1 E151.32469 F2100
+G1 F1800
+G1 X92.838 Y90.450 E151.40409
+G1 X95.225 Y90.446 E151.48350
+G1 X97.611 Y90.449 E151.56291
+G1 X99.998 Y90.453 E151.64232
+G1 X102.387 Y90.451 E151.72173
+G1 X104.777 Y90.452 E151.80113
+G1 X107.164 Y90.452 E151.88054
+G1 X109.548 Y90.454 E151.95995
+G1 X109.547 Y92.841 E152.03936
+G1 X109.553 Y95.228 E152.11877
+G1 X109.546 Y97.609 E152.19818
+G1 X109.553 Y100.000 E152.27758
+G1 X109.549 Y102.391 E152.35699
+G1 X109.546 Y104.775 E152.43640
+G1 X109.550 Y107.160 E152.51581
+G1 X109.549 Y109.552 E152.59522
+G1 X107.166 Y109.546 E152.67463
+G1 X104.775 Y109.547 E152.75403
+G1 X102.390 Y109.547 E152.83344
+G1 X99.996 Y109.549 E152.91285
+G1 X97.614 Y109.549 E152.99226
+G1 X95.222 Y109.552 E153.07167
+G1 X92.840 Y109.553 E153.15107
+G1 X90.448 Y109.549 E153.23048
+G1 X90.448 Y107.163 E153.30989
+G1 X90.449 Y104.774 E153.38930
+G1 X90.452 Y102.391 E153.46871
+G1 X90.451 Y99.997 E153.54812
+G1 X90.451 Y97.612 E153.62752
+G1 X90.454 Y95.227 E153.70693
+G1 X90.453 Y92.839 E153.78634
+G1 X90.450 Y90.453 E153.86575
+;TYPE:Internal infill
+;WIDTH:0.45
+G1 E153.06575 F2100
+G1 X91.000 Y91.000 F10800
+G1 E153.86575 F2100
+G1 F2400
+G1 X109.000 Y91.000 E154.46443
+G1 X109.000 Y91.450 E154.47940
+G1 X91.000 Y91.450 E155.07808
+G1 X91.000 Y91.900 E155.09304
+G1 X109.000 Y91.900 E155.69172
+G1 X109.000 Y92.350 E155.70669
+G1 X91.000 Y92.350 E156.30537
+G1 X91.000 Y92.800 E156.32034
+G1 X109.000 Y92.800 E156.91902
+G1 X109.000 Y93.250 E156.93398
+G1 X91.000 Y93.250 E157.53266
+G1 X91.000 Y93.700 E157.54763
+G1 X109.000 Y93.700 E158.14631
+G1 X109.000 Y94.150 E158.16128
+G1 X91.000 Y94.150 E158.75996
+G1 X91.000 Y94.600 E158.77493
+G1 X109.000 Y94.600 E159.37361
+G1 X109.000 Y95.050 E159.38857
+G1 X91.000 Y95.050 E159.98725
+G1 X91.000 Y95.500 E160.00222
+G1 X109.000 Y95.500 E160.60090
+G1 X109.000 Y95.950 E160.61587
+G1 X91.000 Y95.950 E161.21455
+G1 X91.000 Y96.400 E161.22951
+G1 X109.000 Y96.400 E161.82819
+G1 X109.000 Y96.850 E161.84316
+G1 X91.000 Y96.850 E162.44184
+G1 X91.000 Y97.300 E162.45681
+G1 X109.000 Y97.300 E163.05549
+G1 X109.000 Y97.750 E163.07045
+G1 X91.000 Y97.750 E163.66913
+G1 X91.000 Y98.200 E163.68410
+G1 X109.000 Y98.200 E164.28278
+G1 X109.000 Y98.650 E164.29775
+G1 X91.000 Y98.650 E164.89643
+G1 X91.000 Y99.100 E164.91140
+G1 X109.000 Y99.100 E165.51008
+G1 X109.000 Y99.550 E165.52504
+G1 X91.000 Y99.550 E166.12372
+G1 X91.000 Y100.000 E166.13869
+G1 X109.000 Y100.000 E166.73737
+G1 X109.000 Y100.450 E166.75234
+G1 X91.000 Y100.450 E167.35102
+G1 X91.000 Y100.900 E167.36598
+G1 X109.000 Y100.900 E167.96466
+G1 X109.000 Y101.350 E167.97963
+G1 X91.000 Y101.350 E168.57831
+G1 X91.000 Y101.800 E168.59328
+G1 X109.000 Y101.800 E169.19196
+G1 X109.000 Y102.250 E169.20692
+G1 X91.000 Y102.250 E169.80560
+G1 X91.000 Y102.700 E169.82057
+G1 X109.000 Y102.700 E170.41925
+G1 X109.000 Y103.150 E170.43422
+G1 X91.000 Y103.150 E171.03290
+G1 X91.000 Y103.600 E171.04787
+G1 X109.000 Y103.600 E171.64655
+G1 X109.000 Y104.050 E171.66151
+G1 X91.000 Y104.050 E172.26019
+G1 X91.000 Y104.500 E172.27516
+G1 X109.000 Y104.500 E172.87384
+G1 X109.000 Y104.950 E172.88881
+G1 X91.000 Y104.950 E173.48749
+G1 X91.000 Y105.400 E173.50245
+G1 X109.000 Y105.400 E174.10113
+G1 X109.000 Y105.850 E174.11610
+G1 X91.000 Y105.850 E174.71478
+G1 X91.000 Y106.300 E174.72975
+G1 X109.000 Y106.300 E175.32843
+G1 X109.000 Y106.750 E175.34339
+G1 X91.000 Y106.750 E175.94207
+G1 X91.000 Y107.200 E175.95704
+G1 X109.000 Y107.200 E176.55572
+G1 X109.000 Y107.650 E176.57069
+G1 X91.000 Y107.650 E177.16937
+G1 X91.000 Y108.100 E177.18434
+G1 X109.000 Y108.100 E177.78302
+G1 X109.000 Y108.550 E177.79798
+G1 X91.000 Y108.550 E178.39666
+M106 S200
+M73 P25 R3
+;LAYER_CHANGE
+;Z:1.4
+;HEIGHT:0.2
+G1 E177.59666 F2100
+G1 Z1.400 F7800
+;TYPE:Perimeter
+;WIDTH:0.45
+G1 X90.000 Y90.000 F10800
+G1 E178.39666 F2100
+G1 F1800
+G1 X92.503 Y89.998 E178.47981
+G1 X94.997 Y89.999 E178.56296
+G1 X97.500 Y89.997 E178.64611
+G1 X99.999 Y90.001 E178.72926
+G1 X102.496 Y90.003 E178.81241
+G1 X105.001 Y89.999 E178.89556
+G1 X107.498 Y89.999 E178.97871
+G1 X109.999 Y90.002 E179.06186
+G1 X110.000 Y92.500 E179.14501
+G1 X109.997 Y95.003 E179.22816
+G1 X109.999 Y97.499 E179.31131
+G1 X109.997 Y100.004 E179.39446
+G1 X110.000 Y102.503 E179.47761
+G1 X110.003 Y105.004 E179.56076
+G1 X110.003 Y107.503 E179.64391
+G1 X110.003 Y110.002 E179.72706
+G1 X107.497 Y110.000 E179.81021
+G1 X105.001 Y110.004 E179.89336
+G1 X102.502 Y110.002 E179.97651
+G1 X100.002 Y109.999 E180.05966
+G1 X97.504 Y110.001 E180.14281
+G1 X94.999 Y110.000 E180.22596
+G1 X92.504 Y110.000 E180.30911
+G1 X89.997 Y109.997 E180.39226
+G1 X90.001 Y107.501 E180.47541
+G1 X90.003 Y104.997 E180.55856
+G1 X89.999 Y102.502 E180.64171
+G1 X89.996 Y99.997 E180.72486
+G1 X90.000 Y97.498 E180.80801
+G1 X89.997 Y94.998 E180.89116
+G1 X90.001 Y92.500 E180.97431
+G1 X89.997 Y89.997 E181.05746
+G1 X90.450 Y90.450 F10800
+G1 E181.05746 F2100
+G1 F1800
+G1 X92.840 Y90.451 E181.13687
+G1 X95.222 Y90.453 E181.21628
+G1 X97.609 Y90.449 E181.29569
+G1 X100.003 Y90.452 E181.37510
+G1 X102.386 Y90.453 E181.45450
+G1 X104.776 Y90.453 E181.53391
+G1 X107.166 Y90.449 E181.61332
+G1 X109.551 Y90.450 E181.69273
+G1 X109.554 Y92.840 E181.77214
+G1 X109.552 Y95.228 E181.85154
+G1 X109.554 Y97.611 E181.93095
+G1 X109.548 Y100.002 E182.01036
+G1 X109.552 Y102.388 E182.08977
+G1 X109.550 Y104.774 E182.16918
+G1 X109.553 Y107.165 E182.24859
+G1 X109.551 Y109.546 E182.32799
+G1 X107.165 Y109.550 E182.40740
+G1 X104.773 Y109.548 E182.48681
+G1 X102.389 Y109.546 E182.56622
+G1 X99.997 Y109.548 E182.64563
+G1 X97.616 Y109.552 E182.72504
+G1 X95.229 Y109.550 E182.80444
+G1 X92.838 Y109.550 E182.88385
+G1 X90.450 Y109.550 E182.96326
+G1 X90.453 Y107.166 E183.04267
+G1 X90.449 Y104.776 E183.12208
+G1 X90.448 Y102.386 E183.20148
+G1 X90.450 Y100.001 E183.28089
+G1 X90.450 Y97.616 E183.36030
+G1 X90.447 Y95.226 E183.43971
+G1 X90.454 Y92.839 E183.51912
+G1 X90.451 Y90.449 E183.59853
+;TYPE:Internal infill
+;WIDTH:0.45
+G1 E182.79853 F2100
+G1 X91.000 Y91.000 F10800
+G1 E183.59853 F2100
+G1 F2400
+G1 X109.000 Y91.000 E184.19721
+G1 X109.000 Y91.450 E184.21217
+G1 X91.000 Y91.450 E184.81085
+G1 X91.000 Y91.900 E184.82582
+G1 X109.000 Y91.900 E185.42450
+G1 X109.000 Y92.350 E185.43947
+G1 X91.000 Y92.350 E186.03815
+G1 X91.000 Y92.800 E186.05311
+G1 X109.000 Y92.800 E186.65179
+G1 X109.000 Y93.250 E186.66676
+G1 X91.000 Y93.250 E187.26544
+G1 X91.000 Y93.700 E187.28041
+G1 X109.000 Y93.700 E187.87909
+G1 X109.000 Y94.150 E187.89406
+G1 X91.000 Y94.150 E188.49274
+G1 X91.000 Y94.600 E188.50770
+G1 X109.000 Y94.600 E189.10638
+G1 X109.000 Y95.050 E189.12135
+G1 X91.000 Y95.050 E189.72003
+G1 X91.000 Y95.500 E189.73500
+G1 X109.000 Y95.500 E190.33368
+G1 X109.000 Y95.950 E190.34864
+G1 X91.000 Y95.950 E190.94732
+G1 X91.000 Y96.400 E190.96229
+G1 X109.000 Y96.400 E191.56097
+G1 X109.000 Y96.850 E191.57594
+G1 X91.000 Y96.850 E192.17462
+G1 X91.000 Y97.300 E192.18958
+G1 X109.000 Y97.300 E192.78826
+G1 X109.000 Y97.750 E192.80323
+G1 X91.000 Y97.750 E193.40191
+G1 X91.000 Y98.200 E193.41688
+G1 X109.000 Y98.200 E194.01556
+G1 X109.000 Y98.650 E194.03053
+G1 X91.000 Y98.650 E194.62921
+G1 X91.000 Y99.100 E194.64417
+G1 X109.000 Y99.100 E195.24285
+G1 X109.000 Y99.550 E195.25782
+G1 X91.000 Y99.550 E195.85650
+G1 X91.000 Y100.000 E195.87147
+G1 X109.000 Y100.000 E196.47015
+G1 X109.000 Y100.450 E196.48511
+G1 X91.000 Y100.450 E197.08379
+G1 X91.000 Y100.900 E197.09876
+G1 X109.000 Y100.900 E197.69744
+G1 X109.000 Y101.350 E197.71241
+G1 X91.000 Y101.350 E198.31109
+G1 X91.000 Y101.800 E198.32605
+G1 X109.000 Y101.800 E198.92473
+G1 X109.000 Y102.250 E198.93970
+G1 X91.000 Y102.250 E199.53838
+G1 X91.000 Y102.700 E199.55335
+G1 X109.000 Y102.700 E200.15203
+G1 X109.000 Y103.150 E200.16700
+G1 X91.000 Y103.150 E200.76568
+G1 X91.000 Y103.600 E200.78064
+G1 X109.000 Y103.600 E201.37932
+G1 X109.000 Y104.050 E201.39429
+G1 X91.000 Y104.050 E201.99297
+G1 X91.000 Y104.500 E202.00794
+G1 X109.000 Y104.500 E202.60662
+G1 X109.000 Y104.950 E202.62158
+G1 X91.000 Y104.950 E203.22026
+G1 X91.000 Y105.400 E203.23523
+G1 X109.000 Y105.400 E203.83391
+G1 X109.000 Y105.850 E203.84888
+G1 X91.000 Y105.850 E204.44756
+G1 X91.000 Y106.300 E204.46252
+G1 X109.000 Y106.300 E205.06120
+G1 X109.000 Y106.750 E205.07617
+G1 X91.000 Y106.750 E205.67485
+G1 X91.000 Y107.200 E205.68982
+G1 X109.000 Y107.200 E206.28850
+G1 X109.000 Y107.650 E206.30347
+G1 X91.000 Y107.650 E206.90215
+G1 X91.000 Y108.100 E206.91711
+G1 X109.000 Y108.100 E207.51579
+G1 X109.000 Y108.550 E207.53076
+G1 X91.000 Y108.550 E208.12944
+M106 S240
+M73 P30 R3
+;LAYER_CHANGE
+;Z:1.6
+;HEIGHT:0.2
+G1 E207.32944 F2100
+G1 Z1.600 F7800
+;TYPE:Perimeter
+;WIDTH:0.45
+G1 X90.000 Y90.000 F10800
+G1 E208.12944 F2100
+G1 F1800
+G1 X92.499 Y90.003 E208.21259
+G1 X95.003 Y90.001 E208.29574
+G1 X97.503 Y90.003 E208.37889
+G1 X100.003 Y89.999 E208.46204
+G1 X102.500 Y90.002 E208.54519
+G1 X104.999 Y90.002 E208.62834
+G1 X107.500 Y89.999 E208.71149
+G1 X110.000 Y89.997 E208.79464
+G1 X109.999 Y92.499 E208.87779
+G1 X109.996 Y94.997 E208.96094
+G1 X109.998 Y97.503 E209.04409
+G1 X110.001 Y99.998 E209.12724
+G1 X110.004 Y102.498 E209.21039
+G1 X110.000 Y105.002 E209.29354
+G1 X110.002 Y107.499 E209.37669
+G1 X110.002 Y110.000 E209.45984
+G1 X107.502 Y110.000 E209.54299
+G1 X105.004 Y110.002 E209.62614
+G1 X102.497 Y109.997 E209.70929
+G1 X100.004 Y109.998 E209.79244
+G1 X97.496 Y109.998 E209.87559
+G1 X95.000 Y110.004 E209.95874
+G1 X92.499 Y110.002 E210.04189
+G1 X90.003 Y109.997 E210.12504
+G1 X90.001 Y107.504 E210.20819
+G1 X90.000 Y105.000 E210.29134
+G1 X89.999 Y102.504 E210.37449
+G1 X90.004 Y99.997 E210.45764
+G1 X90.000 Y97.499 E210.54079
+G1 X90.001 Y94.997 E210.62394
+G1 X89.998 Y92.498 E210.70709
+G1 X90.000 Y90.002 E210.79024
+G1 X90.450 Y90.450 F10800
+G1 E210.79024 F2100
+G1 F1800
+G1 X92.840 Y90.452 E210.86965
+G1 X95.226 Y90.447 E210.94906
+G1 X97.612 Y90.451 E211.02846
+G1 X99.998 Y90.450 E211.10787
+G1 X102.391 Y90.447 E211.18728
+G1 X104.778 Y90.447 E211.26669
+G1 X107.162 Y90.453 E211.34610
+G1 X109.548 Y90.450 E211.42551
+G1 X109.549 Y92.841 E211.50491
+G1 X109.554 Y95.223 E211.58432
+G1 X109.550 Y97.616 E211.66373
+G1 X109.550 Y99.998 E211.74314
+G1 X109.552 Y102.386 E211.82255
+G1 X109.550 Y104.771 E211.90195
+G1 X109.554 Y107.164 E211.98136
+G1 X109.553 Y109.554 E212.06077
+G1 X107.161 Y109.550 E212.14018
+G1 X104.775 Y109.552 E212.21959
+G1 X102.390 Y109.548 E212.29900
+G1 X99.998 Y109.552 E212.37840
+G1 X97.612 Y109.547 E212.45781
+G1 X95.223 Y109.550 E212.53722
+G1 X92.838 Y109.554 E212.61663
+G1 X90.450 Y109.551 E212.69604
+G1 X90.447 Y107.162 E212.77545
+G1 X90.448 Y104.777 E212.85485
+G1 X90.448 Y102.385 E212.93426
+G1 X90.449 Y100.000 E213.01367
+G1 X90.449 Y97.613 E213.09308
+G1 X90.447 Y95.228 E213.17249
+G1 X90.452 Y92.838 E213.25189
+G1 X90.446 Y90.449 E213.33130
+;TYPE:Internal infill
+;WIDTH:0.45
+G1 E212.53130 F2100
+G1 X91.000 Y91.000 F10800
+G1 E213.33130 F2100
+G1 F2400
+G1 X109.000 Y91.000 E213.92998
+G1 X109.000 Y91.450 E213.94495
+G1 X91.000 Y91.450 E214.54363
+G1 X91.000 Y91.900 E214.55860
+G1 X109.000 Y91.900 E215.15728
+G1 X109.000 Y92.350 E215.17224
+G1 X91.000 Y92.350 E215.77092
+G1 X91.000 Y92.800 E215.78589
+G1 X109.000 Y92.800 E216.38457
+G1 X109.000 Y93.250 E216.39954
+G1 X91.000 Y93.250 E216.99822
+G1 X91.000 Y93.700 E217.01319
+G1 X109.000 Y93.700 E217.61187
+G1 X109.000 Y94.150 E217.62683
+G1 X91.000 Y94.150 E218.22551
+G1 X91.000 Y94.600 E218.24048
+G1 X109.000 Y94.600 E218.83916
+G1 X109.000 Y95.050 E218.85413
+G1 X91.000 Y95.050 E219.45281
+G1 X91.000 Y95.500 E219.46777
+G1 X109.000 Y95.500 E220.06645
+G1 X109.000 Y95.950 E220.08142
+G1 X91.000 Y95.950 E220.68010
+G1 X91.000 Y96.400 E220.69507
+G1 X109.000 Y96.400 E221.29375
+G1 X109.000 Y96.850 E221.30871
+G1 X91.000 Y96.850 E221.90739
+G1 X91.000 Y97.300 E221.92236
+G1 X109.000 Y97.300 E222.52104
+G1 X109.000 Y97.750 E222.53601
+G1 X91.000 Y97.750 E223.13469
+G1 X91.000 Y98.200 E223.14966
+G1 X109.000 Y98.200 E223.74834
+G1 X109.000 Y98.650 E223.76330
+G1 X91.000 Y98.650 E224.36198
+G1 X91.000 Y99.100 E224.37695
+G1 X109.000 Y99.100 E224.97563
+G1 X109.000 Y99.550 E224.99060
+G1 X91.000 Y99.550 E225.58928
+G1 X91.000 Y100.000 E225.60424
+G1 X109.000 Y100.000 E226.20292
+G1 X109.000 Y100.450 E226.21789
+G1 X91.000 Y100.450 E226.81657
+G1 X91.000 Y100.900 E226.83154
+G1 X109.000 Y100.900 E227.43022
+G1 X109.000 Y101.350 E227.44518
+G1 X91.000 Y101.350 E228.04386
+G1 X91.000 Y101.800 E228.05883
+G1 X109.000 Y101.800 E228.65751
+G1 X109.000 Y102.250 E228.67248
+G1 X91.000 Y102.250 E229.27116
+G1 X91.000 Y102.700 E229.28613
+G1 X109.000 Y102.700 E229.88481
+G1 X109.000 Y103.150 E229.89977
+G1 X91.000 Y103.150 E230.49845
+G1 X91.000 Y103.600 E230.51342
+G1 X109.000 Y103.600 E231.11210
+G1 X109.000 Y104.050 E231.12707
+G1 X91.000 Y104.050 E231.72575
+G1 X91.000 Y104.500 E231.74071
+G1 X109.000 Y104.500 E232.33939
+G1 X109.000 Y104.950 E232.35436
+G1 X91.000 Y104.950 E232.95304
+G1 X91.000 Y105.400 E232.96801
+G1 X109.000 Y105.400 E233.56669
+G1 X109.000 Y105.850 E233.58165
+G1 X91.000 Y105.850 E234.18033
+G1 X91.000 Y106.300 E234.19530
+G1 X109.000 Y106.300 E234.79398
+G1 X109.000 Y106.750 E234.80895
+G1 X91.000 Y106.750 E235.40763
+G1 X91.000 Y107.200 E235.42260
+G1 X109.000 Y107.200 E236.02128
+G1 X109.000 Y107.650 E236.03624
+G1 X91.000 Y107.650 E236.63492
+G1 X91.000 Y108.100 E236.64989
+G1 X109.000 Y108.100 E237.24857
+G1 X109.000 Y108.550 E237.26354
+G1 X91.000 Y108.550 E237.86222
+M106 S255
+M73 P35 R2
+;LAYER_CHANGE
+;Z:1.8
+;HEIGHT:0.2
+G1 E237.06222 F2100
+G1 Z1.800 F7800
+;TYPE:Perimeter
+;WIDTH:0.45
+G1 X90.000 Y90.000 F10800
+G1 E237.86222 F2100
+G1 F1800
+G1 X92.502 Y90.001 E237.94537
+G1 X95.002 Y90.003 E238.02852
+G1 X97.499 Y90.000 E238.11167
+G1 X99.999 Y89.997 E238.19482
+G1 X102.497 Y89.998 E238.27797
+G1 X104.997 Y90.000 E238.36112
+G1 X107.502 Y90.001 E238.44427
+G1 X110.001 Y89.998 E238.52742
+G1 X109.998 Y92.501 E238.61057
+G1 X110.003 Y94.999 E238.69372
+G1 X109.996 Y97.496 E238.77687
+G1 X109.998 Y100.001 E238.86002
+G1 X109.997 Y102.498 E238.94317
+G1 X110.001 Y105.004 E239.02632
+G1 X109.999 Y107.501 E239.10947
+G1 X110.000 Y109.996 E239.19262
+G1 X107.499 Y109.997 E239.27577
+G1 X104.998 Y110.002 E239.35892
+G1 X102.501 Y109.996 E239.44207
+G1 X99.997 Y110.002 E239.52522
+G1 X97.497 Y109.999 E239.60837
+G1 X94.998 Y109.996 E239.69152
+G1 X92.496 Y109.997 E239.77467
+G1 X89.999 Y110.003 E239.85782
+G1 X90.001 Y107.498 E239.94097
+G1 X90.001 Y104.998 E240.02412
+G1 X90.000 Y102.499 E240.10727
+G1 X90.004 Y99.999 E240.19042
+G1 X90.002 Y97.501 E240.27357
+G1 X90.003 Y95.001 E240.35672
+G1 X90.003 Y92.499 E240.43987
+G1 X90.001 Y90.001 E240.52302
+G1 X90.450 Y90.450 F10800
+G1 E240.52302 F2100
+G1 F1800
+G1 X92.838 Y90.451 E240.60242
+G1 X95.225 Y90.449 E240.68183
+G1 X97.616 Y90.451 E240.76124
+G1 X100.000 Y90.446 E240.84065
+G1 X102.388 Y90.447 E240.92006
+G1 X104.773 Y90.449 E240.99947
+G1 X107.163 Y90.448 E241.07887
+G1 X109.548 Y90.450 E241.15828
+G1 X109.550 Y92.837 E241.23769
+G1 X109.547 Y95.224 E241.31710
+G1 X109.551 Y97.613 E241.39651
+G1 X109.550 Y100.003 E241.47592
+G1 X109.552 Y102.389 E241.55532
+G1 X109.546 Y104.773 E241.63473
+G1 X109.551 Y107.160 E241.71414
+G1 X109.553 Y109.547 E241.79355
+G1 X107.166 Y109.548 E241.87296
+G1 X104.778 Y109.553 E241.95236
+G1 X102.386 Y109.553 E242.03177
+G1 X99.997 Y109.553 E242.11118
+G1 X97.612 Y109.550 E242.19059
+G1 X95.222 Y109.551 E242.27000
+G1 X92.836 Y109.551 E242.34941
+G1 X90.452 Y109.551 E242.42881
+G1 X90.446 Y107.166 E242.50822
+G1 X90.453 Y104.776 E242.58763
+G1 X90.449 Y102.388 E242.66704
+G1 X90.453 Y100.000 E242.74645
+G1 X90.452 Y97.613 E242.82586
+G1 X90.449 Y95.228 E242.90526
+G1 X90.449 Y92.838 E242.98467
+G1 X90.446 Y90.450 E243.06408
+;TYPE:Internal infill
+;WIDTH:0.45
+G1 E242.26408 F2100
+G1 X91.000 Y91.000 F10800
+G1 E243.06408 F2100
+G1 F2400
+G1 X109.000 Y91.000 E243.66276
+G1 X109.000 Y91.450 E243.67773
+G1 X91.000 Y91.450 E244.27641
+G1 X91.000 Y91.900 E244.29137
+G1 X109.000 Y91.900 E244.89005
+G1 X109.000 Y92.350 E244.90502
+G1 X91.000 Y92.350 E245.50370
+G1 X91.000 Y92.800 E245.51867
+G1 X109.000 Y92.800 E246.11735
+G1 X109.000 Y93.250 E246.13232
+G1 X91.000 Y93.250 E246.73100
+G1 X91.000 Y93.700 E246.74596
+G1 X109.000 Y93.700 E247.34464
+G1 X109.000 Y94.150 E247.35961
+G1 X91.000 Y94.150 E247.95829
+G1 X91.000 Y94.600 E247.97326
+G1 X109.000 Y94.600 E248.57194
+G1 X109.000 Y95.050 E248.58690
+G1 X91.000 Y95.050 E249.18558
+G1 X91.000 Y95.500 E249.20055
+G1 X109.000 Y95.500 E249.79923
+G1 X109.000 Y95.950 E249.81420
+G1 X91.000 Y95.950 E250.41288
+G1 X91.000 Y96.400 E250.42784
+G1 X109.000 Y96.400 E251.02652
+G1 X109.000 Y96.850 E251.04149
+G1 X91.000 Y96.850 E251.64017
+G1 X91.000 Y97.300 E251.65514
+G1 X109.000 Y97.300 E252.25382
+G1 X109.000 Y97.750 E252.26879
+G1 X91.000 Y97.750 E252.86747
+G1 X91.000 Y98.200 E252.88243
+G1 X109.000 Y98.200 E253.48111
+G1 X109.000 Y98.650 E253.49608
+G1 X91.000 Y98.650 E254.09476
+G1 X91.000 Y99.100 E254.10973
+G1 X109.000 Y99.100 E254.70841
+G1 X109.000 Y99.550 E254.72337
+G1 X91.000 Y99.550 E255.32205
+G1 X91.000 Y100.000 E255.33702
+G1 X109.000 Y100.000 E255.93570
+G1 X109.000 Y100.450 E255.95067
+G1 X91.000 Y100.450 E256.54935
+G1 X91.000 Y100.900 E256.56431
+G1 X109.000 Y100.900 E257.16299
+G1 X109.000 Y101.350 E257.17796
+G1 X91.000 Y101.350 E257.77664
+G1 X91.000 Y101.800 E257.79161
+G1 X109.000 Y101.800 E258.39029
+G1 X109.000 Y102.250 E258.40526
+G1 X91.000 Y102.250 E259.00394
+G1 X91.000 Y102.700 E259.01890
+G1 X109.000 Y102.700 E259.61758
+G1 X109.000 Y103.150 E259.63255
+G1 X91.000 Y103.150 E260.23123
+G1 X91.000 Y103.600 E260.24620
+G1 X109.000 Y103.600 E260.84488
+G1 X109.000 Y104.050 E260.85984
+G1 X91.000 Y104.050 E261.45852
+G1 X91.000 Y104.500 E261.47349
+G1 X109.000 Y104.500 E262.07217
+G1 X109.000 Y104.950 E262.08714
+G1 X91.000 Y104.950 E262.68582
+G1 X91.000 Y105.400 E262.70078
+G1 X109.000 Y105.400 E263.29946
+G1 X109.000 Y105.850 E263.31443
+G1 X91.000 Y105.850 E263.91311
+G1 X91.000 Y106.300 E263.92808
+G1 X109.000 Y106.300 E264.52676
+G1 X109.000 Y106.750 E264.54173
+G1 X91.000 Y106.750 E265.14041
+G1 X91.000 Y107.200 E265.15537
+G1 X109.000 Y107.200 E265.75405
+G1 X109.000 Y107.650 E265.76902
+G1 X91.000 Y107.650 E266.36770
+G1 X91.000 Y108.100 E266.38267
+G1 X109.000 Y108.100 E266.98135
+G1 X109.000 Y108.550 E266.99631
+G1 X91.000 Y108.550 E267.59499
+M106 S255
+M73 P40 R2
+;LAYER_CHANGE
+;Z:2.0
+;HEIGHT:0.2
+G1 E266.79499 F2100
+G1 Z2.000 F7800
+;TYPE:Perimeter
+;WIDTH:0.45
+G1 X90.000 Y90.000 F10800
+G1 E267.59499 F2100
+G1 F1800
+G1 X92.496 Y90.002 E267.67814
+G1 X94.996 Y89.996 E267.76129
+G1 X97.497 Y89.997 E267.84444
+G1 X100.000 Y89.999 E267.92759
+G1 X102.498 Y90.004 E268.01074
+G1 X105.003 Y90.001 E268.09389
+G1 X107.502 Y90.003 E268.17704
+G1 X109.998 Y90.002 E268.26019
+G1 X109.998 Y92.500 E268.34334
+G1 X109.999 Y94.997 E268.42649
+G1 X110.002 Y97.503 E268.50964
+G1 X109.999 Y100.003 E268.59279
+G1 X109.999 Y102.501 E268.67594
+G1 X110.004 Y105.002 E268.75909
+G1 X109.996 Y107.499 E268.84224
+G1 X109.999 Y109.998 E268.92539
+G1 X107.503 Y110.000 E269.00854
+G1 X105.002 Y110.001 E269.09169
+G1 X102.500 Y109.996 E269.17484
+G1 X100.001 Y110.003 E269.25799
+G1 X97.497 Y110.001 E269.34114
+G1 X95.000 Y109.999 E269.42429
+G1 X92.502 Y110.004 E269.50744
+G1 X89.996 Y110.003 E269.59059
+G1 X89.999 Y107.503 E269.67374
+G1 X89.997 Y105.002 E269.75689
+G1 X89.997 Y102.499 E269.84004
+G1 X90.004 Y100.001 E269.92319
+G1 X90.002 Y97.500 E270.00634
+G1 X90.000 Y95.000 E270.08949
+G1 X90.002 Y92.502 E270.17264
+G1 X89.998 Y90.000 E270.25579
+G1 X90.450 Y90.450 F10800
+G1 E270.25579 F2100
+G1 F1800
+G1 X92.838 Y90.451 E270.33520
+G1 X95.228 Y90.453 E270.41461
+G1 X97.610 Y90.449 E270.49402
+G1 X99.997 Y90.446 E270.57343
+G1 X102.384 Y90.447 E270.65283
+G1 X104.777 Y90.451 E270.73224
+G1 X107.165 Y90.448 E270.81165
+G1 X109.547 Y90.454 E270.89106
+G1 X109.553 Y92.841 E270.97047
+G1 X109.546 Y95.224 E271.04988
+G1 X109.551 Y97.614 E271.12928
+G1 X109.553 Y100.000 E271.20869
+G1 X109.549 Y102.384 E271.28810
+G1 X109.552 Y104.779 E271.36751
+G1 X109.553 Y107.164 E271.44692
+G1 X109.549 Y109.548 E271.52633
+G1 X107.165 Y109.553 E271.60573
+G1 X104.779 Y109.547 E271.68514
+G1 X102.388 Y109.550 E271.76455
+G1 X99.999 Y109.552 E271.84396
+G1 X97.616 Y109.552 E271.92337
+G1 X95.227 Y109.552 E272.00277
+G1 X92.839 Y109.550 E272.08218
+G1 X90.448 Y109.552 E272.16159
+G1 X90.447 Y107.164 E272.24100
+G1 X90.449 Y104.775 E272.32041
+G1 X90.451 Y102.387 E272.39982
+G1 X90.454 Y99.998 E272.47922
+G1 X90.446 Y97.616 E272.55863
+G1 X90.448 Y95.223 E272.63804
+G1 X90.449 Y92.838 E272.71745
+G1 X90.454 Y90.452 E272.79686
+;TYPE:Internal infill
+;WIDTH:0.45
+G1 E271.99686 F2100
+G1 X91.000 Y91.000 F10800
+G1 E272.79686 F2100
+G1 F2400
+G1 X109.000 Y91.000 E273.39554
+G1 X109.000 Y91.450 E273.41050
+G1 X91.000 Y91.450 E274.00918
+G1 X91.000 Y91.900 E274.02415
+G1 X109.000 Y91.900 E274.62283
+G1 X109.000 Y92.350 E274.63780
+G1 X91.000 Y92.350 E275.23648
+G1 X91.000 Y92.800 E275.25145
+G1 X109.000 Y92.800 E275.85013
+G1 X109.000 Y93.250 E275.86509
+G1 X91.000 Y93.250 E276.46377
+G1 X91.000 Y93.700 E276.47874
+G1 X109.000 Y93.700 E277.07742
+G1 X109.000 Y94.150 E277.09239
+G1 X91.000 Y94.150 E277.69107
+G1 X91.000 Y94.600 E277.70603
+G1 X109.000 Y94.600 E278.30471
+G1 X109.000 Y95.050 E278.31968
+G1 X91.000 Y95.050 E278.91836
+G1 X91.000 Y95.500 E278.93333
+G1 X109.000 Y95.500 E279.53201
+G1 X109.000 Y95.950 E279.54697
+G1 X91.000 Y95.950 E280.14565
+G1 X91.000 Y96.400 E280.16062
+G1 X109.000 Y96.400 E280.75930
+G1 X109.000 Y96.850 E280.77427
+G1 X91.000 Y96.850 E281.37295
+G1 X91.000 Y97.300 E281.38792
+G1 X109.000 Y97.300 E281.98660
+G1 X109.000 Y97.750 E282.00156
+G1 X91.000 Y97.750 E282.60024
+G1 X91.000 Y98.200 E282.61521
+G1 X109.000 Y98.200 E283.21389
+G1 X109.000 Y98.650 E283.22886
+G1 X91.000 Y98.650 E283.82754
+G1 X91.000 Y99.100 E283.84250
+G1 X109.000 Y99.100 E284.44118
+G1 X109.000 Y99.550 E284.45615
+G1 X91.000 Y99.550 E285.05483
+G1 X91.000 Y100.000 E285.06980
+G1 X109.000 Y100.000 E285.66848
+G1 X109.000 Y100.450 E285.68344
+G1 X91.000 Y100.450 E286.28212
+G1 X91.000 Y100.900 E286.29709
+G1 X109.000 Y100.900 E286.89577
+G1 X109.000 Y101.350 E286.91074
+G1 X91.000 Y101.350 E287.50942
+G1 X91.000 Y101.800 E287.52439
+G1 X109.000 Y101.800 E288.12307
+G1 X109.000 Y102.250 E288.13803
+G1 X91.000 Y102.250 E288.73671
+G1 X91.000 Y102.700 E288.75168
+G1 X109.000 Y102.700 E289.35036
+G1 X109.000 Y103.150 E289.36533
+G1 X91.000 Y103.150 E289.96401
+G1 X91.000 Y103.600 E289.97897
+G1 X109.000 Y103.600 E290.57765
+G1 X109.000 Y104.050 E290.59262
+G1 X91.000 Y104.050 E291.19130
+G1 X91.000 Y104.500 E291.20627
+G1 X109.000 Y104.500 E291.80495
+G1 X109.000 Y104.950 E291.81991
+G1 X91.000 Y104.950 E292.41859
+G1 X91.000 Y105.400 E292.43356
+G1 X109.000 Y105.400 E293.03224
+G1 X109.000 Y105.850 E293.04721
+G1 X91.000 Y105.850 E293.64589
+G1 X91.000 Y106.300 E293.66086
+G1 X109.000 Y106.300 E294.25954
+G1 X109.000 Y106.750 E294.27450
+G1 X91.000 Y106.750 E294.87318
+G1 X91.000 Y107.200 E294.88815
+G1 X109.000 Y107.200 E295.48683
+G1 X109.000 Y107.650 E295.50180
+G1 X91.000 Y107.650 E296.10048
+G1 X91.000 Y108.100 E296.11544
+G1 X109.000 Y108.100 E296.71412
+G1 X109.000 Y108.550 E296.72909
+G1 X91.000 Y108.550 E297.32777
+M106 S255
+M73 P45 R2
+G1 E296.52777 F2100
+M107
+M104 S0 ; turn off temperature
+M140 S0 ; turn off heatbed
+G1 X0 Y200 F3000 ; present print
+M84 ; disable motors
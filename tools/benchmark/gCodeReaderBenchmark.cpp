@@ -0,0 +1,161 @@
+/**
+ * \file gCodeReaderBenchmark.cpp
+ *
+ * \brief Micro benchmark of the g-code reader on the host
+ *
+ * Compresses all lines of a slicer output with #GCodeReader_addGCode and
+ * reads each g-code back from #gCodeRingBuffer, as the application does
+ * before executing it. One operation is one line, including comments and
+ * empty lines which are dropped. The lines are copied to scratch buffers
+ * before each repetition, as they are compressed in-place.
+ * The second case sends the lines as a host does, with line number and
+ * checksum.
+ * The corpus is corpus/slicer.gcode or the file given as first argument.
+ * Prints one JSON line per case, see benchmark.h.
+ * All sources are included directly to get a single translation unit.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <string>
+#include <vector>
+#include "benchmark.h"
+#include "../../Serial/src/serial.cpp"
+#include "../../GCodeReader/src/gCodeReader.cpp"
+
+/* ******************| Macros |**************************************** */
+/**
+ * Longest line of the corpus which is used, longer lines are skipped
+ */
+#define GCODEREADERBENCHMARK_LINE_LENGTH    (uint8_t)200
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Lines of the corpus as read from the file
+ */
+static std::vector<std::string> GCodeReaderBenchmark_lines;
+
+/**
+ * Lines of the corpus with line number and checksum
+ */
+static std::vector<std::string> GCodeReaderBenchmark_hostLines;
+
+/**
+ * Scratch buffers compressed in-place by #GCodeReader_addGCode
+ */
+static std::vector<std::string> GCodeReaderBenchmark_scratch;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Replies to the host are not needed by the benchmark
+ */
+void Platform_serialWrite(const uint8_t *data, uint8_t length)
+{
+  (void)data;
+  (void)length;
+}
+
+/**
+ * \brief Reads the corpus and derives the lines sent by a host
+ *
+ * @param[in] fileName Path of the corpus
+ * @return RESULT_OK if the corpus could be read
+ */
+static uint8_t GCodeReaderBenchmark_load(const char *fileName)
+{
+  FILE *file = fopen(fileName, "r");
+  char line[GCODEREADERBENCHMARK_LINE_LENGTH + 2];
+  uint32_t lineNumber = 0;
+
+  if (file == NULL)
+    {
+      return RESULT_NOT_OK;
+    }
+  while (fgets(line, sizeof(line), file) != NULL)
+    {
+      std::string gCode(line);
+
+      while (!gCode.empty() && ((gCode.back() == '\n') || (gCode.back() == '\r')))
+        {
+          gCode.pop_back();
+        }
+      if (gCode.length() > GCODEREADERBENCHMARK_LINE_LENGTH - 16)
+        {
+          continue;
+        }
+      GCodeReaderBenchmark_lines.push_back(gCode);
+      /* Hosts strip comments and send the line number and the XOR of all
+       * characters before the '*' */
+      gCode = gCode.substr(0, gCode.find(';'));
+      while (!gCode.empty() && (gCode.back() == ' '))
+        {
+          gCode.pop_back();
+        }
+      if (!gCode.empty())
+        {
+          uint8_t checksum = 0;
+
+          gCode = "N" + std::to_string(++lineNumber) + " " + gCode;
+          for (char character : gCode)
+            {
+              checksum ^= (uint8_t)character;
+            }
+          GCodeReaderBenchmark_hostLines.push_back(gCode + "*" + std::to_string(checksum));
+        }
+    }
+  fclose(file);
+  return GCodeReaderBenchmark_lines.empty() ? RESULT_NOT_OK : RESULT_OK;
+}
+
+/**
+ * \brief Adds and reads back all lines
+ *
+ * @param[in] lines Lines to be compressed
+ * @param[in] name Name of the case
+ */
+static void GCodeReaderBenchmark_run(const std::vector<std::string> &lines, const char *name)
+{
+  Benchmark_run("GCodeReader", name, lines.size(), [&lines]()
+    {
+      GCodeReaderBenchmark_scratch = lines;
+    },
+    []()
+    {
+      GCodeReader_GCode_t gCode;
+
+      for (std::string &line : GCodeReaderBenchmark_scratch)
+        {
+          GCodeReader_addGCode((uint8_t *)&line[0]);
+          if (gCodeRingBuffer.read(&gCode) == RESULT_OK)
+            {
+              Benchmark_sink += gCode.data[0];
+            }
+        }
+    });
+}
+
+int main(int argc, char *argv[])
+{
+  const char *fileName = (argc > 1) ? argv[1] : "corpus/slicer.gcode";
+
+  if (GCodeReaderBenchmark_load(fileName) != RESULT_OK)
+    {
+      fprintf(stderr, "Can't read corpus %s\n", fileName);
+      return 1;
+    }
+  GCodeReaderBenchmark_scratch.reserve(GCodeReaderBenchmark_lines.size());
+  Benchmark_init();
+  GCodeReaderBenchmark_run(GCodeReaderBenchmark_lines, "addGCode slicer");
+  GCodeReaderBenchmark_run(GCodeReaderBenchmark_hostLines, "addGCode host");
+  if (GCodeReader_statistics.checksumErrors != 0)
+    {
+      fprintf(stderr, "%u checksum errors\n", GCodeReader_statistics.checksumErrors);
+      return 1;
+    }
+  return 0;
+}
+
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,138 @@
+/**
+ * \file lineMovementBenchmark.cpp
+ *
+ * \brief Micro benchmark of #MotionPlanner::addLineMovement on the host
+ *
+ * Plans line moves along a circle, as produced by slicers, for several
+ * lengths. One operation is one move until it is completely planned, that
+ * is including the calls of #MotionPlanner::run it takes and emptying the
+ * motion buffer without executing the blocks. In contrast to
+ * motionPlannerBenchmark.cpp, which reports the mean of a long run, median
+ * and 99th percentile are reported.
+ * Built once for each machine profile by the Makefile (-include).
+ * Prints one JSON line per case, see benchmark.h.
+ * All sources are included directly to get a single translation unit.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+/* ******************| Inclusions |************************************ */
+#include "benchmark.h"
+#include "../../RingBuffer/src/ringBuffer.cpp"
+#include "../../Parameter/src/parameter.cpp"
+#include "../../Kinematic/src/kinematic.cpp"
+#include "../../MotionBuffer/src/motionBuffer.cpp"
+#include "../../MotionPlanner/src/motionPlanner.cpp"
+
+/* ******************| Macros |**************************************** */
+/**
+ * Number of line moves planned by each repetition
+ */
+#define LINEMOVEMENTBENCHMARK_MOVES         (uint32_t)64
+
+/**
+ * Radius of the circles [mm]
+ */
+#define LINEMOVEMENTBENCHMARK_RADIUS        (WorldCoordinate_t)50.0
+
+/**
+ * Feedrate of all moves [mm/s]
+ */
+#define LINEMOVEMENTBENCHMARK_FEEDRATE      (WorldCoordinate_t)60.0
+
+/**
+ * Filament used per mm of travel [mm]
+ */
+#define LINEMOVEMENTBENCHMARK_EXTRUSION     (WorldCoordinate_t)0.033
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Number of moves planned so far on the current circle
+ */
+static uint32_t LineMovementBenchmark_move;
+
+/**
+ * Target of the last move
+ */
+static WorldCoordinates_t LineMovementBenchmark_targetW;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Cycle counter of the host, used by the latency probes of the
+ * motion planner
+ *
+ * @return Time stamp counter of the CPU [cycles]
+ */
+uint64_t Platform_timeCycles(void)
+{
+  return __rdtsc();
+}
+
+/**
+ * \brief Empties the motion buffer
+ */
+static void LineMovementBenchmark_drain()
+{
+  MotionBlock_t block;
+
+  while (MotionBuffer_read(&block) == RESULT_OK)
+    {
+      Benchmark_sink += block.duration;
+    }
+}
+
+/**
+ * \brief Plans #LINEMOVEMENTBENCHMARK_MOVES moves of the given length
+ *
+ * @param[in] length Length of each move [mm]
+ */
+static void LineMovementBenchmark_run(WorldCoordinate_t length)
+{
+  const float angle = length / LINEMOVEMENTBENCHMARK_RADIUS;
+
+  for (uint32_t i=0; i<LINEMOVEMENTBENCHMARK_MOVES; i++)
+    {
+      LineMovementBenchmark_move++;
+      LineMovementBenchmark_targetW.x = LINEMOVEMENTBENCHMARK_RADIUS * cosf(LineMovementBenchmark_move * angle) - LINEMOVEMENTBENCHMARK_RADIUS;
+      LineMovementBenchmark_targetW.y = LINEMOVEMENTBENCHMARK_RADIUS * sinf(LineMovementBenchmark_move * angle);
+      LineMovementBenchmark_targetW.e += length * LINEMOVEMENTBENCHMARK_EXTRUSION;
+      motionPlanner.addLineMovement(LineMovementBenchmark_targetW, LINEMOVEMENTBENCHMARK_FEEDRATE);
+      while (!motionPlanner.isReady())
+        {
+          LineMovementBenchmark_drain();
+          motionPlanner.run();
+        }
+      LineMovementBenchmark_drain();
+    }
+}
+
+int main(void)
+{
+  const WorldCoordinate_t lengths[] = {0.2, 0.5, 5.0, 20.0};
+
+  Kinematic_init();
+  motionPlanner.init();
+  Parameter_publish(&parameter);
+  Parameter_update();
+  kinematic.init();
+  Benchmark_init();
+  for (uint8_t i=0; i<sizeof(lengths)/sizeof(lengths[0]); i++)
+    {
+      const WorldCoordinate_t length = lengths[i];
+      char name[40];
+
+      snprintf(name, sizeof(name), "addLineMovement %s %.1fmm", MACHINE_PROFILE_NAME, length);
+      motionPlanner = MotionPlanner();
+      LineMovementBenchmark_move = 0;
+      LineMovementBenchmark_targetW = {0.0, 0.0, 0.0, 0.0};
+      Benchmark_run("MotionPlanner", name, LINEMOVEMENTBENCHMARK_MOVES, [length]()
+        {
+          LineMovementBenchmark_run(length);
+        });
+    }
+  return 0;
+}
+
+/* ******************| End of file |*********************************** */
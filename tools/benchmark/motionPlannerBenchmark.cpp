@@ -0,0 +1,136 @@
+/**
+ * \file motionPlannerBenchmark.cpp
+ *
+ * \brief Benchmark of the motion planner on the host
+ *
+ * Plans circles made of short line moves, as produced by slicers, with
+ * #MotionPlanner::addLineMovement and reports the host time spent per
+ * move and per block added to the motion buffer. Blocks are taken out of
+ * the motion buffer as soon as it is full, without being executed. The
+ * time includes calculating the circle and emptying the motion buffer,
+ * both are small compared to planning.
+ * Built once for each machine profile by the Makefile (-include).
+ * All sources are included directly to get a single translation unit.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <chrono>
+#include <x86intrin.h>
+#include <stdio.h>
+#include "../../RingBuffer/src/ringBuffer.cpp"
+#include "../../Parameter/src/parameter.cpp"
+#include "../../Kinematic/src/kinematic.cpp"
+#include "../../MotionBuffer/src/motionBuffer.cpp"
+#include "../../MotionPlanner/src/motionPlanner.cpp"
+
+/* ******************| Macros |**************************************** */
+/**
+ * Number of line moves planned for each length
+ */
+#define MOTIONPLANNERBENCHMARK_MOVES        (uint32_t)200000
+
+/**
+ * Radius of the circles [mm]
+ */
+#define MOTIONPLANNERBENCHMARK_RADIUS       (WorldCoordinate_t)50.0
+
+/**
+ * Feedrate of all moves [mm/s]
+ */
+#define MOTIONPLANNERBENCHMARK_FEEDRATE     (WorldCoordinate_t)60.0
+
+/**
+ * Filament used per mm of travel [mm]
+ */
+#define MOTIONPLANNERBENCHMARK_EXTRUSION    (WorldCoordinate_t)0.033
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Number of blocks taken out of the motion buffer
+ */
+static uint32_t MotionPlannerBenchmark_blocks;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Cycle counter of the host, used by the latency probes of the
+ * motion planner
+ *
+ * @return Time stamp counter of the CPU [cycles]
+ */
+uint64_t Platform_timeCycles(void)
+{
+  return __rdtsc();
+}
+
+/**
+ * \brief Empties the motion buffer
+ */
+static void MotionPlannerBenchmark_drain()
+{
+  MotionBlock_t block;
+
+  while (MotionBuffer_read(&block) == RESULT_OK)
+    {
+      MotionPlannerBenchmark_blocks++;
+    }
+}
+
+/**
+ * \brief Plans #MOTIONPLANNERBENCHMARK_MOVES moves of the given length
+ *
+ * @param[in] length Length of each move [mm]
+ * @return Host time [ns]
+ */
+static uint64_t MotionPlannerBenchmark_run(WorldCoordinate_t length)
+{
+  const float angle = length / MOTIONPLANNERBENCHMARK_RADIUS;
+  WorldCoordinates_t targetW = {0.0, 0.0, 0.0, 0.0};
+
+  MotionPlannerBenchmark_blocks = 0;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (uint32_t i=1; i<=MOTIONPLANNERBENCHMARK_MOVES; i++)
+    {
+      targetW.x = MOTIONPLANNERBENCHMARK_RADIUS * cosf(i * angle) - MOTIONPLANNERBENCHMARK_RADIUS;
+      targetW.y = MOTIONPLANNERBENCHMARK_RADIUS * sinf(i * angle);
+      targetW.e += length * MOTIONPLANNERBENCHMARK_EXTRUSION;
+      while (motionPlanner.addLineMovement(targetW, MOTIONPLANNERBENCHMARK_FEEDRATE) != RESULT_OK)
+        {
+          MotionPlannerBenchmark_drain();
+          motionPlanner.run();
+        }
+    }
+  while (!motionPlanner.isReady())
+    {
+      MotionPlannerBenchmark_drain();
+      motionPlanner.run();
+    }
+  MotionPlannerBenchmark_drain();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(void)
+{
+  const WorldCoordinate_t lengths[] = {0.2, 0.5, 1.0, 5.0, 20.0};
+
+  Kinematic_init();
+  motionPlanner.init();
+  Parameter_publish(&parameter);
+  Parameter_update();
+  kinematic.init();
+  printf("MotionPlanner on the host, %s profile, %u moves per length\n", MACHINE_PROFILE_NAME, MOTIONPLANNERBENCHMARK_MOVES);
+  printf("%10s %9s %12s %13s\n", "length[mm]", "blocks", "move[ns]", "block[ns]");
+  for (uint8_t i=0; i<sizeof(lengths)/sizeof(lengths[0]); i++)
+    {
+      motionPlanner = MotionPlanner();
+      uint64_t time = MotionPlannerBenchmark_run(lengths[i]);
+      printf("%10.1f %9u %12.1f %13.1f\n", lengths[i], MotionPlannerBenchmark_blocks,
+             (double)time / MOTIONPLANNERBENCHMARK_MOVES, (double)time / MotionPlannerBenchmark_blocks);
+    }
+  return 0;
+}
+
+/* ******************| End of file |*********************************** */
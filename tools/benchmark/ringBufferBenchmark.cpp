@@ -0,0 +1,102 @@
+/**
+ * \file ringBufferBenchmark.cpp
+ *
+ * \brief Micro benchmark of the ring buffer on the host
+ *
+ * Writes, reads and iterates over a full ring buffer of
+ * #RINGBUFFERBENCHMARK_SIZE elements for elements of 1, 4, 16 and 64 bytes,
+ * e.g. serial bytes, small events and motion blocks. One operation is one
+ * call of #RingBuffer::write, #RingBuffer::read or #RingBuffer::nextElement.
+ * Prints one JSON line per case, see benchmark.h.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+/* ******************| Inclusions |************************************ */
+#include "benchmark.h"
+#include <ringBuffer.h>
+
+/* ******************| Macros |**************************************** */
+/**
+ * Number of elements of each ring buffer
+ */
+#define RINGBUFFERBENCHMARK_SIZE            (uint8_t)64
+
+/* ******************| Type definitions |****************************** */
+/**
+ * Element of the given size
+ */
+template <uint8_t bytes> struct RingBufferBenchmark_Element_t
+{
+  uint8_t data[bytes];    /*!< Payload */
+};
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Runs all cases for elements of the given size
+ *
+ * @param[in] write Name of the write case
+ * @param[in] read Name of the read case
+ * @param[in] iterate Name of the iterate case
+ */
+template <uint8_t bytes> static void RingBufferBenchmark_run(const char *write, const char *read, const char *iterate)
+{
+  static RingBuffer<RingBufferBenchmark_Element_t<bytes>, RINGBUFFERBENCHMARK_SIZE> ringBuffer;
+  static RingBufferBenchmark_Element_t<bytes> element;
+  auto empty = []()
+    {
+      while (ringBuffer.read(&element) == RESULT_OK)
+        {
+        }
+    };
+  auto fill = []()
+    {
+      while (ringBuffer.write(element) == RESULT_OK)
+        {
+          element.data[0]++;
+        }
+    };
+
+  Benchmark_run("RingBuffer", write, RINGBUFFERBENCHMARK_SIZE, empty, []()
+    {
+      for (uint8_t i=0; i<RINGBUFFERBENCHMARK_SIZE; i++)
+        {
+          element.data[0] = i;
+          ringBuffer.write(element);
+        }
+    });
+  Benchmark_run("RingBuffer", read, RINGBUFFERBENCHMARK_SIZE, fill, []()
+    {
+      for (uint8_t i=0; i<RINGBUFFERBENCHMARK_SIZE; i++)
+        {
+          ringBuffer.read(&element);
+          Benchmark_sink += element.data[bytes - 1];
+        }
+    });
+  fill();
+  Benchmark_run("RingBuffer", iterate, RINGBUFFERBENCHMARK_SIZE, []()
+    {
+      RingBufferBenchmark_Element_t<bytes> *iterator = ringBuffer.startIterator(RINGBUFFER_ITERATOR_TAIL);
+
+      while (iterator != NULL)
+        {
+          Benchmark_sink += iterator->data[bytes - 1];
+          iterator = ringBuffer.nextElement();
+        }
+    });
+  empty();
+}
+
+int main(void)
+{
+  Benchmark_init();
+  RingBufferBenchmark_run<1>("write 1B", "read 1B", "iterate 1B");
+  RingBufferBenchmark_run<4>("write 4B", "read 4B", "iterate 4B");
+  RingBufferBenchmark_run<16>("write 16B", "read 16B", "iterate 16B");
+  RingBufferBenchmark_run<64>("write 64B", "read 64B", "iterate 64B");
+  return 0;
+}
+
+/* ******************| End of file |*********************************** */
@@ -0,0 +1,143 @@
+/**
+ * \file stepCompressBenchmark.cpp
+ *
+ * \brief Benchmark of the compressed step schedules on the host
+ *
+ * Executes the same trapezoid blocks as stepperBenchmark with the
+ * StepCompress step generator. Reports the compression ratio, the host
+ * time spent compressing in the main loop and the host time spent in
+ * #StepCompress_isr replaying the schedules.
+ * All sources are included directly to get a single translation unit.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <chrono>
+#include <x86intrin.h>
+#include <stdio.h>
+#define STEPPER_GENERATOR       STEPPER_GENERATOR_STEPCOMPRESS
+#include "../../RingBuffer/src/ringBuffer.cpp"
+#include "../../MotionBuffer/src/motionBuffer.cpp"
+#include "../../StepCompress/src/stepCompress.cpp"
+#include "../../Platform_WindowsX86/src/stepperTimer.cpp"
+
+/* ******************| Macros |**************************************** */
+/**
+ * Number of step events of each block
+ */
+#define STEPCOMPRESSBENCHMARK_STEP_EVENTS    (StepperCoordinate_t)20000
+
+/**
+ * Number of blocks executed for each rate
+ */
+#define STEPCOMPRESSBENCHMARK_BLOCKS         (uint8_t)20
+
+/**
+ * Time the step timer advances between two calls of the main loop
+ * [ticks]. 1ms.
+ */
+#define STEPCOMPRESSBENCHMARK_LOOP_TICKS     (STEPPER_TIMER_FREQUENCY / 1000)
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Host time spent in #StepCompress_run [ns]
+ */
+static uint64_t StepCompressBenchmark_compressTime;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Calls the main loop part of StepCompress and advances the timer
+ */
+static void StepCompressBenchmark_loop()
+{
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  StepCompress_run();
+  StepCompressBenchmark_compressTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+  Platform_stepperTimerRun(STEPCOMPRESSBENCHMARK_LOOP_TICKS);
+}
+
+/**
+ * \brief Checks if StepCompress has anything left to do
+ * @return True if there are blocks, steps or schedules left
+ */
+static bool StepCompressBenchmark_busy()
+{
+  bool busy = stepCompressState.blockActive || motionBuffer.available();
+
+  for (uint8_t i=0; i<STEPPER_NUM_STEPPER; i++)
+    {
+      busy |= (stepCompressState.stepper[i].pendingCount > 0) || stepCompressQueue[i].available() || StepCompress_replay[i].count;
+    }
+  return busy;
+}
+
+/**
+ * \brief Executes #STEPCOMPRESSBENCHMARK_BLOCKS blocks at nominal rate
+ *
+ * Same blocks as used by stepperBenchmark.
+ * @param[in] rate Nominal rate [steps/sec]
+ */
+static void StepCompressBenchmark_run(StepperCoordinate_t rate)
+{
+  MotionBlock_t block = {};
+  StepperCoordinate_t rampSteps = STEPCOMPRESSBENCHMARK_STEP_EVENTS / 10;
+
+  block.steps.steps[0] = STEPCOMPRESSBENCHMARK_STEP_EVENTS;
+  block.steps.steps[1] = STEPCOMPRESSBENCHMARK_STEP_EVENTS * 7 / 10;
+  block.steps.extruder[0] = STEPCOMPRESSBENCHMARK_STEP_EVENTS / 20;
+  block.stepEventCount = STEPCOMPRESSBENCHMARK_STEP_EVENTS;
+  block.nominalRate = rate;
+  block.initialRate = rate / 10;
+  block.finalRate = rate / 10;
+  /* a = (v^2 - v0^2) / 2s */
+  block.accelerationRate = (StepperCoordinate_t)(((uint64_t)rate * rate - (uint64_t)block.initialRate * block.initialRate) / (2 * rampSteps));
+  block.accelerateUntil = rampSteps;
+  block.decelerateAfter = STEPCOMPRESSBENCHMARK_STEP_EVENTS - rampSteps;
+
+  Platform_stepperTimerStatistics = {0, 0, 0xFFFFFFFF, 0, 0, 0};
+  StepCompressBenchmark_compressTime = 0;
+  stepCompressState.steps = 0;
+  stepCompressState.schedules = 0;
+  for (uint8_t i=0; i<STEPCOMPRESSBENCHMARK_BLOCKS; i++)
+    {
+      block.steps.directionBits = (i & 1) ? 0x03 : 0x00;
+      while (MotionBuffer_write(block) != RESULT_OK)
+        {
+          StepCompressBenchmark_loop();
+        }
+    }
+  while (StepCompressBenchmark_busy())
+    {
+      StepCompressBenchmark_loop();
+    }
+}
+
+int main(void)
+{
+  const StepperCoordinate_t rates[] = {5000, 10000, 20000, 40000, 80000, 160000};
+  Platform_StepperTimerStatistics_t &stats = Platform_stepperTimerStatistics;
+
+  StepCompress_init();
+  printf("StepCompress on the host, %u step events per rate, maximum error %d ticks\n",
+         STEPCOMPRESSBENCHMARK_STEP_EVENTS * STEPCOMPRESSBENCHMARK_BLOCKS, STEPCOMPRESS_MAXIMUM_ERROR);
+  printf("%8s %9s %9s %7s %8s %13s %11s %11s %12s\n", "rate", "steps", "schedules", "ratio", "bytes[%]",
+         "compress[ns]", "isr[ns]", "isr[cyc]", "isr[ns/step]");
+  for (uint8_t i=0; i<sizeof(rates)/sizeof(rates[0]); i++)
+    {
+      StepCompressBenchmark_run(rates[i]);
+      /* Bytes of the schedules compared to one 32 bit time per step */
+      printf("%8u %9u %9u %7.1f %8.2f %13.1f %11.1f %11.1f %12.1f\n", rates[i], stepCompressState.steps, stepCompressState.schedules,
+             (double)stepCompressState.steps / stepCompressState.schedules,
+             100.0 * stepCompressState.schedules * sizeof(StepCompress_Schedule_t) / (stepCompressState.steps * sizeof(uint32_t)),
+             (double)StepCompressBenchmark_compressTime / stepCompressState.steps,
+             (double)stats.hostTime / stats.isrCalls, (double)stats.hostCycles / stats.isrCalls,
+             (double)stats.hostTime / stepCompressState.steps);
+    }
+  return 0;
+}
+
+/* ******************| End of file |*********************************** */
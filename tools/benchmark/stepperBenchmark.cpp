@@ -0,0 +1,127 @@
+/**
+ * \file stepperBenchmark.cpp
+ *
+ * \brief Benchmark of the step generator on the host
+ *
+ * Executes trapezoid blocks with increasing nominal step rates on the
+ * virtual step timer of the platform and reports the host time and cycles
+ * spent in #Stepper_isr. From these the maximum step rate the host could
+ * sustain and the number of cycles available per interrupt at each rate
+ * are derived.
+ * Built twice by the Makefile, with multi-stepping and with one step event
+ * per interrupt (-DSTEPPER_MAXIMUM_STEP_LOOPS=1), to compare both.
+ * All sources are included directly to get a single translation unit.
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <chrono>
+#include <x86intrin.h>
+#include <stdio.h>
+#include "../../RingBuffer/src/ringBuffer.cpp"
+#include "../../MotionBuffer/src/motionBuffer.cpp"
+#include "../../Stepper/src/stepper.cpp"
+#include "../../Platform_WindowsX86/src/stepperTimer.cpp"
+
+/* ******************| Macros |**************************************** */
+/**
+ * Number of step events of each block
+ */
+#define STEPPERBENCHMARK_STEP_EVENTS    (StepperCoordinate_t)20000
+
+/**
+ * Number of blocks executed for each rate
+ */
+#define STEPPERBENCHMARK_BLOCKS         (uint8_t)20
+
+/**
+ * CPU frequency of the target used to calculate the cycle budget per step
+ * event on the target [Hz]. Default is a 16MHz AVR.
+ * It's possible to override default by specifying the value during compile
+ * time with -DSTEPPERBENCHMARK_TARGET_FREQUENCY 16000000
+ */
+#ifndef STEPPERBENCHMARK_TARGET_FREQUENCY
+#define STEPPERBENCHMARK_TARGET_FREQUENCY   16000000.0
+#endif
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Executes #STEPPERBENCHMARK_BLOCKS blocks at nominal rate
+ *
+ * Each block moves X and Y diagonally with some extrusion and accelerates
+ * from and decelerates to 1/10 of the nominal rate within 10% of its step
+ * events.
+ * @param[in] rate Nominal rate [steps/sec]
+ */
+static void StepperBenchmark_run(StepperCoordinate_t rate)
+{
+  MotionBlock_t block = {};
+  StepperCoordinate_t rampSteps = STEPPERBENCHMARK_STEP_EVENTS / 10;
+
+  block.steps.steps[0] = STEPPERBENCHMARK_STEP_EVENTS;
+  block.steps.steps[1] = STEPPERBENCHMARK_STEP_EVENTS * 7 / 10;
+  block.steps.extruder[0] = STEPPERBENCHMARK_STEP_EVENTS / 20;
+  block.stepEventCount = STEPPERBENCHMARK_STEP_EVENTS;
+  block.nominalRate = rate;
+  block.initialRate = rate / 10;
+  block.finalRate = rate / 10;
+  /* a = (v^2 - v0^2) / 2s */
+  block.accelerationRate = (StepperCoordinate_t)(((uint64_t)rate * rate - (uint64_t)block.initialRate * block.initialRate) / (2 * rampSteps));
+  block.accelerateUntil = rampSteps;
+  block.decelerateAfter = STEPPERBENCHMARK_STEP_EVENTS - rampSteps;
+
+  Platform_stepperTimerStatistics = {0, 0, 0xFFFFFFFF, 0, 0, 0};
+  for (uint8_t i=0; i<STEPPERBENCHMARK_BLOCKS; i++)
+    {
+      block.steps.directionBits = (i & 1) ? 0x03 : 0x00;
+      while (MotionBuffer_write(block) != RESULT_OK)
+        {
+          Platform_stepperTimerRun(STEPPER_TIMER_FREQUENCY / 100);
+        }
+    }
+  while (stepperState.blockActive || motionBuffer.available())
+    {
+      Platform_stepperTimerRun(STEPPER_TIMER_FREQUENCY / 100);
+    }
+}
+
+int main(void)
+{
+  const StepperCoordinate_t rates[] = {5000, 10000, 20000, 40000, 80000, 160000};
+  Platform_StepperTimerStatistics_t &stats = Platform_stepperTimerStatistics;
+  double averageTime;
+  double averageCycles;
+  double peakIsrRate;
+  double stepEventTime = 0.0;
+
+  Stepper_init();
+  printf("Stepper ISR on the host, %u step events per rate, up to %u step events per interrupt\n",
+         STEPPERBENCHMARK_STEP_EVENTS * STEPPERBENCHMARK_BLOCKS, STEPPER_MAXIMUM_STEP_LOOPS);
+  printf("%8s %5s %8s %9s %9s %9s %9s %11s %11s %8s\n", "rate", "loops", "isrRate", "avg[ns]", "max[ns]",
+         "[ns/step]", "avg[cyc]", "hostBudget", "tgtBudget", "load[%]");
+  for (uint8_t i=0; i<sizeof(rates)/sizeof(rates[0]); i++)
+    {
+      StepperBenchmark_run(rates[i]);
+      averageTime = (double)stats.hostTime / stats.isrCalls;
+      averageCycles = (double)stats.hostCycles / stats.isrCalls;
+      stepEventTime = (double)stats.hostTime / stats.stepEvents;
+      peakIsrRate = (double)STEPPER_TIMER_FREQUENCY / stats.minInterval;
+      /* Budget is the number of cycles available per interrupt at the peak
+       * rate, load the share of host time spent in the ISR */
+      printf("%8u %5u %8.0f %9.1f %9u %9.1f %9.1f %11.0f %11.0f %8.2f\n", rates[i], stepperState.stepLoops, peakIsrRate,
+             averageTime, stats.maxHostTime, stepEventTime, averageCycles,
+             averageCycles / averageTime * 1E9 / peakIsrRate, STEPPERBENCHMARK_TARGET_FREQUENCY / peakIsrRate,
+             averageTime * 1E-9 * peakIsrRate * 100.0);
+    }
+  /* Maximum host time includes preemption by the host operating system
+   * and is therefore not used here */
+  printf("Maximum sustainable step rate on the host: %.0f steps/sec\n", 1E9 / stepEventTime);
+  printf("Maximum step rate at %u interrupts/sec: %u steps/sec\n", STEPPER_MAXIMUM_ISR_RATE,
+         STEPPER_MAXIMUM_ISR_RATE * STEPPER_MAXIMUM_STEP_LOOPS);
+  return 0;
+}
+
+/* ******************| End of file |*********************************** */
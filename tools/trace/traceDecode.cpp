@@ -0,0 +1,165 @@
+/**
+ * \file traceDecode.cpp
+ *
+ * \brief Converts a dump of the Trace module into the Chrome trace format
+ *
+ * The output is loaded with chrome://tracing or https://ui.perfetto.dev.
+ * Each pipeline stage is shown as thread: g-codes read by the reader,
+ * line movements started by the planner and step interrupt calls
+ * executing a block by the stepper. The fill level of each ring buffer is shown as counter, a
+ * write to a full ring buffer as instant event.
+ * Cycles are converted to microseconds with the time stamps of the
+ * header.
+ *
+ * Usage: traceDecode <dump> [<json>]
+ *
+ * \project BlueMarlin
+ * \author kein0r
+ *
+ */
+
+/* ******************| Inclusions |************************************ */
+#include <stdio.h>
+#include <string.h>
+#include <trace.h>
+
+/* ******************| Macros |**************************************** */
+/**
+ * Thread ids of the pipeline stages
+ */
+#define TRACEDECODE_TID_READER      1
+#define TRACEDECODE_TID_PLANNER     2
+#define TRACEDECODE_TID_STEPPER     3
+#define TRACEDECODE_TID_BUFFERS     4
+
+/* ******************| Global Variables |****************************** */
+/**
+ * Header of the dump
+ */
+static Trace_Header_t TraceDecode_header;
+
+/**
+ * Microseconds per cycle
+ */
+static double TraceDecode_scale;
+
+/* ******************| Function Implementation |*********************** */
+/**
+ * \brief Returns the name of an object
+ *
+ * @param[in] object Lowest 16 bit of the address
+ * @param[out] name Registered name or the address
+ * @param[in] size Size of name
+ */
+static void TraceDecode_name(uint16_t object, char *name, size_t size)
+{
+  for (uint8_t i=0; (i<TraceDecode_header.names) && (i<TRACE_MAX_NAMES); i++)
+    {
+      if (TraceDecode_header.name[i].object == object)
+        {
+          snprintf(name, size, "%.*s", (int)TRACE_NAME_LENGTH, TraceDecode_header.name[i].name);
+          return;
+        }
+    }
+  snprintf(name, size, "ringBuffer@0x%04x", object);
+}
+
+/**
+ * \brief Writes one record as Chrome trace event
+ *
+ * @param[in] output Output file
+ * @param[in] record Record
+ */
+static void TraceDecode_event(FILE *output, const Trace_Record_t *record)
+{
+  double time = TraceDecode_header.startMicros + (double)(int64_t)(record->time - TraceDecode_header.startCycles) * TraceDecode_scale;
+  double duration = record->value * TraceDecode_scale;
+  char name[TRACE_NAME_LENGTH + 32];
+
+  switch (record->event)
+    {
+    case TRACE_EVENT_GCODE:
+      fprintf(output, ",\n{\"name\":\"gcode\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"queued\":%u}}",
+              time, TRACEDECODE_TID_READER, record->value);
+      break;
+    case TRACE_EVENT_LINE:
+      fprintf(output, ",\n{\"name\":\"line movement\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+              time - duration, duration, TRACEDECODE_TID_PLANNER);
+      break;
+    case TRACE_EVENT_STEP:
+      fprintf(output, ",\n{\"name\":\"step interrupt\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+              time - duration, duration, TRACEDECODE_TID_STEPPER);
+      break;
+    case TRACE_EVENT_RINGBUFFER_WRITE:
+    case TRACE_EVENT_RINGBUFFER_READ:
+      TraceDecode_name(record->object, name, sizeof(name));
+      fprintf(output, ",\n{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"elements\":%u}}",
+              name, time, TRACEDECODE_TID_BUFFERS, record->value);
+      break;
+    case TRACE_EVENT_RINGBUFFER_FULL:
+      TraceDecode_name(record->object, name, sizeof(name));
+      fprintf(output, ",\n{\"name\":\"%s full\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+              name, time, TRACEDECODE_TID_BUFFERS);
+      break;
+    default:
+      break;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+  const char *threads[] = {"Reader", "Planner", "Stepper", "Ring buffers"};
+  Trace_Record_t record;
+  FILE *input;
+  FILE *output = stdout;
+
+  if ((argc < 2) || (argc > 3))
+    {
+      fprintf(stderr, "Usage: %s <dump> [<json>]\n", argv[0]);
+      return 1;
+    }
+  input = fopen(argv[1], "rb");
+  if ((input == NULL) || (fread(&TraceDecode_header, sizeof(TraceDecode_header), 1, input) != 1) ||
+      (memcmp(TraceDecode_header.magic, "BMTR", sizeof(TraceDecode_header.magic)) != 0) ||
+      (TraceDecode_header.version != TRACE_VERSION) || (TraceDecode_header.recordSize != sizeof(Trace_Record_t)) ||
+      (TraceDecode_header.headerSize != sizeof(Trace_Header_t)))
+    {
+      fprintf(stderr, "%s is no trace dump of this version\n", argv[1]);
+      return 1;
+    }
+  if ((argc == 3) && ((output = fopen(argv[2], "w")) == NULL))
+    {
+      fprintf(stderr, "Can't write %s\n", argv[2]);
+      return 1;
+    }
+  TraceDecode_scale = (TraceDecode_header.endCycles > TraceDecode_header.startCycles) ?
+                      (double)(TraceDecode_header.endMicros - TraceDecode_header.startMicros) /
+                      (double)(TraceDecode_header.endCycles - TraceDecode_header.startCycles) : 0.0;
+
+  fprintf(output, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+  fprintf(output, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"BlueMarlin\"}}");
+  for (uint8_t i=0; i<sizeof(threads)/sizeof(threads[0]); i++)
+    {
+      fprintf(output, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}", i + 1, threads[i]);
+    }
+  for (uint32_t i=0; i<TraceDecode_header.records; i++)
+    {
+      if (fread(&record, sizeof(record), 1, input) != 1)
+        {
+          fprintf(stderr, "Dump ends after %u of %u records\n", i, TraceDecode_header.records);
+          break;
+        }
+      TraceDecode_event(output, &record);
+    }
+  fprintf(output, "\n]}\n");
+  fprintf(stderr, "%u records, %u lost, %.6f us per cycle\n", TraceDecode_header.records, TraceDecode_header.lostRecords,
+          TraceDecode_scale);
+  fclose(input);
+  if (output != stdout)
+    {
+      fclose(output);
+    }
+  return 0;
+}
+
+/* ******************| End of file |*********************************** */